@@ -13,6 +13,7 @@
 
 #include "fem.hpp"
 #include "../general/device.hpp"
+#include "../general/annotation.hpp"
 #include <cmath>
 
 namespace mfem
@@ -74,6 +75,7 @@ BilinearForm::BilinearForm(FiniteElementSpace * f)
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = 0;
+   elem_cache = NULL;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::LEGACY;
@@ -93,6 +95,7 @@ BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
    hybridization = NULL;
    precompute_sparsity = ps;
    diag_policy = DIAG_KEEP;
+   elem_cache = NULL;
 
    assembly = AssemblyLevel::LEGACY;
    batch = 1;
@@ -206,6 +209,12 @@ void BilinearForm::UseSparsity(SparseMatrix &A)
    UseSparsity(A.GetI(), A.GetJ(), A.ColumnsAreSorted());
 }
 
+void BilinearForm::UseElementAssemblyCache(bool use)
+{
+   delete elem_cache;
+   elem_cache = use ? new ElementAssemblyCache(*fes) : NULL;
+}
+
 double& BilinearForm::Elem (int i, int j)
 {
    return mat -> Elem(i,j);
@@ -223,6 +232,7 @@ MatrixInverse * BilinearForm::Inverse() const
 
 void BilinearForm::Finalize (int skip_zeros)
 {
+   MemoryUsageTag mem_tag("BilinearForm");
    if (assembly == AssemblyLevel::LEGACY)
    {
       if (!static_cond) { mat->Finalize(skip_zeros); }
@@ -384,6 +394,8 @@ void BilinearForm::AssembleBdrElementMatrix(
 
 void BilinearForm::Assemble(int skip_zeros)
 {
+   MFEM_PERF_FUNCTION;
+   MemoryUsageTag mem_tag("BilinearForm");
    if (ext)
    {
       ext->Assemble();
@@ -422,10 +434,30 @@ void BilinearForm::Assemble(int skip_zeros)
          }
       }
 
+      // The cached vdofs reference the cache data, so they are not stored in
+      // the vdofs member which is resized by the other loops.
+      Array<int> cached_vdofs;
+      Array<int> &el_vdofs = elem_cache ? cached_vdofs : vdofs;
+      if (elem_cache)
+      {
+         elem_cache->Update();
+         Array<Geometry::Type> geoms;
+         mesh->GetGeometries(mesh->Dimension(), geoms);
+         for (int k = 0; k < domain_integs.Size(); k++)
+         {
+            const IntegrationRule *ir = domain_integs[k]->GetIntegrationRule();
+            for (int g = 0; ir && g < geoms.Size(); g++)
+            {
+               elem_cache->AddIntegrationRule(geoms[g], *ir);
+            }
+         }
+      }
+
       for (int i = 0; i < fes -> GetNE(); i++)
       {
          int elem_attr = fes->GetMesh()->GetAttribute(i);
-         doftrans = fes->GetElementVDofs(i, vdofs);
+         doftrans = elem_cache ? elem_cache->GetElementVDofs(i, el_vdofs) :
+                    fes->GetElementVDofs(i, el_vdofs);
          if (element_matrices)
          {
             elmat_p = &(*element_matrices)(i);
@@ -433,14 +465,22 @@ void BilinearForm::Assemble(int skip_zeros)
          else
          {
             elmat.SetSize(0);
+            const FiniteElement *fe = NULL;
+            eltrans = NULL;
             for (int k = 0; k < domain_integs.Size(); k++)
             {
                if ( domain_integs_marker[k] == NULL ||
                     (*(domain_integs_marker[k]))[elem_attr-1] == 1)
                {
-                  const FiniteElement &fe = *fes->GetFE(i);
-                  eltrans = fes->GetElementTransformation(i);
-                  domain_integs[k]->AssembleElementMatrix(fe, *eltrans, elemmat);
+                  if (fe == NULL)
+                  {
+                     fe = elem_cache ? elem_cache->GetFE(i) : fes->GetFE(i);
+                     eltrans = elem_cache ?
+                               elem_cache->GetElementTransformation(i) :
+                               fes->GetElementTransformation(i);
+                  }
+                  domain_integs[k]->AssembleElementMatrix(*fe, *eltrans,
+                                                          elemmat);
                   if (elmat.Size() == 0)
                   {
                      elmat = elemmat;
@@ -471,7 +511,7 @@ void BilinearForm::Assemble(int skip_zeros)
          }
          else
          {
-            mat->AddSubMatrix(vdofs, vdofs, *elmat_p, skip_zeros);
+            mat->AddSubMatrix(el_vdofs, el_vdofs, *elmat_p, skip_zeros);
             if (hybridization)
             {
                hybridization->AssembleMatrix(i, *elmat_p);
@@ -773,6 +813,7 @@ void BilinearForm::FormLinearSystem(const Array<int> &ess_tdof_list, Vector &x,
 void BilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                     OperatorHandle &A)
 {
+   MemoryUsageTag mem_tag("BilinearForm");
    if (ext)
    {
       ext->FormSystemMatrix(ess_tdof_list, A);
@@ -1077,6 +1118,27 @@ void BilinearForm::MultTranspose(const Vector & x, Vector & y) const
    }
 }
 
+void BilinearForm::ReassembleGeometry(int skip_zeros)
+{
+   MFEM_VERIFY(fes->GetVSize() == Height() && sequence == fes->GetSequence(),
+               "the finite element space has changed, use Update() instead");
+
+   if (ext)
+   {
+      ext->ReassembleGeometry();
+      return;
+   }
+
+   delete mat_e;
+   mat_e = NULL;
+   FreeElementMatrices();
+   if (mat) { *mat = 0.0; }
+   if (hybridization) { hybridization->Reset(); }
+   if (static_cond) { EnableStaticCondensation(); }
+
+   Assemble(skip_zeros);
+}
+
 void BilinearForm::Update(FiniteElementSpace *nfes)
 {
    bool full_update;
@@ -1085,6 +1147,7 @@ void BilinearForm::Update(FiniteElementSpace *nfes)
    {
       full_update = true;
       fes = nfes;
+      if (elem_cache) { UseElementAssemblyCache(); }
    }
    else
    {
@@ -1131,6 +1194,7 @@ BilinearForm::~BilinearForm()
    delete element_matrices;
    delete static_cond;
    delete hybridization;
+   delete elem_cache;
 
    if (!extern_bfs)
    {
@@ -21,6 +21,7 @@
 #include "bilinearform_ext.hpp"
 #include "staticcond.hpp"
 #include "hybridization.hpp"
+#include "elementcache.hpp"
 
 namespace mfem
 {
@@ -123,6 +124,9 @@ protected:
    DiagonalPolicy diag_policy;
 
    int precompute_sparsity;
+
+   /// Cached element data used by Assemble(), see UseElementAssemblyCache().
+   ElementAssemblyCache *elem_cache; ///< Owned.
    // Allocate appropriate SparseMatrix and assign it to mat
    void AllocMat();
 
@@ -135,6 +139,7 @@ protected:
       mat = mat_e = NULL; extern_bfs = 0; element_matrices = NULL;
       static_cond = NULL; hybridization = NULL;
       precompute_sparsity = 0;
+      elem_cache = NULL;
       diag_policy = DIAG_KEEP;
       assembly = AssemblyLevel::LEGACY;
       batch = 1;
@@ -212,6 +217,21 @@ public:
        present in the bilinear form. */
    void UsePrecomputedSparsity(int ps = 1) { precompute_sparsity = ps; }
 
+   /** @brief Cache the element vdofs, transformations and Jacobians used by
+       the element loop of the legacy Assemble(), see ElementAssemblyCache.
+
+       The cache is built by this call and reused by all following calls to
+       Assemble(), e.g. when the form is reassembled with new coefficients. It
+       is rebuilt when the space or the mesh nodes change. The Jacobians are
+       cached at the points of the integration rules set in the domain
+       integrators, see BilinearFormIntegrator::SetIntRule(); integrators
+       using their default rules evaluate the Jacobians as usual. */
+   void UseElementAssemblyCache(bool use = true);
+
+   /// Return the element assembly cache, or NULL if it is not used.
+   const ElementAssemblyCache *GetElementAssemblyCache() const
+   { return elem_cache; }
+
    /** @brief Use the given CSR sparsity pattern to allocate the internal
        SparseMatrix.
 
@@ -407,6 +427,22 @@ public:
    /// Assembles the form i.e. sums over all domain/bdr integrators.
    void Assemble(int skip_zeros = 1);
 
+   /** @brief Reassemble the form after the nodes of the mesh have moved, e.g.
+       in a Lagrangian or ALE simulation.
+
+       The mesh topology and the finite element space must be unchanged. With
+       partial assembly only the geometric factors and the quadrature point
+       data of the integrators are recomputed, reusing the restriction
+       operators and the work vectors of the extension. With legacy assembly
+       the sparse matrix is zeroed and reassembled in place (its sparsity
+       pattern is kept).
+
+       The caller must call Mesh::NodesUpdated() once after moving the nodes
+       and before calling this method on the forms defined on the mesh, so
+       that the geometric factors are recomputed. The Mesh methods that modify
+       the nodes, e.g. Mesh::MoveNodes(), call it already. */
+   void ReassembleGeometry(int skip_zeros = 1);
+
    /** @brief Assemble the diagonal of the bilinear form into @a diag. Note that
        @a diag is a tdof Vector.
 
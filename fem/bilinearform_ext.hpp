@@ -61,6 +61,12 @@ public:
                                  OperatorHandle &A, Vector &X, Vector &B,
                                  int copy_interior = 0) = 0;
    virtual void Update() = 0;
+
+   /** @brief Recompute the assembled data after the mesh nodes have moved,
+       assuming the mesh topology and the finite element spaces are unchanged.
+
+       The default implementation simply calls Assemble(). */
+   virtual void ReassembleGeometry() { Assemble(); }
 };
 
 /// Data and methods for partially-assembled bilinear forms
@@ -89,8 +95,15 @@ public:
    void MultTranspose(const Vector &x, Vector &y) const;
    void Update();
 
+   /** @brief Recompute only the quadrature point data of the integrators,
+       reusing the restriction operators and work vectors. */
+   void ReassembleGeometry() { AssembleIntegrators(); }
+
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
+
+   /// Call the partial assembly methods of all integrators.
+   void AssembleIntegrators();
 };
 
 /// Data and methods for element-assembled bilinear forms
@@ -110,6 +123,7 @@ public:
    EABilinearFormExtension(BilinearForm *form);
 
    void Assemble();
+   void ReassembleGeometry() { Assemble(); }
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
 };
@@ -255,6 +255,37 @@ public:
                                     Vector &flux, Vector *d_energy = NULL)
    { return 0.0; }
 
+   /** @brief Batched version of ComputeElementFlux() for all elements.
+
+       Computes the flux of the solution @a u, an L-vector of @a fes, at the
+       nodes of the elements of @a flux_fes. On return, @a flux is an E-vector
+       of @a flux_fes with native ordering, see
+       FiniteElementSpace::GetElementRestriction().
+
+       @returns False, without computing the fluxes, if the batched computation
+       is not supported by the integrator or by the given spaces. The default
+       implementation always returns false. */
+   virtual bool ComputeElementFluxes(const FiniteElementSpace &fes,
+                                     const Vector &u,
+                                     const FiniteElementSpace &flux_fes,
+                                     Vector &flux, bool with_coef = true)
+   { return false; }
+
+   /** @brief Batched version of ComputeFluxEnergy() for all elements.
+
+       The @a flux is an E-vector of @a flux_fes with native ordering. The
+       energies of the elements are returned in @a energy and, if @a d_energy
+       is not NULL, the directional energy splits are returned in @a d_energy,
+       as a (dim x NE) column-major matrix.
+
+       @returns False, without computing the energies, if the batched
+       computation is not supported. The default implementation always returns
+       false. */
+   virtual bool ComputeFluxEnergies(const FiniteElementSpace &flux_fes,
+                                    const Vector &flux, Vector &energy,
+                                    Vector *d_energy = NULL)
+   { return false; }
+
    virtual ~BilinearFormIntegrator() { }
 };
 
@@ -2148,6 +2179,17 @@ public:
                                     ElementTransformation &Trans,
                                     Vector &flux, Vector *d_energy = NULL);
 
+   /// Supported for scalar (or no) coefficients, see the base class method.
+   virtual bool ComputeElementFluxes(const FiniteElementSpace &fes,
+                                     const Vector &u,
+                                     const FiniteElementSpace &flux_fes,
+                                     Vector &flux, bool with_coef = true);
+
+   /// Supported for scalar (or no) coefficients, see the base class method.
+   virtual bool ComputeFluxEnergies(const FiniteElementSpace &flux_fes,
+                                    const Vector &flux, Vector &energy,
+                                    Vector *d_energy = NULL);
+
    using BilinearFormIntegrator::AssemblePA;
 
    virtual void AssembleMF(const FiniteElementSpace &fes);
@@ -3486,6 +3528,8 @@ protected:
 
 
 // PA Diffusion Assemble 2D kernel
+// If 'affine' is true, 'j' stores one Jacobian per element, see
+// GeometricFactors::compressed.
 template<const int T_SDIM>
 void PADiffusionSetup2D(const int Q1D,
                         const int coeffDim,
@@ -3493,7 +3537,8 @@ void PADiffusionSetup2D(const int Q1D,
                         const Array<double> &w,
                         const Vector &j,
                         const Vector &c,
-                        Vector &d);
+                        Vector &d,
+                        const bool affine = false);
 
 }
 #endif
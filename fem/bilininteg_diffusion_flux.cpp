@@ -0,0 +1,202 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "../linalg/dtensor.hpp"
+#include "../linalg/kernels.hpp"
+#include "bilininteg.hpp"
+#include "quadinterpolator.hpp"
+
+namespace mfem
+{
+
+// Batched fluxes and flux energies of the diffusion integrator, used by the
+// error estimators.
+
+// Check if the batched kernels support the (vector) flux space 'flux_fes'.
+static bool SupportsBatchedFlux(const FiniteElementSpace &flux_fes)
+{
+   const Mesh *mesh = flux_fes.GetMesh();
+   const int dim = mesh->Dimension();
+   if (mesh->GetNE() == 0 || dim < 2 || mesh->SpaceDimension() != dim ||
+       mesh->GetNumGeometries(dim) != 1 || flux_fes.GetVDim() != dim ||
+       flux_fes.IsVariableOrder() || flux_fes.GetNURBSext())
+   {
+      return false;
+   }
+   const FiniteElement *fe = flux_fes.GetFE(0);
+   return fe->GetRangeType() == FiniteElement::SCALAR &&
+          fe->GetMapType() == FiniteElement::VALUE;
+}
+
+template<int DIM>
+static void DiffusionFluxes(const int NE, const int NQ, const Vector &grad,
+                            const Vector &J, const Vector *coeff, Vector &flux)
+{
+   auto G = Reshape(grad.Read(), NQ, DIM, NE);
+   auto Jac = Reshape(J.Read(), NQ, DIM, DIM, NE);
+   const bool use_coeff = (coeff != NULL);
+   auto C = Reshape(use_coeff ? coeff->Read() : nullptr, NQ, NE);
+   auto F = Reshape(flux.Write(), NQ, DIM, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double Jq[DIM*DIM], A[DIM*DIM];
+      for (int c = 0; c < DIM; c++)
+      {
+         for (int r = 0; r < DIM; r++) { Jq[r + DIM*c] = Jac(q,r,c,e); }
+      }
+      kernels::CalcAdjugate<DIM>(Jq, A);
+      // flux = J^{-T} grad_ref = adj(J)^T grad_ref / det(J)
+      const double s = (use_coeff ? C(q,e) : 1.0) / kernels::Det<DIM>(Jq);
+      for (int d = 0; d < DIM; d++)
+      {
+         double f = 0.0;
+         for (int k = 0; k < DIM; k++) { f += A[k + DIM*d] * G(q,k,e); }
+         F(q,d,e) = s*f;
+      }
+   });
+}
+
+bool DiffusionIntegrator::ComputeElementFluxes(
+   const FiniteElementSpace &fes, const Vector &u,
+   const FiniteElementSpace &flux_fes, Vector &flux, bool with_coef)
+{
+   if (VQ || MQ || !SupportsBatchedFlux(flux_fes)) { return false; }
+   if (fes.GetVDim() != 1 || fes.IsVariableOrder() || fes.GetNURBSext())
+   {
+      return false;
+   }
+   const FiniteElement *el = fes.GetFE(0);
+   if (el->GetRangeType() != FiniteElement::SCALAR ||
+       el->GetMapType() != FiniteElement::VALUE)
+   {
+      return false;
+   }
+
+   Mesh *mesh = fes.GetMesh();
+   const int NE = mesh->GetNE();
+   const int dim = mesh->Dimension();
+   // The flux is computed at the nodes of the flux elements
+   const IntegrationRule &ir = flux_fes.GetFE(0)->GetNodes();
+   const int NQ = ir.GetNPoints();
+
+   const ElementDofOrdering ordering = ElementDofOrdering::NATIVE;
+   const Operator *R = fes.GetElementRestriction(ordering);
+   Vector u_e(R->Height());
+   R->Mult(u, u_e);
+
+   // The nodes are not a tensor-product quadrature rule and the E-vector uses
+   // the native ordering, so the general interpolation kernels are used.
+   QuadratureInterpolator qi(fes, ir);
+   qi.SetOutputLayout(QVectorLayout::byNODES);
+   qi.DisableTensorProducts();
+   Vector grad(NQ*dim*NE), empty;
+   qi.Mult(u_e, QuadratureInterpolator::DERIVATIVES, empty, grad, empty);
+
+   const GeometricFactors *geom =
+      mesh->GetGeometricFactors(ir, GeometricFactors::JACOBIANS);
+
+   Vector coeff;
+   const bool use_coeff = with_coef && Q;
+   if (use_coeff)
+   {
+      QuadratureSpace qs(mesh, ir);
+      Q->Project(qs, coeff);
+   }
+
+   flux.SetSize(NQ*dim*NE);
+   const Vector *c = use_coeff ? &coeff : NULL;
+   switch (dim)
+   {
+      case 2: DiffusionFluxes<2>(NE, NQ, grad, geom->J, c, flux); break;
+      case 3: DiffusionFluxes<3>(NE, NQ, grad, geom->J, c, flux); break;
+      default: MFEM_ABORT("invalid dimension");
+   }
+   return true;
+}
+
+bool DiffusionIntegrator::ComputeFluxEnergies(
+   const FiniteElementSpace &flux_fes, const Vector &flux, Vector &energy,
+   Vector *d_energy)
+{
+   if (VQ || MQ || !SupportsBatchedFlux(flux_fes)) { return false; }
+
+   Mesh *mesh = flux_fes.GetMesh();
+   const int NE = mesh->GetNE();
+   const int dim = mesh->Dimension();
+   const FiniteElement *fluxelem = flux_fes.GetFE(0);
+   const int order = 2 * fluxelem->GetOrder();
+   const IntegrationRule &ir = IntRules.Get(fluxelem->GetGeomType(), order);
+   const int NQ = ir.GetNPoints();
+
+   // The flux E-vector uses the native ordering, which is not supported by
+   // the tensor-product interpolation kernels.
+   QuadratureInterpolator qi(flux_fes, ir);
+   qi.SetOutputLayout(QVectorLayout::byNODES);
+   qi.DisableTensorProducts();
+   Vector pflux(NQ*dim*NE), empty;
+   qi.Mult(flux, QuadratureInterpolator::VALUES, pflux, empty, empty);
+
+   const int flags = GeometricFactors::DETERMINANTS |
+                     (d_energy ? GeometricFactors::JACOBIANS : 0);
+   const GeometricFactors *geom = mesh->GetGeometricFactors(ir, flags);
+
+   Vector coeff;
+   if (Q)
+   {
+      QuadratureSpace qs(mesh, ir);
+      Q->Project(qs, coeff);
+   }
+
+   energy.SetSize(NE);
+   if (d_energy) { d_energy->SetSize(dim*NE); }
+   const bool use_coeff = (Q != NULL);
+   const bool aniso = (d_energy != NULL);
+   auto W = ir.GetWeights().Read();
+   auto detJ = Reshape(geom->detJ.Read(), NQ, NE);
+   auto Jac = Reshape(aniso ? geom->J.Read() : nullptr, NQ, dim, dim, NE);
+   auto C = Reshape(use_coeff ? coeff.Read() : nullptr, NQ, NE);
+   auto F = Reshape(pflux.Read(), NQ, dim, NE);
+   auto E = energy.Write();
+   auto D = Reshape(aniso ? d_energy->Write() : nullptr, dim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      double en = 0.0;
+      double d_en[3] = {0.0, 0.0, 0.0};
+      for (int q = 0; q < NQ; q++)
+      {
+         const double w = W[q] * detJ(q,e);
+         double f2 = 0.0;
+         for (int d = 0; d < dim; d++) { f2 += F(q,d,e)*F(q,d,e); }
+         en += w * (use_coeff ? C(q,e) : 1.0) * f2;
+         if (aniso)
+         {
+            // transform the flux to the reference element
+            for (int k = 0; k < dim; k++)
+            {
+               double v = 0.0;
+               for (int d = 0; d < dim; d++) { v += Jac(q,d,k,e)*F(q,d,e); }
+               d_en[k] += w * v * v;
+            }
+         }
+      }
+      E[e] = en;
+      if (aniso)
+      {
+         for (int k = 0; k < dim; k++) { D(k,e) = d_en[k]; }
+      }
+   });
+   return true;
+}
+
+} // namespace mfem
@@ -87,14 +87,15 @@ void PADiffusionSetup2D<2>(const int Q1D,
                            const Array<double> &w,
                            const Vector &j,
                            const Vector &c,
-                           Vector &d)
+                           Vector &d,
+                           const bool affine)
 {
    const bool symmetric = (coeffDim != 4);
    const bool const_c = c.Size() == 1;
    MFEM_VERIFY(coeffDim < 3 ||
                !const_c, "Constant matrix coefficient not supported");
    const auto W = Reshape(w.Read(), Q1D,Q1D);
-   const auto J = Reshape(j.Read(), Q1D,Q1D,2,2,NE);
+   const auto J = Reshape(j.Read(), affine ? 1 : Q1D*Q1D,2,2,NE);
    const auto C = const_c ? Reshape(c.Read(), 1,1,1,1) :
                   Reshape(c.Read(), coeffDim,Q1D,Q1D,NE);
    auto D = Reshape(d.Write(), Q1D,Q1D, symmetric ? 3 : 4, NE);
@@ -104,10 +105,11 @@ void PADiffusionSetup2D<2>(const int Q1D,
       {
          MFEM_FOREACH_THREAD(qy,y,Q1D)
          {
-            const double J11 = J(qx,qy,0,0,e);
-            const double J21 = J(qx,qy,1,0,e);
-            const double J12 = J(qx,qy,0,1,e);
-            const double J22 = J(qx,qy,1,1,e);
+            const int q = affine ? 0 : qx + Q1D*qy;
+            const double J11 = J(q,0,0,e);
+            const double J21 = J(q,1,0,e);
+            const double J12 = J(q,0,1,e);
+            const double J22 = J(q,1,1,e);
             const double w_detJ = W(qx,qy) / ((J11*J22)-(J21*J12));
             if (coeffDim == 3 || coeffDim == 4) // Matrix coefficient
             {
@@ -154,14 +156,15 @@ void PADiffusionSetup2D<3>(const int Q1D,
                            const Array<double> &w,
                            const Vector &j,
                            const Vector &c,
-                           Vector &d)
+                           Vector &d,
+                           const bool affine)
 {
    MFEM_VERIFY(coeffDim == 1, "Matrix and vector coefficients not supported");
    constexpr int DIM = 2;
    constexpr int SDIM = 3;
    const bool const_c = c.Size() == 1;
    const auto W = Reshape(w.Read(), Q1D,Q1D);
-   const auto J = Reshape(j.Read(), Q1D,Q1D,SDIM,DIM,NE);
+   const auto J = Reshape(j.Read(), affine ? 1 : Q1D*Q1D,SDIM,DIM,NE);
    const auto C = const_c ? Reshape(c.Read(), 1,1,1) :
                   Reshape(c.Read(), Q1D,Q1D,NE);
    auto D = Reshape(d.Write(), Q1D,Q1D, 3, NE);
@@ -172,12 +175,13 @@ void PADiffusionSetup2D<3>(const int Q1D,
          MFEM_FOREACH_THREAD(qy,y,Q1D)
          {
             const double wq = W(qx,qy);
-            const double J11 = J(qx,qy,0,0,e);
-            const double J21 = J(qx,qy,1,0,e);
-            const double J31 = J(qx,qy,2,0,e);
-            const double J12 = J(qx,qy,0,1,e);
-            const double J22 = J(qx,qy,1,1,e);
-            const double J32 = J(qx,qy,2,1,e);
+            const int q = affine ? 0 : qx + Q1D*qy;
+            const double J11 = J(q,0,0,e);
+            const double J21 = J(q,1,0,e);
+            const double J31 = J(q,2,0,e);
+            const double J12 = J(q,0,1,e);
+            const double J22 = J(q,1,1,e);
+            const double J32 = J(q,2,1,e);
             const double E = J11*J11 + J21*J21 + J31*J31;
             const double G = J12*J12 + J22*J22 + J32*J32;
             const double F = J11*J12 + J21*J22 + J31*J32;
@@ -199,14 +203,15 @@ void PADiffusionSetup3D(const int Q1D,
                         const Array<double> &w,
                         const Vector &j,
                         const Vector &c,
-                        Vector &d)
+                        Vector &d,
+                        const bool affine)
 {
    const bool symmetric = (coeffDim != 9);
    const bool const_c = c.Size() == 1;
    MFEM_VERIFY(coeffDim < 6 ||
                !const_c, "Constant matrix coefficient not supported");
    const auto W = Reshape(w.Read(), Q1D,Q1D,Q1D);
-   const auto J = Reshape(j.Read(), Q1D,Q1D,Q1D,3,3,NE);
+   const auto J = Reshape(j.Read(), affine ? 1 : Q1D*Q1D*Q1D,3,3,NE);
    const auto C = const_c ? Reshape(c.Read(), 1,1,1,1,1) :
                   Reshape(c.Read(), coeffDim,Q1D,Q1D,Q1D,NE);
    auto D = Reshape(d.Write(), Q1D,Q1D,Q1D, symmetric ? 6 : 9, NE);
@@ -218,15 +223,16 @@ void PADiffusionSetup3D(const int Q1D,
          {
             MFEM_FOREACH_THREAD(qz,z,Q1D)
             {
-               const double J11 = J(qx,qy,qz,0,0,e);
-               const double J21 = J(qx,qy,qz,1,0,e);
-               const double J31 = J(qx,qy,qz,2,0,e);
-               const double J12 = J(qx,qy,qz,0,1,e);
-               const double J22 = J(qx,qy,qz,1,1,e);
-               const double J32 = J(qx,qy,qz,2,1,e);
-               const double J13 = J(qx,qy,qz,0,2,e);
-               const double J23 = J(qx,qy,qz,1,2,e);
-               const double J33 = J(qx,qy,qz,2,2,e);
+               const int q = affine ? 0 : qx + Q1D*(qy + Q1D*qz);
+               const double J11 = J(q,0,0,e);
+               const double J21 = J(q,1,0,e);
+               const double J31 = J(q,2,0,e);
+               const double J12 = J(q,0,1,e);
+               const double J22 = J(q,1,1,e);
+               const double J32 = J(q,2,1,e);
+               const double J13 = J(q,0,2,e);
+               const double J23 = J(q,1,2,e);
+               const double J33 = J(q,2,2,e);
                const double detJ = J11 * (J22 * J33 - J32 * J23) -
                /* */               J21 * (J12 * J33 - J32 * J13) +
                /* */               J31 * (J12 * J23 - J22 * J13);
@@ -319,13 +325,14 @@ static void PADiffusionSetup(const int dim,
                              const Array<double> &W,
                              const Vector &J,
                              const Vector &C,
-                             Vector &D)
+                             Vector &D,
+                             const bool affine)
 {
    if (dim == 1) { MFEM_ABORT("dim==1 not supported in PADiffusionSetup"); }
    if (dim == 2)
    {
 #ifdef MFEM_USE_OCCA
-      if (DeviceCanUseOcca())
+      if (DeviceCanUseOcca() && !affine)
       {
          OccaPADiffusionSetup2D(D1D, Q1D, NE, W, J, C, D);
          return;
@@ -333,19 +340,25 @@ static void PADiffusionSetup(const int dim,
 #else
       MFEM_CONTRACT_VAR(D1D);
 #endif // MFEM_USE_OCCA
-      if (sdim == 2) { PADiffusionSetup2D<2>(Q1D, coeffDim, NE, W, J, C, D); }
-      if (sdim == 3) { PADiffusionSetup2D<3>(Q1D, coeffDim, NE, W, J, C, D); }
+      if (sdim == 2)
+      {
+         PADiffusionSetup2D<2>(Q1D, coeffDim, NE, W, J, C, D, affine);
+      }
+      if (sdim == 3)
+      {
+         PADiffusionSetup2D<3>(Q1D, coeffDim, NE, W, J, C, D, affine);
+      }
    }
    if (dim == 3)
    {
 #ifdef MFEM_USE_OCCA
-      if (DeviceCanUseOcca())
+      if (DeviceCanUseOcca() && !affine)
       {
          OccaPADiffusionSetup3D(D1D, Q1D, NE, W, J, C, D);
          return;
       }
 #endif // MFEM_USE_OCCA
-      PADiffusionSetup3D(Q1D, coeffDim, NE, W, J, C, D);
+      PADiffusionSetup3D(Q1D, coeffDim, NE, W, J, C, D, affine);
    }
 }
 
@@ -373,7 +386,8 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    const int nq = ir->GetNPoints();
    dim = mesh->Dimension();
    ne = fes.GetNE();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS, mt);
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS |
+                                    GeometricFactors::COMPRESSED, mt);
    const int sdim = mesh->SpaceDimension();
    maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
    dofs1D = maps->ndof;
@@ -385,74 +399,23 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    {
       MFEM_VERIFY(SMQ->GetSize() == dim, "");
       coeffDim = symmDims;
-      coeff.SetSize(symmDims * nq * ne);
-
-      DenseSymmetricMatrix sym_mat;
-      sym_mat.SetSize(dim);
-
-      auto C = Reshape(coeff.HostWrite(), symmDims, nq, ne);
-
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            SMQ->Eval(sym_mat, *tr, ir->IntPoint(p));
-            int cnt = 0;
-            for (int i=0; i<dim; ++i)
-               for (int j=i; j<dim; ++j, ++cnt)
-               {
-                  C(cnt, p, e) = sym_mat(i,j);
-               }
-         }
-      }
+      QuadratureSpace qs(mesh, *ir);
+      SMQ->ProjectSymmetric(qs, coeff);
    }
    else if (MQ)
    {
       symmetric = false;
       MFEM_VERIFY(MQ->GetHeight() == dim && MQ->GetWidth() == dim, "");
-
       coeffDim = MQfullDim;
-
-      coeff.SetSize(MQfullDim * nq * ne);
-
-      DenseMatrix mat;
-      mat.SetSize(dim);
-
-      auto C = Reshape(coeff.HostWrite(), MQfullDim, nq, ne);
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            MQ->Eval(mat, *tr, ir->IntPoint(p));
-            for (int i=0; i<dim; ++i)
-               for (int j=0; j<dim; ++j)
-               {
-                  C(j+(i*dim), p, e) = mat(i,j);
-               }
-         }
-      }
+      QuadratureSpace qs(mesh, *ir);
+      MQ->Project(qs, coeff, true);
    }
    else if (VQ)
    {
       MFEM_VERIFY(VQ->GetVDim() == dim, "");
       coeffDim = VQ->GetVDim();
-      coeff.SetSize(coeffDim * nq * ne);
-      auto C = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-      Vector DM(coeffDim);
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            VQ->Eval(DM, *tr, ir->IntPoint(p));
-            for (int i=0; i<coeffDim; ++i)
-            {
-               C(i, p, e) = DM[i];
-            }
-         }
-      }
+      QuadratureSpace qs(mesh, *ir);
+      VQ->Project(qs, coeff);
    }
    else if (Q == nullptr)
    {
@@ -479,20 +442,12 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      QuadratureSpace qs(fes.GetMesh(), *ir);
+      Q->Project(qs, coeff);
    }
    pa_data.SetSize((symmetric ? symmDims : MQfullDim) * nq * ne, mt);
    PADiffusionSetup(dim, sdim, dofs1D, quad1D, coeffDim, ne, ir->GetWeights(),
-                    geom->J, coeff, pa_data);
+                    geom->J, coeff, pa_data, geom->compressed);
 }
 
 template<int T_D1D = 0, int T_Q1D = 0>
@@ -1742,6 +1697,25 @@ static void PADiffusionApply(const int dim,
                              const Vector &X,
                              Vector &Y)
 {
+   static const int perf_keys[2] =
+   {
+      Profiler::RegisterRegion("PADiffusionApply2D"),
+      Profiler::RegisterRegion("PADiffusionApply3D")
+   };
+   ProfilerRegion perf_region(perf_keys[dim == 2 ? 0 : 1], true);
+   {
+      // sum factorization of the gradient with B, G and of its transpose, and
+      // the product with the (symmetric) dim x dim matrices D at the
+      // quadrature points; X is read, Y is read and written, D is read
+      const double d = D1D, q = Q1D;
+      const double flops = (dim == 2) ? 8.0*(d*d*q + d*q*q) + 8.0*q*q :
+                           4.0*(2.0*d*d*d*q + 3.0*d*d*q*q + 3.0*d*q*q*q) +
+                           18.0*q*q*q;
+      const int nd = symm ? dim*(dim+1)/2 : dim*dim;
+      const double words = (dim == 2) ? 3.0*d*d + nd*q*q :
+                           3.0*d*d*d + nd*q*q*q;
+      MFEM_PERF_WORK(NE*flops, NE*words*sizeof(double));
+   }
 #ifdef MFEM_USE_OCCA
    if (DeviceCanUseOcca())
    {
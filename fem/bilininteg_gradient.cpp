@@ -236,16 +236,8 @@ void GradientIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *trial_fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      QuadratureSpace qs(trial_fes.GetMesh(), *ir);
+      Q->Project(qs, coeff);
    }
 
    PAGradientSetup(dim, trial_dofs1D, test_dofs1D, quad1D,
@@ -993,70 +993,29 @@ void CurlCurlIntegrator::AssemblePA(const FiniteElementSpace &fes)
 
    Vector coeff(coeffDim * ne * nq);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-   if (Q || DQ || MQ)
+   if (Q)
    {
-      Vector DM(DQ ? coeffDim : 0);
-      DenseMatrix GM;
-      DenseSymmetricMatrix SM;
-
-      if (DQ)
-      {
-         MFEM_VERIFY(coeffDim == dimc, "");
-      }
+      QuadratureSpace qs(mesh, *ir);
+      Q->Project(qs, coeff);
+   }
+   else if (DQ || MQ)
+   {
+      QuadratureSpace qs(mesh, *ir);
       if (SMQ)
       {
-         SM.SetSize(dimc);
          MFEM_VERIFY(SMQ->GetSize() == dimc, "");
+         SMQ->ProjectSymmetric(qs, coeff);
       }
       else if (MQ)
       {
-         GM.SetSize(dimc);
          MFEM_VERIFY(coeffDim == MQdim, "");
          MFEM_VERIFY(MQ->GetHeight() == dimc && MQ->GetWidth() == dimc, "");
+         MQ->Project(qs, coeff, true);
       }
-
-      for (int e=0; e<ne; ++e)
+      else
       {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            if (SMQ)
-            {
-               SMQ->Eval(SM, *tr, ir->IntPoint(p));
-
-               int cnt = 0;
-               for (int i=0; i<dimc; ++i)
-                  for (int j=i; j<dimc; ++j, ++cnt)
-                  {
-                     coeffh(cnt, p, e) = SM(i,j);
-                  }
-
-            }
-            else if (MQ)
-            {
-               MQ->Eval(GM, *tr, ir->IntPoint(p));
-
-               for (int i=0; i<dimc; ++i)
-                  for (int j=0; j<dimc; ++j)
-                  {
-                     coeffh(j+(i*dimc), p, e) = GM(i,j);
-                  }
-
-            }
-            else if (DQ)
-            {
-               DQ->Eval(DM, *tr, ir->IntPoint(p));
-               for (int i=0; i<coeffDim; ++i)
-               {
-                  coeffh(i, p, e) = DM[i];
-               }
-            }
-            else
-            {
-               coeffh(0, p, e) = Q->Eval(*tr, ir->IntPoint(p));
-            }
-         }
+         MFEM_VERIFY(coeffDim == dimc, "");
+         DQ->Project(qs, coeff);
       }
    }
 
@@ -3491,17 +3450,10 @@ void MixedScalarCurlIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
 
    Vector coeff(ne * nq);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), nq, ne);
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeffh(p, e) = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      QuadratureSpace qs(mesh, *ir);
+      Q->Project(qs, coeff);
    }
 
    if (dim == 2)
@@ -3595,35 +3547,16 @@ void MixedVectorCurlIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
 
    Vector coeff(coeffDim * nq * ne);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-   if (Q || DQ)
+   if (Q)
    {
-      Vector V(coeffDim);
-      if (DQ)
-      {
-         MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
-      }
-
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-
-         for (int p=0; p<nq; ++p)
-         {
-            if (DQ)
-            {
-               DQ->Eval(V, *tr, ir->IntPoint(p));
-               for (int i=0; i<coeffDim; ++i)
-               {
-                  coeffh(i, p, e) = V[i];
-               }
-            }
-            else
-            {
-               coeffh(0, p, e) = Q->Eval(*tr, ir->IntPoint(p));
-            }
-         }
-      }
+      QuadratureSpace qs(mesh, *ir);
+      Q->Project(qs, coeff);
+   }
+   else if (DQ)
+   {
+      MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
+      QuadratureSpace qs(mesh, *ir);
+      DQ->Project(qs, coeff);
    }
 
    if (testType == mfem::FiniteElement::CURL &&
@@ -5148,35 +5081,16 @@ void MixedVectorWeakCurlIntegrator::AssemblePA(const FiniteElementSpace
 
    Vector coeff(coeffDim * nq * ne);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-   if (Q || DQ)
+   if (Q)
    {
-      Vector V(coeffDim);
-      if (DQ)
-      {
-         MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
-      }
-
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-
-         for (int p=0; p<nq; ++p)
-         {
-            if (DQ)
-            {
-               DQ->Eval(V, *tr, ir->IntPoint(p));
-               for (int i=0; i<coeffDim; ++i)
-               {
-                  coeffh(i, p, e) = V[i];
-               }
-            }
-            else
-            {
-               coeffh(0, p, e) = Q->Eval(*tr, ir->IntPoint(p));
-            }
-         }
-      }
+      QuadratureSpace qs(mesh, *ir);
+      Q->Project(qs, coeff);
+   }
+   else if (DQ)
+   {
+      MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
+      QuadratureSpace qs(mesh, *ir);
+      DQ->Project(qs, coeff);
    }
 
    if (trialType == mfem::FiniteElement::CURL && dim == 3)
@@ -929,14 +929,8 @@ void DivDivIntegrator::AssemblePA(const FiniteElementSpace &fes)
    coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      QuadratureSpace qs(mesh, *ir);
+      Q->Project(qs, coeff);
    }
 
    if (el->GetDerivType() == mfem::FiniteElement::DIV && dim == 3)
@@ -1199,14 +1193,8 @@ VectorFEDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
    coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      QuadratureSpace qs(mesh, *ir);
+      Q->Project(qs, coeff);
    }
 
    if (trial_el->GetDerivType() == mfem::FiniteElement::DIV && dim == 3)
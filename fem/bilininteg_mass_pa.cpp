@@ -45,8 +45,8 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    dim = mesh->Dimension();
    ne = fes.GetMesh()->GetNE();
    nq = ir->GetNPoints();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::COORDINATES |
-                                    GeometricFactors::JACOBIANS, mt);
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS |
+                                    GeometricFactors::COMPRESSED, mt);
    maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
@@ -77,16 +77,8 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      QuadratureSpace qs(fes.GetMesh(), *ir);
+      Q->Project(qs, coeff);
    }
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
    if (dim==2)
@@ -95,8 +87,9 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
       const int Q1D = quad1D;
       const bool const_c = coeff.Size() == 1;
       const bool by_val = map_type == FiniteElement::VALUE;
+      const bool affine = geom->compressed; // one Jacobian per element
       const auto W = Reshape(ir->GetWeights().Read(), Q1D,Q1D);
-      const auto J = Reshape(geom->J.Read(), Q1D,Q1D,2,2,NE);
+      const auto J = Reshape(geom->J.Read(), affine ? 1 : Q1D*Q1D,2,2,NE);
       const auto C = const_c ? Reshape(coeff.Read(), 1,1,1) :
                      Reshape(coeff.Read(), Q1D,Q1D,NE);
       auto v = Reshape(pa_data.Write(), Q1D,Q1D, NE);
@@ -106,10 +99,11 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
          {
             MFEM_FOREACH_THREAD(qy,y,Q1D)
             {
-               const double J11 = J(qx,qy,0,0,e);
-               const double J12 = J(qx,qy,1,0,e);
-               const double J21 = J(qx,qy,0,1,e);
-               const double J22 = J(qx,qy,1,1,e);
+               const int q = affine ? 0 : qx + Q1D*qy;
+               const double J11 = J(q,0,0,e);
+               const double J12 = J(q,1,0,e);
+               const double J21 = J(q,0,1,e);
+               const double J22 = J(q,1,1,e);
                const double detJ = (J11*J22)-(J21*J12);
                const double coeff = const_c ? C(0,0,0) : C(qx,qy,e);
                v(qx,qy,e) =  W(qx,qy) * coeff * (by_val ? detJ : 1.0/detJ);
@@ -123,8 +117,9 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
       const int Q1D = quad1D;
       const bool const_c = coeff.Size() == 1;
       const bool by_val = map_type == FiniteElement::VALUE;
+      const bool affine = geom->compressed; // one Jacobian per element
       const auto W = Reshape(ir->GetWeights().Read(), Q1D,Q1D,Q1D);
-      const auto J = Reshape(geom->J.Read(), Q1D,Q1D,Q1D,3,3,NE);
+      const auto J = Reshape(geom->J.Read(), affine ? 1 : Q1D*Q1D*Q1D,3,3,NE);
       const auto C = const_c ? Reshape(coeff.Read(), 1,1,1,1) :
                      Reshape(coeff.Read(), Q1D,Q1D,Q1D,NE);
       auto v = Reshape(pa_data.Write(), Q1D,Q1D,Q1D,NE);
@@ -136,15 +131,16 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
             {
                MFEM_FOREACH_THREAD(qz,z,Q1D)
                {
-                  const double J11 = J(qx,qy,qz,0,0,e);
-                  const double J21 = J(qx,qy,qz,1,0,e);
-                  const double J31 = J(qx,qy,qz,2,0,e);
-                  const double J12 = J(qx,qy,qz,0,1,e);
-                  const double J22 = J(qx,qy,qz,1,1,e);
-                  const double J32 = J(qx,qy,qz,2,1,e);
-                  const double J13 = J(qx,qy,qz,0,2,e);
-                  const double J23 = J(qx,qy,qz,1,2,e);
-                  const double J33 = J(qx,qy,qz,2,2,e);
+                  const int q = affine ? 0 : qx + Q1D*(qy + Q1D*qz);
+                  const double J11 = J(q,0,0,e);
+                  const double J21 = J(q,1,0,e);
+                  const double J31 = J(q,2,0,e);
+                  const double J12 = J(q,0,1,e);
+                  const double J22 = J(q,1,1,e);
+                  const double J32 = J(q,2,1,e);
+                  const double J13 = J(q,0,2,e);
+                  const double J23 = J(q,1,2,e);
+                  const double J33 = J(q,2,2,e);
                   const double detJ = J11 * (J22 * J33 - J32 * J23) -
                   /* */               J21 * (J12 * J33 - J32 * J13) +
                   /* */               J31 * (J12 * J23 - J22 * J13);
@@ -1164,6 +1160,21 @@ static void PAMassApply(const int dim,
                         const Vector &X,
                         Vector &Y)
 {
+   static const int perf_keys[2] =
+   {
+      Profiler::RegisterRegion("PAMassApply2D"),
+      Profiler::RegisterRegion("PAMassApply3D")
+   };
+   ProfilerRegion perf_region(perf_keys[dim == 2 ? 0 : 1], true);
+   {
+      // sum factorization with B and B^T, and the product with D at the
+      // quadrature points; X is read, Y is read and written, D is read
+      const double d = D1D, q = Q1D;
+      const double flops = (dim == 2) ? 4.0*(d*d*q + d*q*q) + q*q :
+                           4.0*(d*d*d*q + d*d*q*q + d*q*q*q) + q*q*q;
+      const double words = (dim == 2) ? 3.0*d*d + q*q : 3.0*d*d*d + q*q*q;
+      MFEM_PERF_WORK(NE*flops, NE*words*sizeof(double));
+   }
 #ifdef MFEM_USE_OCCA
    if (DeviceCanUseOcca())
    {
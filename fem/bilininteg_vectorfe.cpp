@@ -21,7 +21,8 @@ void PADiffusionSetup3D(const int Q1D,
                         const Array<double> &w,
                         const Vector &j,
                         const Vector &coeff_,
-                        Vector &op);
+                        Vector &op,
+                        const bool affine = false);
 
 void PAHcurlMassAssembleDiagonal2D(const int D1D,
                                    const int Q1D,
@@ -820,68 +821,29 @@ void VectorFEMassIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
 
    Vector coeff(coeffDim * ne * nq);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-   if (Q || DQ || MQ)
+   if (Q)
    {
-      Vector DM(DQ ? coeffDim : 0);
-      DenseMatrix M;
-      DenseSymmetricMatrix SM;
-
-      if (DQ)
-      {
-         MFEM_VERIFY(coeffDim == dim, "");
-      }
+      QuadratureSpace qs(mesh, *ir);
+      Q->Project(qs, coeff);
+   }
+   else if (DQ || MQ)
+   {
+      QuadratureSpace qs(mesh, *ir);
       if (SMQ)
       {
          MFEM_VERIFY(SMQ->GetSize() == dim, "");
-         SM.SetSize(dim);
+         SMQ->ProjectSymmetric(qs, coeff);
       }
       else if (MQ)
       {
          MFEM_VERIFY(coeffDim == MQdim, "");
          MFEM_VERIFY(MQ->GetHeight() == dim && MQ->GetWidth() == dim, "");
-         M.SetSize(dim);
+         MQ->Project(qs, coeff, true);
       }
-
-
-      for (int e=0; e<ne; ++e)
+      else
       {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            if (SMQ)
-            {
-               SMQ->Eval(SM, *tr, ir->IntPoint(p));
-               int cnt = 0;
-               for (int i=0; i<dim; ++i)
-                  for (int j=i; j<dim; ++j, ++cnt)
-                  {
-                     coeffh(cnt, p, e) = SM(i,j);
-                  }
-            }
-            else if (MQ)
-            {
-               MQ->Eval(M, *tr, ir->IntPoint(p));
-
-               for (int i=0; i<dim; ++i)
-                  for (int j=0; j<dim; ++j)
-                  {
-                     coeffh(j+(i*dim), p, e) = M(i,j);
-                  }
-            }
-            else if (DQ)
-            {
-               DQ->Eval(DM, *tr, ir->IntPoint(p));
-               for (int i=0; i<coeffDim; ++i)
-               {
-                  coeffh(i, p, e) = DM[i];
-               }
-            }
-            else
-            {
-               coeffh(0, p, e) = Q->Eval(*tr, ir->IntPoint(p));
-            }
-         }
+         MFEM_VERIFY(coeffDim == dim, "");
+         DQ->Project(qs, coeff);
       }
    }
 
@@ -1160,14 +1122,8 @@ void MixedVectorGradientIntegrator::AssemblePA(const FiniteElementSpace
    coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      QuadratureSpace qs(mesh, *ir);
+      Q->Project(qs, coeff);
    }
 
    // Use the same setup functions as VectorFEMassIntegrator.
@@ -12,9 +12,12 @@
 // Implementation of Coefficient class
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/dtensor.hpp"
 
 #include <cmath>
 #include <limits>
+#include <memory>
 
 namespace mfem
 {
@@ -48,6 +51,77 @@ ElementTransformation *RefinedToCoarse(
    return coarse_T;
 }
 
+// Interpolate the physical coordinates of the quadrature points of qs into x,
+// ordered as (NQ x SDIM x NE), without storing them in the mesh. Meshes without
+// nodes use a temporary linear nodal function filled with the vertices. Returns
+// false if the mesh is not supported by the batched interpolation.
+static bool ProjectCoordinates(QuadratureSpace &qs, Vector &x)
+{
+   Mesh *mesh = qs.GetMesh();
+   const int ne = mesh->GetNE();
+   const GridFunction *nodes = mesh->GetNodes();
+   if (ne == 0 || mesh->NURBSext ||
+       mesh->GetNumGeometries(mesh->Dimension()) > 1 ||
+       (nodes && nodes->FESpace()->IsVariableOrder()))
+   {
+      return false;
+   }
+
+   const int sdim = mesh->SpaceDimension();
+   H1_FECollection vert_fec(1, mesh->Dimension());
+   std::unique_ptr<FiniteElementSpace> vert_fes;
+   GridFunction vert_nodes;
+   if (!nodes)
+   {
+      // the linear H1 dofs are the vertices, ordered byNODES like GetVertices
+      vert_fes.reset(new FiniteElementSpace(mesh, &vert_fec, sdim));
+      vert_nodes.SetSpace(vert_fes.get());
+      mesh->GetVertices(vert_nodes);
+      nodes = &vert_nodes;
+   }
+
+   const IntegrationRule &ir = qs.GetElementIntRule(0);
+   const int nq = ir.GetNPoints();
+   const FiniteElementSpace &nodes_fes = *nodes->FESpace();
+   const Operator *elem_restr =
+      nodes_fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector e_vec(elem_restr->Height());
+   e_vec.UseDevice(true);
+   elem_restr->Mult(*nodes, e_vec);
+   QuadratureInterpolator qi(nodes_fes, ir);
+   qi.SetOutputLayout(QVectorLayout::byNODES);
+   qi.DisableTensorProducts();
+   x.SetSize(nq*sdim*ne);
+   x.UseDevice(true);
+   qi.Values(e_vec, x);
+   return true;
+}
+
+void Coefficient::Project(QuadratureSpace &qs, Vector &coeff)
+{
+   Mesh *mesh = qs.GetMesh();
+   coeff.SetSize(qs.GetSize());
+   double *C = coeff.HostWrite();
+   for (int e = 0, offset = 0; e < mesh->GetNE(); e++)
+   {
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      const IntegrationRule &ir = qs.GetElementIntRule(e);
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         C[offset++] = Eval(T, ip);
+      }
+   }
+}
+
+void ConstantCoefficient::Project(QuadratureSpace &qs, Vector &coeff)
+{
+   coeff.SetSize(qs.GetSize());
+   coeff.UseDevice(true);
+   coeff = constant;
+}
+
 double PWConstCoefficient::Eval(ElementTransformation & T,
                                 const IntegrationPoint & ip)
 {
@@ -55,6 +129,30 @@ double PWConstCoefficient::Eval(ElementTransformation & T,
    return (constants(att-1));
 }
 
+void PWConstCoefficient::Project(QuadratureSpace &qs, Vector &coeff)
+{
+   Mesh *mesh = qs.GetMesh();
+   const int ne = mesh->GetNE();
+   const int nq = (ne > 0) ? qs.GetElementIntRule(0).GetNPoints() : 0;
+   if (qs.GetSize() != nq*ne)
+   {
+      // different number of points per element
+      Coefficient::Project(qs, coeff);
+      return;
+   }
+
+   Array<int> attr(ne);
+   for (int e = 0; e < ne; e++) { attr[e] = mesh->GetAttribute(e); }
+
+   coeff.SetSize(nq*ne);
+   coeff.UseDevice(true);
+   const int NQ = nq;
+   const auto A = attr.Read();
+   const auto K = constants.Read();
+   auto C = coeff.Write();
+   MFEM_FORALL(i, nq*ne, C[i] = K[A[i/NQ] - 1];);
+}
+
 void PWCoefficient::InitMap(const Array<int> & attr,
                             const Array<Coefficient*> & coefs)
 {
@@ -119,6 +217,37 @@ double FunctionCoefficient::Eval(ElementTransformation & T,
    }
 }
 
+void FunctionCoefficient::Project(QuadratureSpace &qs, Vector &coeff)
+{
+   Vector x;
+   if (!ProjectCoordinates(qs, x))
+   {
+      Coefficient::Project(qs, coeff);
+      return;
+   }
+   const IntegrationRule &ir = qs.GetElementIntRule(0);
+   EvalPoints(x, ir.GetNPoints(), qs.GetMesh()->SpaceDimension(), coeff);
+}
+
+void FunctionCoefficient::EvalPoints(const Vector &x, int nq, int sdim,
+                                     Vector &values)
+{
+   const int nb = x.Size() / (nq*sdim);
+   const auto X = Reshape(x.HostRead(), nq, sdim, nb);
+   values.SetSize(nq*nb);
+   auto C = Reshape(values.HostWrite(), nq, nb);
+   Vector transip(sdim);
+   for (int b = 0; b < nb; b++)
+   {
+      for (int q = 0; q < nq; q++)
+      {
+         for (int d = 0; d < sdim; d++) { transip(d) = X(q,d,b); }
+         C(q,b) = Function ? Function(transip) :
+                  TDFunction(transip, GetTime());
+      }
+   }
+}
+
 double GridFunctionCoefficient::Eval (ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
@@ -135,6 +264,57 @@ double GridFunctionCoefficient::Eval (ElementTransformation &T,
    }
 }
 
+void GridFunctionCoefficient::Project(QuadratureSpace &qs, Vector &coeff)
+{
+   Mesh *mesh = qs.GetMesh();
+   const FiniteElementSpace &fes = *GridF->FESpace();
+   if (fes.GetMesh() != mesh || mesh->GetNE() == 0 || fes.GetNURBSext() ||
+       fes.IsVariableOrder() || mesh->GetNumGeometries(mesh->Dimension()) > 1 ||
+       fes.GetFE(0)->GetRangeType() != FiniteElement::SCALAR ||
+       fes.GetFE(0)->GetMapType() != FiniteElement::VALUE)
+   {
+      Coefficient::Project(qs, coeff);
+      return;
+   }
+
+   const IntegrationRule &ir = qs.GetElementIntRule(0);
+   const int ne = mesh->GetNE();
+   const int nq = ir.GetNPoints();
+   const int vdim = fes.GetVDim();
+
+   const bool use_tensor_products = UsesTensorBasis(fes);
+   const ElementDofOrdering e_ordering = use_tensor_products ?
+                                         ElementDofOrdering::LEXICOGRAPHIC :
+                                         ElementDofOrdering::NATIVE;
+   const Operator *elem_restr = fes.GetElementRestriction(e_ordering);
+   Vector e_vec(elem_restr->Height());
+   e_vec.UseDevice(true);
+   elem_restr->Mult(*GridF, e_vec);
+
+   // A local interpolator leaves the settings of the one cached in the space
+   // untouched.
+   QuadratureInterpolator qi(fes, ir);
+   qi.SetOutputLayout(QVectorLayout::byNODES);
+   qi.DisableTensorProducts(!use_tensor_products);
+
+   coeff.SetSize(nq*ne);
+   coeff.UseDevice(true);
+   if (vdim == 1)
+   {
+      qi.Values(e_vec, coeff);
+      return;
+   }
+
+   // extract the requested component, the layout is (NQ x VDIM x NE)
+   Vector q_vec(nq*vdim*ne);
+   q_vec.UseDevice(true);
+   qi.Values(e_vec, q_vec);
+   const int NQ = nq, VDIM = vdim, comp = Component - 1;
+   const auto V = Reshape(q_vec.Read(), NQ, VDIM, ne);
+   auto C = Reshape(coeff.Write(), NQ, ne);
+   MFEM_FORALL(i, nq*ne, C(i%NQ, i/NQ) = V(i%NQ, comp, i/NQ););
+}
+
 void TransformedCoefficient::SetTime(double t)
 {
    if (Q1) { Q1->SetTime(t); }
@@ -203,6 +383,35 @@ void VectorCoefficient::Eval(DenseMatrix &M, ElementTransformation &T,
    }
 }
 
+void VectorCoefficient::Project(QuadratureSpace &qs, Vector &coeff)
+{
+   Mesh *mesh = qs.GetMesh();
+   coeff.SetSize(vdim*qs.GetSize());
+   double *C = coeff.HostWrite();
+   DenseMatrix M;
+   for (int e = 0, offset = 0; e < mesh->GetNE(); e++)
+   {
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      const IntegrationRule &ir = qs.GetElementIntRule(e);
+      Eval(M, T, ir);
+      const double *M_data = M.Data();
+      for (int i = 0; i < vdim*ir.GetNPoints(); i++)
+      {
+         C[offset++] = M_data[i];
+      }
+   }
+}
+
+void VectorConstantCoefficient::Project(QuadratureSpace &qs, Vector &coeff)
+{
+   const int vd = vdim, n = qs.GetSize();
+   coeff.SetSize(vd*n);
+   coeff.UseDevice(true);
+   const auto V = vec.Read();
+   auto C = Reshape(coeff.Write(), vd, n);
+   MFEM_FORALL(i, vd*n, C(i%vd, i/vd) = V[i%vd];);
+}
+
 void PWVectorCoefficient::InitMap(const Array<int> & attr,
                                   const Array<VectorCoefficient*> & coefs)
 {
@@ -283,6 +492,33 @@ void VectorFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
    }
 }
 
+void VectorFunctionCoefficient::Project(QuadratureSpace &qs, Vector &coeff)
+{
+   Vector x;
+   if (Q || !ProjectCoordinates(qs, x))
+   {
+      VectorCoefficient::Project(qs, coeff);
+      return;
+   }
+   const int sdim = qs.GetMesh()->SpaceDimension();
+   const int nq = qs.GetElementIntRule(0).GetNPoints();
+   const int ne = qs.GetMesh()->GetNE();
+   const auto X = Reshape(x.HostRead(), nq, sdim, ne);
+   coeff.SetSize(vdim*nq*ne);
+   double *C = coeff.HostWrite();
+   Vector transip(sdim), V;
+   for (int e = 0; e < ne; e++)
+   {
+      for (int q = 0; q < nq; q++)
+      {
+         for (int d = 0; d < sdim; d++) { transip(d) = X(q,d,e); }
+         V.SetDataAndSize(C + vdim*(q + nq*e), vdim);
+         if (Function) { Function(transip, V); }
+         else { TDFunction(transip, GetTime(), V); }
+      }
+   }
+}
+
 VectorArrayCoefficient::VectorArrayCoefficient (int dim)
    : VectorCoefficient(dim), Coeff(dim), ownCoeff(dim)
 {
@@ -368,6 +604,40 @@ void VectorGridFunctionCoefficient::Eval(
    }
 }
 
+void VectorGridFunctionCoefficient::Project(QuadratureSpace &qs,
+                                            Vector &coeff)
+{
+   Mesh *mesh = qs.GetMesh();
+   const FiniteElementSpace &fes = *GridFunc->FESpace();
+   if (fes.GetMesh() != mesh || mesh->GetNE() == 0 || fes.GetNURBSext() ||
+       fes.IsVariableOrder() || mesh->GetNumGeometries(mesh->Dimension()) > 1 ||
+       fes.GetFE(0)->GetRangeType() != FiniteElement::SCALAR ||
+       fes.GetFE(0)->GetMapType() != FiniteElement::VALUE)
+   {
+      VectorCoefficient::Project(qs, coeff);
+      return;
+   }
+
+   const IntegrationRule &ir = qs.GetElementIntRule(0);
+   const bool use_tensor_products = UsesTensorBasis(fes);
+   const ElementDofOrdering e_ordering = use_tensor_products ?
+                                         ElementDofOrdering::LEXICOGRAPHIC :
+                                         ElementDofOrdering::NATIVE;
+   const Operator *elem_restr = fes.GetElementRestriction(e_ordering);
+   Vector e_vec(elem_restr->Height());
+   e_vec.UseDevice(true);
+   elem_restr->Mult(*GridFunc, e_vec);
+
+   // A local interpolator leaves the settings of the one cached in the space
+   // untouched. The byVDIM layout matches the ordering of the output.
+   QuadratureInterpolator qi(fes, ir);
+   qi.SetOutputLayout(QVectorLayout::byVDIM);
+   qi.DisableTensorProducts(!use_tensor_products);
+   coeff.SetSize(vdim*ir.GetNPoints()*mesh->GetNE());
+   coeff.UseDevice(true);
+   qi.Values(e_vec, coeff);
+}
+
 GradientGridFunctionCoefficient::GradientGridFunctionCoefficient (
    const GridFunction *gf)
    : VectorCoefficient((gf) ?
@@ -517,6 +787,48 @@ void VectorRestrictedCoefficient::Eval(
    }
 }
 
+void MatrixCoefficient::Project(QuadratureSpace &qs, Vector &coeff,
+                                bool transpose)
+{
+   Mesh *mesh = qs.GetMesh();
+   coeff.SetSize(height*width*qs.GetSize());
+   double *C = coeff.HostWrite();
+   DenseMatrix K(height, width);
+   for (int e = 0, offset = 0; e < mesh->GetNE(); e++)
+   {
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      const IntegrationRule &ir = qs.GetElementIntRule(e);
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         Eval(K, T, ip);
+         for (int j = 0; j < width; j++)
+         {
+            for (int i = 0; i < height; i++)
+            {
+               C[offset + (transpose ? j + i*width : i + j*height)] = K(i,j);
+            }
+         }
+         offset += height*width;
+      }
+   }
+}
+
+void MatrixConstantCoefficient::Project(QuadratureSpace &qs, Vector &coeff,
+                                        bool transpose)
+{
+   DenseMatrix vals;
+   if (transpose) { vals.Transpose(mat); }
+   else { vals = mat; }
+   const int size = height*width, nq = qs.GetSize();
+   coeff.SetSize(size*nq);
+   coeff.UseDevice(true);
+   const auto V = vals.Read();
+   auto C = Reshape(coeff.Write(), size, nq);
+   MFEM_FORALL(i, size*nq, C(i%size, i/size) = V[i%size];);
+}
+
 void PWMatrixCoefficient::InitMap(const Array<int> & attr,
                                   const Array<MatrixCoefficient*> & coefs)
 {
@@ -669,6 +981,47 @@ void MatrixFunctionCoefficient::EvalSymmetric(Vector &K,
    }
 }
 
+void SymmetricMatrixCoefficient::ProjectSymmetric(QuadratureSpace &qs,
+                                                  Vector &coeff)
+{
+   Mesh *mesh = qs.GetMesh();
+   const int n = height, symm_size = (n*(n+1))/2;
+   coeff.SetSize(symm_size*qs.GetSize());
+   double *C = coeff.HostWrite();
+   DenseSymmetricMatrix K(n);
+   for (int e = 0, offset = 0; e < mesh->GetNE(); e++)
+   {
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      const IntegrationRule &ir = qs.GetElementIntRule(e);
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         Eval(K, T, ip);
+         for (int i = 0; i < n; i++)
+         {
+            for (int j = i; j < n; j++) { C[offset++] = K(i,j); }
+         }
+      }
+   }
+}
+
+void SymmetricMatrixConstantCoefficient::ProjectSymmetric(QuadratureSpace &qs,
+                                                          Vector &coeff)
+{
+   const int n = height, symm_size = (n*(n+1))/2, nq = qs.GetSize();
+   Vector vals(symm_size);
+   for (int i = 0, k = 0; i < n; i++)
+   {
+      for (int j = i; j < n; j++, k++) { vals(k) = mat(i,j); }
+   }
+   coeff.SetSize(symm_size*nq);
+   coeff.UseDevice(true);
+   const auto V = vals.Read();
+   auto C = Reshape(coeff.Write(), symm_size, nq);
+   MFEM_FORALL(i, symm_size*nq, C(i%symm_size, i/symm_size) = V[i%symm_size];);
+}
+
 void SymmetricMatrixCoefficient::Eval(DenseMatrix &K, ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
@@ -1468,4 +1821,15 @@ double QuadratureFunctionCoefficient::Eval(ElementTransformation &T,
    return temp[0];
 }
 
+void QuadratureFunctionCoefficient::Project(QuadratureSpace &qs, Vector &coeff)
+{
+   MFEM_VERIFY(QuadF.Size() == qs.GetSize(),
+               "Incompatible QuadratureFunction dimension \n");
+   MFEM_VERIFY(qs.GetNE() == 0 || &qs.GetElementIntRule(0) ==
+               &QuadF.GetSpace()->GetElementIntRule(0),
+               "IntegrationRule used within the QuadratureSpace and in"
+               " QuadratureFunction appear to be different");
+   coeff = QuadF;
+}
+
 }
@@ -23,6 +23,7 @@ namespace mfem
 {
 
 class Mesh;
+class QuadratureSpace;
 
 #ifdef MFEM_USE_MPI
 class ParMesh;
@@ -70,6 +71,14 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient at all quadrature points of @a qs, e.g.
+       during the setup of partially assembled integrators. */
+   /** On return, @a coeff has size qs.GetSize() and contains the values
+       ordered by element and then by quadrature point. The default
+       implementation calls Eval() at every point; derived classes override it
+       with batched (and device) evaluations. */
+   virtual void Project(QuadratureSpace &qs, Vector &coeff);
+
    virtual ~Coefficient() { }
 };
 
@@ -87,6 +96,9 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return (constant); }
+
+   /// Set all entries of @a coeff to the constant value.
+   virtual void Project(QuadratureSpace &qs, Vector &coeff);
 };
 
 /** @brief A piecewise constant coefficient with the constants keyed
@@ -123,6 +135,9 @@ public:
    /// Evaluate the coefficient.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /// Evaluate the coefficient using a lookup of the element attributes.
+   virtual void Project(QuadratureSpace &qs, Vector &coeff);
 };
 
 /** @brief A piecewise coefficient with the pieces keyed off the element
@@ -247,6 +262,17 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Evaluate the function at the physical coordinates of the
+       quadrature points, interpolated from the mesh nodes into a temporary
+       vector. Meshes without nodes use the Eval() loop of the base class. */
+   virtual void Project(QuadratureSpace &qs, Vector &coeff);
+
+   /** @brief Evaluate the function at the points with the physical
+       coordinates @a x, given in blocks of @a nq points as (nq,sdim,nblocks),
+       i.e. in the QVectorLayout::byNODES layout. */
+   /** On return, @a values contains the (nq,nblocks) values. */
+   void EvalPoints(const Vector &x, int nq, int sdim, Vector &values);
 };
 
 class GridFunction;
@@ -271,9 +297,19 @@ public:
    /// Get the internal GridFunction
    const GridFunction * GetGridFunction() const { return GridF; }
 
+   /// Get the component of the GridFunction, starting from 1.
+   int GetComponent() const { return Component; }
+
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Evaluate the GridFunction at all quadrature points with the
+       QuadratureInterpolator of its space. */
+   /** Falls back to Coefficient::Project() if the GridFunction is defined on a
+       different mesh or its space is not supported by the
+       QuadratureInterpolator. */
+   virtual void Project(QuadratureSpace &qs, Vector &coeff);
 };
 
 
@@ -471,6 +507,13 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   /** @brief Evaluate the vector coefficient at all quadrature points of
+       @a qs, e.g. during the setup of partially assembled integrators. */
+   /** On return, @a coeff has size GetVDim()*qs.GetSize() and contains the
+       vectors ordered by component, then by quadrature point and then by
+       element. The default implementation calls Eval() at every point. */
+   virtual void Project(QuadratureSpace &qs, Vector &coeff);
+
    virtual ~VectorCoefficient() { }
 };
 
@@ -490,6 +533,9 @@ public:
    virtual void Eval(Vector &V, ElementTransformation &T,
                      const IntegrationPoint &ip) { V = vec; }
 
+   /// Fill @a coeff with the constant vector on the device.
+   virtual void Project(QuadratureSpace &qs, Vector &coeff);
+
    /// Return a reference to the constant vector in this class.
    const Vector& GetVec() { return vec; }
 };
@@ -611,6 +657,13 @@ public:
    virtual void Eval(Vector &V, ElementTransformation &T,
                      const IntegrationPoint &ip);
 
+   /** @brief Evaluate the function at the physical coordinates of the
+       quadrature points, interpolated from the mesh nodes, or from the
+       vertices if the mesh has no nodes. */
+   /** Falls back to VectorCoefficient::Project() if the function is scaled by
+       a Coefficient or the mesh has mixed element types. */
+   virtual void Project(QuadratureSpace &qs, Vector &coeff);
+
    virtual ~VectorFunctionCoefficient() { }
 };
 
@@ -688,6 +741,12 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   /** @brief Interpolate the grid function at all quadrature points of @a qs
+       with a QuadratureInterpolator. */
+   /** Falls back to VectorCoefficient::Project() if the GridFunction is
+       defined on a different mesh or is not a nodal vector H1/L2 function. */
+   virtual void Project(QuadratureSpace &qs, Vector &coeff);
+
    virtual ~VectorGridFunctionCoefficient() { }
 };
 
@@ -926,6 +985,15 @@ public:
                               const IntegrationPoint &ip)
    { mfem_error("MatrixCoefficient::EvalSymmetric"); }
 
+   /** @brief Evaluate the matrix coefficient at all quadrature points of
+       @a qs, e.g. during the setup of partially assembled integrators. */
+   /** On return, @a coeff has size GetHeight()*GetWidth()*qs.GetSize(). The
+       matrices are stored by quadrature point and then by element, each one
+       in column-major order, or in row-major order if @a transpose is true.
+       The default implementation calls Eval() at every point. */
+   virtual void Project(QuadratureSpace &qs, Vector &coeff,
+                        bool transpose = false);
+
    virtual ~MatrixCoefficient() { }
 };
 
@@ -943,6 +1011,9 @@ public:
    /// Evaluate the matrix coefficient at @a ip.
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationPoint &ip) { M = mat; }
+   /// Fill @a coeff with the constant matrix on the device.
+   virtual void Project(QuadratureSpace &qs, Vector &coeff,
+                        bool transpose = false);
 };
 
 
@@ -1280,6 +1351,14 @@ public:
    virtual void Eval(DenseMatrix &K, ElementTransformation &T,
                      const IntegrationPoint &ip);
 
+   /** @brief Evaluate the upper triangular entries of the matrix coefficient
+       at all quadrature points of @a qs. */
+   /** On return, @a coeff has size s*qs.GetSize() with s = n*(n+1)/2 and
+       n = GetSize(). The entries M(i,j), j >= i, of every quadrature point
+       are stored row by row. The default implementation calls Eval() at every
+       point. */
+   virtual void ProjectSymmetric(QuadratureSpace &qs, Vector &coeff);
+
    virtual ~SymmetricMatrixCoefficient() { }
 };
 
@@ -1299,6 +1378,8 @@ public:
    /// Evaluate the matrix coefficient at @a ip.
    virtual void Eval(DenseSymmetricMatrix &M, ElementTransformation &T,
                      const IntegrationPoint &ip) { M = mat; }
+   /// Fill @a coeff with the constant matrix on the device.
+   virtual void ProjectSymmetric(QuadratureSpace &qs, Vector &coeff);
 };
 
 
@@ -2094,6 +2175,10 @@ public:
 
    virtual double Eval(ElementTransformation &T, const IntegrationPoint &ip);
 
+   /** @brief Copy the QuadratureFunction values; @a qs must use the same
+       integration rules as the QuadratureFunction. */
+   virtual void Project(QuadratureSpace &qs, Vector &coeff);
+
    virtual ~QuadratureFunctionCoefficient() { }
 };
 
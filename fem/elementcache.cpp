@@ -0,0 +1,302 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "elementcache.hpp"
+
+namespace mfem
+{
+
+const DenseMatrix &ElementAssemblyCache::Transformation::EvalJacobian()
+{
+   const double *J = cache ? cache->FindJacobian(ElementNo, IntPoint) : NULL;
+   if (J == NULL)
+   {
+      return IsoparametricTransformation::EvalJacobian();
+   }
+   const int sdim = GetPointMat().Height(), dim = GetFE()->GetDim();
+   dFdx.SetSize(sdim, dim);
+   for (int k = 0; k < sdim*dim; k++) { dFdx.GetData()[k] = J[k]; }
+   EvalState |= JACOBIAN_MASK;
+   return dFdx;
+}
+
+ElementAssemblyCache::ElementAssemblyCache(const FiniteElementSpace &fes_)
+   : fes(fes_), sequence(-1), nodes_sequence(-1), has_doftrans(false)
+{
+   Build();
+}
+
+ElementAssemblyCache::~ElementAssemblyCache()
+{
+   for (int k = 0; k < rule_tables.Size(); k++) { delete rule_tables[k]; }
+}
+
+bool ElementAssemblyCache::IsUpToDate() const
+{
+   return sequence == fes.GetSequence() &&
+          nodes_sequence == fes.GetMesh()->GetNodesSequence();
+}
+
+void ElementAssemblyCache::Build()
+{
+   Mesh *mesh = fes.GetMesh();
+   const int NE = fes.GetNE();
+
+   // element vdofs
+   Array<Array<int>*> vdofs(NE);
+   has_doftrans = false;
+   elem_vdofs.MakeI(NE);
+   for (int i = 0; i < NE; i++)
+   {
+      vdofs[i] = new Array<int>;
+      has_doftrans |= (fes.GetElementVDofs(i, *vdofs[i]) != NULL);
+      elem_vdofs.AddColumnsInRow(i, vdofs[i]->Size());
+   }
+   elem_vdofs.MakeJ();
+   for (int i = 0; i < NE; i++)
+   {
+      elem_vdofs.AddConnections(i, vdofs[i]->GetData(), vdofs[i]->Size());
+      delete vdofs[i];
+   }
+   elem_vdofs.ShiftUpI();
+
+   // finite elements and point matrices of the transformations
+   elems.SetSize(NE);
+   tr_elems.SetSize(NE);
+   geom_index.SetSize(NE);
+   pm_offsets.SetSize(NE + 1);
+   pm_offsets[0] = 0;
+   int geom_count[Geometry::NumGeom] = { 0 };
+   IsoparametricTransformation tr;
+   for (int i = 0; i < NE; i++)
+   {
+      elems[i] = fes.GetFE(i);
+      mesh->GetElementTransformation(i, &tr);
+      tr_elems[i] = tr.GetFE();
+      geom_index[i] = geom_count[tr_elems[i]->GetGeomType()]++;
+      pm_offsets[i+1] = pm_offsets[i] + tr.GetPointMat().Height()*
+                        tr.GetPointMat().Width();
+   }
+   point_mats.SetSize(pm_offsets[NE]);
+   for (int i = 0; i < NE; i++)
+   {
+      mesh->GetElementTransformation(i, &tr);
+      const DenseMatrix &pm = tr.GetPointMat();
+      const int size = pm.Height()*pm.Width();
+      for (int k = 0; k < size; k++)
+      {
+         point_mats(pm_offsets[i] + k) = pm.GetData()[k];
+      }
+   }
+
+   sequence = fes.GetSequence();
+   nodes_sequence = mesh->GetNodesSequence();
+
+   for (int k = 0; k < rule_tables.Size(); k++)
+   {
+      BuildTables(*rule_tables[k]);
+   }
+}
+
+void ElementAssemblyCache::BuildTables(RuleTables &tables) const
+{
+   const Mesh *mesh = fes.GetMesh();
+   const int NE = fes.GetNE();
+   const int sdim = mesh->SpaceDimension();
+   const IntegrationRule &ir = *tables.ir;
+   const int nq = ir.GetNPoints();
+
+   // shape functions of the space, if its element is scalar and unique for
+   // the geometry
+   int ne_geom = 0;
+   tables.fe = NULL;
+   for (int i = 0; i < NE; i++)
+   {
+      if (tr_elems[i]->GetGeomType() != tables.geom) { continue; }
+      tables.fe = (ne_geom == 0 || tables.fe == elems[i]) ? elems[i] : NULL;
+      if (ne_geom > 0 && tables.fe == NULL) { break; }
+      ne_geom++;
+   }
+   if (fes.GetNURBSext() ||
+       (tables.fe && tables.fe->GetRangeType() != FiniteElement::SCALAR))
+   {
+      tables.fe = NULL;
+   }
+   if (tables.fe)
+   {
+      const int dof = tables.fe->GetDof(), dim = tables.fe->GetDim();
+      tables.shape.SetSize(dof, nq);
+      tables.dshape.SetSize(dof, dim, nq);
+      Vector shape_q;
+      for (int q = 0; q < nq; q++)
+      {
+         tables.shape.GetColumnReference(q, shape_q);
+         tables.fe->CalcShape(ir.IntPoint(q), shape_q);
+         tables.fe->CalcDShape(ir.IntPoint(q), tables.dshape(q));
+      }
+   }
+   else
+   {
+      tables.shape.Clear();
+      tables.dshape.SetSize(0, 0, 0);
+   }
+
+   // Jacobians, J = PointMat * dshape of the transformation element
+   const int dim = Geometry::Dimension[tables.geom];
+   ne_geom = 0;
+   for (int i = 0; i < NE; i++)
+   {
+      if (tr_elems[i]->GetGeomType() == tables.geom) { ne_geom++; }
+   }
+   tables.jacobians.SetSize(ne_geom*nq*sdim*dim);
+   const FiniteElement *tr_fe = NULL;
+   DenseTensor tr_dshape;
+   for (int i = 0; i < NE; i++)
+   {
+      if (tr_elems[i]->GetGeomType() != tables.geom) { continue; }
+      if (tr_elems[i] != tr_fe)
+      {
+         tr_fe = tr_elems[i];
+         tr_dshape.SetSize(tr_fe->GetDof(), dim, nq);
+         for (int q = 0; q < nq; q++)
+         {
+            tr_fe->CalcDShape(ir.IntPoint(q), tr_dshape(q));
+         }
+      }
+      const int nd = tr_fe->GetDof();
+      DenseMatrix pm(point_mats.GetData() + pm_offsets[i], sdim, nd);
+      for (int q = 0; q < nq; q++)
+      {
+         DenseMatrix J(tables.jacobians.GetData() +
+                       (geom_index[i]*nq + q)*sdim*dim, sdim, dim);
+         Mult(pm, tr_dshape(q), J);
+      }
+   }
+}
+
+void ElementAssemblyCache::AddIntegrationRule(Geometry::Type geom,
+                                              const IntegrationRule &ir)
+{
+   if (FindTables(geom, ir)) { return; }
+   Update();
+   RuleTables *tables = new RuleTables;
+   tables->geom = geom;
+   tables->ir = &ir;
+   rule_tables.Append(tables);
+   BuildTables(*tables);
+}
+
+const ElementAssemblyCache::RuleTables *ElementAssemblyCache::FindTables(
+   Geometry::Type geom, const IntegrationRule &ir) const
+{
+   for (int k = 0; k < rule_tables.Size(); k++)
+   {
+      if (rule_tables[k]->geom == geom && rule_tables[k]->ir == &ir)
+      {
+         return rule_tables[k];
+      }
+   }
+   return NULL;
+}
+
+const double *ElementAssemblyCache::FindJacobian(
+   int i, const IntegrationPoint *ip) const
+{
+   const Geometry::Type geom = tr_elems[i]->GetGeomType();
+   for (int k = 0; k < rule_tables.Size(); k++)
+   {
+      const RuleTables &tables = *rule_tables[k];
+      const int nq = tables.ir->GetNPoints();
+      if (tables.geom != geom || nq == 0) { continue; }
+      const IntegrationPoint *ip0 = &tables.ir->IntPoint(0);
+      if (ip >= ip0 && ip < ip0 + nq)
+      {
+         const int size = fes.GetMesh()->SpaceDimension()*
+                          Geometry::Dimension[geom];
+         return tables.jacobians.GetData() +
+                (geom_index[i]*nq + (ip - ip0))*size;
+      }
+   }
+   return NULL;
+}
+
+DofTransformation *ElementAssemblyCache::GetElementVDofs(
+   int i, Array<int> &vdofs) const
+{
+   MFEM_ASSERT(IsUpToDate(), "the cache is out of date, call Update()");
+   if (has_doftrans) { return fes.GetElementVDofs(i, vdofs); }
+   vdofs.MakeRef(const_cast<int*>(elem_vdofs.GetRow(i)),
+                 elem_vdofs.RowSize(i));
+   return NULL;
+}
+
+ElementTransformation *ElementAssemblyCache::GetElementTransformation(
+   int i) const
+{
+   MFEM_ASSERT(IsUpToDate(), "the cache is out of date, call Update()");
+   Mesh *mesh = fes.GetMesh();
+   const int sdim = mesh->SpaceDimension();
+   T.Attribute = mesh->GetAttribute(i);
+   T.ElementNo = i;
+   T.ElementType = ElementTransformation::ELEMENT;
+   T.mesh = mesh;
+   T.cache = this;
+   T.Reset();
+   DenseMatrix &pm = T.GetPointMat();
+   const int n = (pm_offsets[i+1] - pm_offsets[i]) / sdim;
+   pm.SetSize(sdim, n);
+   for (int k = 0; k < sdim*n; k++)
+   {
+      pm.GetData()[k] = point_mats(pm_offsets[i] + k);
+   }
+   T.SetFE(tr_elems[i]);
+   return &T;
+}
+
+const DenseMatrix *ElementAssemblyCache::GetShape(
+   Geometry::Type geom, const IntegrationRule &ir) const
+{
+   const RuleTables *tables = FindTables(geom, ir);
+   return (tables && tables->fe) ? &tables->shape : NULL;
+}
+
+const DenseTensor *ElementAssemblyCache::GetDShape(
+   Geometry::Type geom, const IntegrationRule &ir) const
+{
+   const RuleTables *tables = FindTables(geom, ir);
+   return (tables && tables->fe) ? &tables->dshape : NULL;
+}
+
+const double *ElementAssemblyCache::GetJacobians(
+   int i, const IntegrationRule &ir) const
+{
+   MFEM_ASSERT(IsUpToDate(), "the cache is out of date, call Update()");
+   if (ir.GetNPoints() == 0) { return NULL; }
+   const RuleTables *tables = FindTables(tr_elems[i]->GetGeomType(), ir);
+   return tables ? FindJacobian(i, &ir.IntPoint(0)) : NULL;
+}
+
+long ElementAssemblyCache::MemoryUsage() const
+{
+   long size = elem_vdofs.MemoryUsage() + elems.MemoryUsage() +
+               tr_elems.MemoryUsage() + pm_offsets.MemoryUsage() +
+               point_mats.Size()*sizeof(double) + geom_index.MemoryUsage();
+   for (int k = 0; k < rule_tables.Size(); k++)
+   {
+      const RuleTables &tables = *rule_tables[k];
+      size += (tables.shape.Height()*tables.shape.Width() +
+               tables.dshape.TotalSize() + tables.jacobians.Size())*
+              sizeof(double);
+   }
+   return size;
+}
+
+}
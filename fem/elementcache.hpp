@@ -0,0 +1,171 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_ELEMENTCACHE
+#define MFEM_ELEMENTCACHE
+
+#include "../config/config.hpp"
+#include "fespace.hpp"
+
+namespace mfem
+{
+
+/** @brief Cached element data of a FiniteElementSpace, used by the element
+    loops of the legacy assembly, see e.g.
+    BilinearForm::UseElementAssemblyCache().
+
+    For all elements of the space, the cache stores:
+    - the element vdofs in flattened CSR format, which are returned as
+      references, without copies, when the space has no DofTransformation%s;
+    - the finite elements, and the point matrices and finite elements of the
+      element transformations, so that the transformations are set up without
+      gathering the mesh nodes.
+
+    For each integration rule added with AddIntegrationRule(), the cache also
+    stores, per element geometry:
+    - the shape functions and their reference derivatives of the scalar
+      finite element of the space at the points of the rule;
+    - the Jacobians of the transformations of all elements of the geometry at
+      the points of the rule. The transformations returned by
+      GetElementTransformation() use them when they are evaluated at a point
+      of the rule, so they are passed to the AssembleElementMatrix() methods
+      of the integrators instead of being evaluated by each integrator.
+
+    The cache is rebuilt when the space or the mesh nodes change, see
+    FiniteElementSpace::GetSequence() and Mesh::GetNodesSequence(). */
+class ElementAssemblyCache
+{
+public:
+   /// Element transformation using the cached Jacobians.
+   class Transformation : public IsoparametricTransformation
+   {
+   protected:
+      const ElementAssemblyCache *cache;
+
+      virtual const DenseMatrix &EvalJacobian();
+
+      friend class ElementAssemblyCache;
+
+   public:
+      Transformation() : cache(NULL) { }
+   };
+
+protected:
+   /// Tables of one integration rule for the elements of one geometry.
+   struct RuleTables
+   {
+      Geometry::Type geom;
+      const IntegrationRule *ir;
+      /// Scalar finite element of the space for the geometry, or NULL.
+      const FiniteElement *fe;
+      /// Shape functions (dof x point) and derivatives (dof x dim x point).
+      DenseMatrix shape;
+      DenseTensor dshape;
+      /// Jacobians (space dim x dim x point) of the elements of the geometry.
+      Vector jacobians;
+   };
+
+   const FiniteElementSpace &fes;
+   long sequence, nodes_sequence;
+
+   /// Element vdofs in CSR format, signed as in the space.
+   Table elem_vdofs;
+   bool has_doftrans;
+
+   /// Finite elements of the elements and of their transformations.
+   Array<const FiniteElement*> elems, tr_elems;
+
+   /// Point matrices of the transformations, space dim x nodes of each element.
+   Array<int> pm_offsets;
+   Vector point_mats;
+
+   /// Index of each element among the elements with the same geometry.
+   Array<int> geom_index;
+
+   Array<RuleTables*> rule_tables; ///< Owned.
+
+   mutable Transformation T;
+
+   void Build();
+
+   /// Tabulate the shape functions and the Jacobians of @a tables.
+   void BuildTables(RuleTables &tables) const;
+
+   /** Return the cached Jacobian of element @a i at the point @a ip, or NULL
+       if @a ip is not a point of a cached rule. */
+   const double *FindJacobian(int i, const IntegrationPoint *ip) const;
+
+   const RuleTables *FindTables(Geometry::Type geom,
+                                const IntegrationRule &ir) const;
+
+public:
+   /// Build the cache for the elements of @a fes_.
+   ElementAssemblyCache(const FiniteElementSpace &fes_);
+
+   /// Rebuild the cache if the space or the mesh nodes changed.
+   void Update() { if (!IsUpToDate()) { Build(); } }
+
+   /// Check if the cache corresponds to the current space and mesh nodes.
+   bool IsUpToDate() const;
+
+   const FiniteElementSpace &GetFESpace() const { return fes; }
+
+   /** @brief Tabulate the shape functions and the element Jacobians at the
+       points of @a ir for the elements with geometry @a geom.
+
+       Nothing is done if the rule was already added. The rule is not copied
+       and must outlive the cache. The Jacobians use space dim x dim x
+       ir.GetNPoints() doubles per element. */
+   void AddIntegrationRule(Geometry::Type geom, const IntegrationRule &ir);
+
+   /** @brief Return the vdofs of element @a i in @a vdofs, like
+       FiniteElementSpace::GetElementVDofs().
+
+       When the space has no DofTransformation%s, @a vdofs is set to reference
+       the cached data and must not be modified. */
+   DofTransformation *GetElementVDofs(int i, Array<int> &vdofs) const;
+
+   /// Return the finite element of element @a i.
+   const FiniteElement *GetFE(int i) const { return elems[i]; }
+
+   /** @brief Return the transformation of element @a i, like
+       FiniteElementSpace::GetElementTransformation().
+
+       The returned object is owned by the cache, and is reused by the next
+       call. Its Jacobian is taken from the cache at the points of the rules
+       added with AddIntegrationRule(). */
+   ElementTransformation *GetElementTransformation(int i) const;
+
+   /** @brief Return the shape functions (dof x point) of the finite element
+       of the space at the points of @a ir, or NULL if the rule was not added
+       for @a geom, or if the element of the space for @a geom is not unique
+       or not scalar. */
+   const DenseMatrix *GetShape(Geometry::Type geom,
+                               const IntegrationRule &ir) const;
+
+   /** @brief Return the reference derivatives (dof x dim x point) of the
+       shape functions, see GetShape(). */
+   const DenseTensor *GetDShape(Geometry::Type geom,
+                                const IntegrationRule &ir) const;
+
+   /** @brief Return the Jacobians (space dim x dim x point) of element @a i
+       at the points of @a ir, or NULL if the rule was not added. */
+   const double *GetJacobians(int i, const IntegrationRule &ir) const;
+
+   /// Return the memory used by the cache, in bytes.
+   long MemoryUsage() const;
+
+   ~ElementAssemblyCache();
+};
+
+}
+
+#endif
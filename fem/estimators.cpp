@@ -10,6 +10,12 @@
 // CONTRIBUTING.md for details.
 
 #include "estimators.hpp"
+#include "quadinterpolator.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/dtensor.hpp"
+#include "../linalg/kernels.hpp"
+
+#include <map>
 
 namespace mfem
 {
@@ -192,9 +198,20 @@ void KellyErrorEstimator::ComputeEstimates()
       attributes.Sort();
    }
 
+   // Compute the fluxes of all elements as one batch, if supported
+   Vector flux_e;
+   const bool batched_flux = (attributes.Size() == 0) &&
+                             flux_integrator->ComputeElementFluxes(
+                                *xfes, *solution, *flux_space, flux_e, true);
+   if (batched_flux)
+   {
+      flux_space->GetElementRestriction(ElementDofOrdering::NATIVE)->
+      MultTranspose(flux_e, *flux);
+   }
+
    Array<int> xdofs, fdofs;
    Vector el_x, el_f;
-   for (int e = 0; e < xfes->GetNE(); e++)
+   for (int e = 0; !batched_flux && e < xfes->GetNE(); e++)
    {
       auto attr = xfes->GetAttribute(e);
       if (attributes.Size() && attributes.FindSorted(attr) == -1)
@@ -214,7 +231,8 @@ void KellyErrorEstimator::ComputeEstimates()
    }
 
    // 2. Add error contribution from local interior faces
-   for (int f = 0; f < mesh->GetNumFaces(); f++)
+   const bool batched_faces = AddLocalFaceJumps(*flux);
+   for (int f = 0; !batched_faces && f < mesh->GetNumFaces(); f++)
    {
       auto FT = mesh->GetFaceElementTransformations(f);
 
@@ -470,6 +488,194 @@ void KellyErrorEstimator::ComputeEstimates()
 #endif // MFEM_USE_MPI
 }
 
+const IntegrationRule &KellyErrorEstimator::GetElementFacePoints(Mesh &mesh,
+                                                                 int order)
+{
+   const Geometry::Type geom = mesh.GetElementBaseGeometry(0);
+   if (geom == face_points_geom && order == face_points_order)
+   {
+      return elem_face_points;
+   }
+
+   const Geometry::Type face_geom = mesh.GetFaceGeometry(0);
+   const int face_type = mesh.GetFaceElementType(0);
+   const int elem_type = mesh.GetElementType(0);
+   const IntegrationRule &fir = IntRules.Get(face_geom, order);
+   const int nf = Geometries.NumBdr(geom);
+   const int nq = fir.GetNPoints();
+
+   elem_face_points.SetSize(nf*nq);
+   IntegrationPointTransformation Loc;
+   for (int lf = 0; lf < nf; lf++)
+   {
+      mesh.GetLocalFaceTransformation(face_type, elem_type, Loc.Transf,
+                                      64*lf);
+      for (int q = 0; q < nq; q++)
+      {
+         Loc.Transform(fir.IntPoint(q), elem_face_points.IntPoint(lf*nq + q));
+      }
+   }
+   face_points_geom = geom;
+   face_points_order = order;
+   return elem_face_points;
+}
+
+bool KellyErrorEstimator::AddLocalFaceJumps(const GridFunction &flux)
+{
+   FiniteElementSpace *xfes = solution->FESpace();
+   Mesh *mesh = xfes->GetMesh();
+   const int dim = mesh->Dimension();
+   const int NE = mesh->GetNE();
+   if (NE == 0 || mesh->Nonconforming() || mesh->SpaceDimension() != dim ||
+       dim < 2 || mesh->GetNumGeometries(dim) != 1 ||
+       xfes->IsVariableOrder() || flux_space->IsVariableOrder() ||
+       flux_space->GetNURBSext() || flux_space->GetVDim() != dim)
+   {
+      return false;
+   }
+   const Geometry::Type geom = mesh->GetElementBaseGeometry(0);
+   const FiniteElement *flux_fe = flux_space->GetFE(0);
+   if ((geom != Geometry::TRIANGLE && geom != Geometry::SQUARE &&
+        geom != Geometry::TETRAHEDRON && geom != Geometry::CUBE) ||
+       flux_fe->GetRangeType() != FiniteElement::SCALAR ||
+       flux_fe->GetMapType() != FiniteElement::VALUE)
+   {
+      return false;
+   }
+
+   // The face rule is the same as in the face loop of ComputeEstimates()
+   const int order = 2 * xfes->GetFE(0)->GetOrder();
+   const IntegrationRule &ir = GetElementFacePoints(*mesh, order);
+   const IntegrationRule &fir = IntRules.Get(mesh->GetFaceGeometry(0), order);
+   const int NQ = fir.GetNPoints();
+   const int NP = ir.GetNPoints();
+   const int face_type = mesh->GetFaceElementType(0);
+   const int elem_type = mesh->GetElementType(0);
+
+   // For a face with the local index and orientation given by 'info', find
+   // the indices in 'ir' of the face points, and the reference normal.
+   std::map<int, std::pair<Array<int>, Vector>> info_data;
+   IntegrationPointTransformation Loc;
+   auto get_info_data = [&](int info) -> const std::pair<Array<int>, Vector>*
+   {
+      auto it = info_data.find(info);
+      if (it != info_data.end()) { return &it->second; }
+      auto &data = info_data[info];
+      data.first.SetSize(NQ);
+      data.second.SetSize(dim);
+      mesh->GetLocalFaceTransformation(face_type, elem_type, Loc.Transf,
+                                       info);
+      const int offset = (info / 64) * NQ;
+      IntegrationPoint ip;
+      for (int q = 0; q < NQ; q++)
+      {
+         Loc.Transform(fir.IntPoint(q), ip);
+         data.first[q] = -1;
+         for (int j = offset; j < offset + NQ; j++)
+         {
+            const IntegrationPoint &jp = ir.IntPoint(j);
+            // only the first dim coordinates are set by the transformation
+            if (std::abs(ip.x - jp.x) + std::abs(ip.y - jp.y) +
+                (dim == 3 ? std::abs(ip.z - jp.z) : 0.0) < 1e-12)
+            {
+               data.first[q] = j;
+               break;
+            }
+         }
+         if (data.first[q] < 0) { return NULL; }
+      }
+      Loc.Transf.SetIntPoint(&fir.IntPoint(0));
+      CalcOrtho(Loc.Transf.Jacobian(), data.second);
+      return &data;
+   };
+
+   // Collect the local interior faces
+   Array<int> face_elems, face_points;
+   Array<double> face_normals, face_coeffs;
+   for (int f = 0; f < mesh->GetNumFaces(); f++)
+   {
+      int e1, e2, inf1, inf2, ncface;
+      mesh->GetFaceElements(f, &e1, &e2);
+      mesh->GetFaceInfos(f, &inf1, &inf2, &ncface);
+      if (e2 < 0 || ncface != -1) { continue; }
+      if (attributes.Size() &&
+          (attributes.FindSorted(mesh->GetAttribute(e1)) == -1 ||
+           attributes.FindSorted(mesh->GetAttribute(e2)) == -1))
+      {
+         continue;
+      }
+      const auto *data1 = get_info_data(inf1);
+      const auto *data2 = get_info_data(inf2);
+      if (!data1 || !data2) { return false; }
+      face_elems.Append(e1);
+      face_elems.Append(e2);
+      face_points.Append(data1->first);
+      face_points.Append(data2->first);
+      for (int d = 0; d < dim; d++) { face_normals.Append(data1->second(d)); }
+      face_coeffs.Append(compute_face_coefficient(mesh, f, false));
+   }
+   const int NF = face_coeffs.Size();
+   if (NF == 0) { return true; }
+
+   // Flux values and element Jacobians at the face points of all elements
+   const Operator *R =
+      flux_space->GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector flux_e(R->Height());
+   R->Mult(flux, flux_e);
+   QuadratureInterpolator qi(*flux_space, ir);
+   qi.SetOutputLayout(QVectorLayout::byNODES);
+   qi.DisableTensorProducts();
+   Vector flux_q(NP*dim*NE), empty;
+   qi.Mult(flux_e, QuadratureInterpolator::VALUES, flux_q, empty, empty);
+   // The rule is owned by the estimator, so the Jacobians are not cached in
+   // the mesh, which identifies the rules by their address.
+   mesh->EnsureNodes();
+   GeometricFactors geom_factors(mesh, ir, GeometricFactors::JACOBIANS);
+
+   const int D = dim;
+   auto W = fir.GetWeights().Read();
+   auto F = Reshape(flux_q.Read(), NP, D, NE);
+   auto Jac = Reshape(geom_factors.J.Read(), NP, D, D, NE);
+   auto E = Reshape(face_elems.Read(), 2, NF);
+   auto P = Reshape(face_points.Read(), NQ, 2, NF);
+   auto N = Reshape(face_normals.Read(), D, NF);
+   auto H = face_coeffs.Read();
+   auto err = error_estimates.ReadWrite();
+   MFEM_FORALL(f, NF,
+   {
+      const int e1 = E(0,f), e2 = E(1,f);
+      double face_err = 0.0;
+      for (int q = 0; q < NQ; q++)
+      {
+         const int p1 = P(q,0,f), p2 = P(q,1,f);
+         // The physical normal, scaled by the face weight, is adj(J)^T n_ref
+         // with the Jacobian J of e1.
+         double J1[9], A[9];
+         for (int c = 0; c < D; c++)
+         {
+            for (int r = 0; r < D; r++) { J1[r + D*c] = Jac(p1,r,c,e1); }
+         }
+         if (D == 2) { kernels::CalcAdjugate<2>(J1, A); }
+         else { kernels::CalcAdjugate<3>(J1, A); }
+         double nrm2 = 0.0, jump = 0.0;
+         for (int d = 0; d < D; d++)
+         {
+            double n = 0.0;
+            for (int k = 0; k < D; k++) { n += A[k + D*d] * N(k,f); }
+            nrm2 += n*n;
+            jump += (F(p1,d,e1) - F(p2,d,e2)) * n;
+         }
+         jump *= W[q] * sqrt(nrm2);
+         face_err += jump*jump;
+      }
+      face_err *= H[f];
+      AtomicAdd(err[e1], face_err);
+      AtomicAdd(err[e2], face_err);
+   });
+   error_estimates.HostReadWrite();
+   return true;
+}
+
 void LpErrorEstimator::ComputeEstimates()
 {
    MFEM_VERIFY(coef != NULL || vcoef != NULL,
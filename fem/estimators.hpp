@@ -621,6 +621,24 @@ private:
    */
    void ComputeEstimates();
 
+   /** @brief The points of a face quadrature rule, mapped to all faces of
+       the reference element, face by face, with the local face orientation
+       0, see GetElementFacePoints(). */
+   IntegrationRule elem_face_points;
+   int face_points_geom = -1, face_points_order = -1;
+
+   /** @brief Return the points of the face quadrature rule of the given
+       @a order on all faces of the reference element of @a mesh, which must
+       have a single element and face geometry. The rule is rebuilt when the
+       geometry or the order change. */
+   const IntegrationRule &GetElementFacePoints(Mesh &mesh, int order);
+
+   /** @brief Add the error contribution from the local interior faces, with
+       all faces processed as one batch. Returns false if the mesh or the
+       spaces are not supported, e.g. for nonconforming meshes, in which case
+       the faces are processed one by one. */
+   bool AddLocalFaceJumps(const GridFunction &flux);
+
 public:
    /** @brief Construct a new KellyErrorEstimator object for a scalar field.
        @param di_         The bilinearform to compute the interface flux.
@@ -1268,6 +1268,12 @@ public:
                                        DofToQuad::Mode mode,
                                        const bool closed) const;
 
+   /// Return the 1D closed basis, of order equal to the element order.
+   const Poly_1D::Basis &GetClosedBasis1D() const { return cbasis1d; }
+
+   /// Return the 1D open basis, of order one less than the element order.
+   const Poly_1D::Basis &GetOpenBasis1D() const { return obasis1d; }
+
    ~VectorTensorFiniteElement();
 };
 
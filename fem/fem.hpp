@@ -25,6 +25,7 @@
 #include "nonlininteg.hpp"
 #include "bilininteg.hpp"
 #include "fespace.hpp"
+#include "elementcache.hpp"
 #include "gridfunc.hpp"
 #include "linearform.hpp"
 #include "nonlinearform.hpp"
@@ -37,6 +38,7 @@
 #include "tmop_tools.hpp"
 #include "tmop_amr.hpp"
 #include "gslib.hpp"
+#include "particles.hpp"
 #include "restriction.hpp"
 #include "quadinterpolator.hpp"
 #include "quadinterpolator_face.hpp"
@@ -2142,6 +2142,7 @@ void FiniteElementSpace::Constructor(Mesh *mesh_, NURBSExtension *NURBSext_,
                                      const FiniteElementCollection *fec_,
                                      int vdim_, int ordering_)
 {
+   MemoryUsageTag mem_tag("FiniteElementSpace");
    mesh = mesh_;
    fec = fec_;
    vdim = vdim_;
@@ -3199,6 +3200,7 @@ void FiniteElementSpace::Destroy()
    {
       delete x.second;
    }
+   L2F.clear();
    for (int i = 0; i < E2IFQ_array.Size(); i++)
    {
       delete E2IFQ_array[i];
@@ -3335,6 +3337,8 @@ void FiniteElementSpace::UpdateElementOrders()
 
 void FiniteElementSpace::Update(bool want_transform)
 {
+   MFEM_PERF_FUNCTION;
+   MemoryUsageTag mem_tag("FiniteElementSpace");
    if (!orders_changed)
    {
       if (mesh->GetSequence() == mesh_sequence)
@@ -3637,6 +3641,26 @@ void QuadratureSpace::Construct()
    element_offsets[num_elem] = size = offset;
 }
 
+QuadratureSpace::QuadratureSpace(Mesh *mesh_, const IntegrationRule &ir)
+   : mesh(mesh_), order(ir.GetOrder())
+{
+   MFEM_VERIFY(mesh->GetNumGeometries(mesh->Dimension()) <= 1,
+               "mixed meshes are not supported!");
+   const int num_elem = mesh->GetNE();
+   const int nq = ir.GetNPoints();
+   element_offsets = new int[num_elem + 1];
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      int_rule[g] = NULL;
+   }
+   if (num_elem > 0) { int_rule[mesh->GetElementBaseGeometry(0)] = &ir; }
+   for (int i = 0; i <= num_elem; i++)
+   {
+      element_offsets[i] = i*nq;
+   }
+   size = num_elem*nq;
+}
+
 QuadratureSpace::QuadratureSpace(Mesh *mesh_, std::istream &in)
    : mesh(mesh_)
 {
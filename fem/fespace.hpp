@@ -972,6 +972,13 @@ public:
    QuadratureSpace(Mesh *mesh_, int order_)
       : mesh(mesh_), order(order_) { Construct(); }
 
+   /** @brief Create a QuadratureSpace using the IntegrationRule @a ir on all
+       elements of the mesh, e.g. the rule used by a partially assembled
+       integrator. */
+   /** All elements of @a mesh_ must have the same geometry. The rule @a ir is
+       not copied, so it must remain valid while the QuadratureSpace is used. */
+   QuadratureSpace(Mesh *mesh_, const IntegrationRule &ir);
+
    /// Read a QuadratureSpace from the stream @a in.
    QuadratureSpace(Mesh *mesh_, std::istream &in);
 
@@ -13,7 +13,9 @@
 
 #include "gridfunc.hpp"
 #include "../mesh/nurbs.hpp"
+#include "../mesh/point_locator.hpp"
 #include "../general/text.hpp"
+#include "../general/annotation.hpp"
 
 #ifdef MFEM_USE_MPI
 #include "pfespace.hpp"
@@ -163,6 +165,7 @@ void GridFunction::Destroy()
 
 void GridFunction::Update()
 {
+   MFEM_PERF_FUNCTION;
    if (fes->GetSequence() == fes_sequence)
    {
       return; // space and grid function are in sync, no-op
@@ -261,6 +264,25 @@ void GridFunction::SumFluxAndCount(BilinearFormIntegrator &blfi,
    FiniteElementSpace *ufes = u.FESpace();
    FiniteElementSpace *ffes = flux.FESpace();
 
+   // Compute the fluxes of all elements as one batch, if supported
+   Vector flux_e;
+   if (subdomain < 0 &&
+       blfi.ComputeElementFluxes(*ufes, u, *ffes, flux_e, wcoef))
+   {
+      const Operator *R =
+         ffes->GetElementRestriction(ElementDofOrdering::NATIVE);
+      R->MultTranspose(flux_e, flux);
+      Vector ones(R->Height()), mult(flux.Size());
+      ones = 1.0;
+      R->MultTranspose(ones, mult);
+      const double *h_mult = mult.HostRead();
+      for (int i = 0; i < count.Size(); i++)
+      {
+         count[i] = (int) std::round(h_mult[i]);
+      }
+      return;
+   }
+
    int nfe = ufes->GetNE();
    Array<int> udofs;
    Array<int> fdofs;
@@ -1190,6 +1212,105 @@ void GridFunction::GetValuesFrom(const GridFunction &orig_func)
    }
 }
 
+int GridFunction::GetValuesAtPoints(const DenseMatrix &point_mat,
+                                    DenseMatrix &vals,
+                                    double default_value) const
+{
+   Mesh *mesh = fes->GetMesh();
+   const int npts = point_mat.Width();
+   Array<int> elem_ids;
+   Array<IntegrationPoint> ips;
+   const int pts_found =
+      mesh->GetPointLocator().FindPoints(point_mat, elem_ids, ips);
+
+   const int vdim = VectorDim();
+   vals.SetSize(vdim, npts);
+   vals = default_value;
+
+   // Group the points found by element
+   const int ne = mesh->GetNE();
+   Array<int> offsets(ne + 1), order(pts_found);
+   offsets = 0;
+   for (int k = 0; k < npts; k++)
+   {
+      if (elem_ids[k] >= 0) { offsets[elem_ids[k] + 1]++; }
+   }
+   offsets.PartialSum();
+   for (int k = 0; k < npts; k++)
+   {
+      if (elem_ids[k] >= 0) { order[offsets[elem_ids[k]]++] = k; }
+   }
+   for (int e = ne; e > 0; e--) { offsets[e] = offsets[e-1]; }
+   offsets[0] = 0;
+
+   IntegrationRule ir;
+   DenseMatrix elem_vals;
+   for (int e = 0; e < ne; e++)
+   {
+      const int np = offsets[e+1] - offsets[e];
+      if (np == 0) { continue; }
+      ir.SetSize(np);
+      for (int j = 0; j < np; j++) { ir[j] = ips[order[offsets[e] + j]]; }
+      ElementTransformation *T = fes->GetElementTransformation(e);
+      GetVectorValues(*T, ir, elem_vals);
+      for (int j = 0; j < np; j++)
+      {
+         const int k = order[offsets[e] + j];
+         for (int c = 0; c < vdim; c++) { vals(c,k) = elem_vals(c,j); }
+      }
+   }
+   return pts_found;
+}
+
+void GridFunction::InterpolateFromMesh(const GridFunction &src,
+                                       double default_value)
+{
+   const int vdim = fes->GetVDim();
+   MFEM_VERIFY(src.VectorDim() == vdim, "incompatible vector dimensions");
+
+   Mesh *mesh = fes->GetMesh();
+   const int ne = fes->GetNE();
+   const int sdim = mesh->SpaceDimension();
+
+   // Physical coordinates of the nodes of all elements
+   int npts = 0;
+   for (int e = 0; e < ne; e++)
+   {
+      const FiniteElement *fe = fes->GetFE(e);
+      MFEM_VERIFY(dynamic_cast<const NodalFiniteElement*>(fe) &&
+                  fe->GetMapType() == FiniteElement::VALUE,
+                  "only nodal scalar finite elements are supported");
+      npts += fe->GetDof();
+   }
+   DenseMatrix point_mat(sdim, npts), elem_pts;
+   for (int e = 0, k = 0; e < ne; e++)
+   {
+      const FiniteElement *fe = fes->GetFE(e);
+      fes->GetElementTransformation(e)->Transform(fe->GetNodes(), elem_pts);
+      for (int j = 0; j < elem_pts.Width(); j++, k++)
+      {
+         for (int d = 0; d < sdim; d++) { point_mat(d,k) = elem_pts(d,j); }
+      }
+   }
+
+   DenseMatrix vals;
+   src.GetValuesAtPoints(point_mat, vals, default_value);
+
+   Array<int> vdofs;
+   Vector loc_values;
+   for (int e = 0, k = 0; e < ne; e++)
+   {
+      const int dof = fes->GetFE(e)->GetDof();
+      fes->GetElementVDofs(e, vdofs);
+      loc_values.SetSize(dof*vdim);
+      for (int j = 0; j < dof; j++, k++)
+      {
+         for (int c = 0; c < vdim; c++) { loc_values(c*dof + j) = vals(c,k); }
+      }
+      SetSubVector(vdofs, loc_values);
+   }
+}
+
 void GridFunction::GetBdrValuesFrom(const GridFunction &orig_func)
 {
    // Without averaging ...
@@ -4140,6 +4261,25 @@ void QuadratureFunction::SaveVTU(const std::string &filename, VTKFormat format,
 }
 
 
+// Flag the reference directions with a large part of the flux energy, given by
+// the dim components of 'd_xyz'.
+static int AnisotropyFlag(const double *d_xyz, int dim)
+{
+   double sum = 0;
+   for (int k = 0; k < dim; k++)
+   {
+      sum += d_xyz[k];
+   }
+
+   double thresh = 0.15 * 3.0/dim;
+   int flag = 0;
+   for (int k = 0; k < dim; k++)
+   {
+      if (d_xyz[k] / sum > thresh) { flag |= (1 << k); }
+   }
+   return flag;
+}
+
 double ZZErrorEstimator(BilinearFormIntegrator &blfi,
                         GridFunction &u,
                         GridFunction &flux, Vector &error_estimates,
@@ -4177,6 +4317,34 @@ double ZZErrorEstimator(BilinearFormIntegrator &blfi,
       // This calls the parallel version when u is a ParGridFunction
       u.ComputeFlux(blfi, flux, with_coeff, (with_subdomains ? s : -1));
 
+      // Compute the energies of all elements as one batch, if supported
+      Vector flux_e, eng, d_eng;
+      if (!with_subdomains &&
+          blfi.ComputeElementFluxes(*ufes, u, *ffes, flux_e, with_coeff))
+      {
+         const Operator *R =
+            ffes->GetElementRestriction(ElementDofOrdering::NATIVE);
+         Vector flux_avg(R->Height());
+         R->Mult(flux, flux_avg);
+         flux_e -= flux_avg;
+         if (blfi.ComputeFluxEnergies(*ffes, flux_e, eng,
+                                      (aniso_flags ? &d_eng : NULL)))
+         {
+            const double *h_eng = eng.HostRead();
+            const double *h_d_eng = aniso_flags ? d_eng.HostRead() : NULL;
+            for (int i = 0; i < nfe; i++)
+            {
+               error_estimates(i) = std::sqrt(h_eng[i]);
+               total_error += h_eng[i];
+               if (aniso_flags)
+               {
+                  (*aniso_flags)[i] = AnisotropyFlag(h_d_eng + dim*i, dim);
+               }
+            }
+            continue;
+         }
+      }
+
       for (int i = 0; i < nfe; i++)
       {
          if (with_subdomains && ufes->GetAttribute(i) != s) { continue; }
@@ -4201,20 +4369,7 @@ double ZZErrorEstimator(BilinearFormIntegrator &blfi,
 
          if (aniso_flags)
          {
-            double sum = 0;
-            for (int k = 0; k < dim; k++)
-            {
-               sum += d_xyz[k];
-            }
-
-            double thresh = 0.15 * 3.0/dim;
-            int flag = 0;
-            for (int k = 0; k < dim; k++)
-            {
-               if (d_xyz[k] / sum > thresh) { flag |= (1 << k); }
-            }
-
-            (*aniso_flags)[i] = flag;
+            (*aniso_flags)[i] = AnisotropyFlag(d_xyz.GetData(), dim);
          }
       }
    }
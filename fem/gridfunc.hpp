@@ -295,6 +295,27 @@ public:
 
    void GetValuesFrom(const GridFunction &orig_func);
 
+   /** @brief Evaluate the GridFunction at the physical points given by the
+       columns of @a point_mat, which are located in the (local) mesh with
+       Mesh::GetPointLocator().
+
+       The values are returned in the columns of @a vals, of size VectorDim()
+       x npts. Points that are not found get the value @a default_value. The
+       points are evaluated in batches of points located in the same element.
+       Returns the number of points found. */
+   int GetValuesAtPoints(const DenseMatrix &point_mat, DenseMatrix &vals,
+                         double default_value = 0.0) const;
+
+   /** @brief Interpolate @a src, defined on a different mesh, at the nodes of
+       this GridFunction.
+
+       The nodes of this space are located in the mesh of @a src with
+       GetValuesAtPoints(); nodes that are not found get @a default_value.
+       This space must use nodal scalar finite elements and have the same
+       vector dimension as @a src. */
+   void InterpolateFromMesh(const GridFunction &src,
+                            double default_value = 0.0);
+
    void GetBdrValuesFrom(const GridFunction &orig_func);
 
    void GetVectorFieldValues(int i, const IntegrationRule &ir,
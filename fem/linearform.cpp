@@ -25,6 +25,7 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
    fes = f;
    ext = nullptr;
    extern_lfs = 1;
+   bdr_faces_mesh = nullptr;
 
    // Copy the pointers to the integrators
    domain_integs = lf->domain_integs;
@@ -115,9 +116,18 @@ bool LinearForm::SupportsDevice()
       }
    }
 
-   // boundary, delta and face integrators are not supported yet
-   if (GetBLFI()->Size() > 0 || GetFLFI()->Size() > 0 ||
-       GetDLFI_Delta()->Size() > 0 || GetIFLFI()->Size() > 0) { return false; }
+   // scan boundary and boundary face integrators
+   for (int k = 0; k < boundary_integs.Size(); k++)
+   {
+      if (!boundary_integs[k]->SupportsDevice()) { return false; }
+   }
+   for (int k = 0; k < boundary_face_integs.Size(); k++)
+   {
+      if (!boundary_face_integs[k]->SupportsDevice()) { return false; }
+   }
+
+   // delta and interior face integrators are not supported yet
+   if (GetDLFI_Delta()->Size() > 0 || GetIFLFI()->Size() > 0) { return false; }
 
    const Mesh &mesh = *fes->GetMesh();
 
@@ -137,9 +147,55 @@ bool LinearForm::SupportsDevice()
       if (!dynamic_cast<const TensorBasisElement*>(fe)) { return false; }
    }
 
+   if (boundary_integs.Size() > 0 || boundary_face_integs.Size() > 0)
+   {
+      // scalar spaces only, as for the legacy assembly
+      if (fes->GetVDim() != 1) { return false; }
+
+      // DG spaces have no dofs on the boundary elements
+      if (boundary_integs.Size() > 0 && fes->IsDGSpace()) { return false; }
+
+      // the face geometric factors need closed tensor-product mesh nodes
+      if (const GridFunction *nodes = mesh.GetNodes())
+      {
+         const TensorBasisElement *tfe = dynamic_cast<const TensorBasisElement*>
+                                         (nodes->FESpace()->GetFE(0));
+         if (!tfe) { return false; }
+         const int btype = tfe->GetBasisType();
+         if (btype != BasisType::GaussLobatto && btype != BasisType::Positive)
+         {
+            return false;
+         }
+      }
+
+      if (!BdrFacesMatch()) { return false; }
+   }
+
    return true;
 }
 
+bool LinearForm::BdrFacesMatch()
+{
+   Mesh &mesh = *fes->GetMesh();
+   if (bdr_faces_mesh == &mesh && bdr_faces_sequence == mesh.GetSequence())
+   {
+      return bdr_faces_match;
+   }
+   bdr_faces_mesh = &mesh;
+   bdr_faces_sequence = mesh.GetSequence();
+   bdr_faces_match = (mesh.GetNBE() == mesh.GetNFbyType(FaceType::Boundary));
+   if (bdr_faces_match)
+   {
+      Array<int> elem, face_id, bdr_attr;
+      GetBdrFaceElements(mesh, elem, face_id, bdr_attr);
+      for (int f = 0; f < bdr_attr.Size(); f++)
+      {
+         if (bdr_attr[f] < 0) { bdr_faces_match = false; break; }
+      }
+   }
+   return bdr_faces_match;
+}
+
 void LinearForm::Assemble(bool use_device)
 {
    Array<int> vdofs;
@@ -74,6 +74,18 @@ protected:
    /// Force (re)computation of delta locations.
    void ResetDeltaLocations() { domain_delta_integs_elem_id.SetSize(0); }
 
+   /** @brief Mesh and value of Mesh::GetSequence() for which the boundary
+       faces were checked by SupportsDevice(), with the result in
+       #bdr_faces_match. */
+   const Mesh *bdr_faces_mesh;
+   long bdr_faces_sequence;
+   bool bdr_faces_match;
+
+   /** @brief Return true if the boundary elements match the boundary faces
+       one-to-one, as required by the device assembly of the boundary
+       integrators. The result is cached until the mesh is modified. */
+   bool BdrFacesMatch();
+
 private:
    /// Copy construction is not supported; body is undefined.
    LinearForm(const LinearForm &);
@@ -82,7 +94,10 @@ public:
    /// Creates linear form associated with FE space @a *f.
    /** The pointer @a f is not owned by the newly constructed object. */
    LinearForm(FiniteElementSpace *f) : Vector(f->GetVSize())
-   { fes = f; ext = nullptr; extern_lfs = 0; UseDevice(true); }
+   {
+      fes = f; ext = nullptr; extern_lfs = 0; bdr_faces_mesh = nullptr;
+      UseDevice(true);
+   }
 
    /** @brief Create a LinearForm on the FiniteElementSpace @a f, using the
        same integrators as the LinearForm @a lf.
@@ -97,7 +112,11 @@ public:
    /** The associated FiniteElementSpace can be set later using one of the
        methods: Update(FiniteElementSpace *) or
        Update(FiniteElementSpace *, Vector &, int). */
-   LinearForm() { fes = NULL; ext = nullptr; extern_lfs = 0; UseDevice(true); }
+   LinearForm()
+   {
+      fes = NULL; ext = nullptr; extern_lfs = 0; bdr_faces_mesh = nullptr;
+      UseDevice(true);
+   }
 
    /// Construct a LinearForm using previously allocated array @a data.
    /** The LinearForm does not assume ownership of @a data which is assumed to
@@ -105,7 +124,7 @@ public:
        for externally allocated array, the pointer @a data can be NULL. The data
        array can be replaced later using the method SetData(). */
    LinearForm(FiniteElementSpace *f, double *data) : Vector(data, f->GetVSize())
-   { fes = f; ext = nullptr; extern_lfs = 0; }
+   { fes = f; ext = nullptr; extern_lfs = 0; bdr_faces_mesh = nullptr; }
 
    /// Copy assignment. Only the data of the base class Vector is copied.
    /** It is assumed that this object and @a rhs use FiniteElementSpace%s that
@@ -174,6 +193,11 @@ public:
    /// Access all integrators added with AddBoundaryIntegrator().
    Array<LinearFormIntegrator*> *GetBLFI() { return &boundary_integs; }
 
+   /** @brief Access all boundary markers added with AddBoundaryIntegrator().
+       If no marker was specified when the integrator was added, the
+       corresponding pointer (to Array<int>) will be NULL. */
+   Array<Array<int>*> *GetBLFI_Marker() { return &boundary_integs_marker; }
+
    /// Access all integrators added with AddBdrFaceIntegrator().
    Array<LinearFormIntegrator*> *GetFLFI() { return &boundary_face_integs; }
 
@@ -15,7 +15,31 @@
 namespace mfem
 {
 
-LinearFormExtension::LinearFormExtension(LinearForm *lf): lf(lf) { Update(); }
+LinearFormExtension::LinearFormExtension(LinearForm *lf)
+   : bdr_faces(nullptr), lf(lf)
+{
+   Update();
+}
+
+LinearFormExtension::~LinearFormExtension()
+{
+   delete bdr_faces;
+}
+
+void LinearFormExtension::SetMarkers(const Array<int> &attr,
+                                     const Array<int> *marker,
+                                     Array<int> &markers)
+{
+   // if there are no markers, just use the whole linear form (1)
+   if (marker == nullptr) { markers.HostReadWrite(); markers = 1; return; }
+
+   // scan the attributes to set the markers to 0 or 1
+   const int N = attr.Size();
+   const auto attr_r = attr.Read();
+   const auto marker_r = marker->Read();
+   auto markers_w = markers.Write();
+   MFEM_FORALL(i, N, markers_w[i] = marker_r[attr_r[i]-1] == 1;);
+}
 
 void LinearFormExtension::Assemble()
 {
@@ -24,43 +48,62 @@ void LinearFormExtension::Assemble()
    MFEM_VERIFY(lf->Size() == fes.GetVSize(), "LinearForm size does not "
                "match the number of vector dofs!");
 
+   const Mesh &mesh = *fes.GetMesh();
+   const int mesh_attributes_size = mesh.attributes.Size();
+   const int bdr_attributes_max =
+      mesh.bdr_attributes.Size() ? mesh.bdr_attributes.Max() : 0;
+
+   // The element restriction overwrites its output, so the contributions of
+   // all the integrators are accumulated in b before applying it once.
+   b = 0.0;
+
    const Array<Array<int>*> &domain_integs_marker = *lf->GetDLFI_Marker();
-   const int mesh_attributes_size = fes.GetMesh()->attributes.Size();
    const Array<LinearFormIntegrator*> &domain_integs = *lf->GetDLFI();
-
    for (int k = 0; k < domain_integs.Size(); ++k)
    {
-      // Get the markers for this integrator
       const Array<int> *domain_integs_marker_k = domain_integs_marker[k];
-
-      // check if there are markers for this integrator
-      const bool has_markers_k = domain_integs_marker_k != nullptr;
-
-      if (has_markers_k)
+      if (domain_integs_marker_k != nullptr)
       {
          // Element attribute marker should be of length mesh->attributes
          MFEM_VERIFY(mesh_attributes_size == domain_integs_marker_k->Size(),
                      "invalid element marker for domain linear form "
                      "integrator #" << k << ", counting from zero");
       }
+      SetMarkers(attributes, domain_integs_marker_k, markers);
+      domain_integs[k]->AssembleDevice(fes, markers, b);
+   }
 
-      // if there are no markers, just use the whole linear form (1)
-      if (!has_markers_k) { markers.HostReadWrite(); markers = 1; }
-      else
+   const Array<Array<int>*> &boundary_integs_marker = *lf->GetBLFI_Marker();
+   const Array<LinearFormIntegrator*> &boundary_integs = *lf->GetBLFI();
+   for (int k = 0; k < boundary_integs.Size(); ++k)
+   {
+      const Array<int> *boundary_integs_marker_k = boundary_integs_marker[k];
+      if (boundary_integs_marker_k != nullptr)
       {
-         // scan the attributes to set the markers to 0 or 1
-         const int NE = fes.GetNE();
-         const auto attr = attributes.Read();
-         const auto dimk = domain_integs_marker_k->Read();
-         auto markers_w = markers.Write();
-         MFEM_FORALL(e, NE, markers_w[e] = dimk[attr[e]-1] == 1;);
+         MFEM_VERIFY(bdr_attributes_max == boundary_integs_marker_k->Size(),
+                     "invalid boundary marker for boundary integrator #"
+                     << k << ", counting from zero");
       }
+      SetMarkers(bdr_faces->bdr_attr, boundary_integs_marker_k, bdr_markers);
+      boundary_integs[k]->AssembleDeviceBdr(fes, bdr_markers, *bdr_faces, b);
+   }
 
-      // Assemble the linear form
-      b = 0.0;
-      domain_integs[k]->AssembleDevice(fes, markers, b);
-      elem_restrict_lex->MultTranspose(b, *lf);
+   const Array<Array<int>*> &bdr_face_integs_marker = *lf->GetFLFI_Marker();
+   const Array<LinearFormIntegrator*> &bdr_face_integs = *lf->GetFLFI();
+   for (int k = 0; k < bdr_face_integs.Size(); ++k)
+   {
+      const Array<int> *bdr_face_integs_marker_k = bdr_face_integs_marker[k];
+      if (bdr_face_integs_marker_k != nullptr)
+      {
+         MFEM_VERIFY(bdr_attributes_max == bdr_face_integs_marker_k->Size(),
+                     "invalid boundary marker for boundary face integrator #"
+                     << k << ", counting from zero");
+      }
+      SetMarkers(bdr_faces->bdr_attr, bdr_face_integs_marker_k, bdr_markers);
+      bdr_face_integs[k]->AssembleDeviceBdr(fes, bdr_markers, *bdr_faces, b);
    }
+
+   elem_restrict_lex->MultTranspose(b, *lf);
 }
 
 void LinearFormExtension::Update()
@@ -78,6 +121,12 @@ void LinearFormExtension::Update()
    attributes.SetSize(NE);
    for (int i = 0; i < NE; ++i) { attributes[i] = mesh.GetAttribute(i); }
 
+   // Gather the boundary faces, their shape functions are computed by the
+   // integrators on first use
+   delete bdr_faces;
+   bdr_faces = new BdrFaceMaps(mesh);
+   bdr_markers.SetSize(bdr_faces->GetNFaces());
+
    constexpr ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
    elem_restrict_lex = fes.GetElementRestriction(ordering);
    MFEM_VERIFY(elem_restrict_lex, "Element restriction not available");
@@ -20,6 +20,7 @@ namespace mfem
 
 class Operator;
 class LinearForm;
+class BdrFaceMaps;
 
 /// Class extending the LinearForm class to support assembly on devices.
 class LinearFormExtension
@@ -30,6 +31,13 @@ class LinearFormExtension
    /// Temporary markers for device kernels.
    Array<int> markers;
 
+   /** Boundary faces with their attributes and the cached shape functions
+       used by the boundary integrators, see BdrFaceMaps. Owned. */
+   BdrFaceMaps *bdr_faces;
+
+   /// Temporary boundary face markers for device kernels.
+   Array<int> bdr_markers;
+
    /// Linear form from which this extension depends. Not owned.
    LinearForm *lf;
 
@@ -39,18 +47,23 @@ class LinearFormExtension
    /// Internal E-vectors.
    mutable Vector b;
 
+   /// Set @a markers from the @a attr array and the attribute @a marker.
+   static void SetMarkers(const Array<int> &attr, const Array<int> *marker,
+                          Array<int> &markers);
+
 public:
 
    /// \brief Create a LinearForm extension of @a lf.
    LinearFormExtension(LinearForm *lf);
 
-   ~LinearFormExtension() { }
+   ~LinearFormExtension();
 
    /// Assemble the linear form, compatible with device execution.
-   /// Only integrators added with AddDomainIntegrator are supported for now.
+   /// Integrators added with AddDomainIntegrator, AddBoundaryIntegrator and
+   /// AddBdrFaceIntegrator are supported.
    void Assemble();
 
-   /// Update the linear form extension.
+   /// Update the linear form extension, after a change of the space.
    void Update();
 };
 
@@ -20,6 +20,8 @@
 namespace mfem
 {
 
+class BdrFaceMaps;
+
 /// Abstract base class LinearFormIntegrator
 class LinearFormIntegrator
 {
@@ -33,11 +35,26 @@ public:
    /// Method probing for assembly on device
    virtual bool SupportsDevice() { return false; }
 
-   /// Method defining assembly on device
+   /** @brief Method defining assembly on device.
+
+       The contributions are added to the lexicographic element E-vector @a b.
+       For domain integrators @a markers is indexed by the mesh elements; for
+       boundary and boundary face integrators it is indexed by the boundary
+       faces, numbered as in the FaceType::Boundary face restrictions. */
    virtual void AssembleDevice(const FiniteElementSpace &fes,
                                const Array<int> &markers,
                                Vector &b);
 
+   /** @brief Method defining assembly on device of the boundary and boundary
+       face integrators, with the boundary face data @a faces cached by the
+       LinearFormExtension.
+
+       The default implementation calls AssembleDevice(fes, markers, b). */
+   virtual void AssembleDeviceBdr(const FiniteElementSpace &fes,
+                                  const Array<int> &markers,
+                                  BdrFaceMaps &faces, Vector &b)
+   { AssembleDevice(fes, markers, b); }
+
    /** Given a particular Finite Element and a transformation (Tr)
        computes the element vector, elvect. */
    virtual void AssembleRHSElementVect(const FiniteElement &el,
@@ -187,6 +204,18 @@ public:
    BoundaryLFIntegrator(Coefficient &QG, int a = 1, int b = 1)
       : Q(QG), oa(a), ob(b) { }
 
+   virtual bool SupportsDevice() { return true; }
+
+   /// Method defining assembly on device
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
+
+   /// Method defining assembly on device with the cached boundary face data
+   virtual void AssembleDeviceBdr(const FiniteElementSpace &fes,
+                                  const Array<int> &markers,
+                                  BdrFaceMaps &faces, Vector &b);
+
    /** Given a particular boundary Finite Element and a transformation (Tr)
        computes the element boundary vector, elvect. */
    virtual void AssembleRHSElementVect(const FiniteElement &el,
@@ -210,6 +239,18 @@ public:
    BoundaryNormalLFIntegrator(VectorCoefficient &QG, int a = 1, int b = 1)
       : Q(QG), oa(a), ob(b) { }
 
+   virtual bool SupportsDevice() { return true; }
+
+   /// Method defining assembly on device
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
+
+   /// Method defining assembly on device with the cached boundary face data
+   virtual void AssembleDeviceBdr(const FiniteElementSpace &fes,
+                                  const Array<int> &markers,
+                                  BdrFaceMaps &faces, Vector &b);
+
    virtual void AssembleRHSElementVect(const FiniteElement &el,
                                        ElementTransformation &Tr,
                                        Vector &elvect);
@@ -528,6 +569,19 @@ public:
                            const double s, const double k)
       : uD(&u), Q(NULL), MQ(&q), sigma(s), kappa(k) { }
 
+   /// Device assembly does not support a MatrixCoefficient.
+   virtual bool SupportsDevice() { return MQ == NULL; }
+
+   /// Method defining assembly on device
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
+
+   /// Method defining assembly on device with the cached boundary face data
+   virtual void AssembleDeviceBdr(const FiniteElementSpace &fes,
+                                  const Array<int> &markers,
+                                  BdrFaceMaps &faces, Vector &b);
+
    virtual void AssembleRHSElementVect(const FiniteElement &el,
                                        ElementTransformation &Tr,
                                        Vector &elvect);
@@ -756,6 +810,73 @@ public:
    }
 };
 
+/** @brief For each boundary face, numbered as in the FaceType::Boundary face
+    restrictions, return the adjacent element @a elem, the local index of the
+    face in that element @a face_id and the attribute @a bdr_attr of the
+    matching boundary element (-1 if there is none). */
+void GetBdrFaceElements(const Mesh &mesh, Array<int> &elem,
+                        Array<int> &face_id, Array<int> &bdr_attr);
+
+/** @brief Boundary face data used by the device assembly of the boundary and
+    boundary face linear form integrators, see
+    LinearFormIntegrator::AssembleDeviceBdr().
+
+    It is built for the boundary faces of a mesh, numbered as in the
+    FaceType::Boundary face restrictions, and cached by the
+    LinearFormExtension, which rebuilds it in LinearFormExtension::Update().
+    It stores the adjacent elements and the attributes of the faces, see
+    GetBdrFaceElements(), and the shape functions of the elements at the
+    points of the face integration rules, computed on first use. */
+class BdrFaceMaps
+{
+public:
+   /// Shape functions of an element at the points of a face rule.
+   struct Shapes
+   {
+      /** Points of the face rule in the reference element, on each face of
+          the element, ordered as the points of the FaceGeometricFactors. */
+      IntegrationRule eir;
+      /** Values (NQ,ND,NLF) and reference gradients (NQ,DIM,ND,NLF) of the
+          lexicographically ordered shape functions at the points @a eir, on
+          the NLF faces of the element. @a G is empty unless requested. */
+      Vector B, G;
+   };
+
+private:
+   struct Entry
+   {
+      const FiniteElement *fe;
+      IntegrationRule ir;
+      Shapes shapes;
+   };
+   Array<Entry*> entries;
+
+public:
+   /// Adjacent element and local index of the face in that element.
+   Array<int> elem, face_id;
+   /// Attributes of the boundary elements and of the adjacent elements.
+   Array<int> bdr_attr, elem_attr;
+
+   /// Gather the boundary faces of @a mesh.
+   explicit BdrFaceMaps(const Mesh &mesh);
+
+   BdrFaceMaps(const BdrFaceMaps &) = delete;
+   BdrFaceMaps &operator=(const BdrFaceMaps &) = delete;
+
+   ~BdrFaceMaps();
+
+   /// Return the number of boundary faces.
+   int GetNFaces() const { return elem.Size(); }
+
+   /** @brief Return the shape functions of the tensor product element @a fe
+       at the points of the face rule @a ir, including their gradients if
+       @a grad is true. */
+   /** The shape functions are computed on the first call and reused by the
+       following calls with the same element and rule. */
+   const Shapes &GetShapes(const FiniteElement &fe, const IntegrationRule &ir,
+                           bool grad = false);
+};
+
 }
 
 
@@ -0,0 +1,610 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "fem.hpp"
+#include "../linalg/kernels.hpp"
+#include "../general/forall.hpp"
+
+namespace mfem
+{
+
+void GetBdrFaceElements(const Mesh &mesh, Array<int> &elem,
+                        Array<int> &face_id, Array<int> &bdr_attr)
+{
+   const int nf = mesh.GetNumFaces();
+   Array<int> face_attr(nf);
+   face_attr = -1;
+   for (int be = 0; be < mesh.GetNBE(); be++)
+   {
+      face_attr[mesh.GetBdrElementEdgeIndex(be)] = mesh.GetBdrAttribute(be);
+   }
+
+   const int nbf = mesh.GetNFbyType(FaceType::Boundary);
+   elem.SetSize(nbf);
+   face_id.SetSize(nbf);
+   bdr_attr.SetSize(nbf);
+   int f_ind = 0;
+   for (int f = 0; f < nf; f++)
+   {
+      const Mesh::FaceInformation face = mesh.GetFaceInformation(f);
+      if (face.IsNonconformingCoarse()) { continue; }
+      if (!face.IsOfFaceType(FaceType::Boundary)) { continue; }
+      elem[f_ind] = face.element[0].index;
+      face_id[f_ind] = face.element[0].local_face_id;
+      bdr_attr[f_ind] = face_attr[f];
+      f_ind++;
+   }
+   MFEM_ASSERT(f_ind == nbf, "inconsistent number of boundary faces");
+}
+
+/** Reference coordinates, in the adjacent element of geometry @a geom, of the
+    points of the face rule @a ir on each of the element faces. On every face
+    the points follow the lexicographic ordering of the face restrictions, see
+    GetFaceDofs(), so that they match the FaceGeometricFactors. */
+static void GetElementFacePoints(const Geometry::Type geom,
+                                 const IntegrationRule &ir,
+                                 IntegrationRule &eir)
+{
+   const int dim = Geometry::Dimension[geom];
+   const int nfaces = Geometry::NumBdrArray[geom];
+   const int nq = ir.GetNPoints();
+   const int nc = 1 << (dim-1);
+   Array<int> corners(nc);
+   eir.SetSize(nfaces*nq);
+   for (int lf = 0; lf < nfaces; lf++)
+   {
+      // lexicographic indices of the face vertices in the element
+      GetFaceDofs(dim, lf, 2, corners);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         double x[3] = {0.0, 0.0, 0.0};
+         for (int c = 0; c < nc; c++)
+         {
+            const double s = (c & 1) ? ip.x : 1.0 - ip.x;
+            const double t = (dim < 3) ? 1.0 : ((c & 2) ? ip.y : 1.0 - ip.y);
+            for (int k = 0; k < dim; k++)
+            {
+               x[k] += s*t*((corners[c] >> k) & 1);
+            }
+         }
+         IntegrationPoint &eip = eir.IntPoint(lf*nq + q);
+         eip.Set(x, dim);
+         eip.weight = ip.weight;
+      }
+   }
+}
+
+/** Values @a B, (NQ,ND,NF), and reference gradients @a G, (NQ,DIM,ND,NF), of
+    the lexicographically ordered basis functions of @a fe at the points @a eir
+    computed by GetElementFacePoints(). */
+static void GetElementFaceShapes(const FiniteElement &fe,
+                                 const IntegrationRule &eir, const int nq,
+                                 Vector &B, Vector *G)
+{
+   const int nd = fe.GetDof(), dim = fe.GetDim();
+   const int nfaces = eir.GetNPoints() / nq;
+   const TensorBasisElement *tfe =
+      dynamic_cast<const TensorBasisElement*>(&fe);
+   MFEM_VERIFY(tfe, "Only tensor-product finite elements are supported");
+   const Array<int> &dof_map = tfe->GetDofMap();
+
+   Vector shape(nd);
+   DenseMatrix dshape(nd, dim);
+   B.SetSize(nq*nd*nfaces);
+   auto b = Reshape(B.HostWrite(), nq, nd, nfaces);
+   if (G) { G->SetSize(nq*dim*nd*nfaces); }
+   auto g = Reshape(G ? G->HostWrite() : nullptr, nq, dim, nd, nfaces);
+   for (int lf = 0; lf < nfaces; lf++)
+   {
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &eip = eir.IntPoint(lf*nq + q);
+         fe.CalcShape(eip, shape);
+         if (G) { fe.CalcDShape(eip, dshape); }
+         for (int d = 0; d < nd; d++)
+         {
+            const int n = dof_map.Size() ? dof_map[d] : d;
+            b(q,d,lf) = shape(n);
+            if (!G) { continue; }
+            for (int k = 0; k < dim; k++) { g(q,k,d,lf) = dshape(n,k); }
+         }
+      }
+   }
+}
+
+BdrFaceMaps::BdrFaceMaps(const Mesh &mesh)
+{
+   if (mesh.Dimension() > 1)
+   {
+      GetBdrFaceElements(mesh, elem, face_id, bdr_attr);
+   }
+   elem_attr.SetSize(elem.Size());
+   for (int f = 0; f < elem.Size(); f++)
+   {
+      elem_attr[f] = mesh.GetAttribute(elem[f]);
+   }
+}
+
+BdrFaceMaps::~BdrFaceMaps()
+{
+   for (int i = 0; i < entries.Size(); i++) { delete entries[i]; }
+}
+
+// The rules are compared by value, since a rule given to an integrator may be
+// destroyed and another one created at the same address.
+static bool SameIntRule(const IntegrationRule &a, const IntegrationRule &b)
+{
+   if (a.GetNPoints() != b.GetNPoints()) { return false; }
+   for (int q = 0; q < a.GetNPoints(); q++)
+   {
+      const IntegrationPoint &pa = a.IntPoint(q), &pb = b.IntPoint(q);
+      if (pa.x != pb.x || pa.y != pb.y || pa.z != pb.z ||
+          pa.weight != pb.weight) { return false; }
+   }
+   return true;
+}
+
+const BdrFaceMaps::Shapes &BdrFaceMaps::GetShapes(const FiniteElement &fe,
+                                                  const IntegrationRule &ir,
+                                                  bool grad)
+{
+   Entry *entry = NULL;
+   for (int i = 0; i < entries.Size() && !entry; i++)
+   {
+      if (entries[i]->fe == &fe && SameIntRule(entries[i]->ir, ir))
+      {
+         entry = entries[i];
+      }
+   }
+   if (!entry)
+   {
+      entry = new Entry;
+      entry->fe = &fe;
+      entry->ir = ir;
+      GetElementFacePoints(fe.GetGeomType(), ir, entry->shapes.eir);
+      entries.Append(entry);
+   }
+   Shapes &s = entry->shapes;
+   if (s.B.Size() == 0 || (grad && s.G.Size() == 0))
+   {
+      GetElementFaceShapes(fe, s.eir, ir.GetNPoints(), s.B,
+                           grad ? &s.G : nullptr);
+   }
+   return s;
+}
+
+/// Check if BdrFaceValues() supports the space @a fes on @a mesh.
+static bool SupportsBdrFaceValues(const FiniteElementSpace &fes,
+                                  const Mesh &mesh)
+{
+   if (fes.GetMesh() != &mesh || fes.GetNE() == 0 || fes.IsVariableOrder() ||
+       mesh.GetNumGeometries(mesh.Dimension()) > 1) { return false; }
+   const FiniteElement &fe = *fes.GetFE(0);
+   return fe.GetMapType() == FiniteElement::VALUE &&
+          fe.GetRangeType() == FiniteElement::SCALAR &&
+          dynamic_cast<const TensorBasisElement*>(&fe) != nullptr;
+}
+
+/** Interpolate the GridFunction @a gf at the points of the face rule @a ir on
+    the boundary faces into @a V, (NQ,VDIM,NF), from the element E-vector and
+    the cached shape functions of its space. */
+static void BdrFaceValues(const GridFunction &gf, BdrFaceMaps &faces,
+                          const IntegrationRule &ir, Vector &V)
+{
+   const FiniteElementSpace &gfes = *gf.FESpace();
+   const FiniteElement &fe = *gfes.GetFE(0);
+   const BdrFaceMaps::Shapes &s = faces.GetShapes(fe, ir);
+   const Operator *R =
+      gfes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+   Vector ue(R->Height());
+   ue.UseDevice(true);
+   R->Mult(gf, ue);
+
+   const int NQ = ir.GetNPoints(), ND = fe.GetDof(), VDIM = gfes.GetVDim();
+   const int NE = gfes.GetNE(), NF = faces.GetNFaces();
+   const int NLF = s.B.Size() / (NQ*ND);
+   const auto E = faces.elem.Read();
+   const auto LF = faces.face_id.Read();
+   const auto b = Reshape(s.B.Read(), NQ, ND, NLF);
+   const auto U = Reshape(ue.Read(), ND, VDIM, NE);
+   V.SetSize(NQ*VDIM*NF);
+   V.UseDevice(true);
+   auto v = Reshape(V.Write(), NQ, VDIM, NF);
+   MFEM_FORALL(i, NQ*NF,
+   {
+      const int q = i % NQ, f = i / NQ;
+      const int e = E[f], lf = LF[f];
+      for (int c = 0; c < VDIM; c++)
+      {
+         double u = 0.0;
+         for (int d = 0; d < ND; d++) { u += b(q,d,lf) * U(d,c,e); }
+         v(q,c,f) = u;
+      }
+   });
+}
+
+/** Evaluate @a coeff at the points of the face rule @a ir on the boundary
+    faces into @a C, (NQ,NF), where @a eir are the points of the rule in the
+    adjacent elements, see BdrFaceMaps::Shapes. The transformations take the
+    attributes @a attr, e.g. BdrFaceMaps::bdr_attr or BdrFaceMaps::elem_attr.
+
+    As in the domain integrators, see Coefficient::Project(), the constant,
+    piecewise constant, function and GridFunction coefficients are evaluated
+    in a batch, the other ones through the element transformations. */
+static void EvalBdrCoefficient(Coefficient &coeff, Mesh &mesh,
+                               BdrFaceMaps &faces, const IntegrationRule &ir,
+                               const IntegrationRule &eir,
+                               const Array<int> &attr, Vector &C)
+{
+   const int nq = ir.GetNPoints(), nf = faces.GetNFaces();
+   C.SetSize(nq*nf);
+   C.UseDevice(true);
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(&coeff))
+   {
+      C = cQ->constant;
+      return;
+   }
+   if (PWConstCoefficient *pwQ = dynamic_cast<PWConstCoefficient*>(&coeff))
+   {
+      Vector constants(pwQ->GetNConst());
+      for (int i = 0; i < constants.Size(); i++)
+      {
+         constants(i) = (*pwQ)(i+1);
+      }
+      for (int f = 0; f < nf; f++)
+      {
+         MFEM_VERIFY(attr[f] >= 1 && attr[f] <= constants.Size(),
+                     "attribute " << attr[f] << " of boundary face " << f
+                     << " is out of the range of the PWConstCoefficient");
+      }
+      const int NQ = nq;
+      const auto A = attr.Read();
+      const auto K = constants.Read();
+      auto c = Reshape(C.Write(), NQ, nf);
+      MFEM_FORALL(i, NQ*nf, c(i % NQ, i / NQ) = K[A[i / NQ] - 1];);
+      return;
+   }
+   const GridFunction *nodes = mesh.GetNodes();
+   FunctionCoefficient *fQ = dynamic_cast<FunctionCoefficient*>(&coeff);
+   if (fQ && nodes && SupportsBdrFaceValues(*nodes->FESpace(), mesh))
+   {
+      Vector x;
+      BdrFaceValues(*nodes, faces, ir, x);
+      fQ->EvalPoints(x, nq, nodes->FESpace()->GetVDim(), C);
+      return;
+   }
+   GridFunctionCoefficient *gQ =
+      dynamic_cast<GridFunctionCoefficient*>(&coeff);
+   const GridFunction *gf = gQ ? gQ->GetGridFunction() : NULL;
+   if (gf && SupportsBdrFaceValues(*gf->FESpace(), mesh))
+   {
+      Vector u;
+      BdrFaceValues(*gf, faces, ir, u);
+      const int NQ = nq, VDIM = gf->FESpace()->GetVDim();
+      const int comp = gQ->GetComponent() - 1;
+      const auto U = Reshape(u.Read(), NQ, VDIM, nf);
+      auto c = Reshape(C.Write(), NQ, nf);
+      MFEM_FORALL(i, NQ*nf,
+      {
+         const int q = i % NQ, f = i / NQ;
+         c(q,f) = U(q,comp,f);
+      });
+      return;
+   }
+   IsoparametricTransformation T;
+   auto c = Reshape(C.HostWrite(), nq, nf);
+   for (int f = 0; f < nf; f++)
+   {
+      mesh.GetElementTransformation(faces.elem[f], &T);
+      T.Attribute = attr[f];
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &eip = eir.IntPoint(faces.face_id[f]*nq + q);
+         T.SetIntPoint(&eip);
+         c(q,f) = coeff.Eval(T, eip);
+      }
+   }
+}
+
+/// Vector version of EvalBdrCoefficient(), @a C is (VDIM,NQ,NF).
+static void EvalBdrCoefficient(VectorCoefficient &coeff, Mesh &mesh,
+                               BdrFaceMaps &faces, const IntegrationRule &ir,
+                               const IntegrationRule &eir,
+                               const Array<int> &attr, Vector &C)
+{
+   const int nq = ir.GetNPoints(), nf = faces.GetNFaces();
+   const int vdim = coeff.GetVDim();
+   C.SetSize(vdim*nq*nf);
+   C.UseDevice(true);
+   if (VectorConstantCoefficient *cQ =
+          dynamic_cast<VectorConstantCoefficient*>(&coeff))
+   {
+      const int VDIM = vdim;
+      const auto K = cQ->GetVec().Read();
+      auto c = C.Write();
+      MFEM_FORALL(i, VDIM*nq*nf, c[i] = K[i % VDIM];);
+      return;
+   }
+   IsoparametricTransformation T;
+   Vector cv(vdim);
+   auto c = Reshape(C.HostWrite(), vdim, nq, nf);
+   for (int f = 0; f < nf; f++)
+   {
+      mesh.GetElementTransformation(faces.elem[f], &T);
+      T.Attribute = attr[f];
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &eip = eir.IntPoint(faces.face_id[f]*nq + q);
+         T.SetIntPoint(&eip);
+         coeff.Eval(cv, T, eip);
+         for (int i = 0; i < vdim; i++) { c(i,q,f) = cv(i); }
+      }
+   }
+}
+
+/** Add the contributions of the marked boundary faces to the element E-vector
+    @a y: y(d,e) += sum_q B(q,d) D(q,f) + sum_{q,k} G(q,k,d) H(k,q,f), where e
+    is the element adjacent to face f. The gradient term is skipped when @a G
+    is NULL. */
+static void BdrFaceAddElementVectors(const int dim, const int nq, const int nd,
+                                     const Array<int> &markers,
+                                     const Array<int> &elem,
+                                     const Array<int> &face_id,
+                                     const Vector &B, const Vector *G,
+                                     const Vector &D, const Vector *H,
+                                     Vector &y)
+{
+   const int DIM = dim, NQ = nq, ND = nd, NF = elem.Size();
+   const int NLF = B.Size() / (NQ*ND);
+   const bool grad = G != nullptr;
+   const auto M = markers.Read();
+   const auto E = elem.Read();
+   const auto LF = face_id.Read();
+   const auto b = Reshape(B.Read(), NQ, ND, NLF);
+   const auto g = Reshape(grad ? G->Read() : nullptr, NQ, DIM, ND, NLF);
+   const auto d_q = Reshape(D.Read(), NQ, NF);
+   const auto h_q = Reshape(grad ? H->Read() : nullptr, DIM, NQ, NF);
+   auto Y = Reshape(y.ReadWrite(), ND, y.Size() / ND);
+   MFEM_FORALL(f, NF,
+   {
+      if (M[f] == 0) { return; } // ignore
+      const int e = E[f], lf = LF[f];
+      for (int d = 0; d < ND; d++)
+      {
+         double s = 0.0;
+         for (int q = 0; q < NQ; q++)
+         {
+            s += b(q,d,lf) * d_q(q,f);
+            if (!grad) { continue; }
+            for (int k = 0; k < DIM; k++) { s += g(q,k,d,lf) * h_q(k,q,f); }
+         }
+         AtomicAdd(Y(d,e), s);
+      }
+   });
+}
+
+void BoundaryLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                          const Array<int> &markers,
+                                          Vector &b)
+{
+   BdrFaceMaps faces(*fes.GetMesh());
+   AssembleDeviceBdr(fes, markers, faces, b);
+}
+
+void BoundaryLFIntegrator::AssembleDeviceBdr(const FiniteElementSpace &fes,
+                                             const Array<int> &markers,
+                                             BdrFaceMaps &faces, Vector &b)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const int nf = faces.GetNFaces();
+   if (nf == 0) { return; }
+
+   const FiniteElement &fe = *fes.GetFE(0);
+   const int dim = mesh.Dimension();
+   const int qorder = oa * fe.GetOrder() + ob;
+   const Geometry::Type fgeom = mesh.GetFaceBaseGeometry(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &IntRules.Get(fgeom, qorder);
+   const int nq = ir->GetNPoints(), nd = fe.GetDof();
+   const BdrFaceMaps::Shapes &shapes = faces.GetShapes(fe, *ir);
+
+   const FaceGeometricFactors *geom = mesh.GetFaceGeometricFactors(
+      *ir, FaceGeometricFactors::DETERMINANTS, FaceType::Boundary);
+
+   Vector coeff;
+   EvalBdrCoefficient(Q, mesh, faces, *ir, shapes.eir, faces.bdr_attr, coeff);
+
+   const int NQ = nq;
+   const auto W = ir->GetWeights().Read();
+   const auto detJ = Reshape(geom->detJ.Read(), NQ, nf);
+   const auto C = Reshape(coeff.Read(), NQ, nf);
+   Vector D(nq*nf);
+   D.UseDevice(true);
+   auto d_q = Reshape(D.Write(), NQ, nf);
+   MFEM_FORALL(i, NQ*nf,
+   {
+      const int q = i % NQ, f = i / NQ;
+      d_q(q,f) = W[q] * detJ(q,f) * C(q,f);
+   });
+   BdrFaceAddElementVectors(dim, nq, nd, markers, faces.elem, faces.face_id,
+                            shapes.B, nullptr, D, nullptr, b);
+}
+
+void BoundaryNormalLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                                const Array<int> &markers,
+                                                Vector &b)
+{
+   BdrFaceMaps faces(*fes.GetMesh());
+   AssembleDeviceBdr(fes, markers, faces, b);
+}
+
+void BoundaryNormalLFIntegrator::AssembleDeviceBdr(
+   const FiniteElementSpace &fes, const Array<int> &markers,
+   BdrFaceMaps &faces, Vector &b)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const int nf = faces.GetNFaces();
+   if (nf == 0) { return; }
+
+   const FiniteElement &fe = *fes.GetFE(0);
+   const int dim = mesh.Dimension();
+   const int qorder = oa * fe.GetOrder() + ob;
+   const Geometry::Type fgeom = mesh.GetFaceBaseGeometry(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &IntRules.Get(fgeom, qorder);
+   const int nq = ir->GetNPoints(), nd = fe.GetDof();
+   MFEM_VERIFY(Q.GetVDim() == dim, "invalid coefficient dimension");
+   const BdrFaceMaps::Shapes &shapes = faces.GetShapes(fe, *ir);
+
+   const int flags = FaceGeometricFactors::DETERMINANTS |
+                     FaceGeometricFactors::NORMALS;
+   const FaceGeometricFactors *geom =
+      mesh.GetFaceGeometricFactors(*ir, flags, FaceType::Boundary);
+
+   Vector coeff;
+   EvalBdrCoefficient(Q, mesh, faces, *ir, shapes.eir, faces.bdr_attr, coeff);
+
+   const int DIM = dim, NQ = nq;
+   const auto W = ir->GetWeights().Read();
+   const auto detJ = Reshape(geom->detJ.Read(), NQ, nf);
+   const auto n = Reshape(geom->normal.Read(), NQ, DIM, nf);
+   const auto C = Reshape(coeff.Read(), DIM, NQ, nf);
+   Vector D(nq*nf);
+   D.UseDevice(true);
+   auto d_q = Reshape(D.Write(), NQ, nf);
+   MFEM_FORALL(i, NQ*nf,
+   {
+      const int q = i % NQ, f = i / NQ;
+      double qn = 0.0;
+      for (int c = 0; c < DIM; c++) { qn += C(c,q,f) * n(q,c,f); }
+      d_q(q,f) = W[q] * detJ(q,f) * qn;
+   });
+   BdrFaceAddElementVectors(dim, nq, nd, markers, faces.elem, faces.face_id,
+                            shapes.B, nullptr, D, nullptr, b);
+}
+
+void DGDirichletLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                             const Array<int> &markers,
+                                             Vector &b)
+{
+   BdrFaceMaps faces(*fes.GetMesh());
+   AssembleDeviceBdr(fes, markers, faces, b);
+}
+
+void DGDirichletLFIntegrator::AssembleDeviceBdr(const FiniteElementSpace &fes,
+                                                const Array<int> &markers,
+                                                BdrFaceMaps &faces, Vector &b)
+{
+   MFEM_VERIFY(MQ == NULL, "MatrixCoefficient is not supported on device");
+   Mesh &mesh = *fes.GetMesh();
+   const int nf = faces.GetNFaces();
+   if (nf == 0) { return; }
+
+   const FiniteElement &fe = *fes.GetFE(0);
+   const int dim = mesh.Dimension();
+   const Geometry::Type fgeom = mesh.GetFaceBaseGeometry(0);
+   const IntegrationRule *ir =
+      IntRule ? IntRule : &IntRules.Get(fgeom, 2*fe.GetOrder());
+   const int nq = ir->GetNPoints(), nd = fe.GetDof();
+   const BdrFaceMaps::Shapes &shapes = faces.GetShapes(fe, *ir, true);
+
+   // The element Jacobians at the face points are computed from the mesh
+   // nodes.
+   mesh.EnsureNodes();
+   const int flags = FaceGeometricFactors::DETERMINANTS |
+                     FaceGeometricFactors::NORMALS;
+   const FaceGeometricFactors *geom =
+      mesh.GetFaceGeometricFactors(*ir, flags, FaceType::Boundary);
+
+   const GridFunction &nodes = *mesh.GetNodes();
+   const FiniteElementSpace &nfes = *nodes.FESpace();
+   const FiniteElement &nfe = *nfes.GetFE(0);
+   const Operator *nodes_restrict =
+      nfes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+   Vector xe(nodes_restrict->Height());
+   xe.UseDevice(true);
+   nodes_restrict->Mult(nodes, xe);
+   const Vector &Gn = faces.GetShapes(nfe, *ir, true).G;
+
+   // uD is evaluated through the face, Q through the adjacent element
+   Vector uD_q, Q_q;
+   EvalBdrCoefficient(*uD, mesh, faces, *ir, shapes.eir, faces.bdr_attr,
+                      uD_q);
+   if (Q)
+   {
+      EvalBdrCoefficient(*Q, mesh, faces, *ir, shapes.eir, faces.elem_attr,
+                         Q_q);
+   }
+   else { Q_q.SetSize(nq*nf); Q_q.UseDevice(true); Q_q = 1.0; }
+
+   const int DIM = dim, NQ = nq, NDN = nfe.GetDof(), NE = mesh.GetNE();
+   const int NLF = Gn.Size() / (NQ*DIM*NDN);
+   const double s = sigma, k = kappa;
+   const auto E = faces.elem.Read();
+   const auto LF = faces.face_id.Read();
+   const auto W = ir->GetWeights().Read();
+   const auto X = Reshape(xe.Read(), NDN, DIM, NE);
+   const auto gn = Reshape(Gn.Read(), NQ, DIM, NDN, NLF);
+   const auto detJ = Reshape(geom->detJ.Read(), NQ, nf);
+   const auto n = Reshape(geom->normal.Read(), NQ, DIM, nf);
+   const auto U = Reshape(uD_q.Read(), NQ, nf);
+   const auto C = Reshape(Q_q.Read(), NQ, nf);
+   Vector D(nq*nf), H(dim*nq*nf);
+   D.UseDevice(true);
+   H.UseDevice(true);
+   auto d_q = Reshape(D.Write(), NQ, nf);
+   auto h_q = Reshape(H.Write(), DIM, NQ, nf);
+   MFEM_FORALL(i, NQ*nf,
+   {
+      const int q = i % NQ, f = i / NQ;
+      const int e = E[f], lf = LF[f];
+      double J[9], adjJ[9];
+      for (int r = 0; r < DIM*DIM; r++) { J[r] = 0.0; }
+      for (int dn = 0; dn < NDN; dn++)
+      {
+         for (int kk = 0; kk < DIM; kk++)
+         {
+            const double g = gn(q,kk,dn,lf);
+            for (int c = 0; c < DIM; c++) { J[c + DIM*kk] += X(dn,c,e) * g; }
+         }
+      }
+      double detJe;
+      if (DIM == 2)
+      {
+         detJe = kernels::Det<2>(J);
+         kernels::CalcAdjugate<2>(J, adjJ);
+      }
+      else
+      {
+         detJe = kernels::Det<3>(J);
+         kernels::CalcAdjugate<3>(J, adjJ);
+      }
+      // ni = w nor, with nor the (unnormalized) outward face normal
+      const double w = W[q] * U(q,f) * C(q,f) / detJe;
+      double ni[3], ni_nor = 0.0;
+      for (int c = 0; c < DIM; c++)
+      {
+         const double nor = detJ(q,f) * n(q,c,f);
+         ni[c] = w * nor;
+         ni_nor += ni[c] * nor;
+      }
+      d_q(q,f) = k * ni_nor;
+      for (int kk = 0; kk < DIM; kk++)
+      {
+         double nh = 0.0;
+         for (int c = 0; c < DIM; c++) { nh += adjJ[kk + DIM*c] * ni[c]; }
+         h_q(kk,q,f) = s * nh;
+      }
+   });
+   BdrFaceAddElementVectors(dim, nq, nd, markers, faces.elem, faces.face_id,
+                            shapes.B, &shapes.G, D, &H, b);
+}
+
+} // namespace mfem
@@ -278,18 +278,8 @@ void DomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& Tr = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            const IntegrationPoint &ip = ir->IntPoint(q);
-            Tr.SetIntPoint(&ip);
-            C(q,e) = Q.Eval(Tr, ip);
-         }
-      }
+      QuadratureSpace qs(fes.GetMesh(), *ir);
+      Q.Project(qs, coeff);
    }
    DLFEvalAssemble(fes, ir, markers, coeff, b);
 }
@@ -324,20 +314,8 @@ void VectorDomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
    }
    else
    {
-      Vector qv(vdim);
-      Qvec.SetSize(vdim * nq * ne);
-      auto C = Reshape(Qvec.HostWrite(), vdim, nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& Tr = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            const IntegrationPoint &ip = ir->IntPoint(q);
-            Tr.SetIntPoint(&ip);
-            Q.Eval(qv, Tr, ip);
-            for (int c=0; c<vdim; ++c) { C(c,q,e) = qv[c]; }
-         }
-      }
+      QuadratureSpace qs(fes.GetMesh(), *ir);
+      Q.Project(qs, Qvec);
    }
    DLFEvalAssemble(fes, ir, markers, Qvec, b);
 }
@@ -345,24 +345,8 @@ void DomainLFGradIntegrator::AssembleDevice(const FiniteElementSpace &fes,
    }
    else
    {
-      const int qvdim = Q.GetVDim();
-      Vector qvec(qvdim);
-      Qvec.SetSize(qvdim * nq * ne);
-      auto C = Reshape(Qvec.HostWrite(), qvdim, nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& Tr = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            const IntegrationPoint &ip = ir->IntPoint(q);
-            Tr.SetIntPoint(&ip);
-            Q.Eval(qvec, Tr, ip);
-            for (int c=0; c < qvdim; ++c)
-            {
-               C(c,q,e) = qvec[c];
-            }
-         }
-      }
+      QuadratureSpace qs(fes.GetMesh(), *ir);
+      Q.Project(qs, Qvec);
    }
    DLFGradAssemble(fes, ir, markers, Qvec, b);
 }
@@ -410,20 +394,8 @@ void VectorDomainLFGradIntegrator::AssembleDevice(const FiniteElementSpace &fes,
    }
    else
    {
-      Vector qvec(vdim);
-      Qvec.SetSize(vdim * nq * ne);
-      auto C = Reshape(Qvec.HostWrite(), vdim, nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation &Tr = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            const IntegrationPoint &ip = ir->IntPoint(q);
-            Tr.SetIntPoint(&ip);
-            Q.Eval(qvec, Tr, ip);
-            for (int c = 0; c<vdim; ++c) { C(c,q,e) = qvec[c]; }
-         }
-      }
+      QuadratureSpace qs(fes.GetMesh(), *ir);
+      Q.Project(qs, Qvec);
    }
    DLFGradAssemble(fes, ir, markers, Qvec, b);
 }
@@ -10,12 +10,19 @@
 // CONTRIBUTING.md for details.
 
 #include "multigrid.hpp"
+#include "transfer.hpp"
+
+#include <algorithm>
 
 namespace mfem
 {
 
 Multigrid::Multigrid()
-   : cycleType(CycleType::VCYCLE), preSmoothingSteps(1), postSmoothingSteps(1)
+   : cycleType(CycleType::VCYCLE), preSmoothingSteps(1), postSmoothingSteps(1),
+     maxSmoothingSteps(0), smoothingStallRatio(0.9)
+#ifdef MFEM_USE_MPI
+   , comm(MPI_COMM_NULL)
+#endif
 {}
 
 Multigrid::Multigrid(const Array<Operator*>& operators_,
@@ -25,7 +32,11 @@ Multigrid::Multigrid(const Array<Operator*>& operators_,
                      const Array<bool>& ownedSmoothers_,
                      const Array<bool>& ownedProlongations_)
    : Solver(operators_.Last()->NumRows()), cycleType(CycleType::VCYCLE),
-     preSmoothingSteps(1), postSmoothingSteps(1),
+     preSmoothingSteps(1), postSmoothingSteps(1), maxSmoothingSteps(0),
+     smoothingStallRatio(0.9),
+#ifdef MFEM_USE_MPI
+     comm(MPI_COMM_NULL),
+#endif
      X(operators_.Size()), Y(X.Size()), R(X.Size()), Z(X.Size())
 {
    operators_.Copy(operators);
@@ -37,6 +48,7 @@ Multigrid::Multigrid(const Array<Operator*>& operators_,
 
    for (int level = 0; level < operators.Size(); ++level)
    {
+      SetCommFromOperator(operators[level]);
       X[level] = new Vector(operators[level]->NumRows());
       *X[level] = 0.0;
       Y[level] = new Vector(operators[level]->NumRows());
@@ -74,6 +86,14 @@ Multigrid::~Multigrid()
       }
    }
 
+   for (int i = 0; i < KR.Size(); ++i)
+   {
+      delete KR[i];
+      delete KC[i];
+      delete KV[i];
+      delete KD[i];
+   }
+
    operators.DeleteAll();
    smoothers.DeleteAll();
    prolongations.DeleteAll();
@@ -86,6 +106,7 @@ Multigrid::~Multigrid()
 void Multigrid::AddLevel(Operator* opr, Solver* smoother, bool ownOperator,
                          bool ownSmoother)
 {
+   SetCommFromOperator(opr);
    operators.Append(opr);
    smoothers.Append(smoother);
    ownedOperators.Append(ownOperator);
@@ -145,15 +166,73 @@ void Multigrid::SetCycleType(CycleType cycleType_, int preSmoothingSteps_,
    postSmoothingSteps = postSmoothingSteps_;
 }
 
+void Multigrid::SetAdaptiveSmoothing(int max_steps, double stall_ratio)
+{
+   maxSmoothingSteps = max_steps;
+   smoothingStallRatio = stall_ratio;
+}
+
+void Multigrid::SetCommFromOperator(const Operator *op)
+{
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL) { return; }
+   if (const HypreParMatrix *A = dynamic_cast<const HypreParMatrix*>(op))
+   {
+      comm = A->GetComm();
+   }
+#endif
+}
+
+void Multigrid::CheckComm() const
+{
+#ifdef MFEM_USE_MPI
+   // With rank-local inner products, the ranks could take different branches
+   // of the adaptive smoothing or of the K-cycle and deadlock.
+   if (comm == MPI_COMM_NULL &&
+       (maxSmoothingSteps > 0 || cycleType == CycleType::KCYCLE))
+   {
+      MFEM_VERIFY(!Mpi::IsInitialized() || Mpi::WorldSize() == 1,
+                  "the adaptive smoothing and the K-cycle need the "
+                  "communicator of the operators, call SetComm(), e.g. with "
+                  "MPI_COMM_SELF for problems local to each rank");
+   }
+#endif
+}
+
 void Multigrid::Mult(const Vector& x, Vector& y) const
 {
    MFEM_ASSERT(NumLevels() > 0, "");
+   CheckComm();
    *X.Last() = x;
    *Y.Last() = 0.0;
-   Cycle(GetFinestLevelIndex());
+   Cycle(GetFinestLevelIndex(), cycleType);
    y = *Y.Last();
 }
 
+void Multigrid::FullMultigrid(const Vector& b, Vector& x) const
+{
+   MFEM_ASSERT(NumLevels() > 0, "");
+   CheckComm();
+   const int finest = GetFinestLevelIndex();
+
+   // Restrict the right-hand side to all levels
+   *X.Last() = b;
+   for (int level = finest; level > 0; level--)
+   {
+      GetProlongationAtLevel(level - 1)->MultTranspose(*X[level],
+                                                       *X[level - 1]);
+   }
+
+   // Solve on the coarse level, then prolongate and improve with one cycle
+   Cycle(0, cycleType);
+   for (int level = 1; level <= finest; level++)
+   {
+      GetProlongationAtLevel(level - 1)->Mult(*Y[level - 1], *Y[level]);
+      Cycle(level, cycleType);
+   }
+   x = *Y.Last();
+}
+
 void Multigrid::SetOperator(const Operator& op)
 {
    MFEM_ABORT("SetOperator not supported in Multigrid");
@@ -174,19 +253,48 @@ void Multigrid::SmoothingStep(int level, bool transpose) const
    add(*Y[level], 1.0, *Z[level], *Y[level]);             // x = x + S (b - A x)
 }
 
-void Multigrid::Cycle(int level) const
+void Multigrid::Smooth(int level, int steps, bool transpose) const
 {
-   if (level == 0)
+   if (maxSmoothingSteps <= steps)
    {
-      GetSmootherAtLevel(level)->Mult(*X[level], *Y[level]);
+      for (int i = 0; i < steps; i++)
+      {
+         SmoothingStep(level, transpose);
+      }
       return;
    }
 
-   for (int i = 0; i < preSmoothingSteps; i++)
+   double r_prev = 0.0;
+   for (int i = 0; i < maxSmoothingSteps; i++)
+   {
+      GetOperatorAtLevel(level)->Mult(*Y[level], *R[level]); // r = A x
+      subtract(*X[level], *R[level], *R[level]);             // r = b - A x
+      const double r_norm = sqrt(Dot(*R[level], *R[level]));
+      // Stop after the minimum number of steps once the reduction stalls
+      if (i >= steps && r_norm > smoothingStallRatio * r_prev) { break; }
+      r_prev = r_norm;
+      if (transpose)
+      {
+         GetSmootherAtLevel(level)->MultTranspose(*R[level], *Z[level]);
+      }
+      else
+      {
+         GetSmootherAtLevel(level)->Mult(*R[level], *Z[level]);
+      }
+      add(*Y[level], 1.0, *Z[level], *Y[level]);
+   }
+}
+
+void Multigrid::Cycle(int level, CycleType type) const
+{
+   if (level == 0)
    {
-      SmoothingStep(level, false);
+      GetSmootherAtLevel(level)->Mult(*X[level], *Y[level]);
+      return;
    }
 
+   Smooth(level, preSmoothingSteps, false);
+
    // Compute residual
    GetOperatorAtLevel(level)->Mult(*Y[level], *R[level]);
    subtract(*X[level], *R[level], *R[level]);
@@ -198,14 +306,23 @@ void Multigrid::Cycle(int level) const
    *Y[level - 1] = 0.0;
 
    // Corrections
-   int corrections = 1;
-   if (cycleType == CycleType::WCYCLE)
-   {
-      corrections = 2;
-   }
-   for (int correction = 0; correction < corrections; ++correction)
+   switch (type)
    {
-      Cycle(level - 1);
+      case CycleType::VCYCLE:
+         Cycle(level - 1, type);
+         break;
+      case CycleType::WCYCLE:
+         Cycle(level - 1, type);
+         Cycle(level - 1, type);
+         break;
+      case CycleType::FCYCLE:
+         Cycle(level - 1, type);
+         Cycle(level - 1, CycleType::VCYCLE);
+         break;
+      case CycleType::KCYCLE:
+         if (level - 1 == 0) { Cycle(level - 1, type); }
+         else { KCycleCorrection(level - 1); }
+         break;
    }
 
    // Prolongate
@@ -215,10 +332,76 @@ void Multigrid::Cycle(int level) const
    *Y[level] += *R[level];
 
    // Post-smooth
-   for (int i = 0; i < postSmoothingSteps; i++)
+   Smooth(level, postSmoothingSteps, true);
+}
+
+void Multigrid::KCycleCorrection(int level) const
+{
+   if (KR.Size() != NumLevels())
+   {
+      KR.SetSize(NumLevels(), NULL);
+      KC.SetSize(NumLevels(), NULL);
+      KV.SetSize(NumLevels(), NULL);
+      KD.SetSize(NumLevels(), NULL);
+   }
+   if (!KR[level])
+   {
+      const int n = X[level]->Size();
+      KR[level] = new Vector(n);
+      KC[level] = new Vector(n);
+      KV[level] = new Vector(n);
+      KD[level] = new Vector(n);
+   }
+   const Operator *A = GetOperatorAtLevel(level);
+   Vector &r = *KR[level], &c = *KC[level], &v = *KV[level], &d = *KD[level];
+   Vector &w = *Z[level];
+
+   // First iteration: c = B r, with the K-cycle B on this level
+   r = *X[level];
+   Cycle(level, CycleType::KCYCLE);
+   c = *Y[level];
+   A->Mult(c, v);
+   const double rho1 = Dot(c, v);
+   const double alpha1 = Dot(c, r);
+   if (rho1 <= 0.0)
+   {
+      return; // keep y = c
+   }
+   const double r_norm = sqrt(Dot(r, r));
+   r.Add(-alpha1/rho1, v);
+   const double r2_norm = sqrt(Dot(r, r));
+   if (r2_norm <= 0.25*r_norm)
+   {
+      *Y[level] = c;
+      *Y[level] *= alpha1/rho1;
+      return;
+   }
+
+   // Second iteration: d = B r2, orthogonalized against c
+   *X[level] = r;
+   *Y[level] = 0.0;
+   Cycle(level, CycleType::KCYCLE);
+   d = *Y[level];
+   A->Mult(d, w);
+   const double gamma = Dot(d, v);
+   const double beta = Dot(d, w);
+   const double alpha2 = Dot(d, r);
+   const double rho2 = beta - gamma*gamma/rho1;
+   if (rho2 <= 0.0)
    {
-      SmoothingStep(level, true);
+      *Y[level] = c;
+      *Y[level] *= alpha1/rho1;
+      return;
    }
+   add(alpha1/rho1 - gamma*alpha2/(rho1*rho2), c, alpha2/rho2, d, *Y[level]);
+}
+
+double Multigrid::Dot(const Vector& x, const Vector& y) const
+{
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL) { return InnerProduct(comm, x, y); }
+#endif
+   return x * y;
 }
 
 const Operator* Multigrid::GetProlongationAtLevel(int level) const
@@ -226,6 +409,17 @@ const Operator* Multigrid::GetProlongationAtLevel(int level) const
    return prolongations[level];
 }
 
+GeometricMultigrid::GeometricMultigrid(
+   const FiniteElementSpaceHierarchy& fespaces_)
+   : Multigrid(), fespaces(fespaces_)
+{
+#ifdef MFEM_USE_MPI
+   const ParFiniteElementSpace *pfes =
+      dynamic_cast<const ParFiniteElementSpace*>(&fespaces.GetFinestFESpace());
+   if (pfes) { comm = pfes->GetComm(); }
+#endif
+}
+
 GeometricMultigrid::~GeometricMultigrid()
 {
    for (int i = 0; i < bfs.Size(); ++i)
@@ -261,4 +455,168 @@ const Operator* GeometricMultigrid::GetProlongationAtLevel(int level) const
    return fespaces.GetProlongationAtLevel(level);
 }
 
+#ifdef MFEM_USE_MPI
+
+PMultigridSolver::PMultigridSolver(ParBilinearForm &a_,
+                                   const Array<int> &ess_bdr_,
+                                   int coarse_order)
+   : Multigrid(), a(a_), smoother_order(2), fespaces(NULL), coarse_lor(NULL),
+     levels_valid(false)
+{
+   ess_bdr_.Copy(ess_bdr);
+
+   ParFiniteElementSpace &fine_fes = *a.ParFESpace();
+   comm = fine_fes.GetComm();
+   const H1_FECollection *fine_fec =
+      dynamic_cast<const H1_FECollection*>(fine_fes.FEColl());
+   MFEM_VERIFY(fine_fec, "PMultigridSolver requires an H1 space");
+   MFEM_VERIFY(!fine_fes.IsVariableOrder(),
+               "variable order spaces are not supported");
+   MFEM_VERIFY(a.GetAssemblyLevel() == AssemblyLevel::PARTIAL,
+               "the form must use partial assembly");
+   MFEM_VERIFY(a.GetBBFI()->Size() == 0 && a.GetFBFI()->Size() == 0 &&
+               a.GetBFBFI()->Size() == 0,
+               "only domain integrators are supported");
+
+   const int fine_order = fine_fes.GetMaxElementOrder();
+   MFEM_VERIFY(coarse_order >= 1 && coarse_order < fine_order,
+               "the coarse order must be between 1 and the fine order - 1");
+   // Halve the order down to the coarse order, the levels go from coarse to
+   // fine
+   for (int p = fine_order; p > coarse_order; p = std::max(p/2, coarse_order))
+   {
+      orders.Append(p);
+   }
+   orders.Append(coarse_order);
+   const int nlevels = orders.Size();
+   for (int l = 0; l < nlevels/2; l++)
+   {
+      std::swap(orders[l], orders[nlevels - 1 - l]);
+   }
+
+   ParMesh *pmesh = fine_fes.GetParMesh();
+   const int dim = pmesh->Dimension();
+   const int vdim = fine_fes.GetVDim();
+   const int ordering = fine_fes.GetOrdering();
+   for (int l = 0; l < nlevels - 1; l++)
+   {
+      fecs.Append(new H1_FECollection(orders[l], dim,
+                                      fine_fec->GetBasisType()));
+   }
+   fespaces = new ParFiniteElementSpaceHierarchy(
+      pmesh, new ParFiniteElementSpace(pmesh, fecs[0], vdim, ordering),
+      false, true);
+   for (int l = 1; l < fecs.Size(); l++)
+   {
+      fespaces->AddOrderRefinedLevel(fecs[l], vdim, ordering);
+   }
+   Operator *P = new TrueTransferOperator(fespaces->GetFinestFESpace(),
+                                          fine_fes);
+   fespaces->AddLevel(pmesh, &fine_fes, P, false, false, true);
+
+   height = width = fine_fes.GetTrueVSize();
+}
+
+PMultigridSolver::~PMultigridSolver()
+{
+   for (int l = 0; l < forms.Size(); l++) { delete forms[l]; }
+   for (int l = 0; l < ess_tdofs.Size(); l++) { delete ess_tdofs[l]; }
+   delete coarse_lor;
+   delete fespaces;
+   for (int l = 0; l < fecs.Size(); l++) { delete fecs[l]; }
+}
+
+void PMultigridSolver::Setup()
+{
+   const int nlevels = fespaces->GetNumLevels();
+   const bool first_setup = (NumLevels() == 0);
+   Array<BilinearFormIntegrator*> &integs = *a.GetDBFI();
+
+   if (first_setup)
+   {
+      for (int l = 0; l < nlevels - 1; l++)
+      {
+         ParFiniteElementSpace &fes = fespaces->GetFESpaceAtLevel(l);
+         ParBilinearForm *form = new ParBilinearForm(&fes);
+         form->UseExternalIntegrators();
+         for (int i = 0; i < integs.Size(); i++)
+         {
+            form->AddDomainIntegrator(integs[i]);
+         }
+         // The coarse form is only used by the LOR discretization, the
+         // intermediate levels use element assembly
+         if (l > 0) { form->SetAssemblyLevel(AssemblyLevel::ELEMENT); }
+         forms.Append(form);
+         ess_tdofs.Append(new Array<int>);
+         fes.GetEssentialTrueDofs(ess_bdr, *ess_tdofs.Last());
+      }
+      ess_tdofs.Append(new Array<int>);
+      a.ParFESpace()->GetEssentialTrueDofs(ess_bdr, *ess_tdofs.Last());
+   }
+
+   // Coarse level: BoomerAMG on the LOR discretization
+   delete coarse_lor;
+   coarse_lor = new ParLORDiscretization(*forms[0], *ess_tdofs[0]);
+   auto *coarse_solver = new LORSolver<HypreBoomerAMG>(*coarse_lor);
+   coarse_solver->GetSolver().SetPrintLevel(0);
+   if (first_setup)
+   {
+      AddLevel(&coarse_lor->GetAssembledMatrix(), coarse_solver, false, true);
+   }
+   else
+   {
+      operators[0] = &coarse_lor->GetAssembledMatrix();
+      delete smoothers[0];
+      smoothers[0] = coarse_solver;
+   }
+
+   // The integrators keep the partial assembly data of the last assembled
+   // space, so each level is assembled right before computing its diagonal
+   // and smoother, and the fine form is assembled last.
+   for (int l = 1; l < nlevels; l++)
+   {
+      const bool fine = (l == nlevels - 1);
+      ParBilinearForm &form = fine ? a : *forms[l];
+      form.Assemble();
+      if (first_setup)
+      {
+         OperatorPtr op;
+         op.SetType(Operator::ANY_TYPE);
+         form.FormSystemMatrix(*ess_tdofs[l], op);
+         op.SetOperatorOwner(false);
+         AddLevel(op.Ptr(), NULL, true, true);
+      }
+      Vector diag(form.ParFESpace()->GetTrueVSize());
+      form.AssembleDiagonal(diag);
+      delete smoothers[l];
+      smoothers[l] = new OperatorChebyshevSmoother(*operators[l], diag,
+                                                   *ess_tdofs[l],
+                                                   smoother_order, comm);
+   }
+   levels_valid = true;
+}
+
+void PMultigridSolver::Mult(const Vector &x, Vector &y) const
+{
+   if (!levels_valid)
+   {
+      // The levels are set up lazily, on the first application
+      const_cast<PMultigridSolver*>(this)->Setup();
+   }
+   Multigrid::Mult(x, y);
+}
+
+void PMultigridSolver::SetOperator(const Operator &op)
+{
+   MFEM_VERIFY(op.Height() == height && op.Width() == width,
+               "invalid operator size");
+}
+
+const Operator* PMultigridSolver::GetProlongationAtLevel(int level) const
+{
+   return fespaces->GetProlongationAtLevel(level);
+}
+
+#endif // MFEM_USE_MPI
+
 } // namespace mfem
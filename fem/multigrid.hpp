@@ -18,6 +18,11 @@
 #include "../linalg/operator.hpp"
 #include "../linalg/handle.hpp"
 
+#ifdef MFEM_USE_MPI
+#include "pbilinearform.hpp"
+#include "lor/lor.hpp"
+#endif
+
 namespace mfem
 {
 
@@ -28,7 +33,14 @@ public:
    enum class CycleType
    {
       VCYCLE,
-      WCYCLE
+      WCYCLE,
+      /// An F-cycle on the coarser level followed by a V-cycle.
+      FCYCLE,
+      /** @brief Krylov-accelerated cycle: the coarse corrections use two
+          iterations of flexible CG preconditioned by the K-cycle on the
+          coarser level, see Notay and Vassilevski, "Recursive Krylov-based
+          multigrid cycles", Numer. Linear Algebra Appl., 15 (2008). */
+      KCYCLE
    };
 
 protected:
@@ -44,10 +56,21 @@ protected:
    int preSmoothingSteps;
    int postSmoothingSteps;
 
+   /// Adaptive smoothing, disabled if maxSmoothingSteps is 0.
+   int maxSmoothingSteps;
+   double smoothingStallRatio;
+
+#ifdef MFEM_USE_MPI
+   /// Communicator for the inner products, MPI_COMM_NULL in serial.
+   MPI_Comm comm;
+#endif
+
    mutable Array<Vector*> X;
    mutable Array<Vector*> Y;
    mutable Array<Vector*> R;
    mutable Array<Vector*> Z;
+   /// Work vectors of the K-cycle, allocated on first use.
+   mutable Array<Vector*> KR, KC, KV, KD;
 
 public:
    /// Constructs an empty multigrid hierarchy.
@@ -98,6 +121,35 @@ public:
    void SetCycleType(CycleType cycleType_, int preSmoothingSteps_,
                      int postSmoothingSteps_);
 
+   /** @brief Enable adaptive smoothing: on each level, up to @a max_steps
+       smoothing steps are done, stopping after the number of pre- or
+       post-smoothing steps set by SetCycleType() once a step reduces the
+       residual norm by less than the factor @a stall_ratio.
+
+       The cycle is then no longer a fixed linear operator, so it should be
+       used with a flexible Krylov method, e.g. FGMRESSolver. Use
+       @a max_steps = 0 to disable. */
+   void SetAdaptiveSmoothing(int max_steps, double stall_ratio = 0.9);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Set the communicator used for the inner products of the K-cycle
+       and of the adaptive smoothing.
+
+       By default, the communicator is the one of the first HypreParMatrix
+       operator, or of the finest space of a GeometricMultigrid. When MPI runs
+       with several ranks, the adaptive smoothing and the K-cycle require a
+       communicator, e.g. MPI_COMM_SELF for problems local to each rank. */
+   void SetComm(MPI_Comm comm_) { comm = comm_; }
+#endif
+
+   /** @brief Compute an approximate solution @a x of A x = @a b with full
+       multigrid (FMG), e.g. as an initial guess for a Krylov solver.
+
+       The right-hand side is restricted to all levels, the coarse problem is
+       solved, and on each finer level the prolongated solution is improved by
+       one cycle of the current type. */
+   void FullMultigrid(const Vector& b, Vector& x) const;
+
    /// Application of the multigrid as a preconditioner
    virtual void Mult(const Vector& x, Vector& y) const override;
 
@@ -108,8 +160,24 @@ private:
    /// Application of a smoothing step at particular level
    void SmoothingStep(int level, bool transpose) const;
 
-   /// Application of a multigrid cycle at particular level
-   void Cycle(int level) const;
+   /// Pre- or post-smoothing at particular level, possibly adaptive
+   void Smooth(int level, int steps, bool transpose) const;
+
+   /// Application of a multigrid cycle of the given type at particular level
+   void Cycle(int level, CycleType type) const;
+
+   /// Coarse correction of the K-cycle, approximately solving at @a level
+   void KCycleCorrection(int level) const;
+
+   /// Inner product, global in parallel
+   double Dot(const Vector& x, const Vector& y) const;
+
+   /// Take the communicator of @a op if it is a HypreParMatrix, see SetComm()
+   void SetCommFromOperator(const Operator *op);
+
+   /** @brief Check that the communicator is set if the inner products are
+       used in parallel, see SetComm(). */
+   void CheckComm() const;
 
    /// Returns prolongation operator at given level
    virtual const Operator* GetProlongationAtLevel(int level) const;
@@ -126,8 +194,7 @@ protected:
 public:
    /** Construct an empty multigrid object for the given finite element space
        hierarchy @a fespaces_ */
-   GeometricMultigrid(const FiniteElementSpaceHierarchy& fespaces_)
-      : Multigrid(), fespaces(fespaces_) { }
+   GeometricMultigrid(const FiniteElementSpaceHierarchy& fespaces_);
 
    /// Destructor
    virtual ~GeometricMultigrid();
@@ -145,6 +212,85 @@ private:
    virtual const Operator* GetProlongationAtLevel(int level) const override;
 };
 
+#ifdef MFEM_USE_MPI
+
+/** @brief Matrix-free p-multigrid solver for a ParBilinearForm with partial
+    assembly on an H1 space.
+
+    The hierarchy of orders p, p/2, p/4, ..., down to the coarse order (1 by
+    default) is built automatically on the mesh of the form, with the same
+    basis type, vector dimension and ordering. The fine level uses the given
+    form, the intermediate levels use element assembly, and all levels above
+    the coarse one are smoothed with an OperatorChebyshevSmoother with an
+    estimate of the largest eigenvalue. The coarse level is solved by one
+    BoomerAMG V-cycle on its low-order refined (LOR) discretization, see
+    ParLORDiscretization.
+
+    The coarse levels share the domain integrators of the form, which must not
+    have boundary or face integrators. The levels are set up on the first call
+    to Mult() (or by Setup()) and are reused by the following calls, e.g. in
+    the following time steps, until Reset() is called, e.g. after a change of
+    the coefficients. */
+class PMultigridSolver : public Multigrid
+{
+protected:
+   ParBilinearForm &a;
+   Array<int> ess_bdr;
+   int smoother_order;
+
+   /// The orders of the levels, from coarse to fine.
+   Array<int> orders;
+   Array<FiniteElementCollection*> fecs;
+   ParFiniteElementSpaceHierarchy *fespaces;
+
+   /// Forms and essential true dofs of the coarse levels.
+   Array<ParBilinearForm*> forms;
+   Array<Array<int>*> ess_tdofs;
+   ParLORDiscretization *coarse_lor;
+
+   bool levels_valid;
+
+public:
+   /** @brief Construct a p-multigrid solver for the form @a a_, with
+       essential boundary attributes marked in @a ess_bdr_, and order
+       @a coarse_order on the coarse level. */
+   PMultigridSolver(ParBilinearForm &a_, const Array<int> &ess_bdr_,
+                    int coarse_order = 1);
+
+   virtual ~PMultigridSolver();
+
+   /// Set the order of the Chebyshev smoothers, default 2.
+   void SetSmootherOrder(int order) { smoother_order = order; Reset(); }
+
+   /** @brief Set up (or update) the level operators, smoothers and the coarse
+       solver.
+
+       Since the integrators are shared with the coarse levels, this method
+       assembles the fine form again after the coarse levels. */
+   void Setup();
+
+   /// Set up the levels again in the next call to Mult().
+   void Reset() { levels_valid = false; }
+
+   /// Return the orders of the levels, from coarse to fine.
+   const Array<int> &GetOrders() const { return orders; }
+
+   /// Return the hierarchy of spaces, from coarse to fine.
+   ParFiniteElementSpaceHierarchy &GetFESpaceHierarchy() { return *fespaces; }
+
+   /// Apply one multigrid cycle, setting up the levels if needed.
+   virtual void Mult(const Vector &x, Vector &y) const override;
+
+   /** @brief The fine operator is defined by the form, this method only
+       checks the size of @a op. */
+   virtual void SetOperator(const Operator &op) override;
+
+private:
+   virtual const Operator* GetProlongationAtLevel(int level) const override;
+};
+
+#endif // MFEM_USE_MPI
+
 } // namespace mfem
 
 #endif
@@ -0,0 +1,537 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "particles.hpp"
+#include "../mesh/point_locator.hpp"
+
+#include <algorithm>
+
+namespace mfem
+{
+
+// Resize a vector with ncomp components ordered byNODES.
+static void ResizeByNodes(Vector &v, int ncomp, int old_n, int new_n)
+{
+   Vector tmp(ncomp*new_n);
+   tmp = 0.0;
+   const int n = std::min(old_n, new_n);
+   for (int c = 0; c < ncomp; c++)
+   {
+      for (int i = 0; i < n; i++) { tmp(c*new_n + i) = v(c*old_n + i); }
+   }
+   v.Swap(tmp);
+}
+
+// Gather the entries perm[k] of a vector with ncomp components ordered
+// byNODES.
+static void PermuteByNodes(Vector &v, int ncomp, int old_n,
+                           const Array<int> &perm)
+{
+   const int new_n = perm.Size();
+   Vector tmp(ncomp*new_n);
+   for (int c = 0; c < ncomp; c++)
+   {
+      for (int k = 0; k < new_n; k++)
+      {
+         tmp(c*new_n + k) = v(c*old_n + perm[k]);
+      }
+   }
+   v.Swap(tmp);
+}
+
+ParticleSet::ParticleSet(Mesh &mesh_, int nfields_)
+   : mesh(&mesh_), sdim(mesh_.SpaceDimension()), dim(mesh_.Dimension()),
+     nfields(nfields_), np(0), next_id(0), sequence(mesh_.GetSequence())
+{
+   MFEM_VERIFY(nfields >= 0, "invalid number of fields");
+   elem_offsets.SetSize(mesh->GetNE() + 1);
+   elem_offsets = 0;
+}
+
+void ParticleSet::Resize(int new_np)
+{
+   ResizeByNodes(coords, sdim, np, new_np);
+   ResizeByNodes(ref_coords, dim, np, new_np);
+   ResizeByNodes(fields, nfields, np, new_np);
+   elems.SetSize(new_np, -1);
+   ids.SetSize(new_np, -1);
+   np = new_np;
+}
+
+void ParticleSet::GetIntPoint(int i, IntegrationPoint &ip) const
+{
+   ip.x = ref_coords(i);
+   ip.y = (dim > 1) ? ref_coords(np + i) : 0.0;
+   ip.z = (dim > 2) ? ref_coords(2*np + i) : 0.0;
+   ip.weight = 0.0;
+}
+
+void ParticleSet::SetIntPoint(int i, const IntegrationPoint &ip)
+{
+   ref_coords(i) = ip.x;
+   if (dim > 1) { ref_coords(np + i) = ip.y; }
+   if (dim > 2) { ref_coords(2*np + i) = ip.z; }
+}
+
+void ParticleSet::LocateLost(Array<int> &lost)
+{
+   if (lost.Size() == 0) { return; }
+   DenseMatrix pts(sdim, lost.Size());
+   for (int k = 0; k < lost.Size(); k++)
+   {
+      for (int d = 0; d < sdim; d++) { pts(d,k) = coords(d*np + lost[k]); }
+   }
+   Array<int> lost_elems;
+   Array<IntegrationPoint> ips;
+   mesh->GetPointLocator().FindPoints(pts, lost_elems, ips);
+
+   int nlost = 0;
+   for (int k = 0; k < lost.Size(); k++)
+   {
+      const int i = lost[k];
+      elems[i] = lost_elems[k];
+      if (lost_elems[k] >= 0) { SetIntPoint(i, ips[k]); }
+      else { lost[nlost++] = i; }
+   }
+   lost.SetSize(nlost);
+}
+
+int ParticleSet::HandleLost(const Array<int> &lost)
+{
+   for (int k = 0; k < lost.Size(); k++) { elems[lost[k]] = -1; }
+   return lost.Size();
+}
+
+long long ParticleSet::ReserveIds(int n)
+{
+   const long long first = next_id;
+   next_id += n;
+   return first;
+}
+
+void ParticleSet::SortByElement()
+{
+   const int NE = mesh->GetNE();
+   elem_offsets.SetSize(NE + 1);
+   elem_offsets = 0;
+   for (int i = 0; i < np; i++)
+   {
+      if (elems[i] >= 0) { elem_offsets[elems[i] + 1]++; }
+   }
+   elem_offsets.PartialSum();
+
+   // Stable counting sort, dropping the removed particles
+   const int new_np = elem_offsets[NE];
+   Array<int> perm(new_np), pos(NE);
+   for (int e = 0; e < NE; e++) { pos[e] = elem_offsets[e]; }
+   bool sorted = (new_np == np);
+   for (int i = 0; i < np; i++)
+   {
+      if (elems[i] < 0) { continue; }
+      const int k = pos[elems[i]]++;
+      perm[k] = i;
+      sorted = sorted && (k == i);
+   }
+   if (sorted) { return; }
+
+   PermuteByNodes(coords, sdim, np, perm);
+   PermuteByNodes(ref_coords, dim, np, perm);
+   PermuteByNodes(fields, nfields, np, perm);
+   Array<int> new_elems(new_np);
+   Array<long long> new_ids(new_np);
+   for (int k = 0; k < new_np; k++)
+   {
+      new_elems[k] = elems[perm[k]];
+      new_ids[k] = ids[perm[k]];
+   }
+   Swap(elems, new_elems);
+   Swap(ids, new_ids);
+   np = new_np;
+}
+
+int ParticleSet::AddParticles(const DenseMatrix &pts,
+                              const DenseMatrix *field_vals)
+{
+   MFEM_VERIFY(pts.Height() == sdim, "invalid points matrix");
+   const int n = pts.Width();
+   MFEM_VERIFY(field_vals == NULL || (field_vals->Height() == nfields &&
+                                      field_vals->Width() == n),
+               "invalid fields matrix");
+   MFEM_VERIFY(sequence == mesh->GetSequence(),
+               "the mesh was modified, call Relocate()");
+
+   const int old_np = np;
+   Resize(np + n);
+   const long long first_id = ReserveIds(n);
+   Array<int> lost(n);
+   for (int k = 0; k < n; k++)
+   {
+      const int i = old_np + k;
+      for (int d = 0; d < sdim; d++) { coords(d*np + i) = pts(d,k); }
+      if (field_vals)
+      {
+         for (int f = 0; f < nfields; f++)
+         {
+            fields(f*np + i) = (*field_vals)(f,k);
+         }
+      }
+      ids[i] = first_id + k;
+      lost[k] = i;
+   }
+   LocateLost(lost);
+   const int removed = HandleLost(lost);
+   SortByElement();
+   return removed;
+}
+
+int ParticleSet::Relocate()
+{
+   Array<int> lost;
+   if (sequence != mesh->GetSequence())
+   {
+      // The elements changed, locate all particles from scratch
+      lost.SetSize(np);
+      for (int i = 0; i < np; i++) { lost[i] = i; }
+      sequence = mesh->GetSequence();
+   }
+   else if (np > 0)
+   {
+      const Table &el_to_el = mesh->ElementToElementTable();
+      const int NE = mesh->GetNE();
+      IsoparametricTransformation T;
+      // Newton's method starts from the previous position in the current
+      // element, and from the default initial guess in the neighbors.
+      InverseElementTransformation inv_cur, inv_nbr;
+      inv_cur.SetInitialGuessType(InverseElementTransformation::GivenPoint);
+      Vector x(sdim);
+      IntegrationPoint ip;
+      for (int i = 0; i < np; i++)
+      {
+         for (int d = 0; d < sdim; d++) { x(d) = coords(d*np + i); }
+         const int e = elems[i];
+         GetIntPoint(i, ip);
+         mesh->GetElementTransformation(e, &T);
+         inv_cur.SetTransformation(T);
+         inv_cur.SetInitialGuess(ip);
+         if (inv_cur.Transform(x, ip) == InverseElementTransformation::Inside)
+         {
+            SetIntPoint(i, ip);
+            continue;
+         }
+
+         int found = -1;
+         const int *nbrs = el_to_el.GetRow(e);
+         for (int j = 0; j < el_to_el.RowSize(e) && found < 0; j++)
+         {
+            // skip the face-neighbor elements of other ranks
+            if (nbrs[j] >= NE) { continue; }
+            mesh->GetElementTransformation(nbrs[j], &T);
+            inv_nbr.SetTransformation(T);
+            if (inv_nbr.Transform(x, ip) == InverseElementTransformation::Inside)
+            {
+               found = nbrs[j];
+            }
+         }
+         if (found >= 0)
+         {
+            elems[i] = found;
+            SetIntPoint(i, ip);
+         }
+         else
+         {
+            lost.Append(i);
+         }
+      }
+   }
+   LocateLost(lost);
+   const int removed = HandleLost(lost);
+   SortByElement();
+   return removed;
+}
+
+void ParticleSet::Interpolate(const GridFunction &gf, Vector &vals) const
+{
+   const FiniteElementSpace *fes = gf.FESpace();
+   MFEM_VERIFY(fes->GetMesh() == mesh, "incompatible mesh");
+   MFEM_VERIFY(sequence == mesh->GetSequence(),
+               "the mesh was modified, call Relocate()");
+   const int vdim = gf.VectorDim();
+   vals.SetSize(vdim*np);
+
+   IntegrationRule ir;
+   DenseMatrix elem_vals;
+   for (int e = 0; e < mesh->GetNE(); e++)
+   {
+      const int offset = elem_offsets[e];
+      const int npe = elem_offsets[e+1] - offset;
+      if (npe == 0) { continue; }
+      ir.SetSize(npe);
+      for (int j = 0; j < npe; j++) { GetIntPoint(offset + j, ir[j]); }
+      gf.GetVectorValues(*fes->GetElementTransformation(e), ir, elem_vals);
+      for (int c = 0; c < vdim; c++)
+      {
+         for (int j = 0; j < npe; j++)
+         {
+            vals(c*np + offset + j) = elem_vals(c,j);
+         }
+      }
+   }
+}
+
+void ParticleSet::Deposit(const Vector &w, GridFunction &b) const
+{
+   const FiniteElementSpace *fes = b.FESpace();
+   MFEM_VERIFY(fes->GetMesh() == mesh, "incompatible mesh");
+   MFEM_VERIFY(sequence == mesh->GetSequence(),
+               "the mesh was modified, call Relocate()");
+   const int vdim = fes->GetVDim();
+   MFEM_VERIFY(w.Size() == vdim*np, "invalid size of the weights");
+
+   Array<int> vdofs;
+   IntegrationPoint ip;
+   Vector shape;
+   DenseMatrix shapes, elem_w, elem_vec;
+   for (int e = 0; e < mesh->GetNE(); e++)
+   {
+      const int offset = elem_offsets[e];
+      const int npe = elem_offsets[e+1] - offset;
+      if (npe == 0) { continue; }
+      const FiniteElement *fe = fes->GetFE(e);
+      MFEM_VERIFY(fe->GetRangeType() == FiniteElement::SCALAR &&
+                  fe->GetMapType() == FiniteElement::VALUE,
+                  "only scalar VALUE finite elements are supported");
+      const int dof = fe->GetDof();
+
+      // elem_vec = shapes * elem_w for all particles of the element
+      shapes.SetSize(dof, npe);
+      elem_w.SetSize(npe, vdim);
+      for (int j = 0; j < npe; j++)
+      {
+         GetIntPoint(offset + j, ip);
+         shapes.GetColumnReference(j, shape);
+         fe->CalcShape(ip, shape);
+         for (int c = 0; c < vdim; c++) { elem_w(j,c) = w(c*np + offset + j); }
+      }
+      elem_vec.SetSize(dof, vdim);
+      Mult(shapes, elem_w, elem_vec);
+      fes->GetElementVDofs(e, vdofs);
+      b.AddElementVector(vdofs, elem_vec.GetData());
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+ParParticleSet::ParParticleSet(ParMesh &pmesh_, int nfields_)
+   : ParticleSet(pmesh_, nfields_), pmesh(&pmesh_), comm(pmesh_.GetComm())
+{ }
+
+long long ParParticleSet::ReserveIds(int n)
+{
+   long long loc_n = n, scan_n, glob_n;
+   MPI_Scan(&loc_n, &scan_n, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   MPI_Allreduce(&loc_n, &glob_n, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   const long long first = next_id + scan_n - loc_n;
+   next_id += glob_n;
+   return first;
+}
+
+long long ParParticleSet::GlobalNP() const
+{
+   long long loc_np = np, glob_np;
+   MPI_Allreduce(&loc_np, &glob_np, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   return glob_np;
+}
+
+// Exchange blocks of 'unit' entries per item, with item counts given per rank.
+static void ExchangeItems(MPI_Comm comm, const Array<int> &send_cnt,
+                          const Array<int> &recv_cnt, int unit,
+                          MPI_Datatype type, const void *send_buf,
+                          void *recv_buf)
+{
+   const int nranks = send_cnt.Size();
+   Array<int> sc(nranks), sd(nranks), rc(nranks), rd(nranks);
+   for (int r = 0; r < nranks; r++)
+   {
+      sc[r] = unit*send_cnt[r];
+      rc[r] = unit*recv_cnt[r];
+      sd[r] = (r == 0) ? 0 : sd[r-1] + sc[r-1];
+      rd[r] = (r == 0) ? 0 : rd[r-1] + rc[r-1];
+   }
+   MPI_Alltoallv(const_cast<void*>(send_buf), sc.GetData(), sd.GetData(), type,
+                 recv_buf, rc.GetData(), rd.GetData(), type, comm);
+}
+
+int ParParticleSet::HandleLost(const Array<int> &lost)
+{
+   int nranks, myid;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &myid);
+
+   // Bounding boxes of the local meshes of all ranks
+   Vector bb_min, bb_max, boxes(2*sdim*nranks), my_box(2*sdim);
+   mesh->GetPointLocator().GetBoundingBox(bb_min, bb_max);
+   for (int d = 0; d < sdim; d++)
+   {
+      my_box(d) = bb_min(d);
+      my_box(sdim + d) = bb_max(d);
+   }
+   MPI_Allgather(my_box.GetData(), 2*sdim, MPI_DOUBLE, boxes.GetData(),
+                 2*sdim, MPI_DOUBLE, comm);
+
+   // 1. Send the coordinates of the lost particles to the candidate ranks,
+   //    i.e. the ranks whose bounding box contains them.
+   const int nlost = lost.Size();
+   auto in_box = [&](int r, int k)
+   {
+      const double *box = boxes.GetData() + 2*sdim*r;
+      for (int d = 0; d < sdim; d++)
+      {
+         const double x = coords(d*np + lost[k]);
+         if (x < box[d] || x > box[sdim + d]) { return false; }
+      }
+      return true;
+   };
+   Array<int> send_cnt(nranks), recv_cnt(nranks);
+   send_cnt = 0;
+   for (int k = 0; k < nlost; k++)
+   {
+      for (int r = 0; r < nranks; r++)
+      {
+         if (r != myid && in_box(r, k)) { send_cnt[r]++; }
+      }
+   }
+   Array<int> send_offsets(nranks + 1), pos(nranks);
+   send_offsets[0] = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      pos[r] = send_offsets[r];
+      send_offsets[r+1] = send_offsets[r] + send_cnt[r];
+   }
+   // send_lost[j] is the index in 'lost' of the j-th point sent
+   const int nsend = send_offsets[nranks];
+   Array<int> send_lost(nsend);
+   for (int k = 0; k < nlost; k++)
+   {
+      for (int r = 0; r < nranks; r++)
+      {
+         if (r != myid && in_box(r, k)) { send_lost[pos[r]++] = k; }
+      }
+   }
+   Vector send_x(sdim*nsend);
+   for (int j = 0; j < nsend; j++)
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         send_x(j*sdim + d) = coords(d*np + lost[send_lost[j]]);
+      }
+   }
+   MPI_Alltoall(send_cnt.GetData(), 1, MPI_INT, recv_cnt.GetData(), 1, MPI_INT,
+                comm);
+   Array<int> recv_offsets(nranks + 1);
+   recv_offsets[0] = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      recv_offsets[r+1] = recv_offsets[r] + recv_cnt[r];
+   }
+   const int nrecv = recv_offsets[nranks];
+   DenseMatrix recv_x(sdim, nrecv);
+   ExchangeItems(comm, send_cnt, recv_cnt, sdim, MPI_DOUBLE, send_x.GetData(),
+                 recv_x.Data());
+
+   // 2. Locate the received points and report back which ones were found
+   Array<int> recv_elems;
+   Array<IntegrationPoint> recv_ips;
+   mesh->GetPointLocator().FindPoints(recv_x, recv_elems, recv_ips);
+   Array<int> recv_found(nrecv), send_found(nsend);
+   for (int j = 0; j < nrecv; j++) { recv_found[j] = (recv_elems[j] >= 0); }
+   ExchangeItems(comm, recv_cnt, send_cnt, 1, MPI_INT, recv_found.GetData(),
+                 send_found.GetData());
+
+   // 3. Each particle goes to the lowest rank that found it. Send the index of
+   //    the particle in the message of step 1, its id and its fields.
+   Array<int> owner(nlost);
+   owner = -1;
+   for (int r = 0; r < nranks; r++)
+   {
+      for (int j = send_offsets[r]; j < send_offsets[r+1]; j++)
+      {
+         const int k = send_lost[j];
+         if (send_found[j] && owner[k] < 0) { owner[k] = r; }
+      }
+   }
+   int removed = 0;
+   for (int k = 0; k < nlost; k++) { removed += (owner[k] < 0); }
+
+   Array<int> send_cnt2(nranks), recv_cnt2(nranks);
+   send_cnt2 = 0;
+   for (int k = 0; k < nlost; k++)
+   {
+      if (owner[k] >= 0) { send_cnt2[owner[k]]++; }
+   }
+   const int nsend2 = nlost - removed;
+   Array<int> send_idx(nsend2);
+   Array<long long> send_ids(nsend2);
+   Vector send_f(nfields*nsend2);
+   for (int r = 0, m = 0; r < nranks; r++)
+   {
+      for (int j = send_offsets[r]; j < send_offsets[r+1]; j++)
+      {
+         const int k = send_lost[j];
+         if (owner[k] != r) { continue; }
+         send_idx[m] = j - send_offsets[r];
+         send_ids[m] = ids[lost[k]];
+         for (int f = 0; f < nfields; f++)
+         {
+            send_f(m*nfields + f) = fields(f*np + lost[k]);
+         }
+         m++;
+      }
+   }
+   MPI_Alltoall(send_cnt2.GetData(), 1, MPI_INT, recv_cnt2.GetData(), 1,
+                MPI_INT, comm);
+   int nrecv2 = 0;
+   for (int r = 0; r < nranks; r++) { nrecv2 += recv_cnt2[r]; }
+   Array<int> recv_idx(nrecv2);
+   Array<long long> recv_ids(nrecv2);
+   Vector recv_f(nfields*nrecv2);
+   ExchangeItems(comm, send_cnt2, recv_cnt2, 1, MPI_INT, send_idx.GetData(),
+                 recv_idx.GetData());
+   ExchangeItems(comm, send_cnt2, recv_cnt2, 1, MPI_LONG_LONG,
+                 send_ids.GetData(), recv_ids.GetData());
+   ExchangeItems(comm, send_cnt2, recv_cnt2, nfields, MPI_DOUBLE,
+                 send_f.GetData(), recv_f.GetData());
+
+   // The lost particles leave this rank, the received ones are appended
+   for (int k = 0; k < nlost; k++) { elems[lost[k]] = -1; }
+   const int old_np = np;
+   Resize(np + nrecv2);
+   for (int r = 0, m = 0; r < nranks; r++)
+   {
+      for (int t = 0; t < recv_cnt2[r]; t++, m++)
+      {
+         const int j = recv_offsets[r] + recv_idx[m];
+         const int i = old_np + m;
+         for (int d = 0; d < sdim; d++) { coords(d*np + i) = recv_x(d,j); }
+         for (int f = 0; f < nfields; f++)
+         {
+            fields(f*np + i) = recv_f(m*nfields + f);
+         }
+         elems[i] = recv_elems[j];
+         SetIntPoint(i, recv_ips[j]);
+         ids[i] = recv_ids[m];
+      }
+   }
+   return removed;
+}
+
+#endif // MFEM_USE_MPI
+
+}
@@ -0,0 +1,194 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PARTICLES
+#define MFEM_PARTICLES
+
+#include "../config/config.hpp"
+#include "gridfunc.hpp"
+#ifdef MFEM_USE_MPI
+#include "../mesh/pmesh.hpp"
+#endif
+
+namespace mfem
+{
+
+/** @brief A set of particles located in the elements of a Mesh.
+
+    Each particle has physical coordinates, a unique id and a number of real
+    fields, e.g. a charge or velocity components. The data is stored as a
+    structure of arrays, with the particles sorted by their owning element:
+    the particles in element e have indices GetElementOffsets()[e] to
+    GetElementOffsets()[e+1]-1. The components of the coordinates and of the
+    fields are stored with Ordering::byNODES, i.e. component c of particle i
+    is at index c*GetNP()+i.
+
+    Unlike the stateless queries Mesh::FindPoints() and FindPointsGSLIB, the
+    set keeps the owning elements and reference coordinates of the particles.
+    After the coordinates are modified, Relocate() first searches the current
+    element of each particle and its face neighbors (see
+    Mesh::ElementToElementTable()), and only the remaining particles are
+    searched with Mesh::GetPointLocator().
+
+    Particles that leave the mesh are removed from the set; in parallel, see
+    ParParticleSet, they are first sent to the rank that owns them. */
+class ParticleSet
+{
+protected:
+   Mesh *mesh;
+   int sdim, dim, nfields;
+
+   /// Number of particles.
+   int np;
+
+   /// Next id to assign to a new particle.
+   long long next_id;
+
+   /// Value of Mesh::GetSequence() when the particles were located.
+   long sequence;
+
+   /// Physical coordinates, (sdim x np) ordered byNODES.
+   Vector coords;
+   /// Reference coordinates in the owning elements, (dim x np) byNODES.
+   Vector ref_coords;
+   /// Fields of the particles, (nfields x np) ordered byNODES.
+   Vector fields;
+   /// Owning elements and ids of the particles.
+   Array<int> elems;
+   Array<long long> ids;
+   /// Particles of each element in CSR format, size NE+1.
+   Array<int> elem_offsets;
+
+   /// Change the number of particles, keeping the data of the first ones.
+   void Resize(int new_np);
+
+   /// Return the reference coordinates of particle @a i in @a ip.
+   void GetIntPoint(int i, IntegrationPoint &ip) const;
+   void SetIntPoint(int i, const IntegrationPoint &ip);
+
+   /** @brief Locate the particles in @a lost with Mesh::GetPointLocator(). On
+       return, @a lost contains the particles that were not found. */
+   void LocateLost(Array<int> &lost);
+
+   /** @brief Handle the particles in @a lost that were not found in the
+       (local) mesh. Returns the number of particles removed from the set.
+
+       The particles must be marked as removed by setting their element to -1;
+       they are deleted by the following call to SortByElement(). In parallel,
+       this method is collective and may append received particles. */
+   virtual int HandleLost(const Array<int> &lost);
+
+   /// Return the first of @a n new consecutive ids.
+   virtual long long ReserveIds(int n);
+
+   /// Sort the particles by element, deleting the ones with element -1.
+   void SortByElement();
+
+public:
+   /// Create an empty particle set with @a nfields_ real fields per particle.
+   ParticleSet(Mesh &mesh_, int nfields_ = 0);
+
+   virtual ~ParticleSet() { }
+
+   /** @brief Add the particles with coordinates given by the columns of
+       @a pts, and optionally fields given by the columns of @a field_vals.
+
+       The new particles are located in the mesh. Returns the number of
+       particles removed because they are outside the mesh. */
+   int AddParticles(const DenseMatrix &pts,
+                    const DenseMatrix *field_vals = NULL);
+
+   /** @brief Update the owning elements and the reference coordinates after
+       the coordinates of the particles were modified.
+
+       Returns the number of particles removed because they left the mesh. The
+       particles are sorted by element again, so the order of the particles
+       may change, see GetIds(). */
+   int Relocate();
+
+   /// Return the number of particles.
+   int GetNP() const { return np; }
+
+   Mesh *GetMesh() const { return mesh; }
+
+   int GetNFields() const { return nfields; }
+
+   /// Physical coordinates, ordered byNODES. Call Relocate() after modifying.
+   Vector &GetCoordinates() { return coords; }
+   const Vector &GetCoordinates() const { return coords; }
+
+   /// Reference coordinates in the owning elements, ordered byNODES.
+   const Vector &GetReferenceCoordinates() const { return ref_coords; }
+
+   /// Fields of the particles, ordered byNODES.
+   Vector &GetFields() { return fields; }
+   const Vector &GetFields() const { return fields; }
+
+   /// Make @a f reference the values of field @a i of all particles.
+   void GetField(int i, Vector &f) { f.MakeRef(fields, i*np, np); }
+
+   /// Owning element of each particle.
+   const Array<int> &GetElements() const { return elems; }
+
+   /// Unique ids of the particles.
+   const Array<long long> &GetIds() const { return ids; }
+
+   /// Offsets of the particles of each element, size NE+1.
+   const Array<int> &GetElementOffsets() const { return elem_offsets; }
+
+   /** @brief Evaluate @a gf at the particles. The values are returned in
+       @a vals, of size VectorDim()*GetNP(), ordered byNODES.
+
+       The particles of each element are evaluated as one batch. */
+   void Interpolate(const GridFunction &gf, Vector &vals) const;
+
+   /** @brief Deposit the weights @a w of the particles on the dual vector
+       @a b: b_j += sum_i w_i phi_j(x_i), where phi_j are the basis functions
+       of the space of @a b.
+
+       The weights are of size VDim*GetNP(), ordered byNODES, for a space with
+       vector dimension VDim. The space must use scalar finite elements with
+       the VALUE map type. In parallel, @a b is a local dual vector which can
+       be assembled with ParGridFunction::ParallelAssemble(). */
+   void Deposit(const Vector &w, GridFunction &b) const;
+};
+
+#ifdef MFEM_USE_MPI
+
+/** @brief A set of particles distributed according to the elements of a
+    ParMesh.
+
+    Particles leaving the local mesh are sent to the ranks whose mesh bounding
+    boxes contain them, and are kept by the lowest rank that finds them. The
+    methods AddParticles() and Relocate() are collective. */
+class ParParticleSet : public ParticleSet
+{
+protected:
+   ParMesh *pmesh;
+   MPI_Comm comm;
+
+   virtual int HandleLost(const Array<int> &lost);
+   virtual long long ReserveIds(int n);
+
+public:
+   ParParticleSet(ParMesh &pmesh_, int nfields_ = 0);
+
+   MPI_Comm GetComm() const { return comm; }
+
+   /// Return the global number of particles.
+   long long GlobalNP() const;
+};
+
+#endif // MFEM_USE_MPI
+
+}
+
+#endif
@@ -123,6 +123,7 @@ void ParBilinearForm::pAllocMat()
 
 void ParBilinearForm::ParallelAssemble(OperatorHandle &A, SparseMatrix *A_local)
 {
+   MemoryUsageTag mem_tag("HypreParMatrix");
    A.Clear();
 
    if (A_local == NULL) { return; }
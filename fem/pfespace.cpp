@@ -89,6 +89,7 @@ ParNURBSExtension *ParFiniteElementSpace::MakeLocalNURBSext(
 
 void ParFiniteElementSpace::ParInit(ParMesh *pm)
 {
+   MemoryUsageTag mem_tag("FiniteElementSpace");
    pmesh = pm;
    pncmesh = NULL;
 
@@ -3286,6 +3287,8 @@ void ParFiniteElementSpace::GetTrueTransferOperator(
 
 void ParFiniteElementSpace::Update(bool want_transform)
 {
+   MFEM_PERF_FUNCTION;
+   MemoryUsageTag mem_tag("FiniteElementSpace");
    MFEM_VERIFY(!IsVariableOrder(),
                "Parallel variable order space not supported yet.");
 
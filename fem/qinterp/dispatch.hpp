@@ -57,6 +57,39 @@ void TensorDeterminants(const int NE,
                         Vector &q_det,
                         Vector &d_buff);
 
+// Tensor-product transpose of the evaluation of quadrature point values and
+// reference derivatives: dispatch function.
+template<QVectorLayout VL>
+void TensorMultTranspose(const int NE,
+                         const int vdim,
+                         const DofToQuad &maps,
+                         const unsigned eval_flags,
+                         const Vector &q_val,
+                         const Vector &q_der,
+                         Vector &e_vec);
+
+// Transpose of the evaluation of quadrature point values and reference
+// derivatives: non-tensor product version.
+void GenericMultTranspose(const int NE,
+                          const int vdim,
+                          const QVectorLayout q_layout,
+                          const DofToQuad &maps,
+                          const unsigned eval_flags,
+                          const Vector &q_val,
+                          const Vector &q_der,
+                          Vector &e_vec);
+
+// Transpose of the map from reference to physical derivatives at quadrature
+// points.
+void PhysDerivativesTranspose(const int NE,
+                              const int vdim,
+                              const int dim,
+                              const int nq,
+                              const QVectorLayout q_layout,
+                              const GeometricFactors &geom,
+                              const Vector &q_phys,
+                              Vector &q_ref);
+
 } // namespace quadrature_interpolator
 
 } // namespace internal
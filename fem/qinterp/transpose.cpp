@@ -0,0 +1,526 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../quadinterpolator.hpp"
+#include "dispatch.hpp"
+#include "../../general/forall.hpp"
+#include "../../linalg/dtensor.hpp"
+#include "../../linalg/kernels.hpp"
+#include "../kernels.hpp"
+
+namespace mfem
+{
+
+namespace internal
+{
+
+namespace quadrature_interpolator
+{
+
+// Template compute kernel for the transpose of Values and Derivatives in 2D:
+// tensor product version. Computes e_vec = B^T q_val + G^T q_der.
+template<QVectorLayout Q_LAYOUT,
+         int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0,
+         int T_NBZ = 1, int MAX_D1D = 0, int MAX_Q1D = 0>
+static void MultTranspose2D(const int NE,
+                            const double *b_,
+                            const double *g_,
+                            const bool use_val,
+                            const double *qv_,
+                            const bool use_der,
+                            const double *qd_,
+                            double *y_,
+                            const int vdim = 0,
+                            const int d1d = 0,
+                            const int q1d = 0)
+{
+   static constexpr int NBZ = T_NBZ ? T_NBZ : 1;
+
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+
+   const auto b = Reshape(b_, Q1D, D1D);
+   const auto g = Reshape(g_, Q1D, D1D);
+   const auto val = Q_LAYOUT == QVectorLayout::byNODES ?
+                    Reshape(qv_, Q1D, Q1D, VDIM, NE):
+                    Reshape(qv_, VDIM, Q1D, Q1D, NE);
+   const auto der = Q_LAYOUT == QVectorLayout::byNODES ?
+                    Reshape(qd_, Q1D, Q1D, VDIM, 2, NE):
+                    Reshape(qd_, VDIM, 2, Q1D, Q1D, NE);
+   auto y = Reshape(y_, D1D, D1D, VDIM, NE);
+
+   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      const int VDIM = T_VDIM ? T_VDIM : vdim;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr bool by_vdim = Q_LAYOUT == QVectorLayout::byVDIM;
+
+      const int tidz = MFEM_THREAD_ID(z);
+      MFEM_SHARED double BG[2][MQ1*MD1];
+      kernels::internal::LoadBG<MD1,MQ1>(D1D,Q1D,b,g,BG);
+      DeviceMatrix B(BG[0], D1D, Q1D);
+      DeviceMatrix G(BG[1], D1D, Q1D);
+
+      MFEM_SHARED double s_QQ[3][NBZ][MQ1*MQ1];
+      DeviceMatrix QQ0(s_QQ[0][tidz], Q1D, Q1D);
+      DeviceMatrix QQ1(s_QQ[1][tidz], Q1D, Q1D);
+      DeviceMatrix QQ2(s_QQ[2][tidz], Q1D, Q1D);
+
+      MFEM_SHARED double s_DQ[2][NBZ][MD1*MQ1];
+      DeviceMatrix DQ0(s_DQ[0][tidz], D1D, Q1D);
+      DeviceMatrix DQ1(s_DQ[1][tidz], D1D, Q1D);
+
+      for (int c = 0; c < VDIM; c++)
+      {
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         {
+            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            {
+               double u = 0.0, ux = 0.0, uy = 0.0;
+               if (use_val) { u = by_vdim ? val(c,qx,qy,e) : val(qx,qy,c,e); }
+               if (use_der)
+               {
+                  ux = by_vdim ? der(c,0,qx,qy,e) : der(qx,qy,c,0,e);
+                  uy = by_vdim ? der(c,1,qx,qy,e) : der(qx,qy,c,1,e);
+               }
+               QQ0(qx,qy) = u;
+               QQ1(qx,qy) = ux;
+               QQ2(qx,qy) = uy;
+            }
+         }
+         MFEM_SYNC_THREAD;
+         // contract in x: DQ0 collects the terms multiplied by B(dy,qy), DQ1
+         // the ones multiplied by G(dy,qy)
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         {
+            MFEM_FOREACH_THREAD(dx,x,D1D)
+            {
+               double u = 0.0;
+               double v = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double bx = B(dx,qx);
+                  u += bx * QQ0(qx,qy) + G(dx,qx) * QQ1(qx,qy);
+                  v += bx * QQ2(qx,qy);
+               }
+               DQ0(dx,qy) = u;
+               DQ1(dx,qy) = v;
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dy,y,D1D)
+         {
+            MFEM_FOREACH_THREAD(dx,x,D1D)
+            {
+               double u = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  u += B(dy,qy) * DQ0(dx,qy) + G(dy,qy) * DQ1(dx,qy);
+               }
+               y(dx,dy,c,e) = u;
+            }
+         }
+         MFEM_SYNC_THREAD;
+      }
+   });
+}
+
+// Template compute kernel for the transpose of Values and Derivatives in 3D:
+// tensor product version. Computes e_vec = B^T q_val + G^T q_der.
+template<QVectorLayout Q_LAYOUT,
+         int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0,
+         int MAX_D1D = 0, int MAX_Q1D = 0>
+static void MultTranspose3D(const int NE,
+                            const double *b_,
+                            const double *g_,
+                            const bool use_val,
+                            const double *qv_,
+                            const bool use_der,
+                            const double *qd_,
+                            double *y_,
+                            const int vdim = 0,
+                            const int d1d = 0,
+                            const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+
+   const auto b = Reshape(b_, Q1D, D1D);
+   const auto g = Reshape(g_, Q1D, D1D);
+   const auto val = Q_LAYOUT == QVectorLayout::byNODES ?
+                    Reshape(qv_, Q1D, Q1D, Q1D, VDIM, NE):
+                    Reshape(qv_, VDIM, Q1D, Q1D, Q1D, NE);
+   const auto der = Q_LAYOUT == QVectorLayout::byNODES ?
+                    Reshape(qd_, Q1D, Q1D, Q1D, VDIM, 3, NE):
+                    Reshape(qd_, VDIM, 3, Q1D, Q1D, Q1D, NE);
+   auto y = Reshape(y_, D1D, D1D, D1D, VDIM, NE);
+
+   MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      const int VDIM = T_VDIM ? T_VDIM : vdim;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr bool by_vdim = Q_LAYOUT == QVectorLayout::byVDIM;
+
+      MFEM_SHARED double BG[2][MQ1*MD1];
+      kernels::internal::LoadBG<MD1,MQ1>(D1D,Q1D,b,g,BG);
+      DeviceMatrix B(BG[0], D1D, Q1D);
+      DeviceMatrix G(BG[1], D1D, Q1D);
+
+      MFEM_SHARED double sm0[4][MQ1*MQ1*MQ1];
+      MFEM_SHARED double sm1[3][MQ1*MQ1*MQ1];
+      DeviceTensor<3> QQQ0(sm0[0], Q1D, Q1D, Q1D);
+      DeviceTensor<3> QQQ1(sm0[1], Q1D, Q1D, Q1D);
+      DeviceTensor<3> QQQ2(sm0[2], Q1D, Q1D, Q1D);
+      DeviceTensor<3> QQQ3(sm0[3], Q1D, Q1D, Q1D);
+      DeviceTensor<3> DQQ0(sm1[0], D1D, Q1D, Q1D);
+      DeviceTensor<3> DQQ1(sm1[1], D1D, Q1D, Q1D);
+      DeviceTensor<3> DQQ2(sm1[2], D1D, Q1D, Q1D);
+      DeviceTensor<3> DDQ0(sm0[0], D1D, D1D, Q1D);
+      DeviceTensor<3> DDQ1(sm0[1], D1D, D1D, Q1D);
+
+      for (int c = 0; c < VDIM; ++c)
+      {
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
+         {
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
+            {
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
+               {
+                  double u = 0.0, ux = 0.0, uy = 0.0, uz = 0.0;
+                  if (use_val)
+                  {
+                     u = by_vdim ? val(c,qx,qy,qz,e) : val(qx,qy,qz,c,e);
+                  }
+                  if (use_der)
+                  {
+                     ux = by_vdim ? der(c,0,qx,qy,qz,e) : der(qx,qy,qz,c,0,e);
+                     uy = by_vdim ? der(c,1,qx,qy,qz,e) : der(qx,qy,qz,c,1,e);
+                     uz = by_vdim ? der(c,2,qx,qy,qz,e) : der(qx,qy,qz,c,2,e);
+                  }
+                  QQQ0(qx,qy,qz) = u;
+                  QQQ1(qx,qy,qz) = ux;
+                  QQQ2(qx,qy,qz) = uy;
+                  QQQ3(qx,qy,qz) = uz;
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         // contract in x: DQQ0 collects the terms multiplied by B(dy,qy) and
+         // B(dz,qz), DQQ1 by G(dy,qy), DQQ2 by G(dz,qz)
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
+         {
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
+            {
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  double u = 0.0;
+                  double v = 0.0;
+                  double w = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double bx = B(dx,qx);
+                     u += bx * QQQ0(qx,qy,qz) + G(dx,qx) * QQQ1(qx,qy,qz);
+                     v += bx * QQQ2(qx,qy,qz);
+                     w += bx * QQQ3(qx,qy,qz);
+                  }
+                  DQQ0(dx,qy,qz) = u;
+                  DQQ1(dx,qy,qz) = v;
+                  DQQ2(dx,qy,qz) = w;
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         // contract in y: DDQ0 collects the terms multiplied by B(dz,qz), DDQ1
+         // the ones multiplied by G(dz,qz)
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  double u = 0.0;
+                  double v = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     const double by = B(dy,qy);
+                     u += by * DQQ0(dx,qy,qz) + G(dy,qy) * DQQ1(dx,qy,qz);
+                     v += by * DQQ2(dx,qy,qz);
+                  }
+                  DDQ0(dx,dy,qz) = u;
+                  DDQ1(dx,dy,qz) = v;
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  double u = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     u += B(dz,qz) * DDQ0(dx,dy,qz) + G(dz,qz) * DDQ1(dx,dy,qz);
+                  }
+                  y(dx,dy,dz,c,e) = u;
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+      }
+   });
+}
+
+// Tensor-product transpose of the evaluation of quadrature point values and
+// reference derivatives: dispatch function.
+template<QVectorLayout L>
+void TensorMultTranspose(const int NE,
+                         const int vdim,
+                         const DofToQuad &maps,
+                         const unsigned eval_flags,
+                         const Vector &q_val,
+                         const Vector &q_der,
+                         Vector &e_vec)
+{
+   using QI = QuadratureInterpolator;
+
+   if (NE == 0) { return; }
+   const int dim = maps.FE->GetDim();
+   const int D1D = maps.ndof;
+   const int Q1D = maps.nqpt;
+   const bool V = eval_flags & QI::VALUES;
+   const bool D = eval_flags & QI::DERIVATIVES;
+   const double *B = maps.B.Read();
+   const double *G = maps.G.Read();
+   const double *QV = V ? q_val.Read() : nullptr;
+   const double *QD = D ? q_der.Read() : nullptr;
+   double *Y = e_vec.Write();
+
+   const int id = (vdim<<8) | (D1D<<4) | Q1D;
+
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x122: return MultTranspose2D<L,1,2,2,16>(NE,B,G,V,QV,D,QD,Y);
+         case 0x123: return MultTranspose2D<L,1,2,3,16>(NE,B,G,V,QV,D,QD,Y);
+         case 0x133: return MultTranspose2D<L,1,3,3,8>(NE,B,G,V,QV,D,QD,Y);
+         case 0x134: return MultTranspose2D<L,1,3,4,8>(NE,B,G,V,QV,D,QD,Y);
+         case 0x144: return MultTranspose2D<L,1,4,4,4>(NE,B,G,V,QV,D,QD,Y);
+         case 0x145: return MultTranspose2D<L,1,4,5,4>(NE,B,G,V,QV,D,QD,Y);
+         case 0x155: return MultTranspose2D<L,1,5,5,2>(NE,B,G,V,QV,D,QD,Y);
+         case 0x156: return MultTranspose2D<L,1,5,6,2>(NE,B,G,V,QV,D,QD,Y);
+
+         case 0x222: return MultTranspose2D<L,2,2,2,16>(NE,B,G,V,QV,D,QD,Y);
+         case 0x223: return MultTranspose2D<L,2,2,3,8>(NE,B,G,V,QV,D,QD,Y);
+         case 0x233: return MultTranspose2D<L,2,3,3,2>(NE,B,G,V,QV,D,QD,Y);
+         case 0x234: return MultTranspose2D<L,2,3,4,4>(NE,B,G,V,QV,D,QD,Y);
+         case 0x244: return MultTranspose2D<L,2,4,4,2>(NE,B,G,V,QV,D,QD,Y);
+         case 0x245: return MultTranspose2D<L,2,4,5,2>(NE,B,G,V,QV,D,QD,Y);
+         default:
+         {
+            constexpr int MD = MAX_D1D;
+            constexpr int MQ = MAX_Q1D;
+            MFEM_VERIFY(D1D <= MD, "Orders higher than " << MD-1
+                        << " are not supported!");
+            MFEM_VERIFY(Q1D <= MQ, "Quadrature rules with more than "
+                        << MQ << " 1D points are not supported!");
+            return MultTranspose2D<L,0,0,0,0,MD,MQ>(NE,B,G,V,QV,D,QD,Y,
+                                                    vdim,D1D,Q1D);
+         }
+      }
+   }
+   if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x122: return MultTranspose3D<L,1,2,2>(NE,B,G,V,QV,D,QD,Y);
+         case 0x123: return MultTranspose3D<L,1,2,3>(NE,B,G,V,QV,D,QD,Y);
+         case 0x133: return MultTranspose3D<L,1,3,3>(NE,B,G,V,QV,D,QD,Y);
+         case 0x134: return MultTranspose3D<L,1,3,4>(NE,B,G,V,QV,D,QD,Y);
+         case 0x144: return MultTranspose3D<L,1,4,4>(NE,B,G,V,QV,D,QD,Y);
+         case 0x145: return MultTranspose3D<L,1,4,5>(NE,B,G,V,QV,D,QD,Y);
+
+         case 0x322: return MultTranspose3D<L,3,2,2>(NE,B,G,V,QV,D,QD,Y);
+         case 0x323: return MultTranspose3D<L,3,2,3>(NE,B,G,V,QV,D,QD,Y);
+         case 0x333: return MultTranspose3D<L,3,3,3>(NE,B,G,V,QV,D,QD,Y);
+         case 0x334: return MultTranspose3D<L,3,3,4>(NE,B,G,V,QV,D,QD,Y);
+         case 0x344: return MultTranspose3D<L,3,4,4>(NE,B,G,V,QV,D,QD,Y);
+         case 0x345: return MultTranspose3D<L,3,4,5>(NE,B,G,V,QV,D,QD,Y);
+         default:
+         {
+            constexpr int MD = 8;
+            constexpr int MQ = 8;
+            MFEM_VERIFY(D1D <= MD, "Orders higher than " << MD-1
+                        << " are not supported!");
+            MFEM_VERIFY(Q1D <= MQ, "Quadrature rules with more than "
+                        << MQ << " 1D points are not supported!");
+            return MultTranspose3D<L,0,0,0,MD,MQ>(NE,B,G,V,QV,D,QD,Y,
+                                                  vdim,D1D,Q1D);
+         }
+      }
+   }
+   mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
+   MFEM_ABORT("Kernel not supported yet");
+}
+
+template void TensorMultTranspose<QVectorLayout::byNODES>(
+   const int, const int, const DofToQuad &, const unsigned,
+   const Vector &, const Vector &, Vector &);
+
+template void TensorMultTranspose<QVectorLayout::byVDIM>(
+   const int, const int, const DofToQuad &, const unsigned,
+   const Vector &, const Vector &, Vector &);
+
+// Transpose of the evaluation of quadrature point values and reference
+// derivatives: non-tensor product version, also used for 1D tensor elements.
+// Assumes 'maps.mode == FULL' (or 'TENSOR' in 1D) and one thread per dof.
+void GenericMultTranspose(const int NE,
+                          const int vdim,
+                          const QVectorLayout q_layout,
+                          const DofToQuad &maps,
+                          const unsigned eval_flags,
+                          const Vector &q_val,
+                          const Vector &q_der,
+                          Vector &e_vec)
+{
+   using QI = QuadratureInterpolator;
+
+   if (NE == 0) { return; }
+   const int ND = maps.ndof;
+   const int NQ = maps.nqpt;
+   const int DIM = maps.FE->GetDim();
+   const int VDIM = vdim;
+   const bool use_val = eval_flags & QI::VALUES;
+   const bool use_der = eval_flags & QI::DERIVATIVES;
+   const bool by_vdim = q_layout == QVectorLayout::byVDIM;
+   const auto B = Reshape(maps.B.Read(), NQ, ND);
+   const auto G = Reshape(maps.G.Read(), NQ, DIM, ND);
+   const auto val = by_vdim ?
+                    Reshape(use_val ? q_val.Read() : nullptr, VDIM, NQ, NE):
+                    Reshape(use_val ? q_val.Read() : nullptr, NQ, VDIM, NE);
+   const auto der = by_vdim ?
+                    Reshape(use_der ? q_der.Read() : nullptr, VDIM, DIM, NQ, NE):
+                    Reshape(use_der ? q_der.Read() : nullptr, NQ, VDIM, DIM, NE);
+   auto E = Reshape(e_vec.Write(), ND, VDIM, NE);
+   MFEM_FORALL(i, ND*NE,
+   {
+      const int d = i % ND;
+      const int e = i / ND;
+      for (int c = 0; c < VDIM; c++)
+      {
+         double u = 0.0;
+         for (int q = 0; q < NQ; q++)
+         {
+            if (use_val)
+            {
+               u += B(q,d) * (by_vdim ? val(c,q,e) : val(q,c,e));
+            }
+            if (use_der)
+            {
+               for (int k = 0; k < DIM; k++)
+               {
+                  u += G(q,k,d) * (by_vdim ? der(c,k,q,e) : der(q,c,k,e));
+               }
+            }
+         }
+         E(d,c,e) = u;
+      }
+   });
+}
+
+// Apply the transpose of the map from reference to physical derivatives,
+// q_ref = J^{-1} q_phys at each quadrature point, see PHYSICAL_DERIVATIVES.
+template<int DIM>
+static void PhysDerivativesTranspose(const int NE,
+                                     const int vdim,
+                                     const int nq,
+                                     const QVectorLayout q_layout,
+                                     const GeometricFactors &geom,
+                                     const Vector &q_phys,
+                                     Vector &q_ref)
+{
+   const int NQ = nq;
+   const int VDIM = vdim;
+   const bool by_vdim = q_layout == QVectorLayout::byVDIM;
+   MFEM_VERIFY(geom.mesh->SpaceDimension() == DIM,
+               "surface and line meshes are not supported");
+   const auto J = Reshape(geom.J.Read(), NQ, DIM, DIM, NE);
+   const auto X = by_vdim ? Reshape(q_phys.Read(), VDIM, DIM, NQ, NE):
+                  Reshape(q_phys.Read(), NQ, VDIM, DIM, NE);
+   auto Y = by_vdim ? Reshape(q_ref.Write(), VDIM, DIM, NQ, NE):
+            Reshape(q_ref.Write(), NQ, VDIM, DIM, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double Jloc[DIM*DIM], Jinv[DIM*DIM];
+      for (int col = 0; col < DIM; col++)
+      {
+         for (int row = 0; row < DIM; row++)
+         {
+            Jloc[row+DIM*col] = J(q,row,col,e);
+         }
+      }
+      kernels::CalcInverse<DIM>(Jloc, Jinv);
+      for (int c = 0; c < VDIM; c++)
+      {
+         double u[DIM];
+         for (int j = 0; j < DIM; j++)
+         {
+            u[j] = by_vdim ? X(c,j,q,e) : X(q,c,j,e);
+         }
+         for (int k = 0; k < DIM; k++)
+         {
+            double v = 0.0;
+            for (int j = 0; j < DIM; j++) { v += Jinv[k+DIM*j]*u[j]; }
+            if (by_vdim) { Y(c,k,q,e) = v; }
+            else         { Y(q,c,k,e) = v; }
+         }
+      }
+   });
+}
+
+void PhysDerivativesTranspose(const int NE,
+                              const int vdim,
+                              const int dim,
+                              const int nq,
+                              const QVectorLayout q_layout,
+                              const GeometricFactors &geom,
+                              const Vector &q_phys,
+                              Vector &q_ref)
+{
+   if (NE == 0) { return; }
+   switch (dim)
+   {
+      case 2: return PhysDerivativesTranspose<2>(NE, vdim, nq, q_layout, geom,
+                                                    q_phys, q_ref);
+      case 3: return PhysDerivativesTranspose<3>(NE, vdim, nq, q_layout, geom,
+                                                    q_phys, q_ref);
+   }
+   MFEM_ABORT("invalid dimension " << dim << ", 1D is rejected by"
+              " QuadratureInterpolator::MultTranspose()");
+}
+
+} // namespace quadrature_interpolator
+
+} // namespace internal
+
+} // namespace mfem
@@ -600,11 +600,68 @@ void QuadratureInterpolator::MultTranspose(unsigned eval_flags,
                                            const Vector &q_der,
                                            Vector &e_vec) const
 {
-   MFEM_CONTRACT_VAR(eval_flags);
-   MFEM_CONTRACT_VAR(q_val);
-   MFEM_CONTRACT_VAR(q_der);
-   MFEM_CONTRACT_VAR(e_vec);
-   MFEM_ABORT("this method is not implemented yet");
+   using namespace internal::quadrature_interpolator;
+
+   const int ne = fespace->GetNE();
+   if (ne == 0) { return; }
+   MFEM_VERIFY(!(eval_flags & DETERMINANTS),
+               "the DETERMINANTS flag can only be used in Mult()");
+   MFEM_VERIFY(!((eval_flags & DERIVATIVES) &&
+                 (eval_flags & PHYSICAL_DERIVATIVES)),
+               "only one of DERIVATIVES and PHYSICAL_DERIVATIVES can be set");
+   const int vdim = fespace->GetVDim();
+   const FiniteElement *fe = fespace->GetFE(0);
+   const int dim = fe->GetDim();
+   MFEM_VERIFY(dim > 1 || !(eval_flags & PHYSICAL_DERIVATIVES),
+               "PHYSICAL_DERIVATIVES is not supported in 1D, the Jacobians"
+               " of 1D meshes are not available in GeometricFactors");
+   const bool use_tensor_eval =
+      use_tensor_products &&
+      dynamic_cast<const TensorBasisElement*>(fe) != nullptr;
+   const IntegrationRule *ir =
+      IntRule ? IntRule : &qspace->GetElementIntRule(0);
+   const DofToQuad::Mode mode =
+      use_tensor_eval ? DofToQuad::TENSOR : DofToQuad::FULL;
+   const DofToQuad &maps = fe->GetDofToQuad(*ir, mode);
+
+   MFEM_ASSERT(fespace->GetMesh()->GetNumGeometries(
+                  fespace->GetMesh()->Dimension()) == 1,
+               "mixed meshes are not supported");
+
+   const Vector *q_ref = &q_der;
+   unsigned flags = eval_flags & (VALUES | DERIVATIVES);
+   if (eval_flags & PHYSICAL_DERIVATIVES)
+   {
+      const int jacobians = GeometricFactors::JACOBIANS;
+      const GeometricFactors *geom =
+         fespace->GetMesh()->GetGeometricFactors(*ir, jacobians);
+      d_buffer.SetSize(q_der.Size());
+      PhysDerivativesTranspose(ne, vdim, dim, ir->GetNPoints(), q_layout,
+                               *geom, q_der, d_buffer);
+      q_ref = &d_buffer;
+      flags |= DERIVATIVES;
+   }
+
+   if (use_tensor_eval && dim > 1)
+   {
+      if (q_layout == QVectorLayout::byNODES)
+      {
+         TensorMultTranspose<QVectorLayout::byNODES>(
+            ne, vdim, maps, flags, q_val, *q_ref, e_vec);
+      }
+      if (q_layout == QVectorLayout::byVDIM)
+      {
+         TensorMultTranspose<QVectorLayout::byVDIM>(
+            ne, vdim, maps, flags, q_val, *q_ref, e_vec);
+      }
+   }
+   else
+   {
+      // also used for 1D tensor elements, where the TENSOR and FULL maps have
+      // the same layout
+      GenericMultTranspose(ne, vdim, q_layout, maps, flags, q_val, *q_ref,
+                           e_vec);
+   }
 }
 
 void QuadratureInterpolator::Values(const Vector &e_vec,
@@ -134,7 +134,17 @@ public:
        reference coordinates) of the E-vector @a e_vec at quadrature points. */
    void Determinants(const Vector &e_vec, Vector &q_det) const;
 
-   /// Perform the transpose operation of Mult(). (TODO)
+   /// Perform the transpose operation of Mult().
+   /** Computes @a e_vec = B^T @a q_val + G^T @a q_der, where B and G are the
+       interpolation and differentiation operators used by Mult(), i.e. the
+       values at quadrature points are "integrated" back against the basis
+       functions (without quadrature weights). Only the terms selected by the
+       flags VALUES and DERIVATIVES (or PHYSICAL_DERIVATIVES) in @a eval_flags
+       are included; the DETERMINANTS flag is not allowed. The Q-vectors must
+       use the layout given by GetOutputLayout(), and @a e_vec must be
+       allocated by the caller; it is overwritten and uses the same ordering as
+       the input of Mult(). The flag PHYSICAL_DERIVATIVES is not supported
+       in 1D. */
    void MultTranspose(unsigned eval_flags, const Vector &q_val,
                       const Vector &q_der, Vector &e_vec) const;
 };
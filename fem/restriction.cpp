@@ -106,6 +106,9 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
 
 void ElementRestriction::Mult(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_DETAIL_FUNCTION;
+   // gather map, and the dof values read and written
+   MFEM_PERF_WORK(0.0, double(ne)*dof*(sizeof(int) + 2*vdim*sizeof(double)));
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -128,6 +131,9 @@ void ElementRestriction::Mult(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultUnsigned(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_DETAIL_FUNCTION;
+   // gather map, and the dof values read and written
+   MFEM_PERF_WORK(0.0, double(ne)*dof*(sizeof(int) + 2*vdim*sizeof(double)));
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -149,6 +155,11 @@ void ElementRestriction::MultUnsigned(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_DETAIL_FUNCTION;
+   // offsets and indices, the E-vector values read and the dof values written
+   MFEM_PERF_WORK(double(ne)*dof*vdim,
+                  double(ndofs)*(sizeof(int) + vdim*sizeof(double)) +
+                  double(ne)*dof*(sizeof(int) + vdim*sizeof(double)));
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -166,7 +177,8 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
          double dof_value = 0;
          for (int j = offset; j < next_offset; ++j)
          {
-            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] : -1 - d_indices[j];
+            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] :
+                              -1 - d_indices[j];
             dof_value += ((d_indices[j] >= 0) ? d_x(idx_j % nd, c, idx_j / nd) :
                           -d_x(idx_j % nd, c, idx_j / nd));
          }
@@ -177,6 +189,11 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_DETAIL_FUNCTION;
+   // offsets and indices, the E-vector values read and the dof values written
+   MFEM_PERF_WORK(double(ne)*dof*vdim,
+                  double(ndofs)*(sizeof(int) + vdim*sizeof(double)) +
+                  double(ne)*dof*(sizeof(int) + vdim*sizeof(double)));
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -194,7 +211,8 @@ void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
          double dof_value = 0;
          for (int j = offset; j < next_offset; ++j)
          {
-            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] : -1 - d_indices[j];
+            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] :
+                              -1 - d_indices[j];
             dof_value += d_x(idx_j % nd, c, idx_j / nd);
          }
          d_y(t?c:i,t?i:c) = dof_value;
@@ -249,7 +267,8 @@ void ElementRestriction::BooleanMask(Vector& y) const
       {
          for (int j = offset; j < next_offset; ++j)
          {
-            const int idx_j = d_indices[j];
+            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] :
+                              -1 - d_indices[j];
             if (d_x(t?c:i,t?i:c))
             {
                d_y(idx_j % nd, c, idx_j / nd) = 0.0;
@@ -166,10 +166,20 @@ MFEM_REGISTER_TMOP_KERNELS(void, AddMultPA_Kernel_2D,
 
 void TMOP_Integrator::AddMultPA_2D(const Vector &X, Vector &Y) const
 {
+   MFEM_PERF_DETAIL_FUNCTION;
    const int N = PA.ne;
    const int M = metric->Id();
    const int D1D = PA.maps->ndof;
    const int Q1D = PA.maps->nqpt;
+   // gradient of the 2 components with B, G and its transpose, and the
+   // products with the target Jacobians; the metric evaluation is not
+   // counted. X and the target Jacobians are read, Y is read and written.
+   {
+      const double d = D1D, q = Q1D;
+      const double flops = 16.0*(d*d*q + d*q*q) + 32.0*q*q;
+      const double words = 6.0*d*d + 4.0*q*q;
+      MFEM_PERF_WORK(N*flops, N*words*sizeof(double));
+   }
    const int id = (D1D << 4 ) | Q1D;
    const DenseTensor &J = PA.Jtr;
    const Array<double> &W = PA.ir->GetWeights();
@@ -191,10 +191,21 @@ MFEM_REGISTER_TMOP_KERNELS(void, AddMultPA_Kernel_3D,
 
 void TMOP_Integrator::AddMultPA_3D(const Vector &X, Vector &Y) const
 {
+   MFEM_PERF_DETAIL_FUNCTION;
    const int N = PA.ne;
    const int M = metric->Id();
    const int D1D = PA.maps->ndof;
    const int Q1D = PA.maps->nqpt;
+   // gradient of the 3 components with B, G and its transpose, and the
+   // products with the target Jacobians; the metric evaluation is not
+   // counted. X and the target Jacobians are read, Y is read and written.
+   {
+      const double d = D1D, q = Q1D;
+      const double flops = 12.0*(2.0*d*d*d*q + 3.0*d*d*q*q + 3.0*d*q*q*q) +
+                           108.0*q*q*q;
+      const double words = 9.0*d*d*d + 9.0*q*q*q;
+      MFEM_PERF_WORK(N*flops, N*words*sizeof(double));
+   }
    const int id = (D1D << 4 ) | Q1D;
    const DenseTensor &J = PA.Jtr;
    const Array<double> &W = PA.ir->GetWeights();
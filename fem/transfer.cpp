@@ -904,24 +904,22 @@ TransferOperator::TransferOperator(const FiniteElementSpace& lFESpace_,
    : Operator(hFESpace_.GetVSize(), lFESpace_.GetVSize())
 {
    bool isvar_order = lFESpace_.IsVariableOrder() || hFESpace_.IsVariableOrder();
-   if (lFESpace_.FEColl() == hFESpace_.FEColl() && !isvar_order)
+   const bool same_fec = lFESpace_.FEColl() == hFESpace_.FEColl();
+   if (same_fec && !isvar_order &&
+       TensorProductHRefinementTransferOperator::Supports(lFESpace_, hFESpace_))
+   {
+      opr = new TensorProductHRefinementTransferOperator(lFESpace_, hFESpace_);
+   }
+   else if (same_fec && !isvar_order)
    {
       OperatorPtr P(Operator::ANY_TYPE);
       hFESpace_.GetTransferOperator(lFESpace_, P);
       P.SetOperatorOwner(false);
       opr = P.Ptr();
    }
-   else if (lFESpace_.GetMesh()->GetNE() > 0
-            && hFESpace_.GetMesh()->GetNE() > 0
-            && lFESpace_.GetVDim() == 1
-            && hFESpace_.GetVDim() == 1
-            && dynamic_cast<const TensorBasisElement*>(lFESpace_.GetFE(0))
-            && dynamic_cast<const TensorBasisElement*>(hFESpace_.GetFE(0))
-            && !isvar_order
-            && (hFESpace_.FEColl()->GetContType() ==
-                mfem::FiniteElementCollection::CONTINUOUS ||
-                hFESpace_.FEColl()->GetContType() ==
-                mfem::FiniteElementCollection::DISCONTINUOUS))
+   else if (!isvar_order &&
+            TensorProductPRefinementTransferOperator::Supports(lFESpace_,
+                                                               hFESpace_))
    {
       opr = new TensorProductPRefinementTransferOperator(lFESpace_, hFESpace_);
    }
@@ -1078,59 +1076,252 @@ void PRefinementTransferOperator::MultTranspose(const Vector& x,
 }
 
 
-TensorProductPRefinementTransferOperator::
-TensorProductPRefinementTransferOperator(
-   const FiniteElementSpace& lFESpace_,
-   const FiniteElementSpace& hFESpace_)
-   : Operator(hFESpace_.GetVSize(), lFESpace_.GetVSize()), lFESpace(lFESpace_),
-     hFESpace(hFESpace_)
+// Tensor-product structure of the element 'fe' of a 'dim'-dimensional mesh:
+// the 1D bases and their sizes, dim x NB, and the offsets of the NB blocks in
+// the lexicographic element dofs. Returns false if 'fe' is not supported.
+static bool GetTensorBlocks(const FiniteElement &fe, const int dim,
+                            Array<const Poly_1D::Basis*> &basis,
+                            Array<int> &sizes, Array<int> &offsets)
 {
-   // Assuming the same element type
-   Mesh* mesh = lFESpace.GetMesh();
-   dim = mesh->Dimension();
-   if (mesh->GetNE() == 0)
+   const int p = fe.GetOrder();
+   if (fe.GetRangeType() == FiniteElement::SCALAR)
    {
-      return;
+      const TensorBasisElement *tel =
+         dynamic_cast<const TensorBasisElement*>(&fe);
+      if (!tel) { return false; }
+      basis.SetSize(dim);
+      sizes.SetSize(dim);
+      offsets.SetSize(1);
+      offsets[0] = 0;
+      for (int d = 0; d < dim; d++)
+      {
+         basis[d] = &tel->GetBasis1D();
+         sizes[d] = p + 1;
+      }
+      return true;
    }
-   const FiniteElement& el = *lFESpace.GetFE(0);
 
-   const TensorBasisElement* ltel =
-      dynamic_cast<const TensorBasisElement*>(&el);
-   MFEM_VERIFY(ltel, "Low order FE space must be tensor product space");
+   const VectorTensorFiniteElement *vtel =
+      dynamic_cast<const VectorTensorFiniteElement*>(&fe);
+   const int map_type = fe.GetMapType();
+   if (!vtel || (map_type != FiniteElement::H_CURL &&
+                 map_type != FiniteElement::H_DIV))
+   {
+      return false;
+   }
+   // Component c of ND elements uses the open basis in direction c and the
+   // closed basis in the other directions, and the reverse for RT elements.
+   basis.SetSize(dim*dim);
+   sizes.SetSize(dim*dim);
+   offsets.SetSize(dim);
+   int offset = 0;
+   for (int c = 0; c < dim; c++)
+   {
+      offsets[c] = offset;
+      int size = 1;
+      for (int d = 0; d < dim; d++)
+      {
+         const bool closed = (d == c) == (map_type == FiniteElement::H_DIV);
+         basis[d + dim*c] = closed ? &vtel->GetClosedBasis1D() :
+                            &vtel->GetOpenBasis1D();
+         sizes[d + dim*c] = closed ? p + 1 : p;
+         size *= sizes[d + dim*c];
+      }
+      offset += size;
+   }
+   return offset == fe.GetDof();
+}
 
-   const TensorBasisElement* htel =
-      dynamic_cast<const TensorBasisElement*>(hFESpace.GetFE(0));
-   MFEM_VERIFY(htel, "High order FE space must be tensor product space");
-   const Array<int>& hdofmap = htel->GetDofMap();
+// The 1D nodes of the blocks of the element 'fe', stored in 'nodes' with size
+// max_size x dim x NB. Returns false if the dofs of 'fe' are not the values of
+// its (components of the) reference functions at these nodes.
+static bool GetTensorNodes(const FiniteElement &fe, const int dim,
+                           const Array<const Poly_1D::Basis*> &basis,
+                           const Array<int> &sizes, const Array<int> &offsets,
+                           const int max_size, Vector &nodes)
+{
+   const Array<int> &dof_map =
+      dynamic_cast<const TensorBasisElement&>(fe).GetDofMap();
+   const IntegrationRule &ir = fe.GetNodes();
+   const int nb = offsets.Size();
+   nodes.SetSize(max_size*dim*nb);
+   Vector vals;
+   for (int b = 0; b < nb; b++)
+   {
+      for (int d = 0; d < dim; d++)
+      {
+         const int n = sizes[d + dim*b];
+         int stride = 1;
+         for (int k = 0; k < d; k++) { stride *= sizes[k + dim*b]; }
+         vals.SetSize(n);
+         for (int i = 0; i < n; i++)
+         {
+            // lexicographic index of the i-th node in direction d
+            const int lex = offsets[b] + i*stride;
+            const int s = dof_map.Size() ? dof_map[lex] : lex;
+            const IntegrationPoint &ip = ir.IntPoint(s >= 0 ? s : -1 - s);
+            const double x = (d == 0) ? ip.x : ((d == 1) ? ip.y : ip.z);
+            nodes(i + max_size*(d + dim*b)) = x;
+            basis[d + dim*b]->Eval(x, vals);
+            for (int j = 0; j < n; j++)
+            {
+               if (std::abs(vals(j) - (i == j)) > 1e-12) { return false; }
+            }
+         }
+      }
+   }
+   return true;
+}
+
+bool TensorProductTransferOperator::SupportedSpaces(
+   const FiniteElementSpace& lFESpace, const FiniteElementSpace& hFESpace)
+{
+   const Mesh *lmesh = lFESpace.GetMesh();
+   const Mesh *hmesh = hFESpace.GetMesh();
+   const int dim = hmesh->Dimension();
+   if (lmesh->GetNE() == 0 || hmesh->GetNE() == 0 ||
+       (dim != 2 && dim != 3) || lmesh->Dimension() != dim ||
+       lmesh->GetNumGeometries(dim) != 1 ||
+       hmesh->GetNumGeometries(dim) != 1 ||
+       !Geometry::IsTensorProduct(hmesh->GetElementBaseGeometry(0)) ||
+       lFESpace.IsVariableOrder() || hFESpace.IsVariableOrder() ||
+       lFESpace.GetNURBSext() || hFESpace.GetNURBSext() ||
+       lFESpace.GetVDim() != hFESpace.GetVDim())
+   {
+      return false;
+   }
+
+   const FiniteElement &lfe = *lFESpace.GetFE(0);
+   const FiniteElement &hfe = *hFESpace.GetFE(0);
+   if (lfe.GetRangeType() != hfe.GetRangeType() ||
+       (lfe.GetRangeType() == FiniteElement::VECTOR &&
+        lfe.GetMapType() != hfe.GetMapType()) ||
+       std::max(lfe.GetOrder(), hfe.GetOrder()) + 1 > MAX_D1D)
+   {
+      return false;
+   }
+   Array<const Poly_1D::Basis*> lbasis, hbasis;
+   Array<int> lsizes, hsizes, loffsets, hoffsets;
+   Vector nodes;
+   return GetTensorBlocks(lfe, dim, lbasis, lsizes, loffsets) &&
+          GetTensorBlocks(hfe, dim, hbasis, hsizes, hoffsets) &&
+          GetTensorNodes(hfe, dim, hbasis, hsizes, hoffsets, MAX_Q1D, nodes);
+}
 
-   const IntegrationRule& ir = hFESpace.GetFE(0)->GetNodes();
-   IntegrationRule irLex = ir;
+TensorProductTransferOperator::TensorProductTransferOperator(
+   const FiniteElementSpace& lFESpace_, const FiniteElementSpace& hFESpace_)
+   : Operator(hFESpace_.GetVSize(), lFESpace_.GetVSize()), lFESpace(lFESpace_),
+     hFESpace(hFESpace_), dim(hFESpace_.GetMesh()->Dimension()),
+     NE(hFESpace_.GetNE()), NEL(lFESpace_.GetNE()), NB(0), LD(0), HD(0), NM(0),
+     MD1D(0), MQ1D(0), elem_restrict_lex_l(NULL), elem_restrict_lex_h(NULL)
+{ }
 
-   // The quadrature points, or equivalently, the dofs of the high order space
-   // must be sorted in lexicographical order
-   for (int i = 0; i < ir.GetNPoints(); ++i)
+void TensorProductTransferOperator::Setup(const Array<int>& parents_,
+                                          const Array<int>& map_ids_,
+                                          const Array<double>& maps)
+{
+   if (NE == 0) { return; }
+   MFEM_VERIFY(SupportedSpaces(lFESpace, hFESpace),
+               "the spaces are not supported");
+   MFEM_VERIFY(parents_.Size() == NE && map_ids_.Size() == dim*NE,
+               "invalid refinement data");
+
+   // Assuming the same element type
+   const FiniteElement &lfe = *lFESpace.GetFE(0);
+   const FiniteElement &hfe = *hFESpace.GetFE(0);
+   Array<const Poly_1D::Basis*> lbasis, hbasis;
+   Array<int> lsizes, hsizes, loffsets, hoffsets;
+   GetTensorBlocks(lfe, dim, lbasis, lsizes, loffsets);
+   GetTensorBlocks(hfe, dim, hbasis, hsizes, hoffsets);
+   MD1D = lsizes.Max();
+   MQ1D = hsizes.Max();
+   Vector nodes;
+   GetTensorNodes(hfe, dim, hbasis, hsizes, hoffsets, MQ1D, nodes);
+
+   // The blocks of the vector dimensions
+   const int vdim = hFESpace.GetVDim();
+   const int ncomp = loffsets.Size();
+   NB = vdim*ncomp;
+   LD = vdim*lfe.GetDof();
+   HD = vdim*hfe.GetDof();
+   l_sizes.SetSize(dim*NB);
+   h_sizes.SetSize(dim*NB);
+   l_offsets.SetSize(NB);
+   h_offsets.SetSize(NB);
+   for (int vd = 0; vd < vdim; vd++)
    {
-      int j = hdofmap[i] >=0 ? hdofmap[i] : -1 - hdofmap[i];
-      irLex.IntPoint(i) = ir.IntPoint(j);
+      for (int c = 0; c < ncomp; c++)
+      {
+         const int b = c + ncomp*vd;
+         l_offsets[b] = loffsets[c] + vd*lfe.GetDof();
+         h_offsets[b] = hoffsets[c] + vd*hfe.GetDof();
+         for (int d = 0; d < dim; d++)
+         {
+            l_sizes[d + dim*b] = lsizes[d + dim*c];
+            h_sizes[d + dim*b] = hsizes[d + dim*c];
+         }
+      }
    }
 
-   NE = lFESpace.GetNE();
-   const DofToQuad& maps = el.GetDofToQuad(irLex, DofToQuad::TENSOR);
+   // The 1D interpolation matrices: the coarse 1D bases at the mapped fine 1D
+   // nodes, scaled according to the map type of the elements
+   const int map_type = hfe.GetMapType();
+   NM = maps.Size()/2;
+   B.SetSize(MQ1D*MD1D*NM*dim*NB);
+   B = 0.0;
+   auto B_ = Reshape(B.HostWrite(), MQ1D, MD1D, NM, dim, NB);
+   Vector vals(MD1D);
+   for (int b = 0; b < NB; b++)
+   {
+      const int c = b % ncomp;
+      for (int d = 0; d < dim; d++)
+      {
+         for (int m = 0; m < NM; m++)
+         {
+            const double h = maps[2*m+1];
+            double scale = 1.0;
+            if (map_type == FiniteElement::INTEGRAL ||
+                (map_type == FiniteElement::H_CURL && d == c) ||
+                (map_type == FiniteElement::H_DIV && d != c))
+            {
+               scale = h;
+            }
+            for (int q = 0; q < h_sizes[d + dim*b]; q++)
+            {
+               const double x = nodes(q + MQ1D*(d + dim*c));
+               vals.SetSize(l_sizes[d + dim*b]);
+               lbasis[d + dim*c]->Eval(maps[2*m] + h*x, vals);
+               for (int j = 0; j < vals.Size(); j++)
+               {
+                  B_(q, j, m, d, b) = scale*vals(j);
+               }
+            }
+         }
+      }
+   }
 
-   D1D = maps.ndof;
-   Q1D = maps.nqpt;
-   B = maps.B;
-   Bt = maps.Bt;
+   // The fine elements of each coarse element
+   parents_.Copy(parents);
+   map_ids_.Copy(matrix_ids);
+   child_offsets.SetSize(NEL + 1);
+   child_offsets = 0;
+   for (int e = 0; e < NE; e++)
+   {
+      MFEM_VERIFY(0 <= parents[e] && parents[e] < NEL, "invalid parent");
+      child_offsets[parents[e] + 1]++;
+   }
+   child_offsets.PartialSum();
+   children.SetSize(NE);
+   for (int e = 0; e < NE; e++) { children[child_offsets[parents[e]]++] = e; }
+   for (int i = NEL; i > 0; i--) { child_offsets[i] = child_offsets[i-1]; }
+   child_offsets[0] = 0;
 
    elem_restrict_lex_l =
       lFESpace.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
-
    MFEM_VERIFY(elem_restrict_lex_l,
                "Low order ElementRestriction not available");
-
    elem_restrict_lex_h =
       hFESpace.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
-
    MFEM_VERIFY(elem_restrict_lex_h,
                "High order ElementRestriction not available");
 
@@ -1139,230 +1330,314 @@ TensorProductPRefinementTransferOperator(
    localL.UseDevice(true);
    localH.UseDevice(true);
 
-   MFEM_VERIFY(dynamic_cast<const ElementRestriction*>(elem_restrict_lex_h),
-               "High order element restriction is of unsupported type");
-
+   // Each shared fine dof is set by one of its elements, the L2 element
+   // restriction has no shared dofs.
    mask.SetSize(localH.Size(), Device::GetMemoryType());
-   static_cast<const ElementRestriction*>(elem_restrict_lex_h)
-   ->BooleanMask(mask);
+   const ElementRestriction *h_restrict =
+      dynamic_cast<const ElementRestriction*>(elem_restrict_lex_h);
+   if (h_restrict) { h_restrict->BooleanMask(mask); }
+   else { mask = 1.0; }
    mask.UseDevice(true);
 }
 
 namespace TransferKernels
 {
-void Prolongation2D(const int NE, const int D1D, const int Q1D,
-                    const Vector& localL, Vector& localH,
-                    const Array<double>& B, const Vector& mask)
+void Prolongation2D(const int NE, const int NEL, const int NB, const int LD,
+                    const int HD, const int MD1D, const int MQ1D, const int NM,
+                    const Array<int>& l_sizes, const Array<int>& h_sizes,
+                    const Array<int>& l_offsets, const Array<int>& h_offsets,
+                    const Array<double>& B, const Array<int>& parents,
+                    const Array<int>& matrix_ids, const Vector& localL,
+                    Vector& localH, const Vector& mask)
 {
-   auto x_ = Reshape(localL.Read(), D1D, D1D, NE);
-   auto y_ = Reshape(localH.ReadWrite(), Q1D, Q1D, NE);
-   auto B_ = Reshape(B.Read(), Q1D, D1D);
-   auto m_ = Reshape(mask.Read(), Q1D, Q1D, NE);
-
-   localH = 0.0;
+   auto x_ = Reshape(localL.Read(), LD, NEL);
+   auto y_ = Reshape(localH.Write(), HD, NE);
+   auto B_ = Reshape(B.Read(), MQ1D, MD1D, NM, 2, NB);
+   auto m_ = Reshape(mask.Read(), HD, NE);
+   auto ls = Reshape(l_sizes.Read(), 2, NB);
+   auto hs = Reshape(h_sizes.Read(), 2, NB);
+   auto lo = l_offsets.Read();
+   auto ho = h_offsets.Read();
+   auto p_ = parents.Read();
+   auto mid = Reshape(matrix_ids.Read(), 2, NE);
 
    MFEM_FORALL(e, NE,
    {
-      for (int dy = 0; dy < D1D; ++dy)
+      const int pe = p_[e];
+      const int mx = mid(0, e), my = mid(1, e);
+      for (int b = 0; b < NB; ++b)
       {
-         double sol_x[MAX_Q1D];
-         for (int qy = 0; qy < Q1D; ++qy)
+         const int DX = ls(0, b), DY = ls(1, b);
+         const int QX = hs(0, b), QY = hs(1, b);
+         const int ol = lo[b], oh = ho[b];
+         for (int q = 0; q < QX*QY; ++q)
          {
-            sol_x[qy] = 0.0;
+            y_(oh + q, e) = 0.0;
          }
-         for (int dx = 0; dx < D1D; ++dx)
+         for (int dy = 0; dy < DY; ++dy)
          {
-            const double s = x_(dx, dy, e);
-            for (int qx = 0; qx < Q1D; ++qx)
+            double sol_x[MAX_Q1D];
+            for (int qx = 0; qx < QX; ++qx)
             {
-               sol_x[qx] += B_(qx, dx) * s;
+               sol_x[qx] = 0.0;
             }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            const double d2q = B_(qy, dy);
-            for (int qx = 0; qx < Q1D; ++qx)
+            for (int dx = 0; dx < DX; ++dx)
             {
-               y_(qx, qy, e) += d2q * sol_x[qx];
+               const double s = x_(ol + dx + DX*dy, pe);
+               for (int qx = 0; qx < QX; ++qx)
+               {
+                  sol_x[qx] += B_(qx, dx, mx, 0, b) * s;
+               }
+            }
+            for (int qy = 0; qy < QY; ++qy)
+            {
+               const double d2q = B_(qy, dy, my, 1, b);
+               for (int qx = 0; qx < QX; ++qx)
+               {
+                  y_(oh + qx + QX*qy, e) += d2q * sol_x[qx];
+               }
             }
          }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
+         for (int q = 0; q < QX*QY; ++q)
          {
-            y_(qx, qy, e) *= m_(qx, qy, e);
+            y_(oh + q, e) *= m_(oh + q, e);
          }
       }
    });
 }
 
-void Prolongation3D(const int NE, const int D1D, const int Q1D,
-                    const Vector& localL, Vector& localH,
-                    const Array<double>& B, const Vector& mask)
+void Prolongation3D(const int NE, const int NEL, const int NB, const int LD,
+                    const int HD, const int MD1D, const int MQ1D, const int NM,
+                    const Array<int>& l_sizes, const Array<int>& h_sizes,
+                    const Array<int>& l_offsets, const Array<int>& h_offsets,
+                    const Array<double>& B, const Array<int>& parents,
+                    const Array<int>& matrix_ids, const Vector& localL,
+                    Vector& localH, const Vector& mask)
 {
-   auto x_ = Reshape(localL.Read(), D1D, D1D, D1D, NE);
-   auto y_ = Reshape(localH.ReadWrite(), Q1D, Q1D, Q1D, NE);
-   auto B_ = Reshape(B.Read(), Q1D, D1D);
-   auto m_ = Reshape(mask.Read(), Q1D, Q1D, Q1D, NE);
-
-   localH = 0.0;
+   auto x_ = Reshape(localL.Read(), LD, NEL);
+   auto y_ = Reshape(localH.Write(), HD, NE);
+   auto B_ = Reshape(B.Read(), MQ1D, MD1D, NM, 3, NB);
+   auto m_ = Reshape(mask.Read(), HD, NE);
+   auto ls = Reshape(l_sizes.Read(), 3, NB);
+   auto hs = Reshape(h_sizes.Read(), 3, NB);
+   auto lo = l_offsets.Read();
+   auto ho = h_offsets.Read();
+   auto p_ = parents.Read();
+   auto mid = Reshape(matrix_ids.Read(), 3, NE);
 
    MFEM_FORALL(e, NE,
    {
-      for (int dz = 0; dz < D1D; ++dz)
+      const int pe = p_[e];
+      const int mx = mid(0, e), my = mid(1, e), mz = mid(2, e);
+      for (int b = 0; b < NB; ++b)
       {
-         double sol_xy[MAX_Q1D][MAX_Q1D];
-         for (int qy = 0; qy < Q1D; ++qy)
+         const int DX = ls(0, b), DY = ls(1, b), DZ = ls(2, b);
+         const int QX = hs(0, b), QY = hs(1, b), QZ = hs(2, b);
+         const int ol = lo[b], oh = ho[b];
+         for (int q = 0; q < QX*QY*QZ; ++q)
          {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xy[qy][qx] = 0.0;
-            }
+            y_(oh + q, e) = 0.0;
          }
-         for (int dy = 0; dy < D1D; ++dy)
+         for (int dz = 0; dz < DZ; ++dz)
          {
-            double sol_x[MAX_Q1D];
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_x[qx] = 0;
-            }
-            for (int dx = 0; dx < D1D; ++dx)
+            double sol_xy[MAX_Q1D][MAX_Q1D];
+            for (int qy = 0; qy < QY; ++qy)
             {
-               const double s = x_(dx, dy, dz, e);
-               for (int qx = 0; qx < Q1D; ++qx)
+               for (int qx = 0; qx < QX; ++qx)
                {
-                  sol_x[qx] += B_(qx, dx) * s;
+                  sol_xy[qy][qx] = 0.0;
                }
             }
-            for (int qy = 0; qy < Q1D; ++qy)
+            for (int dy = 0; dy < DY; ++dy)
             {
-               const double wy = B_(qy, dy);
-               for (int qx = 0; qx < Q1D; ++qx)
+               double sol_x[MAX_Q1D];
+               for (int qx = 0; qx < QX; ++qx)
+               {
+                  sol_x[qx] = 0;
+               }
+               for (int dx = 0; dx < DX; ++dx)
                {
-                  sol_xy[qy][qx] += wy * sol_x[qx];
+                  const double s = x_(ol + dx + DX*(dy + DY*dz), pe);
+                  for (int qx = 0; qx < QX; ++qx)
+                  {
+                     sol_x[qx] += B_(qx, dx, mx, 0, b) * s;
+                  }
+               }
+               for (int qy = 0; qy < QY; ++qy)
+               {
+                  const double wy = B_(qy, dy, my, 1, b);
+                  for (int qx = 0; qx < QX; ++qx)
+                  {
+                     sol_xy[qy][qx] += wy * sol_x[qx];
+                  }
                }
             }
-         }
-         for (int qz = 0; qz < Q1D; ++qz)
-         {
-            const double wz = B_(qz, dz);
-            for (int qy = 0; qy < Q1D; ++qy)
+            for (int qz = 0; qz < QZ; ++qz)
             {
-               for (int qx = 0; qx < Q1D; ++qx)
+               const double wz = B_(qz, dz, mz, 2, b);
+               for (int qy = 0; qy < QY; ++qy)
                {
-                  y_(qx, qy, qz, e) += wz * sol_xy[qy][qx];
+                  for (int qx = 0; qx < QX; ++qx)
+                  {
+                     y_(oh + qx + QX*(qy + QY*qz), e) += wz * sol_xy[qy][qx];
+                  }
                }
             }
          }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
+         for (int q = 0; q < QX*QY*QZ; ++q)
          {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               y_(qx, qy, qz, e) *= m_(qx, qy, qz, e);
-            }
+            y_(oh + q, e) *= m_(oh + q, e);
          }
       }
    });
 }
 
-void Restriction2D(const int NE, const int D1D, const int Q1D,
-                   const Vector& localH, Vector& localL,
-                   const Array<double>& Bt, const Vector& mask)
+void Restriction2D(const int NE, const int NEL, const int NB, const int LD,
+                   const int HD, const int MD1D, const int MQ1D, const int NM,
+                   const Array<int>& l_sizes, const Array<int>& h_sizes,
+                   const Array<int>& l_offsets, const Array<int>& h_offsets,
+                   const Array<double>& B, const Array<int>& child_offsets,
+                   const Array<int>& children, const Array<int>& matrix_ids,
+                   const Vector& localH, Vector& localL, const Vector& mask)
 {
-   auto x_ = Reshape(localH.Read(), Q1D, Q1D, NE);
-   auto y_ = Reshape(localL.ReadWrite(), D1D, D1D, NE);
-   auto Bt_ = Reshape(Bt.Read(), D1D, Q1D);
-   auto m_ = Reshape(mask.Read(), Q1D, Q1D, NE);
-
-   localL = 0.0;
-
-   MFEM_FORALL(e, NE,
+   auto x_ = Reshape(localH.Read(), HD, NE);
+   auto y_ = Reshape(localL.Write(), LD, NEL);
+   auto B_ = Reshape(B.Read(), MQ1D, MD1D, NM, 2, NB);
+   auto m_ = Reshape(mask.Read(), HD, NE);
+   auto ls = Reshape(l_sizes.Read(), 2, NB);
+   auto hs = Reshape(h_sizes.Read(), 2, NB);
+   auto lo = l_offsets.Read();
+   auto ho = h_offsets.Read();
+   auto co = child_offsets.Read();
+   auto ch = children.Read();
+   auto mid = Reshape(matrix_ids.Read(), 2, NE);
+
+   MFEM_FORALL(pe, NEL,
    {
-      for (int qy = 0; qy < Q1D; ++qy)
+      for (int i = 0; i < LD; ++i)
       {
-         double sol_x[MAX_D1D];
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            sol_x[dx] = 0.0;
-         }
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const double s = m_(qx, qy, e) * x_(qx, qy, e);
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_x[dx] += Bt_(dx, qx) * s;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
+         y_(i, pe) = 0.0;
+      }
+      for (int k = co[pe]; k < co[pe + 1]; ++k)
+      {
+         const int e = ch[k];
+         const int mx = mid(0, e), my = mid(1, e);
+         for (int b = 0; b < NB; ++b)
          {
-            const double q2d = Bt_(dy, qy);
-            for (int dx = 0; dx < D1D; ++dx)
+            const int DX = ls(0, b), DY = ls(1, b);
+            const int QX = hs(0, b), QY = hs(1, b);
+            const int ol = lo[b], oh = ho[b];
+            for (int qy = 0; qy < QY; ++qy)
             {
-               y_(dx, dy, e) += q2d * sol_x[dx];
+               double sol_x[MAX_D1D];
+               for (int dx = 0; dx < DX; ++dx)
+               {
+                  sol_x[dx] = 0.0;
+               }
+               for (int qx = 0; qx < QX; ++qx)
+               {
+                  const int q = oh + qx + QX*qy;
+                  const double s = m_(q, e) * x_(q, e);
+                  for (int dx = 0; dx < DX; ++dx)
+                  {
+                     sol_x[dx] += B_(qx, dx, mx, 0, b) * s;
+                  }
+               }
+               for (int dy = 0; dy < DY; ++dy)
+               {
+                  const double q2d = B_(qy, dy, my, 1, b);
+                  for (int dx = 0; dx < DX; ++dx)
+                  {
+                     y_(ol + dx + DX*dy, pe) += q2d * sol_x[dx];
+                  }
+               }
             }
          }
       }
    });
 }
-void Restriction3D(const int NE, const int D1D, const int Q1D,
-                   const Vector& localH, Vector& localL,
-                   const Array<double>& Bt, const Vector& mask)
-{
-   auto x_ = Reshape(localH.Read(), Q1D, Q1D, Q1D, NE);
-   auto y_ = Reshape(localL.ReadWrite(), D1D, D1D, D1D, NE);
-   auto Bt_ = Reshape(Bt.Read(), D1D, Q1D);
-   auto m_ = Reshape(mask.Read(), Q1D, Q1D, Q1D, NE);
 
-   localL = 0.0;
-
-   MFEM_FORALL(e, NE,
+void Restriction3D(const int NE, const int NEL, const int NB, const int LD,
+                   const int HD, const int MD1D, const int MQ1D, const int NM,
+                   const Array<int>& l_sizes, const Array<int>& h_sizes,
+                   const Array<int>& l_offsets, const Array<int>& h_offsets,
+                   const Array<double>& B, const Array<int>& child_offsets,
+                   const Array<int>& children, const Array<int>& matrix_ids,
+                   const Vector& localH, Vector& localL, const Vector& mask)
+{
+   auto x_ = Reshape(localH.Read(), HD, NE);
+   auto y_ = Reshape(localL.Write(), LD, NEL);
+   auto B_ = Reshape(B.Read(), MQ1D, MD1D, NM, 3, NB);
+   auto m_ = Reshape(mask.Read(), HD, NE);
+   auto ls = Reshape(l_sizes.Read(), 3, NB);
+   auto hs = Reshape(h_sizes.Read(), 3, NB);
+   auto lo = l_offsets.Read();
+   auto ho = h_offsets.Read();
+   auto co = child_offsets.Read();
+   auto ch = children.Read();
+   auto mid = Reshape(matrix_ids.Read(), 3, NE);
+
+   MFEM_FORALL(pe, NEL,
    {
-      for (int qz = 0; qz < Q1D; ++qz)
+      for (int i = 0; i < LD; ++i)
       {
-         double sol_xy[MAX_D1D][MAX_D1D];
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_xy[dy][dx] = 0;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
+         y_(i, pe) = 0.0;
+      }
+      for (int k = co[pe]; k < co[pe + 1]; ++k)
+      {
+         const int e = ch[k];
+         const int mx = mid(0, e), my = mid(1, e), mz = mid(2, e);
+         for (int b = 0; b < NB; ++b)
          {
-            double sol_x[MAX_D1D];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_x[dx] = 0;
-            }
-            for (int qx = 0; qx < Q1D; ++qx)
+            const int DX = ls(0, b), DY = ls(1, b), DZ = ls(2, b);
+            const int QX = hs(0, b), QY = hs(1, b), QZ = hs(2, b);
+            const int ol = lo[b], oh = ho[b];
+            for (int qz = 0; qz < QZ; ++qz)
             {
-               const double s = m_(qx, qy, qz, e) * x_(qx, qy, qz, e);
-               for (int dx = 0; dx < D1D; ++dx)
+               double sol_xy[MAX_D1D][MAX_D1D];
+               for (int dy = 0; dy < DY; ++dy)
                {
-                  sol_x[dx] += Bt_(dx, qx) * s;
+                  for (int dx = 0; dx < DX; ++dx)
+                  {
+                     sol_xy[dy][dx] = 0;
+                  }
                }
-            }
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               const double wy = Bt_(dy, qy);
-               for (int dx = 0; dx < D1D; ++dx)
+               for (int qy = 0; qy < QY; ++qy)
                {
-                  sol_xy[dy][dx] += wy * sol_x[dx];
+                  double sol_x[MAX_D1D];
+                  for (int dx = 0; dx < DX; ++dx)
+                  {
+                     sol_x[dx] = 0;
+                  }
+                  for (int qx = 0; qx < QX; ++qx)
+                  {
+                     const int q = oh + qx + QX*(qy + QY*qz);
+                     const double s = m_(q, e) * x_(q, e);
+                     for (int dx = 0; dx < DX; ++dx)
+                     {
+                        sol_x[dx] += B_(qx, dx, mx, 0, b) * s;
+                     }
+                  }
+                  for (int dy = 0; dy < DY; ++dy)
+                  {
+                     const double wy = B_(qy, dy, my, 1, b);
+                     for (int dx = 0; dx < DX; ++dx)
+                     {
+                        sol_xy[dy][dx] += wy * sol_x[dx];
+                     }
+                  }
                }
-            }
-         }
-         for (int dz = 0; dz < D1D; ++dz)
-         {
-            const double wz = Bt_(dz, qz);
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               for (int dx = 0; dx < D1D; ++dx)
+               for (int dz = 0; dz < DZ; ++dz)
                {
-                  y_(dx, dy, dz, e) += wz * sol_xy[dy][dx];
+                  const double wz = B_(qz, dz, mz, 2, b);
+                  for (int dy = 0; dy < DY; ++dy)
+                  {
+                     for (int dx = 0; dx < DX; ++dx)
+                     {
+                        y_(ol + dx + DX*(dy + DY*dz), pe) +=
+                           wz * sol_xy[dy][dx];
+                     }
+                  }
                }
             }
          }
@@ -1371,16 +1646,9 @@ void Restriction3D(const int NE, const int D1D, const int Q1D,
 }
 } // namespace TransferKernels
 
-
-TensorProductPRefinementTransferOperator::
-~TensorProductPRefinementTransferOperator()
+void TensorProductTransferOperator::Mult(const Vector& x, Vector& y) const
 {
-}
-
-void TensorProductPRefinementTransferOperator::Mult(const Vector& x,
-                                                    Vector& y) const
-{
-   if (lFESpace.GetMesh()->GetNE() == 0)
+   if (NE == 0)
    {
       return;
    }
@@ -1388,25 +1656,31 @@ void TensorProductPRefinementTransferOperator::Mult(const Vector& x,
    elem_restrict_lex_l->Mult(x, localL);
    if (dim == 2)
    {
-      TransferKernels::Prolongation2D(NE, D1D, Q1D, localL, localH, B, mask);
+      TransferKernels::Prolongation2D(NE, NEL, NB, LD, HD, MD1D, MQ1D, NM,
+                                      l_sizes, h_sizes, l_offsets, h_offsets,
+                                      B, parents, matrix_ids, localL, localH,
+                                      mask);
    }
    else if (dim == 3)
    {
-      TransferKernels::Prolongation3D(NE, D1D, Q1D, localL, localH, B, mask);
+      TransferKernels::Prolongation3D(NE, NEL, NB, LD, HD, MD1D, MQ1D, NM,
+                                      l_sizes, h_sizes, l_offsets, h_offsets,
+                                      B, parents, matrix_ids, localL, localH,
+                                      mask);
    }
    else
    {
-      MFEM_ABORT("TensorProductPRefinementTransferOperator::Mult not "
+      MFEM_ABORT("TensorProductTransferOperator::Mult not "
                  "implemented for dim = "
                  << dim);
    }
    elem_restrict_lex_h->MultTranspose(localH, y);
 }
 
-void TensorProductPRefinementTransferOperator::MultTranspose(const Vector& x,
-                                                             Vector& y) const
+void TensorProductTransferOperator::MultTranspose(const Vector& x,
+                                                  Vector& y) const
 {
-   if (lFESpace.GetMesh()->GetNE() == 0)
+   if (NE == 0)
    {
       return;
    }
@@ -1414,15 +1688,21 @@ void TensorProductPRefinementTransferOperator::MultTranspose(const Vector& x,
    elem_restrict_lex_h->Mult(x, localH);
    if (dim == 2)
    {
-      TransferKernels::Restriction2D(NE, D1D, Q1D, localH, localL, Bt, mask);
+      TransferKernels::Restriction2D(NE, NEL, NB, LD, HD, MD1D, MQ1D, NM,
+                                     l_sizes, h_sizes, l_offsets, h_offsets,
+                                     B, child_offsets, children, matrix_ids,
+                                     localH, localL, mask);
    }
    else if (dim == 3)
    {
-      TransferKernels::Restriction3D(NE, D1D, Q1D, localH, localL, Bt, mask);
+      TransferKernels::Restriction3D(NE, NEL, NB, LD, HD, MD1D, MQ1D, NM,
+                                     l_sizes, h_sizes, l_offsets, h_offsets,
+                                     B, child_offsets, children, matrix_ids,
+                                     localH, localL, mask);
    }
    else
    {
-      MFEM_ABORT("TensorProductPRefinementTransferOperator::MultTranspose not "
+      MFEM_ABORT("TensorProductTransferOperator::MultTranspose not "
                  "implemented for dim = "
                  << dim);
    }
@@ -1430,6 +1710,140 @@ void TensorProductPRefinementTransferOperator::MultTranspose(const Vector& x,
 }
 
 
+TensorProductPRefinementTransferOperator::
+TensorProductPRefinementTransferOperator(
+   const FiniteElementSpace& lFESpace_,
+   const FiniteElementSpace& hFESpace_)
+   : TensorProductTransferOperator(lFESpace_, hFESpace_)
+{
+   MFEM_VERIFY(NE == NEL, "the spaces must use the same mesh");
+   // Each element is its own parent, with the identity map
+   Array<int> elems(NE), map_ids(dim*NE);
+   for (int e = 0; e < NE; e++) { elems[e] = e; }
+   map_ids = 0;
+   Array<double> maps(2);
+   maps[0] = 0.0;
+   maps[1] = 1.0;
+   Setup(elems, map_ids, maps);
+}
+
+TensorProductPRefinementTransferOperator::
+~TensorProductPRefinementTransferOperator()
+{
+}
+
+bool TensorProductPRefinementTransferOperator::Supports(
+   const FiniteElementSpace& lFESpace, const FiniteElementSpace& hFESpace)
+{
+   return lFESpace.GetMesh()->GetNE() == hFESpace.GetMesh()->GetNE() &&
+          SupportedSpaces(lFESpace, hFESpace);
+}
+
+// Compute the affine maps x -> a + h*x, in each direction, from the reference
+// coordinates of the fine elements to the reference coordinates of their
+// parents, given by the point matrices of the refinement. Returns false if the
+// maps are not of this form.
+static bool GetAxisAlignedEmbeddings(const Mesh &fine_mesh,
+                                     const FiniteElementSpace &coarse_fes,
+                                     Array<int> &parents, Array<int> &map_ids,
+                                     Array<double> &maps)
+{
+   Mesh &mesh = const_cast<Mesh&>(fine_mesh);
+   const int dim = mesh.Dimension();
+   const int NE = mesh.GetNE();
+   const Geometry::Type geom = mesh.GetElementBaseGeometry(0);
+   const CoarseFineTransformations &rtrans = mesh.GetRefinementTransforms();
+   if (rtrans.embeddings.Size() != NE) { return false; }
+   const DenseTensor &pmats = rtrans.point_matrices[geom];
+   const IntegrationRule &verts = *Geometries.GetVertices(geom);
+
+   // The maps of the point matrices, dim x nmat
+   const int nmat = pmats.SizeK();
+   Array<int> pmat_ids(dim*nmat);
+   maps.SetSize(0);
+   for (int k = 0; k < nmat; k++)
+   {
+      const DenseMatrix &pm = pmats(k);
+      for (int d = 0; d < dim; d++)
+      {
+         // vertex 0 is the origin, vertices 1, 3 and 4 are on the axes
+         const int vd = (d == 0) ? 1 : ((d == 1) ? 3 : 4);
+         const double a = pm(d, 0);
+         const double h = pm(d, vd) - a;
+         if (h <= 0.0) { return false; }
+         for (int v = 0; v < verts.GetNPoints(); v++)
+         {
+            const IntegrationPoint &ip = verts.IntPoint(v);
+            const double x = (d == 0) ? ip.x : ((d == 1) ? ip.y : ip.z);
+            if (std::abs(pm(d, v) - (a + h*x)) > 1e-12) { return false; }
+         }
+         // reuse the maps common to several matrices and directions
+         int m = 0;
+         for (; m < maps.Size()/2; m++)
+         {
+            if (std::abs(maps[2*m] - a) < 1e-12 &&
+                std::abs(maps[2*m+1] - h) < 1e-12) { break; }
+         }
+         if (m == maps.Size()/2)
+         {
+            maps.Append(a);
+            maps.Append(h);
+         }
+         pmat_ids[d + dim*k] = m;
+      }
+   }
+
+   parents.SetSize(NE);
+   map_ids.SetSize(dim*NE);
+   for (int e = 0; e < NE; e++)
+   {
+      const Embedding &emb = rtrans.embeddings[e];
+      if (emb.parent < 0 || emb.parent >= coarse_fes.GetNE() ||
+          emb.matrix >= nmat)
+      {
+         return false;
+      }
+      parents[e] = emb.parent;
+      for (int d = 0; d < dim; d++)
+      {
+         map_ids[d + dim*e] = pmat_ids[d + dim*emb.matrix];
+      }
+   }
+   return true;
+}
+
+TensorProductHRefinementTransferOperator::
+TensorProductHRefinementTransferOperator(
+   const FiniteElementSpace& lFESpace_,
+   const FiniteElementSpace& hFESpace_)
+   : TensorProductTransferOperator(lFESpace_, hFESpace_)
+{
+   if (NE == 0) { return; }
+   Array<int> elem_parents, map_ids;
+   Array<double> maps;
+   const bool valid = GetAxisAlignedEmbeddings(*hFESpace.GetMesh(), lFESpace,
+                                               elem_parents, map_ids, maps);
+   MFEM_VERIFY(valid, "the refinement is not supported");
+   Setup(elem_parents, map_ids, maps);
+}
+
+bool TensorProductHRefinementTransferOperator::Supports(
+   const FiniteElementSpace& lFESpace, const FiniteElementSpace& hFESpace)
+{
+   const Mesh *hmesh = hFESpace.GetMesh();
+   if (hmesh == lFESpace.GetMesh() ||
+       hmesh->GetLastOperation() != Mesh::REFINE ||
+       !SupportedSpaces(lFESpace, hFESpace))
+   {
+      return false;
+   }
+   Array<int> elem_parents, map_ids;
+   Array<double> maps;
+   return GetAxisAlignedEmbeddings(*hmesh, lFESpace, elem_parents, map_ids,
+                                   maps);
+}
+
+
 TrueTransferOperator::TrueTransferOperator(const FiniteElementSpace& lFESpace_,
                                            const FiniteElementSpace& hFESpace_)
    : Operator(hFESpace_.GetTrueVSize(), lFESpace_.GetTrueVSize()),
@@ -362,9 +362,11 @@ public:
        If both spaces' FE collection pointers are pointing to the same
        collection we assume that the grid was refined while keeping the order
        constant. If the FE collections are different, it is assumed that both
-       spaces have are using the same mesh. If the first element of the
-       high-order space is a `TensorBasisElement`, the optimized tensor-product
-       transfers are used. If not, the general transfers used. */
+       spaces have are using the same mesh. If the elements of both spaces are
+       supported `TensorBasisElement`s, the optimized tensor-product transfers
+       are used, see TensorProductPRefinementTransferOperator and
+       TensorProductHRefinementTransferOperator. If not, the general transfers
+       are used. */
    TransferOperator(const FiniteElementSpace& lFESpace,
                     const FiniteElementSpace& hFESpace);
 
@@ -411,31 +413,87 @@ public:
    virtual void MultTranspose(const Vector& x, Vector& y) const override;
 };
 
-/// @brief Matrix-free transfer operator between finite element spaces on the
-/// same mesh exploiting the tensor product structure of the finite elements
-class TensorProductPRefinementTransferOperator : public Operator
+/** @brief Base class of the matrix-free transfer operators exploiting the
+    tensor product structure of the finite elements.
+
+    The element dofs of the coarse and fine spaces, in lexicographic order, are
+    split into blocks: one block for scalar elements (H1 and L2), and one block
+    per vector component for ND and RT elements. Each block is the tensor
+    product of 1D bases, and each fine element block is obtained from the
+    block of its coarse element by sum factorization with one 1D interpolation
+    matrix per direction. The dofs of the fine space have to be nodal, i.e.
+    point values of the (components of the) reference functions. */
+class TensorProductTransferOperator : public Operator
 {
-private:
+protected:
    const FiniteElementSpace& lFESpace;
    const FiniteElementSpace& hFESpace;
    int dim;
-   int NE;
-   int D1D;
-   int Q1D;
+   /// Number of fine and coarse elements
+   int NE, NEL;
+   /// Number of blocks per element, sizes of the element blocks
+   int NB, LD, HD;
+   /// Number of 1D interpolation matrices per direction and block
+   int NM;
+   /// Maximum 1D sizes of the coarse and fine blocks
+   int MD1D, MQ1D;
+   /// 1D sizes of the coarse and fine blocks, dim x NB
+   Array<int> l_sizes, h_sizes;
+   /// Offsets of the blocks in the coarse and fine element dofs
+   Array<int> l_offsets, h_offsets;
+   /// 1D interpolation matrices, MQ1D x MD1D x NM x dim x NB
    Array<double> B;
-   Array<double> Bt;
+   /// Coarse element of each fine element
+   Array<int> parents;
+   /// Matrix of each fine element in each direction, dim x NE
+   Array<int> matrix_ids;
+   /// Fine elements of each coarse element in CSR format
+   Array<int> child_offsets, children;
    const Operator* elem_restrict_lex_l;
    const Operator* elem_restrict_lex_h;
    Vector mask;
    mutable Vector localL;
    mutable Vector localH;
 
+   TensorProductTransferOperator(const FiniteElementSpace& lFESpace_,
+                                 const FiniteElementSpace& hFESpace_);
+
+   /** @brief Set up the transfer given the coarse element @a parents_ of the
+       fine elements and the affine maps from the fine to the coarse reference
+       coordinates in each direction.
+
+       The map of fine element e in direction d is x -> maps[2*m] +
+       maps[2*m+1]*x, with m = @a map_ids_[d+dim*e]. */
+   void Setup(const Array<int>& parents_, const Array<int>& map_ids_,
+              const Array<double>& maps);
+
+   /// Check if the elements and the meshes of the spaces are supported.
+   static bool SupportedSpaces(const FiniteElementSpace& lFESpace,
+                               const FiniteElementSpace& hFESpace);
+
+public:
+   /// @brief Interpolation or prolongation of a vector \p x corresponding to
+   /// the coarse space to the vector \p y corresponding to the fine space.
+   virtual void Mult(const Vector& x, Vector& y) const override;
+
+   /// Restriction by applying the transpose of the Mult method.
+   /** The vector \p x corresponding to the fine space is restricted to the
+   vector \p y corresponding to the coarse space. */
+   virtual void MultTranspose(const Vector& x, Vector& y) const override;
+};
+
+/// @brief Matrix-free transfer operator between finite element spaces on the
+/// same mesh exploiting the tensor product structure of the finite elements
+class TensorProductPRefinementTransferOperator :
+   public TensorProductTransferOperator
+{
 public:
    /// @brief Constructs a transfer operator from \p lFESpace to \p hFESpace
    /// which have different FE collections.
    /** No matrices are assembled, only the action to a vector is being computed.
-   The underlying finite elements need to be of type `TensorBasisElement`. It is
-   also assumed that all the elements in the spaces are of the same type. */
+   The underlying finite elements need to be H1, L2, ND or RT elements of type
+   `TensorBasisElement`, see Supports(). It is also assumed that all the
+   elements in the spaces are of the same type. */
    TensorProductPRefinementTransferOperator(
       const FiniteElementSpace& lFESpace_,
       const FiniteElementSpace& hFESpace_);
@@ -443,14 +501,39 @@ public:
    /// Destructor
    virtual ~TensorProductPRefinementTransferOperator();
 
-   /// @brief Interpolation or prolongation of a vector \p x corresponding to
-   /// the coarse space to the vector \p y corresponding to the fine space.
-   virtual void Mult(const Vector& x, Vector& y) const override;
+   /** @brief Check if the tensor-product transfer from \p lFESpace to
+       \p hFESpace is supported: both spaces use the same quadrilateral or
+       hexahedral mesh, scalar or matching ND or RT tensor-product elements,
+       and the elements of \p hFESpace are nodal. */
+   static bool Supports(const FiniteElementSpace& lFESpace,
+                        const FiniteElementSpace& hFESpace);
+};
 
-   /// Restriction by applying the transpose of the Mult method.
-   /** The vector \p x corresponding to the fine space is restricted to the
-   vector \p y corresponding to the coarse space. */
-   virtual void MultTranspose(const Vector& x, Vector& y) const override;
+/** @brief Matrix-free transfer operator between finite element spaces with the
+    same FE collection on a coarse mesh and on a refined mesh, exploiting the
+    tensor product structure of the finite elements.
+
+    The refinement has to map the fine reference elements to axis-aligned
+    boxes in the reference elements of their parents, as is the case for the
+    (uniform or anisotropic) refinement of quadrilaterals and hexahedra. */
+class TensorProductHRefinementTransferOperator :
+   public TensorProductTransferOperator
+{
+public:
+   /** @brief Constructs a transfer operator from \p lFESpace to \p hFESpace,
+       where the mesh of \p hFESpace was obtained by refining the mesh of
+       \p lFESpace, see Supports(). */
+   TensorProductHRefinementTransferOperator(
+      const FiniteElementSpace& lFESpace_,
+      const FiniteElementSpace& hFESpace_);
+
+   /** @brief Check if the tensor-product transfer from \p lFESpace to
+       \p hFESpace is supported, see also
+       TensorProductPRefinementTransferOperator::Supports(). The last
+       operation on the mesh of \p hFESpace must be the refinement of the
+       mesh of \p lFESpace. */
+   static bool Supports(const FiniteElementSpace& lFESpace,
+                        const FiniteElementSpace& hFESpace);
 };
 
 /// @brief Matrix-free transfer operator between finite element spaces working
@@ -13,25 +13,61 @@
 #define MFEM_ANNOTATION_HPP
 
 #include "../config/config.hpp"
+#include "error.hpp"
+#include "profiler.hpp"
+
+// The annotation macros open and close regions of the built-in Profiler, and
+// in addition Caliper regions when MFEM is built with Caliper. The function and
+// scope regions register their name once per call site, see
+// Profiler::RegisterRegion(), so the name given to a scope must be the same at
+// every call, e.g. a string literal.
 
 #ifdef MFEM_USE_CALIPER
 
 #include <caliper/cali.h>
 #include <caliper/cali-manager.h>
-#define MFEM_PERF_FUNCTION CALI_CXX_MARK_FUNCTION
-#define MFEM_PERF_BEGIN(s) CALI_MARK_BEGIN(s)
-#define MFEM_PERF_END(s) CALI_MARK_END(s)
+#define MFEM_PERF_FUNCTION CALI_CXX_MARK_FUNCTION; \
+  static const int mfem_perf_function_key = \
+     mfem::Profiler::RegisterRegion(_MFEM_FUNC_NAME); \
+  mfem::ProfilerRegion mfem_perf_function_region(mfem_perf_function_key)
+#define MFEM_PERF_BEGIN(s) \
+  do { CALI_MARK_BEGIN(s); mfem::Profiler::Begin(s); } while (0)
+#define MFEM_PERF_END(s) \
+  do { mfem::Profiler::End(s); CALI_MARK_END(s); } while (0)
 #define MFEM_PERF_SCOPE(name) \
-  cali::Annotation::Guard cali_autogenerated_guard_name(cali::Annotation("function").begin(std::string(name).c_str()))
+  cali::Annotation::Guard cali_autogenerated_guard_name(cali::Annotation("function").begin(std::string(name).c_str())); \
+  static const int mfem_perf_scope_key = \
+     mfem::Profiler::RegisterRegion(std::string(name).c_str()); \
+  mfem::ProfilerRegion mfem_perf_scope_region(mfem_perf_scope_key)
 
 
 #else
 
-#define MFEM_PERF_FUNCTION
-#define MFEM_PERF_BEGIN(s)
-#define MFEM_PERF_END(s)
-#define MFEM_PERF_SCOPE(name)
+#define MFEM_PERF_FUNCTION \
+  static const int mfem_perf_function_key = \
+     mfem::Profiler::RegisterRegion(_MFEM_FUNC_NAME); \
+  mfem::ProfilerRegion mfem_perf_function_region(mfem_perf_function_key)
+#define MFEM_PERF_BEGIN(s) mfem::Profiler::Begin(s)
+#define MFEM_PERF_END(s) mfem::Profiler::End(s)
+#define MFEM_PERF_SCOPE(name) \
+  static const int mfem_perf_scope_key = \
+     mfem::Profiler::RegisterRegion(std::string(name).c_str()); \
+  mfem::ProfilerRegion mfem_perf_scope_region(mfem_perf_scope_key)
 
 #endif
 
+// Fine-grained regions of the built-in Profiler, such as kernels or solver
+// iterations, only recorded after Profiler::EnableDetails().
+#define MFEM_PERF_DETAIL_FUNCTION \
+  static const int mfem_perf_function_key = \
+     mfem::Profiler::RegisterRegion(_MFEM_FUNC_NAME); \
+  mfem::ProfilerRegion mfem_perf_function_region(mfem_perf_function_key, true)
+#define MFEM_PERF_DETAIL_SCOPE(name) \
+  static const int mfem_perf_scope_key = \
+     mfem::Profiler::RegisterRegion(std::string(name).c_str()); \
+  mfem::ProfilerRegion mfem_perf_scope_region(mfem_perf_scope_key, true)
+
+// Register the analytic work of the current region, see Profiler::AddWork().
+#define MFEM_PERF_WORK(flops, bytes) mfem::Profiler::AddWork(flops, bytes)
+
 #endif
@@ -90,6 +90,24 @@ Device::Device()
          host_mem_type = MemoryType::HOST_64;
          device_mem_type = MemoryType::HOST_64;
       }
+      else if (mem_backend == "huge")
+      {
+         mem_host_env = true;
+         host_mem_type = MemoryType::HOST_HUGE;
+         device_mem_type = MemoryType::HOST_HUGE;
+      }
+      else if (mem_backend == "numa")
+      {
+         mem_host_env = true;
+         host_mem_type = MemoryType::HOST_NUMA;
+         device_mem_type = MemoryType::HOST_NUMA;
+      }
+      else if (mem_backend == "first-touch")
+      {
+         mem_host_env = true;
+         host_mem_type = MemoryType::HOST_FIRST_TOUCH;
+         device_mem_type = MemoryType::HOST_FIRST_TOUCH;
+      }
       else if (mem_backend == "umpire")
       {
          mem_host_env = true;
@@ -99,6 +117,15 @@ Device::Device()
          // Device::UpdateMemoryTypeAndClass().
          device_mem_type = MemoryType::HOST_UMPIRE;
       }
+      else if (mem_backend == "pool")
+      {
+         mem_host_env = true;
+         host_mem_type = MemoryType::HOST_POOL;
+         // Note: device_mem_type will be set to MemoryType::DEVICE_POOL only
+         // when an actual device is configured -- this is done later in
+         // Device::UpdateMemoryTypeAndClass().
+         device_mem_type = MemoryType::HOST_POOL;
+      }
       else if (mem_backend == "debug")
       {
          mem_host_env = true;
@@ -340,6 +367,9 @@ void Device::UpdateMemoryTypeAndClass()
                case MemoryType::HOST_DEBUG:
                   device_mem_type = MemoryType::DEVICE_DEBUG;
                   break;
+               case MemoryType::HOST_POOL:
+                  device_mem_type = MemoryType::DEVICE_POOL;
+                  break;
                default:
                   device_mem_type = MemoryType::DEVICE;
             }
@@ -363,6 +393,14 @@ void Device::UpdateMemoryTypeAndClass()
       device_mem_type = MemoryType::MANAGED;
    }
 
+   // Enable the memory pools when requested
+   if (device_option && !strcmp(device_option, "pool") &&
+       !mem_host_env && !mem_device_env)
+   {
+      host_mem_type = MemoryType::HOST_POOL;
+      device_mem_type = device ? MemoryType::DEVICE_POOL : MemoryType::HOST_POOL;
+   }
+
    // Enable the DEBUG mode when requested
    if (debug)
    {
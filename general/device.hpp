@@ -219,6 +219,10 @@ public:
          and evaluation of operators and enables the 'hip' backend to avoid
          transfers between host and device.
        * The 'debug' backend should not be combined with other device backends.
+       * The option 'pool' of a backend, e.g. 'cpu:pool' or 'cuda:pool', makes
+         the memory pools MemoryType::HOST_POOL and MemoryType::DEVICE_POOL
+         the default MemoryTypes, see MemoryPool. The environment variable
+         MFEM_MEMORY=pool has the same effect.
    */
    void Configure(const std::string &device, const int dev = 0);
 
@@ -16,6 +16,7 @@
 #include "array.hpp"
 #include "globals.hpp"
 #include <type_traits>
+#include <cstdint>
 
 namespace mfem
 {
@@ -25,8 +26,7 @@ namespace mfem
  */
 struct Hashed2
 {
-   int p1, p2;
-   int next;
+   int p1, p2; // NOTE: p1 == -1 marks an unused item
 };
 
 /** A concept for items that should be used in HashTable and be accessible by
@@ -35,7 +35,6 @@ struct Hashed2
 struct Hashed4
 {
    int p1, p2, p3; // NOTE: p4 is neither hashed nor stored
-   int next;
 };
 
 
@@ -62,7 +61,8 @@ struct Hashed4
  *  other items.
  *
  *  The item type (T) needs to follow either the Hashed2 or the Hashed4
- *  concept. It is easiest to just inherit from these structs.
+ *  concept. It is easiest to just inherit from these structs. The indices p1,
+ *  p2, ... must be non-negative.
  *
  *  All items in the container can also be accessed sequentially using the
  *  provided iterator.
@@ -71,11 +71,15 @@ struct Hashed4
  *   The data structure and implementation is based on a BlockArray<T> which
  *   provides an efficient item storage that avoids heap fragmentation, and
  *   index-based item access. The hash table implemented on top of the
- *   BlockArray provides fast associative (key -> value) access by grouping
- *   items into bins (buckets) of O(1) size.
+ *   BlockArray provides fast associative (key -> value) access using open
+ *   addressing with linear probing: each slot of the table holds the id of
+ *   one item (or -1 if the slot is empty) and a key is searched for in
+ *   consecutive slots, starting at its hashed position, until it is found or
+ *   an empty slot is reached. Compared to chaining, no links need to be stored
+ *   in the items and the probed slots are contiguous in memory.
  *   - "id" denotes the index of an item in the underlying BlockArray<T>,
- *   - "idx" denotes the index of a bin, determined by hashing a key with
- *     the function `Hash`.
+ *   - "idx" denotes the index of a slot, determined by hashing a key with
+ *     the function `Hash` and probing.
  */
 template<typename T>
 class HashTable : public BlockArray<T>
@@ -231,7 +235,7 @@ public:
        @param[in] id Index of the item in the underlying BlockArray<T>.
 
        @warning It is assumed that 0 <= id < NumIds(). */
-   bool IdExists(int id) const { return (Base::At(id).next != -2); }
+   bool IdExists(int id) const { return (Base::At(id).p1 != -1); }
 
    /** @brief Remove an item from the hash table.
 
@@ -289,7 +293,11 @@ public:
    /// @brief Write details of the memory usage to the mfem output stream.
    void PrintMemoryDetail() const;
 
-   /// @brief Print a histogram of bin sizes for debugging purposes.
+   /** @brief Print the table size, the item count and a histogram of the
+       probe distances of the items, for debugging purposes. */
+   /** The probe distance of an item is the number of slots between its home
+       slot and the slot where it is stored; the last bin of the histogram
+       also counts the larger distances. */
    void PrintStats() const;
 
    class iterator : public Base::iterator
@@ -301,13 +309,13 @@ public:
       iterator() { }
       iterator(const base &it) : base(it)
       {
-         while (base::good() && (*this)->next == -2) { base::next(); }
+         while (base::good() && (*this)->p1 == -1) { base::next(); }
       }
 
    public:
       iterator &operator++()
       {
-         while (base::next(), base::good() && (*this)->next == -2) { }
+         while (base::next(), base::good() && (*this)->p1 == -1) { }
          return *this;
       }
    };
@@ -321,13 +329,13 @@ public:
       const_iterator() { }
       const_iterator(const base &it) : base(it)
       {
-         while (base::good() && (*this)->next == -2) { base::next(); }
+         while (base::good() && (*this)->p1 == -1) { base::next(); }
       }
 
    public:
       const_iterator &operator++()
       {
-         while (base::next(), base::good() && (*this)->next == -2) { }
+         while (base::next(), base::good() && (*this)->p1 == -1) { }
          return *this;
       }
    };
@@ -339,9 +347,9 @@ public:
    const_iterator cend() const { return const_iterator(); }
 
 protected:
-   /** The hash table: each bin is a linked list of items. For each non-empty
-       bin, this arrays stores the 'id' of the first item in the list, or -1
-       if the bin is empty. */
+   /** The hash table: each slot stores the 'id' of an item, or -1 if the slot
+       is empty. The items hashed to the same slot are stored in the following
+       slots (linear probing). At most 3/4 of the slots are used. */
    int* table;
 
    /** mask = table_size-1. Used for fast modulo operation in Hash(), to wrap
@@ -353,29 +361,44 @@ protected:
        these ids first, before they are appended to the block array. */
    Array<int> unused;
 
+   /** @brief Scramble the bits of a raw hash value.
+
+       Linear probing is sensitive to clustering, so the low bits used to index
+       the table need to depend on all bits of the keys. */
+   static inline std::uint64_t Mix(std::uint64_t h)
+   {
+      h ^= h >> 31;
+      h *= 0x7fb5d329728ea185ull;
+      h ^= h >> 27;
+      return h;
+   }
+
    /** @brief hash function for Hashed2 items.
 
        @param[in] p1 First part of the key.
        @param[in] p2 Second part of the key.
-       @return The hash key "idx" identifying a bin/bucket.
+       @return The hash key "idx" identifying the initial slot.
 
        NOTE: the constants are arbitrary
        @warning This method should only be called if T inherits from Hashed2. */
-   inline int Hash(size_t p1, size_t p2) const
-   { return (984120265ul*p1 + 125965121ul*p2) & mask; }
+   inline int Hash(std::uint64_t p1, std::uint64_t p2) const
+   { return int(Mix(984120265ull*p1 + 125965121ull*p2) & mask); }
 
    /** @brief hash function for Hashed4 items.
 
        @param[in] p1 First part of the key.
        @param[in] p2 Second part of the key.
        @param[in] p3 Third part of the key.
-       @return The hash key "idx" identifying a bin/bucket.
+       @return The hash key "idx" identifying the initial slot.
 
        NOTE: The constants are arbitrary.
        NOTE: p4 is not hashed nor stored as p1, p2, p3 identify a face uniquely.
        @warning This method should only be called if T inherits from Hashed4. */
-   inline int Hash(size_t p1, size_t p2, size_t p3) const
-   { return (984120265ul*p1 + 125965121ul*p2 + 495698413ul*p3) & mask; }
+   inline int Hash(std::uint64_t p1, std::uint64_t p2, std::uint64_t p3) const
+   {
+      return int(Mix(984120265ull*p1 + 125965121ull*p2 + 495698413ull*p3)
+                 & mask);
+   }
 
    // Delete() and Reparent() use one of these:
    /// @brief Hash function for items of type T that inherit from Hashed2.
@@ -386,43 +409,46 @@ protected:
    inline int Hash(const Hashed4& item) const
    { return Hash(item.p1, item.p2, item.p3); }
 
-   /** @brief Search the index of the item associated to the key (p1,p2)
-       starting from the item with index @a id.
+   /** @brief Search for the key (p1,p2) starting from the slot @a idx.
 
-       @param[in] id Index of the item in the underlying BlockArray<T>.
+       @param[in,out] idx On input, the initial slot. On output, the slot
+                          holding the item or, if not found, the first empty
+                          slot where the item can be inserted.
        @param[in] p1 First part of the key.
        @param[in] p2 Second part of the key.
-       @return The index "id" of the key in the BlockArray<T>.
+       @return The index "id" of the key in the BlockArray<T>, or -1.
 
        @warning This method should only be called if T inherits from Hashed2. */
-   int SearchList(int id, int p1, int p2) const;
+   inline int Probe(int &idx, int p1, int p2) const;
 
-   /** @brief Search the index of the item associated to the key (p1,p2,p3,(p4))
-       starting from the item with index @a id.
+   /** @brief Search for the key (p1,p2,p3,(p4)) starting from the slot @a idx.
 
-       @param[in] id Index of the item in the underlying BlockArray<T>.
+       @param[in,out] idx On input, the initial slot. On output, the slot
+                          holding the item or, if not found, the first empty
+                          slot where the item can be inserted.
        @param[in] p1 First part of the key.
        @param[in] p2 Second part of the key.
        @param[in] p3 Third part of the key.
-       @return The index "id" of the key in the BlockArray<T>.
+       @return The index "id" of the key in the BlockArray<T>, or -1.
 
        @warning This method should only be called if T inherits from Hashed4. */
-   int SearchList(int id, int p1, int p2, int p3) const;
+   inline int Probe(int &idx, int p1, int p2, int p3) const;
 
-   /** @brief Insert the item 'id' into bin 'idx'.
+   /** @brief Insert the item 'id' into the first empty slot starting from
+       slot 'idx'.
 
-       @param[in] idx The bin/bucket index.
+       @param[in] idx The initial slot, usually Hash(item).
        @param[in] id The index of the item in the BlockArray<T>.
-       @param[in] item The item to insert at the beginning of the linked list.
 
-       @warning The method only works with bin 'idx' and does not check the
-                overall fill factor of the hash table. If appropriate,
-                use CheckRehash() for that. */
-   inline void Insert(int idx, int id, T &item);
+       @warning The method does not check the overall fill factor of the hash
+                table. If appropriate, use CheckRehash() for that. */
+   inline void Insert(int idx, int id);
 
-   /** @brief Unlink an item @a id from the linked list of bin @a idx.
+   /** @brief Remove the item @a id from the table, starting the search at the
+       slot @a idx. The items following it in the probe sequence are shifted
+       back so that no "deleted" markers are needed.
 
-       @param[in] idx The bin/bucket index.
+       @param[in] idx The initial slot, i.e., Hash(item).
        @param[in] id The index of the item in the BlockArray<T>.
 
        @warning The method aborts if the item is not found. */
@@ -430,23 +456,24 @@ protected:
 
    /** @brief Check table fill factor and resize if necessary.
 
-       The method checks the average size of the bins (i.e., the fill factor).
-       If the fill factor is > 2, the table is enlarged (see DoRehash()). */
+       The method checks the fraction of used slots (i.e., the fill factor).
+       If the fill factor is > 3/4, the table is enlarged (see DoRehash()). */
    inline void CheckRehash();
 
-   /** @brief Double the size of the hash table (i.e., double the number of bins)
-       and reinsert all items into the new bins.
+   /** @brief Double the size of the hash table (i.e., double the number of
+       slots) and reinsert all items into the new table.
 
        NOTE: Rehashing is computationally expensive (O(N) in the number of items),
        but since it is only done rarely (when the number of items doubles),
        the amortized complexity of inserting an item is still O(1). */
    void DoRehash();
 
-   /** @brief Return the size of the bin "idx".
+   /** @brief Return the distance of the item in slot "idx" from its initial
+       slot, i.e., the number of extra probes needed to find it.
 
-       @param[in] idx The index of the bin.
-       @return The size of the bin. */
-   int BinSize(int idx) const;
+       @param[in] idx The index of a non-empty slot.
+       @return The probe distance. */
+   int ProbeDistance(int idx) const;
 };
 
 
@@ -610,7 +637,7 @@ int HashTable<T>::GetId(int p1, int p2)
    // search for the item in the hashtable
    if (p1 > p2) { std::swap(p1, p2); }
    int idx = Hash(p1, p2);
-   int id = SearchList(table[idx], p1, p2);
+   int id = Probe(idx, p1, p2);
    if (id >= 0) { return id; }
 
    // not found - use an unused item or create a new one
@@ -628,8 +655,8 @@ int HashTable<T>::GetId(int p1, int p2)
    item.p1 = p1;
    item.p2 = p2;
 
-   // insert into hashtable
-   Insert(idx, new_id, item);
+   // insert into the empty slot found by Probe()
+   table[idx] = new_id;
    CheckRehash();
 
    return new_id;
@@ -641,7 +668,7 @@ int HashTable<T>::GetId(int p1, int p2, int p3, int p4)
    // search for the item in the hashtable
    internal::sort4_ext(p1, p2, p3, p4);
    int idx = Hash(p1, p2, p3);
-   int id = SearchList(table[idx], p1, p2, p3);
+   int id = Probe(idx, p1, p2, p3);
    if (id >= 0) { return id; }
 
    // not found - use an unused item or create a new one
@@ -660,8 +687,8 @@ int HashTable<T>::GetId(int p1, int p2, int p3, int p4)
    item.p2 = p2;
    item.p3 = p3;
 
-   // insert into hashtable
-   Insert(idx, new_id, item);
+   // insert into the empty slot found by Probe()
+   table[idx] = new_id;
    CheckRehash();
 
    return new_id;
@@ -699,36 +726,40 @@ template<typename T>
 int HashTable<T>::FindId(int p1, int p2) const
 {
    if (p1 > p2) { std::swap(p1, p2); }
-   return SearchList(table[Hash(p1, p2)], p1, p2);
+   int idx = Hash(p1, p2);
+   return Probe(idx, p1, p2);
 }
 
 template<typename T>
 int HashTable<T>::FindId(int p1, int p2, int p3, int p4) const
 {
    internal::sort4_ext(p1, p2, p3, p4);
-   return SearchList(table[Hash(p1, p2, p3)], p1, p2, p3);
+   int idx = Hash(p1, p2, p3);
+   return Probe(idx, p1, p2, p3);
 }
 
 template<typename T>
-int HashTable<T>::SearchList(int id, int p1, int p2) const
+inline int HashTable<T>::Probe(int &idx, int p1, int p2) const
 {
-   while (id >= 0)
+   int id;
+   while ((id = table[idx]) >= 0)
    {
       const T& item = Base::At(id);
       if (item.p1 == p1 && item.p2 == p2) { return id; }
-      id = item.next;
+      idx = (idx + 1) & mask;
    }
    return -1;
 }
 
 template<typename T>
-int HashTable<T>::SearchList(int id, int p1, int p2, int p3) const
+inline int HashTable<T>::Probe(int &idx, int p1, int p2, int p3) const
 {
-   while (id >= 0)
+   int id;
+   while ((id = table[idx]) >= 0)
    {
       const T& item = Base::At(id);
       if (item.p1 == p1 && item.p2 == p2 && item.p3 == p3) { return id; }
-      id = item.next;
+      idx = (idx + 1) & mask;
    }
    return -1;
 }
@@ -736,10 +767,8 @@ int HashTable<T>::SearchList(int id, int p1, int p2, int p3) const
 template<typename T>
 inline void HashTable<T>::CheckRehash()
 {
-   const int fill_factor = 2;
-
-   // is the table overfull?
-   if (Base::Size() > (mask+1) * fill_factor)
+   // is the table overfull? (fill factor > 3/4)
+   if (4*(long) Size() > 3*((long) mask+1))
    {
       DoRehash();
    }
@@ -764,34 +793,46 @@ void HashTable<T>::DoRehash()
    // reinsert all items
    for (iterator it = begin(); it != end(); ++it)
    {
-      Insert(Hash(*it), it.index(), *it);
+      Insert(Hash(*it), it.index());
    }
 }
 
 template<typename T>
-inline void HashTable<T>::Insert(int idx, int id, T &item)
+inline void HashTable<T>::Insert(int idx, int id)
 {
-   // add item at the beginning of the linked list
-   item.next = table[idx];
+   while (table[idx] >= 0) { idx = (idx + 1) & mask; }
    table[idx] = id;
 }
 
 template<typename T>
 void HashTable<T>::Unlink(int idx, int id)
 {
-   // remove item from the linked list
-   int* p_id = table + idx;
-   while (*p_id >= 0)
+   // find the slot of the item
+   while (table[idx] != id)
    {
-      T& item = Base::At(*p_id);
-      if (*p_id == id)
+      MFEM_VERIFY(table[idx] >= 0, "HashTable<>::Unlink: item not found!");
+      idx = (idx + 1) & mask;
+   }
+
+   // backward shift deletion: move back the following items of the probe
+   // sequence, unless their initial slot lies cyclically in (idx, next]
+   int next = idx;
+   while (true)
+   {
+      next = (next + 1) & mask;
+      const int next_id = table[next];
+      if (next_id < 0) { break; }
+
+      const int home = Hash(Base::At(next_id));
+      const bool stays = (idx <= next) ? (idx < home && home <= next)
+                         /*         */ : (idx < home || home <= next);
+      if (!stays)
       {
-         *p_id = item.next;
-         return;
+         table[idx] = next_id;
+         idx = next;
       }
-      p_id = &(item.next);
    }
-   MFEM_ABORT("HashTable<>::Unlink: item not found!");
+   table[idx] = -1;
 }
 
 template<typename T>
@@ -799,7 +840,7 @@ void HashTable<T>::Delete(int id)
 {
    T& item = Base::At(id);
    Unlink(Hash(item), id);
-   item.next = -2;    // mark item as unused
+   item.p1 = -1;      // mark item as unused
    unused.Append(id); // add its id to the unused ids
 }
 
@@ -817,17 +858,16 @@ void HashTable<T>::Alloc(int id, int p1, int p2)
    // enlarge the BlockArray to hold 'id'
    while (id >= Base::Size())
    {
-      Base::At(Base::Append()).next = -2; // append "unused" items
+      Base::At(Base::Append()).p1 = -1; // append "unused" items
    }
 
    T& item = Base::At(id);
-   if (item.next == -2)
+   if (item.p1 == -1)
    {
-      item.next = -1;
       item.p1 = p1;
       item.p2 = p2;
 
-      Insert(Hash(p1, p2), id, item);
+      Insert(Hash(p1, p2), id);
       CheckRehash();
    }
 }
@@ -838,7 +878,7 @@ void HashTable<T>::UpdateUnused()
    unused.DeleteAll();
    for (int i = 0; i < Base::Size(); i++)
    {
-      if (Base::At(i).next == -2) { unused.Append(i); }
+      if (Base::At(i).p1 == -1) { unused.Append(i); }
    }
 }
 
@@ -853,8 +893,7 @@ void HashTable<T>::Reparent(int id, int new_p1, int new_p2)
    item.p2 = new_p2;
 
    // reinsert under new parent IDs
-   int new_idx = Hash(new_p1, new_p2);
-   Insert(new_idx, id, item);
+   Insert(Hash(new_p1, new_p2), id);
 }
 
 template<typename T>
@@ -870,8 +909,7 @@ void HashTable<T>::Reparent(int id,
    item.p3 = new_p3;
 
    // reinsert under new parent IDs
-   int new_idx = Hash(new_p1, new_p2, new_p3);
-   Insert(new_idx, id, item);
+   Insert(Hash(new_p1, new_p2, new_p3), id);
 }
 
 template<typename T>
@@ -888,17 +926,10 @@ void HashTable<T>::PrintMemoryDetail() const
 }
 
 template<typename T>
-int HashTable<T>::BinSize(int idx) const
+int HashTable<T>::ProbeDistance(int idx) const
 {
-   int count = 0;
-   int id = table[idx];
-   while (id >= 0)
-   {
-      const T& item = Base::At(id);
-      id = item.next;
-      count++;
-   }
-   return count;
+   const int home = Hash(Base::At(table[idx]));
+   return (idx - home) & mask;
 }
 
 template<typename T>
@@ -916,16 +947,17 @@ void HashTable<T>::PrintStats() const
 
    for (int i = 0; i < table_size; i++)
    {
-      int bs = BinSize(i);
-      if (bs >= H) { bs = H-1; }
-      hist[bs]++;
+      if (table[i] < 0) { continue; }
+      int pd = ProbeDistance(i);
+      if (pd >= H) { pd = H-1; }
+      hist[pd]++;
    }
 
-   mfem::out << "Bin size histogram:\n";
+   mfem::out << "Probe distance histogram:\n";
    for (int i = 0; i < H; i++)
    {
-      mfem::out << "  size " << i << ": "
-                << hist[i] << " bins" << std::endl;
+      mfem::out << "  distance " << i << ": "
+                << hist[i] << " items" << std::endl;
    }
 }
 
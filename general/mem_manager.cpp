@@ -11,6 +11,7 @@
 
 #include "forall.hpp"
 #include "mem_manager.hpp"
+#include "mem_pool.hpp"
 
 #include <list>
 #include <cstring> // std::memcpy, std::memcmp
@@ -25,6 +26,7 @@
 #include <unistd.h>
 #include <signal.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #define mfem_memalign(p,a,s) posix_memalign(p,a,s)
 #define mfem_aligned_free free
 #else
@@ -397,6 +399,154 @@ public:
    { MmuAllow(MmuAddrP(ptr), MmuLengthP(ptr, bytes)); }
 };
 
+// Size of the arrays placed by the large host memory spaces, see
+// LargeHostMemorySpace, and of the transparent huge pages.
+constexpr size_t LargeBytes = size_t(2) << 20;
+
+#ifndef _WIN32
+/// Map @a bytes, rounded up to a multiple of @a align, at an address aligned
+/// at @a align, through ::mmap
+inline void *LargeAlloc(const size_t bytes, const size_t align)
+{
+   const size_t length = (bytes + align - 1) / align * align;
+   const size_t extra = align > (size_t) sysconf(_SC_PAGE_SIZE) ? align : 0;
+   const int prot = PROT_READ | PROT_WRITE;
+   const int flags = MAP_ANONYMOUS | MAP_PRIVATE;
+   void *ptr = ::mmap(NULL, length + extra, prot, flags, -1, 0);
+   if (ptr == MAP_FAILED) { throw ::std::bad_alloc(); }
+   if (extra == 0) { return ptr; }
+   // unmap the parts of the mapping before and after the aligned region
+   const uintptr_t addr = (uintptr_t) ptr;
+   const uintptr_t aligned = (addr + align - 1) & ~(uintptr_t)(align - 1);
+   if (aligned > addr) { ::munmap(ptr, aligned - addr); }
+   if (extra > aligned - addr)
+   {
+      ::munmap((void*) (aligned + length), extra - (aligned - addr));
+   }
+   return (void*) aligned;
+}
+
+/// Unmap the region of @a bytes, mapped by LargeAlloc with @a align
+inline void LargeDealloc(void *ptr, const size_t bytes, const size_t align)
+{
+   const size_t length = (bytes + align - 1) / align * align;
+   if (::munmap(ptr, length) == -1) { mfem_error("Dealloc error!"); }
+}
+
+/// Request transparent huge pages, through ::madvise
+inline void HugePages(void *ptr, const size_t length)
+{
+#ifdef MADV_HUGEPAGE
+   ::madvise(ptr, length, MADV_HUGEPAGE);
+#else
+   MFEM_CONTRACT_VAR(ptr);
+   MFEM_CONTRACT_VAR(length);
+#endif
+}
+
+/// Interleave the pages over the NUMA nodes allowed to the process, through
+/// the mbind system call. Nothing is done if the system call fails.
+inline void NumaInterleave(void *ptr, const size_t length)
+{
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+   // MPOL_INTERLEAVE and MPOL_F_MEMS_ALLOWED from <linux/mempolicy.h>
+   const int mpol_interleave = 3;
+   const unsigned long mpol_f_mems_allowed = 1 << 2;
+   unsigned long nodes[16] = { 0 };
+   const unsigned long maxnode = 8 * sizeof(nodes);
+   if (syscall(SYS_get_mempolicy, NULL, nodes, maxnode, NULL,
+               mpol_f_mems_allowed) != 0) { return; }
+   syscall(SYS_mbind, ptr, length, mpol_interleave, nodes, maxnode, 0);
+#else
+   MFEM_CONTRACT_VAR(ptr);
+   MFEM_CONTRACT_VAR(length);
+#endif
+}
+#else
+inline void *LargeAlloc(const size_t bytes, const size_t align)
+{
+   void *ptr;
+   if (mfem_memalign(&ptr, align, bytes) != 0) { throw ::std::bad_alloc(); }
+   return ptr;
+}
+inline void LargeDealloc(void *ptr, const size_t, const size_t)
+{ mfem_aligned_free(ptr); }
+inline void HugePages(void*, const size_t) { }
+inline void NumaInterleave(void*, const size_t) { }
+#endif
+
+/// Touch the pages in parallel, with the static OpenMP schedule used by the
+/// host kernels, so that they are placed on the NUMA nodes of the threads
+inline void FirstTouch(void *ptr, const size_t length)
+{
+#ifdef MFEM_USE_OPENMP
+   const long page = 4096;
+   const long npages = (long) ((length + page - 1) / page);
+   char *p = static_cast<char*>(ptr);
+   #pragma omp parallel for schedule(static)
+   for (long i = 0; i < npages; i++) { p[i*page] = 0; }
+#else
+   MFEM_CONTRACT_VAR(ptr);
+   MFEM_CONTRACT_VAR(length);
+#endif
+}
+
+/// The host memory space base class for large arrays: the arrays of at least
+/// LargeBytes are mapped and placed by Place(), the smaller arrays are aligned
+/// at 64 bytes.
+class LargeHostMemorySpace : public HostMemorySpace
+{
+protected:
+   const size_t align;
+   virtual void Place(void *ptr, size_t length) = 0;
+
+public:
+   LargeHostMemorySpace(size_t a): HostMemorySpace(), align(a) { }
+   void Alloc(void **ptr, size_t bytes)
+   {
+      if (bytes < LargeBytes)
+      {
+         if (mfem_memalign(ptr, 64, bytes) != 0) { throw ::std::bad_alloc(); }
+         return;
+      }
+      *ptr = LargeAlloc(bytes, align);
+      Place(*ptr, (bytes + align - 1) / align * align);
+   }
+   void Dealloc(void *ptr)
+   {
+      const size_t bytes = maps->memories.at(ptr).bytes;
+      if (bytes < LargeBytes) { mfem_aligned_free(ptr); }
+      else { LargeDealloc(ptr, bytes, align); }
+   }
+};
+
+/// The transparent huge pages host memory space
+class HugeHostMemorySpace : public LargeHostMemorySpace
+{
+protected:
+   void Place(void *ptr, size_t length) { HugePages(ptr, length); }
+public:
+   HugeHostMemorySpace(): LargeHostMemorySpace(LargeBytes) { }
+};
+
+/// The NUMA interleaved host memory space
+class NumaHostMemorySpace : public LargeHostMemorySpace
+{
+protected:
+   void Place(void *ptr, size_t length) { NumaInterleave(ptr, length); }
+public:
+   NumaHostMemorySpace(): LargeHostMemorySpace(4096) { }
+};
+
+/// The parallel first touch host memory space
+class FirstTouchHostMemorySpace : public LargeHostMemorySpace
+{
+protected:
+   void Place(void *ptr, size_t length) { FirstTouch(ptr, length); }
+public:
+   FirstTouchHostMemorySpace(): LargeHostMemorySpace(4096) { }
+};
+
 /// The UVM host memory space
 class UvmHostMemorySpace : public HostMemorySpace
 {
@@ -523,6 +673,59 @@ public:
    { return std::memcpy(dst, src, bytes); }
 };
 
+/// The pool host memory space
+class PoolHostMemorySpace : public HostMemorySpace
+{
+public:
+   PoolHostMemorySpace(): HostMemorySpace() { }
+   ~PoolHostMemorySpace() { MemoryPool::Release(MemoryType::HOST_POOL); }
+   void Alloc(void **ptr, size_t bytes)
+   { *ptr = MemoryPool::Allocate(MemoryType::HOST_POOL, bytes); }
+   void Dealloc(void *ptr)
+   {
+      MemoryPool::Deallocate(MemoryType::HOST_POOL, ptr,
+                             maps->memories.at(ptr).bytes);
+   }
+};
+
+#if defined(MFEM_USE_CUDA) || defined(MFEM_USE_HIP)
+/// The pool device memory space
+class PoolDeviceMemorySpace : public DeviceMemorySpace
+{
+public:
+   PoolDeviceMemorySpace(): DeviceMemorySpace() { }
+   ~PoolDeviceMemorySpace() { MemoryPool::Release(MemoryType::DEVICE_POOL); }
+   void Alloc(Memory &base)
+   { base.d_ptr = MemoryPool::Allocate(MemoryType::DEVICE_POOL, base.bytes); }
+   void Dealloc(Memory &base)
+   { MemoryPool::Deallocate(MemoryType::DEVICE_POOL, base.d_ptr, base.bytes); }
+   void *HtoD(void *dst, const void *src, size_t bytes)
+   {
+#ifdef MFEM_USE_CUDA
+      return CuMemcpyHtoD(dst, src, bytes);
+#else
+      return HipMemcpyHtoD(dst, src, bytes);
+#endif
+   }
+   void *DtoD(void* dst, const void* src, size_t bytes)
+   {
+#ifdef MFEM_USE_CUDA
+      return CuMemcpyDtoD(dst, src, bytes);
+#else
+      return HipMemcpyDtoDAsync(dst, src, bytes);
+#endif
+   }
+   void *DtoH(void *dst, const void *src, size_t bytes)
+   {
+#ifdef MFEM_USE_CUDA
+      return CuMemcpyDtoH(dst, src, bytes);
+#else
+      return HipMemcpyDtoH(dst, src, bytes);
+#endif
+   }
+};
+#endif // MFEM_USE_CUDA || MFEM_USE_HIP
+
 #ifdef MFEM_USE_UMPIRE
 class UmpireMemorySpace
 {
@@ -643,7 +846,8 @@ public:
       }
 
       // Filling the host memory backends
-      // HOST, HOST_32 & HOST_64 are always ready
+      // HOST, HOST_32, HOST_64, HOST_HUGE, HOST_NUMA & HOST_FIRST_TOUCH are
+      // always ready
       // MFEM_USE_UMPIRE will set either [No/Umpire] HostMemorySpace
       host[static_cast<int>(MT::HOST)] = new StdHostMemorySpace();
       host[static_cast<int>(MT::HOST_32)] = new Aligned32HostMemorySpace();
@@ -651,6 +855,11 @@ public:
       // HOST_DEBUG is delayed, as it reroutes signals
       host[static_cast<int>(MT::HOST_DEBUG)] = nullptr;
       host[static_cast<int>(MT::HOST_UMPIRE)] = nullptr;
+      host[static_cast<int>(MT::HOST_POOL)] = nullptr;
+      host[static_cast<int>(MT::HOST_HUGE)] = new HugeHostMemorySpace();
+      host[static_cast<int>(MT::HOST_NUMA)] = new NumaHostMemorySpace();
+      host[static_cast<int>(MT::HOST_FIRST_TOUCH)] =
+         new FirstTouchHostMemorySpace();
       host[static_cast<int>(MT::MANAGED)] = new UvmHostMemorySpace();
 
       // Filling the device memory backends, shifting with the device size
@@ -661,6 +870,7 @@ public:
       device[static_cast<int>(MT::DEVICE_DEBUG)-shift] = nullptr;
       device[static_cast<int>(MT::DEVICE_UMPIRE)-shift] = nullptr;
       device[static_cast<int>(MT::DEVICE_UMPIRE_2)-shift] = nullptr;
+      device[static_cast<int>(MT::DEVICE_POOL)-shift] = nullptr;
    }
 
    HostMemorySpace* Host(const MemoryType mt)
@@ -704,6 +914,7 @@ private:
          case MT::HOST_UMPIRE: return new NoHostMemorySpace();
 #endif
          case MT::HOST_PINNED: return new HostPinnedMemorySpace();
+         case MT::HOST_POOL: return new PoolHostMemorySpace();
          default: MFEM_ABORT("Unknown host memory controller!");
       }
       return nullptr;
@@ -725,6 +936,11 @@ private:
          case MT::DEVICE_UMPIRE_2: return new NoDeviceMemorySpace();
 #endif
          case MT::DEVICE_DEBUG: return new MmuDeviceMemorySpace();
+#if defined(MFEM_USE_CUDA) || defined(MFEM_USE_HIP)
+         case MT::DEVICE_POOL: return new PoolDeviceMemorySpace();
+#else
+         case MT::DEVICE_POOL: return new NoDeviceMemorySpace();
+#endif
          case MT::DEVICE:
          {
 #if defined(MFEM_USE_CUDA)
@@ -746,6 +962,39 @@ private:
 
 static internal::Ctrl *ctrl;
 
+// Allocation and deallocation of the host and device memory spaces, recorded
+// by the MemoryUsage accounting.
+static void HostAlloc(MemoryType h_mt, void **ptr, size_t bytes)
+{
+   ctrl->Host(h_mt)->Alloc(ptr, bytes);
+   if (MemoryUsage::IsActive()) { MemoryUsage::Allocate(*ptr, bytes, h_mt); }
+}
+
+static void HostDealloc(MemoryType h_mt, void *ptr)
+{
+   if (MemoryUsage::IsActive()) { MemoryUsage::Deallocate(ptr, h_mt); }
+   ctrl->Host(h_mt)->Dealloc(ptr);
+}
+
+// The managed device memory space shares the host allocation.
+static void DeviceAlloc(MemoryType d_mt, internal::Memory &mem)
+{
+   ctrl->Device(d_mt)->Alloc(mem);
+   if (MemoryUsage::IsActive() && mem.d_ptr != mem.h_ptr)
+   {
+      MemoryUsage::Allocate(mem.d_ptr, mem.bytes, d_mt);
+   }
+}
+
+static void DeviceDealloc(internal::Memory &mem)
+{
+   if (MemoryUsage::IsActive() && mem.d_ptr != mem.h_ptr)
+   {
+      MemoryUsage::Deallocate(mem.d_ptr, mem.d_mt);
+   }
+   ctrl->Device(mem.d_mt)->Dealloc(mem);
+}
+
 void *MemoryManager::New_(void *h_tmp, size_t bytes, MemoryType mt,
                           unsigned &flags)
 {
@@ -783,7 +1032,7 @@ void *MemoryManager::New_(void *h_tmp, size_t bytes, MemoryType h_mt,
    MFEM_ASSERT((valid_flags & ~(Mem::VALID_HOST | Mem::VALID_DEVICE)) == 0,
                "Internal error");
    void *h_ptr;
-   if (h_tmp == nullptr) { ctrl->Host(h_mt)->Alloc(&h_ptr, bytes); }
+   if (h_tmp == nullptr) { HostAlloc(h_mt, &h_ptr, bytes); }
    else { h_ptr = h_tmp; }
    flags = Mem::REGISTERED | Mem::OWNS_INTERNAL | Mem::OWNS_HOST |
            Mem::OWNS_DEVICE | valid_flags;
@@ -833,7 +1082,7 @@ void *MemoryManager::Register_(void *ptr, void *h_tmp, size_t bytes,
    {
       MFEM_VERIFY(ptr || bytes == 0,
                   "cannot register NULL device pointer with bytes = " << bytes);
-      if (h_tmp == nullptr) { ctrl->Host(h_mt)->Alloc(&h_ptr, bytes); }
+      if (h_tmp == nullptr) { HostAlloc(h_mt, &h_ptr, bytes); }
       else { h_ptr = h_tmp; }
       mm.InsertDevice(ptr, h_ptr, bytes, h_mt, d_mt);
       flags = own ? flags | Mem::OWNS_DEVICE : flags & ~Mem::OWNS_DEVICE;
@@ -937,7 +1186,7 @@ MemoryType MemoryManager::Delete_(void *h_ptr, MemoryType h_mt, unsigned flags)
    else // Known
    {
       if (owns_host && (h_mt != MemoryType::HOST))
-      { ctrl->Host(h_mt)->Dealloc(h_ptr); }
+      { HostDealloc(h_mt, h_ptr); }
       if (owns_internal)
       {
          MFEM_ASSERT(mm.IsKnown(h_ptr), "");
@@ -1000,6 +1249,7 @@ bool MemoryManager::MemoryClassCheck_(MemoryClass mc, void *h_ptr,
                      d_mt == MemoryType::DEVICE_DEBUG ||
                      d_mt == MemoryType::DEVICE_UMPIRE ||
                      d_mt == MemoryType::DEVICE_UMPIRE_2 ||
+                     d_mt == MemoryType::DEVICE_POOL ||
                      d_mt == MemoryType::MANAGED,"");
          return true;
       }
@@ -1323,7 +1573,7 @@ void MemoryManager::InsertDevice(void *d_ptr, void *h_ptr, size_t bytes,
    MFEM_ASSERT(h_ptr != NULL, "internal error");
    Insert(h_ptr, bytes, h_mt, d_mt);
    internal::Memory &mem = maps->memories.at(h_ptr);
-   if (d_ptr == NULL && bytes != 0) { ctrl->Device(d_mt)->Alloc(mem); }
+   if (d_ptr == NULL && bytes != 0) { DeviceAlloc(d_mt, mem); }
    else { mem.d_ptr = d_ptr; }
 }
 
@@ -1380,7 +1630,7 @@ void MemoryManager::Erase(void *h_ptr, bool free_dev_ptr)
    auto mem_map_iter = maps->memories.find(h_ptr);
    if (mem_map_iter == maps->memories.end()) { mfem_error("Unknown pointer!"); }
    internal::Memory &mem = mem_map_iter->second;
-   if (mem.d_ptr && free_dev_ptr) { ctrl->Device(mem.d_mt)->Dealloc(mem);}
+   if (mem.d_ptr && free_dev_ptr) { DeviceDealloc(mem); }
    maps->memories.erase(mem_map_iter);
 }
 
@@ -1390,7 +1640,7 @@ void MemoryManager::EraseDevice(void *h_ptr)
    auto mem_map_iter = maps->memories.find(h_ptr);
    if (mem_map_iter == maps->memories.end()) { mfem_error("Unknown pointer!"); }
    internal::Memory &mem = mem_map_iter->second;
-   if (mem.d_ptr) { ctrl->Device(mem.d_mt)->Dealloc(mem);}
+   if (mem.d_ptr) { DeviceDealloc(mem); }
    mem.d_ptr = nullptr;
 }
 
@@ -1423,7 +1673,7 @@ void *MemoryManager::GetDevicePtr(const void *h_ptr, size_t bytes,
    if (!mem.d_ptr)
    {
       if (d_mt == MemoryType::DEFAULT) { d_mt = GetDualMemoryType(h_mt); }
-      if (mem.bytes) { ctrl->Device(d_mt)->Alloc(mem); }
+      if (mem.bytes) { DeviceAlloc(d_mt, mem); }
    }
    // Aliases might have done some protections
    if (mem.d_ptr) { ctrl->Device(d_mt)->Unprotect(mem); }
@@ -1456,7 +1706,7 @@ void *MemoryManager::GetAliasDevicePtr(const void *alias_ptr, size_t bytes,
    if (!mem.d_ptr)
    {
       if (d_mt == MemoryType::DEFAULT) { d_mt = GetDualMemoryType(h_mt); }
-      if (mem.bytes) { ctrl->Device(d_mt)->Alloc(mem); }
+      if (mem.bytes) { DeviceAlloc(d_mt, mem); }
    }
    void *alias_h_ptr = static_cast<char*>(mem.h_ptr) + offset;
    void *alias_d_ptr = static_cast<char*>(mem.d_ptr) + offset;
@@ -1594,8 +1844,8 @@ void MemoryManager::Destroy()
    {
       internal::Memory &mem = n.second;
       bool mem_h_ptr = mem.h_mt != MemoryType::HOST && mem.h_ptr;
-      if (mem_h_ptr) { ctrl->Host(mem.h_mt)->Dealloc(mem.h_ptr); }
-      if (mem.d_ptr) { ctrl->Device(mem.d_mt)->Dealloc(mem); }
+      if (mem_h_ptr) { HostDealloc(mem.h_mt, mem.h_ptr); }
+      if (mem.d_ptr) { DeviceDealloc(mem); }
    }
    delete maps; maps = nullptr;
    delete ctrl; ctrl = nullptr;
@@ -1712,17 +1962,22 @@ MemoryType MemoryManager::device_mem_type = MemoryType::HOST;
 
 MemoryType MemoryManager::dual_map[MemoryTypeSize] =
 {
-   /* HOST            */  MemoryType::DEVICE,
-   /* HOST_32         */  MemoryType::DEVICE,
-   /* HOST_64         */  MemoryType::DEVICE,
-   /* HOST_DEBUG      */  MemoryType::DEVICE_DEBUG,
-   /* HOST_UMPIRE     */  MemoryType::DEVICE_UMPIRE,
-   /* HOST_PINNED     */  MemoryType::DEVICE,
-   /* MANAGED         */  MemoryType::MANAGED,
-   /* DEVICE          */  MemoryType::HOST,
-   /* DEVICE_DEBUG    */  MemoryType::HOST_DEBUG,
-   /* DEVICE_UMPIRE   */  MemoryType::HOST_UMPIRE,
-   /* DEVICE_UMPIRE_2 */  MemoryType::HOST_UMPIRE
+   /* HOST             */  MemoryType::DEVICE,
+   /* HOST_32          */  MemoryType::DEVICE,
+   /* HOST_64          */  MemoryType::DEVICE,
+   /* HOST_DEBUG       */  MemoryType::DEVICE_DEBUG,
+   /* HOST_UMPIRE      */  MemoryType::DEVICE_UMPIRE,
+   /* HOST_PINNED      */  MemoryType::DEVICE,
+   /* HOST_POOL        */  MemoryType::DEVICE_POOL,
+   /* HOST_HUGE        */  MemoryType::DEVICE,
+   /* HOST_NUMA        */  MemoryType::DEVICE,
+   /* HOST_FIRST_TOUCH */  MemoryType::DEVICE,
+   /* MANAGED          */  MemoryType::MANAGED,
+   /* DEVICE           */  MemoryType::HOST,
+   /* DEVICE_DEBUG     */  MemoryType::HOST_DEBUG,
+   /* DEVICE_UMPIRE    */  MemoryType::HOST_UMPIRE,
+   /* DEVICE_UMPIRE_2  */  MemoryType::HOST_UMPIRE,
+   /* DEVICE_POOL      */  MemoryType::HOST_POOL
 };
 
 #ifdef MFEM_USE_UMPIRE
@@ -1735,6 +1990,7 @@ const char * MemoryManager::d_umpire_2_name = "MFEM_DEVICE_2";
 const char *MemoryTypeName[MemoryTypeSize] =
 {
    "host-std", "host-32", "host-64", "host-debug", "host-umpire", "host-pinned",
+   "host-pool", "host-huge", "host-numa", "host-first-touch",
 #if defined(MFEM_USE_CUDA)
    "cuda-uvm",
    "cuda",
@@ -1749,12 +2005,15 @@ const char *MemoryTypeName[MemoryTypeSize] =
 #if defined(MFEM_USE_CUDA)
    "cuda-umpire",
    "cuda-umpire-2",
+   "cuda-pool",
 #elif defined(MFEM_USE_HIP)
    "hip-umpire",
    "hip-umpire-2",
+   "hip-pool",
 #else
    "device-umpire",
    "device-umpire-2",
+   "device-pool",
 #endif
 };
 
@@ -14,6 +14,7 @@
 
 #include "globals.hpp"
 #include "error.hpp"
+#include "mem_usage.hpp"
 #include <cstring> // std::memcpy
 #include <type_traits> // std::is_const
 #include <cstddef> // std::max_align_t
@@ -37,6 +38,14 @@ enum class MemoryType
    HOST_UMPIRE,    /**< Host memory; using an Umpire allocator which can be set
                         with MemoryManager::SetUmpireHostAllocatorName */
    HOST_PINNED,    ///< Host memory: pinned (page-locked)
+   HOST_POOL,      /**< Host memory; using the MFEM memory pool, see
+                        MemoryPool */
+   HOST_HUGE,      /**< Host memory; the arrays of at least 2 MiB use
+                        transparent huge pages */
+   HOST_NUMA,      /**< Host memory; the arrays of at least 2 MiB are
+                        interleaved over the NUMA nodes */
+   HOST_FIRST_TOUCH, /**< Host memory; the pages of the arrays of at least
+                          2 MiB are first touched by the OpenMP threads */
    MANAGED,        /**< Managed memory; using CUDA or HIP *MallocManaged
                         and *Free */
    DEVICE,         ///< Device memory; using CUDA or HIP *Malloc and *Free
@@ -46,6 +55,8 @@ enum class MemoryType
                         set with MemoryManager::SetUmpireDeviceAllocatorName */
    DEVICE_UMPIRE_2, /**< Device memory; using a second Umpire allocator settable
                          with MemoryManager::SetUmpireDevice2AllocatorName */
+   DEVICE_POOL,    /**< Device memory; using the MFEM memory pool, see
+                        MemoryPool */
    SIZE,           ///< Number of host and device memory types
 
    PRESERVE,       /**< Pseudo-MemoryType used as default value for MemoryType
@@ -73,11 +84,13 @@ extern const char *MemoryTypeName[MemoryTypeSize];
 enum class MemoryClass
 {
    HOST,    /**< Memory types: { HOST, HOST_32, HOST_64, HOST_DEBUG,
-                                 HOST_UMPIRE, HOST_PINNED, MANAGED } */
+                                 HOST_UMPIRE, HOST_PINNED, HOST_POOL,
+                                 HOST_HUGE, HOST_NUMA, HOST_FIRST_TOUCH,
+                                 MANAGED } */
    HOST_32, ///< Memory types: { HOST_32, HOST_64, HOST_DEBUG }
    HOST_64, ///< Memory types: { HOST_64, HOST_DEBUG }
    DEVICE,  /**< Memory types: { DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE,
-                                 DEVICE_UMPIRE_2, MANAGED } */
+                                 DEVICE_UMPIRE_2, DEVICE_POOL, MANAGED } */
    MANAGED  ///< Memory types: { MANAGED }
 };
 
@@ -570,7 +583,12 @@ private:
    // Shortcut for Alloc<new_align_bytes>::New(size)
    static inline T *NewHOST(std::size_t size)
    {
-      return Alloc<new_align_bytes>::New(size);
+      T *ptr = Alloc<new_align_bytes>::New(size);
+      if (MemoryUsage::IsActive())
+      {
+         MemoryUsage::Allocate(ptr, size*sizeof(T), MemoryType::HOST);
+      }
+      return ptr;
    }
 };
 
@@ -754,19 +772,24 @@ public:
    /// Return the dual MemoryType of the given one, @a mt.
    /** The default dual memory types are:
 
-       memory type     | dual type
-       --------------- | ---------
-       HOST            | DEVICE
-       HOST_32         | DEVICE
-       HOST_64         | DEVICE
-       HOST_DEBUG      | DEVICE_DEBUG
-       HOST_UMPIRE     | DEVICE_UMPIRE
-       HOST_PINNED     | DEVICE
-       MANAGED         | MANAGED
-       DEVICE          | HOST
-       DEVICE_DEBUG    | HOST_DEBUG
-       DEVICE_UMPIRE   | HOST_UMPIRE
-       DEVICE_UMPIRE_2 | HOST_UMPIRE
+       memory type      | dual type
+       ---------------- | ---------
+       HOST             | DEVICE
+       HOST_32          | DEVICE
+       HOST_64          | DEVICE
+       HOST_DEBUG       | DEVICE_DEBUG
+       HOST_UMPIRE      | DEVICE_UMPIRE
+       HOST_PINNED      | DEVICE
+       HOST_POOL        | DEVICE_POOL
+       HOST_HUGE        | DEVICE
+       HOST_NUMA        | DEVICE
+       HOST_FIRST_TOUCH | DEVICE
+       MANAGED          | MANAGED
+       DEVICE           | HOST
+       DEVICE_DEBUG     | HOST_DEBUG
+       DEVICE_UMPIRE    | HOST_UMPIRE
+       DEVICE_UMPIRE_2  | HOST_UMPIRE
+       DEVICE_POOL      | HOST_POOL
 
        The dual types can be modified before device configuration using the
        method SetDualMemoryType() or by calling Device::SetMemoryTypes(). */
@@ -1010,7 +1033,14 @@ inline void Memory<T>::Delete()
    if (std_delete ||
        MemoryManager::Delete_((void*)h_ptr, h_mt, flags) == MemoryType::HOST)
    {
-      if (flags & OWNS_HOST) { delete [] h_ptr; }
+      if (flags & OWNS_HOST)
+      {
+         if (MemoryUsage::IsActive())
+         {
+            MemoryUsage::Deallocate(h_ptr, MemoryType::HOST);
+         }
+         delete [] h_ptr;
+      }
    }
    Reset(h_mt);
 }
@@ -0,0 +1,352 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mem_pool.hpp"
+#include "mem_manager.hpp"
+#include "cuda.hpp"
+#include "hip.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#ifndef _WIN32
+#define mfem_memalign(p,a,s) posix_memalign(p,a,s)
+#define mfem_aligned_free free
+#else
+#include <malloc.h>
+#define mfem_memalign(p,a,s) (((*(p))=_aligned_malloc((s),(a))),*(p)?0:errno)
+#define mfem_aligned_free _aligned_free
+#endif
+
+namespace mfem
+{
+
+namespace internal
+{
+
+// The blocks of up to 2^MinShift bytes form the size class 0, and each
+// interval (2^p, 2^(p+1)], p >= MinShift, is split into four size classes.
+constexpr int MinShift = 6;
+constexpr int MaxShift = 61;
+constexpr int NumSizeClasses = 4*(MaxShift - MinShift) + 1;
+
+// The blocks of up to 1 MiB are cached by the threads, at most
+// ThreadCacheDepth blocks per size class.
+constexpr int NumCachedClasses = 4*(20 - MinShift) + 1;
+constexpr int ThreadCacheDepth = 8;
+
+/// Return the size class of @a bytes and its block size, @a size.
+static int SizeClass(std::size_t bytes, std::size_t &size)
+{
+   const std::size_t one = 1;
+   if (bytes <= (one << MinShift)) { size = one << MinShift; return 0; }
+   int p = MinShift;
+   while ((bytes - 1) >> (p + 1)) { p++; }
+   MFEM_VERIFY(p < MaxShift, "the memory pool block is too large: "
+               << bytes << " bytes");
+   // 2^p < bytes <= 2^(p+1) is rounded up to 2^p + n 2^(p-2), n = 1,...,4
+   const std::size_t step = one << (p - 2);
+   const std::size_t n = (bytes - (one << p) + step - 1) / step;
+   size = (one << p) + n*step;
+   return 4*(p - MinShift) + (int)n;
+}
+
+/// Return the block size of the size class @a c.
+static std::size_t ClassSize(int c)
+{
+   const std::size_t one = 1;
+   if (c == 0) { return one << MinShift; }
+   const int p = MinShift + (c - 1)/4;
+   return (one << p) + ((c - 1)%4 + 1)*(one << (p - 2));
+}
+
+class Pool;
+
+// The cache of a thread, used without locking. It is trivially destructible,
+// so that it remains usable during the destruction of the static objects, and
+// it is flushed by a PoolThreadCacheGuard when the thread exits.
+struct PoolThreadCache
+{
+   Pool *pool;
+   bool closed;
+   int count[NumCachedClasses];
+   void *blocks[NumCachedClasses][ThreadCacheDepth];
+};
+
+// The caches of the host and the device pools.
+static thread_local PoolThreadCache thread_cache[2];
+
+struct PoolThreadCacheGuard
+{
+   bool active = false;
+   ~PoolThreadCacheGuard();
+};
+
+/// A pool of blocks allocated by @a upstream_alloc, with free lists per size
+/// class and thread caches.
+class Pool
+{
+public:
+   typedef void *(*AllocFn)(std::size_t);
+   typedef void (*DeallocFn)(void*);
+
+private:
+   const int id;
+   const AllocFn upstream_alloc;
+   const DeallocFn upstream_dealloc;
+   std::mutex mutex;
+   std::vector<void*> free_list[NumSizeClasses];
+   std::atomic<std::size_t> allocs, thread_hits, pool_hits, misses, deallocs;
+   std::atomic<std::size_t> used, peak_used, reserved, peak_reserved;
+
+   static void Add(std::atomic<std::size_t> &count,
+                   std::atomic<std::size_t> &peak, std::size_t bytes)
+   {
+      const std::size_t value =
+         count.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+      std::size_t p = peak.load(std::memory_order_relaxed);
+      while (value > p &&
+             !peak.compare_exchange_weak(p, value, std::memory_order_relaxed))
+      { }
+   }
+
+   /// Return the cache of the calling thread, or nullptr if it has exited.
+   PoolThreadCache *ThreadCache()
+   {
+      PoolThreadCache &tc = thread_cache[id];
+      if (tc.closed) { return nullptr; }
+      if (!tc.pool)
+      {
+         static thread_local PoolThreadCacheGuard guard;
+         guard.active = true;
+         tc.pool = this;
+      }
+      return &tc;
+   }
+
+public:
+   Pool(int id_, AllocFn alloc, DeallocFn dealloc)
+      : id(id_), upstream_alloc(alloc), upstream_dealloc(dealloc), allocs(0),
+        thread_hits(0), pool_hits(0), misses(0), deallocs(0), used(0),
+        peak_used(0), reserved(0), peak_reserved(0) { }
+
+   void *Alloc(std::size_t bytes)
+   {
+      std::size_t size;
+      const int c = SizeClass(bytes, size);
+      allocs.fetch_add(1, std::memory_order_relaxed);
+      Add(used, peak_used, size);
+      PoolThreadCache *tc = c < NumCachedClasses ? ThreadCache() : nullptr;
+      if (tc && tc->count[c] > 0)
+      {
+         thread_hits.fetch_add(1, std::memory_order_relaxed);
+         return tc->blocks[c][--tc->count[c]];
+      }
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         if (!free_list[c].empty())
+         {
+            void *ptr = free_list[c].back();
+            free_list[c].pop_back();
+            pool_hits.fetch_add(1, std::memory_order_relaxed);
+            return ptr;
+         }
+      }
+      misses.fetch_add(1, std::memory_order_relaxed);
+      void *ptr = upstream_alloc(size);
+      // return the cached blocks to the system and try again
+      if (!ptr) { Release(); ptr = upstream_alloc(size); }
+      if (!ptr)
+      {
+         used.fetch_sub(size, std::memory_order_relaxed);
+         throw ::std::bad_alloc();
+      }
+      Add(reserved, peak_reserved, size);
+      return ptr;
+   }
+
+   void Dealloc(void *ptr, std::size_t bytes)
+   {
+      if (!ptr) { return; }
+      std::size_t size;
+      const int c = SizeClass(bytes, size);
+      deallocs.fetch_add(1, std::memory_order_relaxed);
+      used.fetch_sub(size, std::memory_order_relaxed);
+      PoolThreadCache *tc = c < NumCachedClasses ? ThreadCache() : nullptr;
+      if (tc && tc->count[c] < ThreadCacheDepth)
+      {
+         tc->blocks[c][tc->count[c]++] = ptr;
+         return;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      free_list[c].push_back(ptr);
+   }
+
+   /// Move the blocks of the thread cache @a tc to the free lists.
+   void Flush(PoolThreadCache &tc)
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (int c = 0; c < NumCachedClasses; c++)
+      {
+         for (int i = 0; i < tc.count[c]; i++)
+         {
+            free_list[c].push_back(tc.blocks[c][i]);
+         }
+         tc.count[c] = 0;
+      }
+   }
+
+   void Release()
+   {
+      PoolThreadCache *tc = ThreadCache();
+      if (tc) { Flush(*tc); }
+      std::lock_guard<std::mutex> lock(mutex);
+      for (int c = 0; c < NumSizeClasses; c++)
+      {
+         for (void *ptr : free_list[c]) { upstream_dealloc(ptr); }
+         reserved.fetch_sub(free_list[c].size()*ClassSize(c),
+                            std::memory_order_relaxed);
+         std::vector<void*>().swap(free_list[c]);
+      }
+   }
+
+   MemoryPool::Statistics GetStatistics() const
+   {
+      MemoryPool::Statistics s;
+      s.allocs = allocs.load(std::memory_order_relaxed);
+      s.thread_hits = thread_hits.load(std::memory_order_relaxed);
+      s.pool_hits = pool_hits.load(std::memory_order_relaxed);
+      s.misses = misses.load(std::memory_order_relaxed);
+      s.deallocs = deallocs.load(std::memory_order_relaxed);
+      s.bytes_used = used.load(std::memory_order_relaxed);
+      s.peak_used = peak_used.load(std::memory_order_relaxed);
+      s.bytes_reserved = reserved.load(std::memory_order_relaxed);
+      s.peak_reserved = peak_reserved.load(std::memory_order_relaxed);
+      return s;
+   }
+};
+
+PoolThreadCacheGuard::~PoolThreadCacheGuard()
+{
+   for (PoolThreadCache &tc : thread_cache)
+   {
+      if (tc.pool) { tc.pool->Flush(tc); }
+      tc.closed = true;
+   }
+}
+
+static void *HostPoolAlloc(std::size_t bytes)
+{
+   void *ptr;
+   return mfem_memalign(&ptr, 64, bytes) == 0 ? ptr : nullptr;
+}
+
+static void HostPoolDealloc(void *ptr) { mfem_aligned_free(ptr); }
+
+// The device allocation errors are not fatal: the pool returns its cached
+// blocks to the system and tries again, see Pool::Alloc().
+static void *DevicePoolAlloc(std::size_t bytes)
+{
+   void *ptr = nullptr;
+#if defined(MFEM_USE_CUDA)
+   if (cudaMalloc(&ptr, bytes) != cudaSuccess)
+   {
+      cudaGetLastError(); // clear the error
+      return nullptr;
+   }
+#elif defined(MFEM_USE_HIP)
+   if (hipMalloc(&ptr, bytes) != hipSuccess)
+   {
+      hipGetLastError(); // clear the error
+      return nullptr;
+   }
+#else
+   MFEM_CONTRACT_VAR(bytes);
+   MFEM_ABORT("the device memory pool requires CUDA or HIP!");
+#endif
+   return ptr;
+}
+
+static void DevicePoolDealloc(void *ptr)
+{
+#if defined(MFEM_USE_CUDA)
+   CuMemFree(ptr);
+#elif defined(MFEM_USE_HIP)
+   HipMemFree(ptr);
+#else
+   MFEM_CONTRACT_VAR(ptr);
+#endif
+}
+
+// The pools are never destroyed, so that the Memory objects deleted during the
+// destruction of the static objects can still be returned to them.
+static Pool &GetPool(MemoryType mt)
+{
+   if (mt == MemoryType::HOST_POOL)
+   {
+      static Pool *host = new Pool(0, HostPoolAlloc, HostPoolDealloc);
+      return *host;
+   }
+   MFEM_VERIFY(mt == MemoryType::DEVICE_POOL,
+               "invalid memory pool type: " << MemoryTypeName[(int)mt]);
+   static Pool *device = new Pool(1, DevicePoolAlloc, DevicePoolDealloc);
+   return *device;
+}
+
+} // namespace internal
+
+void *MemoryPool::Allocate(MemoryType mt, std::size_t bytes)
+{
+   return internal::GetPool(mt).Alloc(bytes);
+}
+
+void MemoryPool::Deallocate(MemoryType mt, void *ptr, std::size_t bytes)
+{
+   internal::GetPool(mt).Dealloc(ptr, bytes);
+}
+
+void MemoryPool::Release(MemoryType mt)
+{
+   internal::GetPool(mt).Release();
+}
+
+MemoryPool::Statistics MemoryPool::GetStatistics(MemoryType mt)
+{
+   return internal::GetPool(mt).GetStatistics();
+}
+
+void MemoryPool::PrintStatistics(MemoryType mt, std::ostream &os)
+{
+   const Statistics s = GetStatistics(mt);
+   const double MiB = 1024.0*1024.0;
+   const std::ios::fmtflags flags = os.flags();
+   const std::streamsize precision = os.precision();
+   os << "Memory pool " << MemoryTypeName[(int)mt] << ":\n"
+      << std::left << std::fixed << std::setprecision(3)
+      << std::setw(24) << "   allocations" << s.allocs << '\n'
+      << std::setw(24) << "   thread cache hits" << s.thread_hits << '\n'
+      << std::setw(24) << "   pool hits" << s.pool_hits << '\n'
+      << std::setw(24) << "   system allocations" << s.misses << '\n'
+      << std::setw(24) << "   deallocations" << s.deallocs << '\n'
+      << std::setw(24) << "   used (MiB)" << s.bytes_used/MiB
+      << " (peak " << s.peak_used/MiB << ")\n"
+      << std::setw(24) << "   reserved (MiB)" << s.bytes_reserved/MiB
+      << " (peak " << s.peak_reserved/MiB << ")\n";
+   os.flags(flags);
+   os.precision(precision);
+}
+
+} // namespace mfem
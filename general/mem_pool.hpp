@@ -0,0 +1,92 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_MEM_POOL_HPP
+#define MFEM_MEM_POOL_HPP
+
+#include "../config/config.hpp"
+#include "globals.hpp"
+#include <cstddef>
+
+namespace mfem
+{
+
+enum class MemoryType;
+
+/** @brief The memory pools behind MemoryType::HOST_POOL and
+    MemoryType::DEVICE_POOL, which reuse the freed blocks instead of returning
+    them to the system.
+
+    The pools are meant for the temporary vectors that are repeatedly
+    allocated and freed, e.g. in the iterative solvers or in the partial
+    assembly operators, where the cost of new[]/delete[] or of the device
+    allocation and deallocation is significant. They do not require an
+    external library, unlike MemoryType::HOST_UMPIRE and
+    MemoryType::DEVICE_UMPIRE.
+
+    The requested sizes are rounded up to a size class, with four classes per
+    power of two, and the freed blocks are kept in a free list per size class.
+    The small blocks, up to 1 MiB, are first kept in a cache local to the
+    thread that frees them, which is used without locking. The host blocks are
+    aligned at 64 bytes.
+
+    The pools can be used as the default MemoryTypes by configuring the Device
+    with the option "pool", e.g. "cpu:pool" or "cuda:pool", with the
+    environment variable MFEM_MEMORY=pool, or with Device::SetMemoryTypes().
+    The cached blocks are only returned to the system by Release(). */
+class MemoryPool
+{
+public:
+   /// Usage statistics of a memory pool.
+   struct Statistics
+   {
+      /// Number of allocations.
+      std::size_t allocs;
+      /// Number of allocations served by the cache of the allocating thread.
+      std::size_t thread_hits;
+      /// Number of allocations served by the free lists of the pool.
+      std::size_t pool_hits;
+      /// Number of allocations of new blocks from the system.
+      std::size_t misses;
+      /// Number of deallocations.
+      std::size_t deallocs;
+      /// Bytes in the blocks currently allocated, and their peak.
+      std::size_t bytes_used, peak_used;
+      /// Bytes obtained from the system, including the cached blocks.
+      std::size_t bytes_reserved, peak_reserved;
+   };
+
+   /** @brief Allocate a block of at least @a bytes from the pool of the
+       MemoryType @a mt, HOST_POOL or DEVICE_POOL. */
+   /** This function is used by the memory manager, see MemoryType::HOST_POOL
+       and MemoryType::DEVICE_POOL. When the allocation of a new block from
+       the system fails, the cached blocks are released, see Release(), and
+       the allocation is tried again before throwing std::bad_alloc. */
+   static void *Allocate(MemoryType mt, std::size_t bytes);
+
+   /** @brief Return the block @a ptr of @a bytes, allocated by Allocate(), to
+       the pool of the MemoryType @a mt. */
+   static void Deallocate(MemoryType mt, void *ptr, std::size_t bytes);
+
+   /** @brief Return the cached blocks of the pool of the MemoryType @a mt to
+       the system: the free lists and the cache of the calling thread. */
+   static void Release(MemoryType mt);
+
+   /// Return the usage statistics of the pool of the MemoryType @a mt.
+   static Statistics GetStatistics(MemoryType mt);
+
+   /// Print the usage statistics of the pool of the MemoryType @a mt.
+   static void PrintStatistics(MemoryType mt, std::ostream &os = mfem::out);
+};
+
+} // namespace mfem
+
+#endif
@@ -0,0 +1,364 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mem_usage.hpp"
+#include "mem_manager.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mfem
+{
+
+namespace internal
+{
+
+struct MemoryUsageRecord
+{
+   std::size_t bytes;
+   int tag;
+   MemoryType mt;
+};
+
+struct MemoryUsageCount
+{
+   std::string name;
+   std::size_t current, peak, at_peak;
+   long allocs;
+
+   MemoryUsageCount(const std::string &name_)
+      : name(name_), current(0), peak(0), at_peak(0), allocs(0) { }
+};
+
+typedef std::unordered_map<const void*, MemoryUsageRecord> MemoryUsageMap;
+
+// The state of the accounting, tag 0 is the untagged entry.
+struct MemoryUsageState
+{
+   bool enabled;
+   std::mutex mutex;
+   MemoryUsageMap host, device;
+   std::vector<MemoryUsageCount> tags;
+   std::map<std::string, int> index;
+   std::vector<int> stack;
+   std::size_t current[MemoryTypeSize], peak[MemoryTypeSize];
+   std::size_t total, total_peak;
+
+   MemoryUsageState()
+      : enabled(false), tags(1, MemoryUsageCount("untagged")), total(0),
+        total_peak(0)
+   {
+      for (int i = 0; i < MemoryTypeSize; i++) { current[i] = peak[i] = 0; }
+   }
+
+   MemoryUsageMap &Map(MemoryType mt)
+   {
+      return IsHostMemory(mt) ? host : device;
+   }
+
+   int Tag(const char *name)
+   {
+      const std::map<std::string, int>::const_iterator it = index.find(name);
+      if (it != index.end()) { return it->second; }
+      tags.push_back(MemoryUsageCount(name));
+      return index[name] = tags.size() - 1;
+   }
+};
+
+// The state is never destroyed, so that the Memory objects deleted during the
+// destruction of the static objects can still be released.
+static MemoryUsageState &GetMemoryUsageState()
+{
+   static MemoryUsageState *state = new MemoryUsageState;
+   return *state;
+}
+
+} // namespace internal
+
+bool MemoryUsage::active = false;
+
+void MemoryUsage::Enable(bool enable)
+{
+   internal::MemoryUsageState &s = internal::GetMemoryUsageState();
+   std::lock_guard<std::mutex> lock(s.mutex);
+   s.enabled = enable;
+   active = enable || !s.host.empty() || !s.device.empty();
+}
+
+bool MemoryUsage::IsEnabled()
+{
+   return internal::GetMemoryUsageState().enabled;
+}
+
+void MemoryUsage::Allocate(const void *ptr, std::size_t bytes, MemoryType mt)
+{
+   internal::MemoryUsageState &s = internal::GetMemoryUsageState();
+   if (!s.enabled || ptr == nullptr) { return; }
+   std::lock_guard<std::mutex> lock(s.mutex);
+   const int tag = s.stack.empty() ? 0 : s.stack.back();
+   internal::MemoryUsageMap &map = s.Map(mt);
+   const internal::MemoryUsageMap::iterator it = map.find(ptr);
+   if (it != map.end())
+   {
+      // the address was released while it was not tracked
+      const internal::MemoryUsageRecord &r = it->second;
+      s.tags[r.tag].current -= r.bytes;
+      s.current[(int)r.mt] -= r.bytes;
+      s.total -= r.bytes;
+      map.erase(it);
+   }
+   map[ptr] = internal::MemoryUsageRecord{bytes, tag, mt};
+
+   internal::MemoryUsageCount &t = s.tags[tag];
+   t.allocs++;
+   t.current += bytes;
+   t.peak = std::max(t.peak, t.current);
+   s.current[(int)mt] += bytes;
+   s.peak[(int)mt] = std::max(s.peak[(int)mt], s.current[(int)mt]);
+   s.total += bytes;
+   if (s.total > s.total_peak)
+   {
+      s.total_peak = s.total;
+      for (internal::MemoryUsageCount &c : s.tags) { c.at_peak = c.current; }
+   }
+}
+
+void MemoryUsage::Deallocate(const void *ptr, MemoryType mt)
+{
+   internal::MemoryUsageState &s = internal::GetMemoryUsageState();
+   std::lock_guard<std::mutex> lock(s.mutex);
+   internal::MemoryUsageMap &map = s.Map(mt);
+   const internal::MemoryUsageMap::iterator it = map.find(ptr);
+   if (it == map.end()) { return; }
+   const internal::MemoryUsageRecord &r = it->second;
+   s.tags[r.tag].current -= r.bytes;
+   s.current[(int)r.mt] -= r.bytes;
+   s.total -= r.bytes;
+   map.erase(it);
+   active = s.enabled || !s.host.empty() || !s.device.empty();
+}
+
+int MemoryUsage::BeginTag(const char *name)
+{
+   internal::MemoryUsageState &s = internal::GetMemoryUsageState();
+   if (!s.enabled) { return -1; }
+   std::lock_guard<std::mutex> lock(s.mutex);
+   const int id = s.Tag(name);
+   s.stack.push_back(id);
+   return id;
+}
+
+void MemoryUsage::EndTag(int id)
+{
+   if (id < 0) { return; }
+   internal::MemoryUsageState &s = internal::GetMemoryUsageState();
+   std::lock_guard<std::mutex> lock(s.mutex);
+   if (!s.stack.empty() && s.stack.back() == id) { s.stack.pop_back(); }
+}
+
+std::size_t MemoryUsage::GetCurrent()
+{
+   return internal::GetMemoryUsageState().total;
+}
+
+std::size_t MemoryUsage::GetPeak()
+{
+   return internal::GetMemoryUsageState().total_peak;
+}
+
+std::size_t MemoryUsage::GetCurrent(MemoryType mt)
+{
+   return internal::GetMemoryUsageState().current[(int)mt];
+}
+
+std::size_t MemoryUsage::GetPeak(MemoryType mt)
+{
+   return internal::GetMemoryUsageState().peak[(int)mt];
+}
+
+std::size_t MemoryUsage::GetCurrent(const char *name)
+{
+   internal::MemoryUsageState &s = internal::GetMemoryUsageState();
+   std::lock_guard<std::mutex> lock(s.mutex);
+   const std::map<std::string, int>::const_iterator it = s.index.find(name);
+   return it != s.index.end() ? s.tags[it->second].current : 0;
+}
+
+std::size_t MemoryUsage::GetPeak(const char *name)
+{
+   internal::MemoryUsageState &s = internal::GetMemoryUsageState();
+   std::lock_guard<std::mutex> lock(s.mutex);
+   const std::map<std::string, int>::const_iterator it = s.index.find(name);
+   return it != s.index.end() ? s.tags[it->second].peak : 0;
+}
+
+void MemoryUsage::ResetPeak()
+{
+   internal::MemoryUsageState &s = internal::GetMemoryUsageState();
+   std::lock_guard<std::mutex> lock(s.mutex);
+   for (internal::MemoryUsageCount &c : s.tags)
+   {
+      c.peak = c.at_peak = c.current;
+   }
+   for (int i = 0; i < MemoryTypeSize; i++) { s.peak[i] = s.current[i]; }
+   s.total_peak = s.total;
+}
+
+static double MiB(double bytes) { return bytes/1048576.0; }
+
+static void PrintMemoryUsageRow(std::ostream &os, const std::string &name,
+                                std::size_t current, std::size_t peak,
+                                std::size_t at_peak, long allocs)
+{
+   os << std::left << std::setw(32) << name << std::right
+      << std::setw(12) << MiB(current) << std::setw(12) << MiB(peak);
+   if (allocs >= 0)
+   {
+      os << std::setw(12) << MiB(at_peak) << std::setw(12) << allocs;
+   }
+   os << '\n';
+}
+
+void MemoryUsage::PrintReport(std::ostream &os)
+{
+   internal::MemoryUsageState &s = internal::GetMemoryUsageState();
+   std::lock_guard<std::mutex> lock(s.mutex);
+   const std::ios::fmtflags flags = os.flags();
+   const std::streamsize precision = os.precision();
+   os << std::left << std::setw(32) << "Memory usage (MiB)" << std::right
+      << std::setw(12) << "Current" << std::setw(12) << "Peak"
+      << std::setw(12) << "At peak" << std::setw(12) << "Allocs" << '\n'
+      << std::string(80, '-') << '\n' << std::fixed << std::setprecision(3);
+   for (const internal::MemoryUsageCount &c : s.tags)
+   {
+      if (c.allocs == 0) { continue; }
+      PrintMemoryUsageRow(os, c.name, c.current, c.peak, c.at_peak, c.allocs);
+   }
+   os << std::string(80, '-') << '\n';
+   for (int i = 0; i < MemoryTypeSize; i++)
+   {
+      if (s.peak[i] == 0) { continue; }
+      PrintMemoryUsageRow(os, MemoryTypeName[i], s.current[i], s.peak[i],
+                          0, -1);
+   }
+   PrintMemoryUsageRow(os, "Total", s.total, s.total_peak, 0, -1);
+   os.flags(flags);
+   os.precision(precision);
+}
+
+#ifdef MFEM_USE_MPI
+void MemoryUsage::PrintReport(MPI_Comm comm, std::ostream &os)
+{
+   int rank, nranks;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nranks);
+
+   // the names of the tags, separated by '\0', and their current, peak and
+   // at peak bytes, followed by the total current and peak bytes
+   std::string names;
+   std::vector<double> vals;
+   {
+      internal::MemoryUsageState &s = internal::GetMemoryUsageState();
+      std::lock_guard<std::mutex> lock(s.mutex);
+      for (const internal::MemoryUsageCount &c : s.tags)
+      {
+         if (c.allocs == 0) { continue; }
+         names += c.name + '\0';
+         vals.push_back(c.current);
+         vals.push_back(c.peak);
+         vals.push_back(c.at_peak);
+      }
+      vals.push_back(s.total);
+      vals.push_back(s.total_peak);
+   }
+
+   int sizes[2] = { (int)names.size(), (int)vals.size() };
+   std::vector<int> all_sizes(2*nranks);
+   MPI_Gather(sizes, 2, MPI_INT, all_sizes.data(), 2, MPI_INT, 0, comm);
+   std::vector<int> name_sizes(nranks), val_sizes(nranks);
+   std::vector<int> name_displs(nranks + 1, 0), val_displs(nranks + 1, 0);
+   for (int p = 0; p < nranks && rank == 0; p++)
+   {
+      name_sizes[p] = all_sizes[2*p];
+      val_sizes[p] = all_sizes[2*p+1];
+      name_displs[p+1] = name_displs[p] + name_sizes[p];
+      val_displs[p+1] = val_displs[p] + val_sizes[p];
+   }
+   std::vector<char> all_names(rank == 0 ? name_displs[nranks] : 0);
+   std::vector<double> all_vals(rank == 0 ? val_displs[nranks] : 0);
+   MPI_Gatherv(&names[0], sizes[0], MPI_CHAR, all_names.data(),
+               name_sizes.data(), name_displs.data(), MPI_CHAR, 0, comm);
+   MPI_Gatherv(vals.data(), sizes[1], MPI_DOUBLE, all_vals.data(),
+               val_sizes.data(), val_displs.data(), MPI_DOUBLE, 0, comm);
+   if (rank != 0) { return; }
+
+   const std::ios::fmtflags flags = os.flags();
+   const std::streamsize precision = os.precision();
+   os << std::left << std::setw(8) << "Rank" << std::right << std::setw(12)
+      << "Current" << std::setw(12) << "Peak" << "  "
+      << "Largest tag at peak (MiB)\n"
+      << std::string(80, '-') << '\n' << std::fixed << std::setprecision(3);
+
+   // for each tag, the maximum over the processors of its peak and the rank
+   // where it is reached, in the order of appearance of the tags
+   std::vector<std::string> tag_names;
+   std::map<std::string, std::pair<double, int>> tag_max;
+   for (int p = 0; p < nranks; p++)
+   {
+      const double *v = &all_vals[val_displs[p]];
+      std::string largest = "-";
+      double largest_bytes = -1.0;
+      int t = 0;
+      for (int b = name_displs[p]; b < name_displs[p+1]; t++)
+      {
+         const std::string name(&all_names[b]);
+         b += name.size() + 1;
+         if (v[3*t+2] > largest_bytes)
+         {
+            largest_bytes = v[3*t+2];
+            largest = name;
+         }
+         auto it = tag_max.find(name);
+         if (it == tag_max.end())
+         {
+            tag_names.push_back(name);
+            tag_max[name] = std::make_pair(v[3*t+1], p);
+         }
+         else if (v[3*t+1] > it->second.first)
+         {
+            it->second = std::make_pair(v[3*t+1], p);
+         }
+      }
+      os << std::left << std::setw(8) << p << std::right << std::setw(12)
+         << MiB(v[3*t]) << std::setw(12) << MiB(v[3*t+1]) << "  " << largest;
+      if (largest_bytes >= 0.0) { os << " (" << MiB(largest_bytes) << ')'; }
+      os << '\n';
+   }
+
+   os << '\n' << std::left << std::setw(32) << "Tag" << std::right
+      << std::setw(12) << "Max peak" << std::setw(8) << "Rank" << '\n'
+      << std::string(52, '-') << '\n';
+   for (const std::string &name : tag_names)
+   {
+      const std::pair<double, int> &m = tag_max[name];
+      os << std::left << std::setw(32) << name << std::right << std::setw(12)
+         << MiB(m.first) << std::setw(8) << m.second << '\n';
+   }
+   os.flags(flags);
+   os.precision(precision);
+}
+#endif
+
+} // namespace mfem
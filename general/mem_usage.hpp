@@ -0,0 +1,136 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_MEM_USAGE_HPP
+#define MFEM_MEM_USAGE_HPP
+
+#include "../config/config.hpp"
+#include "globals.hpp"
+#include <cstddef>
+#include <string>
+
+namespace mfem
+{
+
+enum class MemoryType;
+
+/** @brief Optional accounting of the memory allocated through the Memory
+    class, e.g. by Vector, Array, SparseMatrix or DenseMatrix.
+
+    When enabled, see Enable(), every host and device allocation of a Memory
+    object is recorded with its size, its MemoryType and the current tag, and
+    is released when the Memory is deleted. The tags name the components that
+    allocate the memory: they are opened and closed with BeginTag() and
+    EndTag(), usually through a MemoryUsageTag object, and an allocation is
+    charged to the innermost open tag, or to the "untagged" entry. The library
+    tags the mesh construction and refinement ("Mesh"), the finite element
+    space setup ("FiniteElementSpace"), the bilinear form assembly and the
+    formation of its matrix, including the partial assembly data
+    ("BilinearForm"), the parallel matrix assembly ("HypreParMatrix") and the
+    workspaces of the iterative solvers ("Solver").
+
+    For each tag, MemoryType and in total, the accounting tracks the number of
+    bytes currently allocated and their peak, i.e. the high-water mark. For
+    each tag, it also records the bytes allocated at the time of the total
+    peak, which shows the components responsible for the high-water mark.
+
+    Only the memory allocated while the accounting is enabled is recorded: the
+    memory allocated by external libraries, e.g. by hypre inside its matrices,
+    is not included. The accounting is disabled by default and its cost, a hash
+    table update per allocation, is only paid when it is enabled. */
+class MemoryUsage
+{
+private:
+   static bool active;
+
+public:
+   /// Enable or disable the recording of new allocations, disabled by default.
+   /** The allocations recorded before the accounting is disabled are still
+       released when they are deleted. */
+   static void Enable(bool enable = true);
+
+   /// Return true if the accounting is enabled.
+   static bool IsEnabled();
+
+   /** @brief Return true if allocations are being recorded or released, used
+       by the Memory class to skip the accounting calls. */
+   static bool IsActive() { return active; }
+
+   /** @brief Record the allocation of @a bytes at @a ptr with MemoryType
+       @a mt, charged to the current tag. */
+   static void Allocate(const void *ptr, std::size_t bytes, MemoryType mt);
+
+   /** @brief Release the allocation at @a ptr with MemoryType @a mt. Nothing
+       is done if it was not recorded. */
+   static void Deallocate(const void *ptr, MemoryType mt);
+
+   /** @brief Open the tag @a name and return its id, or -1 if the accounting
+       is disabled. The tags with the same name share their counts. */
+   static int BeginTag(const char *name);
+
+   /// Close the tag with the given @a id, returned by BeginTag().
+   /** Nothing is done if @a id is not the innermost open tag, e.g. if it is
+       -1. */
+   static void EndTag(int id);
+
+   /// Return the number of bytes currently allocated.
+   static std::size_t GetCurrent();
+
+   /// Return the peak number of bytes allocated.
+   static std::size_t GetPeak();
+
+   /// Return the number of bytes of MemoryType @a mt currently allocated.
+   static std::size_t GetCurrent(MemoryType mt);
+
+   /// Return the peak number of bytes of MemoryType @a mt allocated.
+   static std::size_t GetPeak(MemoryType mt);
+
+   /// Return the number of bytes currently allocated with the tag @a name.
+   static std::size_t GetCurrent(const char *name);
+
+   /// Return the peak number of bytes allocated with the tag @a name.
+   static std::size_t GetPeak(const char *name);
+
+   /** @brief Set the peaks to the current numbers of bytes, e.g. to measure
+       the high-water mark of a phase of a computation. */
+   static void ResetPeak();
+
+   /** @brief Print the number of bytes currently allocated, their peak and
+       the bytes allocated at the total peak, per tag, per MemoryType and in
+       total, with the number of allocations of each tag. */
+   static void PrintReport(std::ostream &os = mfem::out);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Print the current and peak numbers of bytes allocated on each
+       processor of @a comm with its largest tag at its peak, and for each tag
+       the maximum over the processors of its peak.
+
+       This function is collective on @a comm and prints on its rank 0. */
+   static void PrintReport(MPI_Comm comm, std::ostream &os = mfem::out);
+#endif
+};
+
+/// Memory usage tag, open during the lifetime of the object.
+class MemoryUsageTag
+{
+private:
+   const int id;
+
+public:
+   explicit MemoryUsageTag(const char *name) : id(MemoryUsage::BeginTag(name))
+   { }
+
+   ~MemoryUsageTag() { MemoryUsage::EndTag(id); }
+};
+
+} // namespace mfem
+
+#endif
@@ -0,0 +1,694 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "profiler.hpp"
+#include "forall.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace mfem
+{
+
+namespace internal
+{
+
+typedef std::chrono::steady_clock ProfilerClock;
+
+struct ProfilerNode
+{
+   int key; // key of the region, see Profiler::RegisterRegion()
+   std::string name; // name in the reports
+   int parent;
+   std::vector<int> children;
+   long count;
+   double time; // inclusive time in seconds
+   double flops, bytes; // work registered with Profiler::AddWork()
+   ProfilerClock::time_point start;
+
+   ProfilerNode(int key_, const std::string &name_, int parent_);
+};
+
+// The tree of regions, node 0 is the root.
+struct ProfilerTree
+{
+   std::vector<ProfilerNode> nodes;
+   int current;
+
+   ProfilerTree() : nodes(1, ProfilerNode(-1, "", -1)), current(0) { }
+};
+
+static ProfilerTree &GetProfilerTree()
+{
+   static ProfilerTree tree;
+   return tree;
+}
+
+// The names of the regions, indexed by their keys.
+struct ProfilerRegistry
+{
+   std::mutex mutex;
+   std::unordered_map<std::string, int> keys;
+   std::vector<std::string> names;
+};
+
+static ProfilerRegistry &GetProfilerRegistry()
+{
+   static ProfilerRegistry registry;
+   return registry;
+}
+
+static std::atomic<bool> profiler_enabled(true);
+
+// Record the fine-grained regions, see Profiler::EnableDetails().
+static std::atomic<bool> profiler_details(false);
+
+// Number of open fine-grained regions that are not recorded, on the recording
+// thread. The work is not registered inside these regions.
+static int profiler_skipped_depth = 0;
+
+// Synchronize the device at the end of the regions with work, see
+// Profiler::SetDeviceSync().
+static bool profiler_device_sync = false;
+
+// The thread that records the regions, see Profiler::Enable(). Initialized
+// during the static initialization, i.e. by the main thread.
+static std::atomic<std::thread::id> profiler_thread(std::this_thread::get_id());
+
+// Return true if the calling thread is the recording thread.
+static bool IsProfilerThread()
+{
+   return std::this_thread::get_id() ==
+          profiler_thread.load(std::memory_order_relaxed);
+}
+
+// Return true if the regions opened by the calling thread are recorded.
+static bool IsRecording()
+{
+   if (!profiler_enabled.load(std::memory_order_relaxed)) { return false; }
+   if (!IsProfilerThread()) { return false; }
+#ifdef _OPENMP
+   if (omp_in_parallel()) { return false; }
+#endif
+   return true;
+}
+
+// Shorten the function signatures given by MFEM_PERF_FUNCTION, e.g.
+// "void mfem::BilinearForm::Assemble(int)" -> "BilinearForm::Assemble".
+static std::string RegionName(const char *key)
+{
+   std::string name(key);
+   const size_t p = name.find('(');
+   if (p != std::string::npos && p > 0)
+   {
+      name.resize(p);
+      const size_t s = name.rfind(' ');
+      if (s != std::string::npos) { name.erase(0, s + 1); }
+   }
+   if (name.compare(0, 6, "mfem::") == 0) { name.erase(0, 6); }
+   return name;
+}
+
+ProfilerNode::ProfilerNode(int key_, const std::string &name_, int parent_)
+   : key(key_), name(RegionName(name_.c_str())), parent(parent_), count(0),
+     time(0.0), flops(0.0), bytes(0.0)
+{ }
+
+// Open the region with the given key as a child of the current region.
+static int OpenRegion(int key)
+{
+   ProfilerTree &tree = GetProfilerTree();
+   int id = -1;
+   for (int c : tree.nodes[tree.current].children)
+   {
+      if (tree.nodes[c].key == key) { id = c; break; }
+   }
+   if (id < 0)
+   {
+      ProfilerRegistry &registry = GetProfilerRegistry();
+      std::string name;
+      {
+         std::lock_guard<std::mutex> lock(registry.mutex);
+         name = registry.names[key];
+      }
+      id = tree.nodes.size();
+      tree.nodes[tree.current].children.push_back(id);
+      tree.nodes.push_back(ProfilerNode(key, name, tree.current));
+   }
+   ProfilerNode &node = tree.nodes[id];
+   node.count++;
+   tree.current = id;
+   node.start = ProfilerClock::now();
+   return id;
+}
+
+// Region entry of a report: the counts and times are the min/avg/max over the
+// processors, in that order.
+struct ProfilerEntry
+{
+   std::string path; // region names separated by '\n'
+   std::string name;
+   int depth;
+   double count[3], incl[3], excl[3], flops[3], bytes[3];
+};
+
+// Flatten the tree in depth-first order, skipping the subtrees without calls.
+static void FlattenProfilerTree(const ProfilerTree &tree, int n,
+                                const std::string &path, int depth,
+                                std::vector<ProfilerEntry> &entries)
+{
+   for (int c : tree.nodes[n].children)
+   {
+      const ProfilerNode &node = tree.nodes[c];
+      const size_t pos = entries.size();
+      ProfilerEntry e;
+      e.path = path + node.name + '\n';
+      e.name = node.name;
+      e.depth = depth;
+      double child_time = 0.0;
+      for (int cc : node.children) { child_time += tree.nodes[cc].time; }
+      for (int k = 0; k < 3; k++)
+      {
+         e.count[k] = node.count;
+         e.incl[k] = node.time;
+         e.excl[k] = node.time - child_time;
+         e.flops[k] = node.flops;
+         e.bytes[k] = node.bytes;
+      }
+      entries.push_back(e);
+      FlattenProfilerTree(tree, c, e.path, depth + 1, entries);
+      if (node.count == 0 && entries.size() == pos + 1) { entries.pop_back(); }
+   }
+}
+
+static void GetProfilerEntries(std::vector<ProfilerEntry> &entries)
+{
+   entries.clear();
+   FlattenProfilerTree(GetProfilerTree(), 0, "", 0, entries);
+}
+
+#ifdef MFEM_USE_MPI
+// Merged region tree of the processors, used to order the entries.
+struct ProfilerMergeNode
+{
+   std::string name;
+   std::vector<ProfilerMergeNode> children;
+};
+
+static void MergeProfilerPath(ProfilerMergeNode &root, const std::string &path)
+{
+   ProfilerMergeNode *node = &root;
+   size_t b = 0, e;
+   while ((e = path.find('\n', b)) != std::string::npos)
+   {
+      const std::string name = path.substr(b, e - b);
+      ProfilerMergeNode *next = NULL;
+      for (ProfilerMergeNode &child : node->children)
+      {
+         if (child.name == name) { next = &child; break; }
+      }
+      if (!next)
+      {
+         node->children.push_back(ProfilerMergeNode());
+         next = &node->children.back();
+         next->name = name;
+      }
+      node = next;
+      b = e + 1;
+   }
+}
+
+static void FlattenMergedTree(const ProfilerMergeNode &node,
+                              const std::string &path, int depth,
+                              std::vector<ProfilerEntry> &entries)
+{
+   for (const ProfilerMergeNode &child : node.children)
+   {
+      ProfilerEntry e;
+      e.path = path + child.name + '\n';
+      e.name = child.name;
+      e.depth = depth;
+      entries.push_back(e);
+      FlattenMergedTree(child, e.path, depth + 1, entries);
+   }
+}
+
+// Aggregate the entries of all processors in comm, on rank 0.
+static void GetProfilerEntries(MPI_Comm comm,
+                               std::vector<ProfilerEntry> &entries)
+{
+   int rank, nranks;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nranks);
+
+   std::vector<ProfilerEntry> local;
+   GetProfilerEntries(local);
+
+   // gather the region paths on rank 0, which merges them, and broadcast the
+   // merged paths, separated by '\0'
+   std::string paths;
+   for (const ProfilerEntry &e : local) { paths += e.path + '\0'; }
+   int size = paths.size();
+   std::vector<int> sizes(nranks), displs(nranks + 1, 0);
+   MPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+   for (int p = 0; p < nranks; p++) { displs[p+1] = displs[p] + sizes[p]; }
+   std::vector<char> all_paths(rank == 0 ? displs[nranks] : 0);
+   MPI_Gatherv(&paths[0], size, MPI_CHAR, all_paths.data(), sizes.data(),
+               displs.data(), MPI_CHAR, 0, comm);
+   std::vector<ProfilerEntry> merged;
+   if (rank == 0)
+   {
+      ProfilerMergeNode root;
+      for (int b = 0; b < displs[nranks]; )
+      {
+         const std::string path(&all_paths[b]);
+         MergeProfilerPath(root, path);
+         b += path.size() + 1;
+      }
+      FlattenMergedTree(root, "", 0, merged);
+      paths.clear();
+      for (const ProfilerEntry &e : merged) { paths += e.path + '\0'; }
+      size = paths.size();
+   }
+   MPI_Bcast(&size, 1, MPI_INT, 0, comm);
+   paths.resize(size);
+   MPI_Bcast(&paths[0], size, MPI_CHAR, 0, comm);
+
+   // the local counts and times of the merged regions
+   std::map<std::string, int> index;
+   for (size_t i = 0; i < local.size(); i++) { index[local[i].path] = i; }
+   std::vector<double> vals;
+   for (int b = 0; b < size; )
+   {
+      const std::string path(&paths[b]);
+      std::map<std::string, int>::const_iterator it = index.find(path);
+      const ProfilerEntry *e = (it != index.end()) ? &local[it->second] : NULL;
+      vals.push_back(e ? e->count[0] : 0.0);
+      vals.push_back(e ? e->incl[0] : 0.0);
+      vals.push_back(e ? e->excl[0] : 0.0);
+      vals.push_back(e ? e->flops[0] : 0.0);
+      vals.push_back(e ? e->bytes[0] : 0.0);
+      b += path.size() + 1;
+   }
+   const int nv = vals.size();
+   std::vector<double> vmin(nv), vsum(nv), vmax(nv);
+   MPI_Reduce(vals.data(), vmin.data(), nv, MPI_DOUBLE, MPI_MIN, 0, comm);
+   MPI_Reduce(vals.data(), vsum.data(), nv, MPI_DOUBLE, MPI_SUM, 0, comm);
+   MPI_Reduce(vals.data(), vmax.data(), nv, MPI_DOUBLE, MPI_MAX, 0, comm);
+
+   entries.clear();
+   if (rank != 0) { return; }
+   entries = merged;
+   for (size_t i = 0; i < entries.size(); i++)
+   {
+      ProfilerEntry &e = entries[i];
+      double *v[5] = { e.count, e.incl, e.excl, e.flops, e.bytes };
+      for (int j = 0; j < 5; j++)
+      {
+         v[j][0] = vmin[5*i+j];
+         v[j][1] = vsum[5*i+j]/nranks;
+         v[j][2] = vmax[5*i+j];
+      }
+   }
+}
+#endif // MFEM_USE_MPI
+
+static void PrintProfilerReport(const std::vector<ProfilerEntry> &entries,
+                                bool aggregated, std::ostream &os)
+{
+   const int name_width = 40;
+   std::ostringstream s;
+   s << std::left << std::setw(name_width) << "Region" << std::right;
+   if (!aggregated)
+   {
+      s << std::setw(10) << "Calls" << std::setw(12) << "Incl. (s)"
+        << std::setw(12) << "Excl. (s)" << std::setw(9) << "Incl. %";
+   }
+   else
+   {
+      s << std::setw(10) << "Max calls" << std::setw(12) << "Min incl."
+        << std::setw(12) << "Avg incl." << std::setw(12) << "Max incl."
+        << std::setw(12) << "Min excl." << std::setw(12) << "Avg excl."
+        << std::setw(12) << "Max excl.";
+   }
+   const std::string header = s.str();
+   os << header << '\n' << std::string(header.size(), '-') << '\n';
+
+   double total = 0.0;
+   for (const ProfilerEntry &e : entries)
+   {
+      if (e.depth == 0) { total += e.incl[1]; }
+   }
+   s.str("");
+   s << std::scientific << std::setprecision(3);
+   for (const ProfilerEntry &e : entries)
+   {
+      const std::string name = std::string(2*e.depth, ' ') + e.name;
+      s << std::left << std::setw(name_width) << name << std::right;
+      if (!aggregated)
+      {
+         s << std::setw(10) << long(e.count[0]) << std::setw(12) << e.incl[0]
+           << std::setw(12) << e.excl[0] << std::fixed << std::setprecision(1)
+           << std::setw(9) << (total > 0.0 ? 100.0*e.incl[0]/total : 0.0)
+           << std::scientific << std::setprecision(3);
+      }
+      else
+      {
+         s << std::setw(10) << long(e.count[2]);
+         for (int k = 0; k < 3; k++) { s << std::setw(12) << e.incl[k]; }
+         for (int k = 0; k < 3; k++) { s << std::setw(12) << e.excl[k]; }
+      }
+      s << '\n';
+   }
+   os << s.str() << std::flush;
+}
+
+static std::string JSONString(const std::string &str)
+{
+   std::string json("\"");
+   for (char c : str)
+   {
+      if (c == '"' || c == '\\') { json += '\\'; }
+      json += c;
+   }
+   return json + '"';
+}
+
+static void PrintJSONValue(const double *v, bool aggregated, std::ostream &os)
+{
+   if (!aggregated) { os << v[0]; return; }
+   os << "{ \"min\": " << v[0] << ", \"avg\": " << v[1] << ", \"max\": "
+      << v[2] << " }";
+}
+
+// Print the entries starting at i, with the given depth, and their children.
+static void PrintJSONEntries(const std::vector<ProfilerEntry> &entries,
+                             size_t &i, int depth, bool aggregated,
+                             std::ostream &os)
+{
+   const std::string indent(4*depth + 4, ' ');
+   bool first = true;
+   while (i < entries.size() && entries[i].depth == depth)
+   {
+      const ProfilerEntry &e = entries[i++];
+      os << (first ? "" : ",\n") << indent << "{\n"
+         << indent << "  \"name\": " << JSONString(e.name) << ",\n"
+         << indent << "  \"calls\": ";
+      PrintJSONValue(e.count, aggregated, os);
+      os << ",\n" << indent << "  \"inclusive\": ";
+      PrintJSONValue(e.incl, aggregated, os);
+      os << ",\n" << indent << "  \"exclusive\": ";
+      PrintJSONValue(e.excl, aggregated, os);
+      if (e.flops[2] > 0.0 || e.bytes[2] > 0.0)
+      {
+         os << ",\n" << indent << "  \"flops\": ";
+         PrintJSONValue(e.flops, aggregated, os);
+         os << ",\n" << indent << "  \"bytes\": ";
+         PrintJSONValue(e.bytes, aggregated, os);
+      }
+      os << ",\n" << indent << "  \"children\": [";
+      if (i < entries.size() && entries[i].depth > depth)
+      {
+         os << '\n';
+         PrintJSONEntries(entries, i, depth + 1, aggregated, os);
+         os << '\n' << indent << "  ";
+      }
+      os << "]\n" << indent << "}";
+      first = false;
+   }
+}
+
+static void PrintProfilerJSON(const std::vector<ProfilerEntry> &entries,
+                              int nranks, std::ostream &os)
+{
+   std::ostringstream s;
+   s << std::setprecision(9);
+   s << "{\n  \"ranks\": " << nranks << ",\n  \"regions\": [";
+   if (!entries.empty())
+   {
+      s << '\n';
+      size_t i = 0;
+      PrintJSONEntries(entries, i, 0, nranks > 1, s);
+      s << "\n  ";
+   }
+   s << "]\n}\n";
+   os << s.str() << std::flush;
+}
+
+// Roofline report of the entries with work, using their average values.
+static void PrintProfilerRoofline(const std::vector<ProfilerEntry> &entries,
+                                  double peak_gflops, double peak_gbs,
+                                  std::ostream &os)
+{
+   const int name_width = 40;
+   const bool peaks = (peak_gflops > 0.0 && peak_gbs > 0.0);
+   std::ostringstream s;
+   s << std::left << std::setw(name_width) << "Region" << std::right
+     << std::setw(10) << "Calls" << std::setw(12) << "Time (s)"
+     << std::setw(10) << "GFLOP/s" << std::setw(10) << "GB/s"
+     << std::setw(10) << "Flop/B";
+   if (peaks) { s << std::setw(10) << "Bound" << std::setw(9) << "% peak"; }
+   const std::string header = s.str();
+   os << header << '\n' << std::string(header.size(), '-') << '\n';
+
+   s.str("");
+   for (size_t i = 0; i < entries.size(); i++)
+   {
+      const ProfilerEntry &e = entries[i];
+      const double time = e.incl[1], flops = e.flops[1], bytes = e.bytes[1];
+      const std::string name = std::string(2*e.depth, ' ') + e.name;
+      if (flops == 0.0 && bytes == 0.0)
+      {
+         // print the name of the regions containing regions with work
+         bool work = false;
+         for (size_t j = i + 1; j < entries.size() &&
+              entries[j].depth > e.depth && !work; j++)
+         {
+            work = (entries[j].flops[1] > 0.0 || entries[j].bytes[1] > 0.0);
+         }
+         if (work) { s << name << '\n'; }
+         continue;
+      }
+      const double gflops = (time > 0.0) ? 1e-9*flops/time : 0.0;
+      const double gbs = (time > 0.0) ? 1e-9*bytes/time : 0.0;
+      const double intensity = (bytes > 0.0) ? flops/bytes : 0.0;
+      s << std::left << std::setw(name_width) << name << std::right
+        << std::setw(10) << long(e.count[1]) << std::scientific
+        << std::setprecision(3) << std::setw(12) << time << std::fixed
+        << std::setprecision(2) << std::setw(10) << gflops << std::setw(10)
+        << gbs << std::setw(10) << intensity;
+      if (peaks)
+      {
+         // the data movement regions are compared to the bandwidth
+         const bool memory = (bytes > 0.0) &&
+                             (intensity*peak_gbs < peak_gflops);
+         const double percent = (flops == 0.0) ? 100.0*gbs/peak_gbs :
+                                100.0*gflops/std::min(peak_gflops,
+                                                      intensity*peak_gbs);
+         s << std::setw(10) << (memory ? "memory" : "compute")
+           << std::setprecision(1) << std::setw(9) << percent;
+      }
+      s << '\n';
+   }
+   if (peaks)
+   {
+      s << "Peaks: " << std::setprecision(2) << peak_gflops << " GFLOP/s, "
+        << peak_gbs << " GB/s, ridge point " << peak_gflops/peak_gbs
+        << " flop/B\n";
+   }
+   os << s.str() << std::flush;
+}
+
+} // namespace internal
+
+using namespace internal;
+
+void Profiler::Enable(bool enable)
+{
+   if (enable)
+   {
+      profiler_thread.store(std::this_thread::get_id(),
+                            std::memory_order_relaxed);
+   }
+   profiler_enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled()
+{
+   return profiler_enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::EnableDetails(bool enable)
+{
+   profiler_details.store(enable, std::memory_order_relaxed);
+}
+
+bool Profiler::DetailsEnabled()
+{
+   return profiler_details.load(std::memory_order_relaxed);
+}
+
+int Profiler::RegisterRegion(const char *name)
+{
+   ProfilerRegistry &registry = GetProfilerRegistry();
+   std::lock_guard<std::mutex> lock(registry.mutex);
+   auto it = registry.keys.find(name);
+   if (it != registry.keys.end()) { return it->second; }
+   const int key = registry.names.size();
+   registry.names.push_back(name);
+   registry.keys[name] = key;
+   return key;
+}
+
+void Profiler::SetDeviceSync(bool sync)
+{
+   profiler_device_sync = sync;
+}
+
+int Profiler::Begin(int key, bool detail)
+{
+   if (!IsRecording()) { return -1; }
+   if (detail && !DetailsEnabled()) { profiler_skipped_depth++; return -2; }
+   return OpenRegion(key);
+}
+
+int Profiler::Begin(const char *name, bool detail)
+{
+   if (!IsRecording()) { return -1; }
+   if (detail && !DetailsEnabled()) { profiler_skipped_depth++; return -2; }
+   return OpenRegion(RegisterRegion(name));
+}
+
+void Profiler::End(int id)
+{
+   if (id == -2 && IsProfilerThread())
+   {
+      // a fine-grained region that was not recorded
+      if (profiler_skipped_depth > 0) { profiler_skipped_depth--; }
+      return;
+   }
+   if (id <= 0 || !IsProfilerThread()) { return; }
+   ProfilerTree &tree = GetProfilerTree();
+   if (id != tree.current) { return; }
+   ProfilerNode &node = tree.nodes[id];
+   if (profiler_device_sync && (node.flops > 0.0 || node.bytes > 0.0) &&
+       Device::Allows(Backend::DEVICE_MASK))
+   {
+      MFEM_DEVICE_SYNC;
+   }
+   node.time += std::chrono::duration<double>(ProfilerClock::now() -
+                                              node.start).count();
+   tree.current = node.parent;
+}
+
+void Profiler::End(const char *name)
+{
+   if (!IsProfilerThread()) { return; }
+   ProfilerTree &tree = GetProfilerTree();
+   if (tree.current == 0) { return; }
+   bool same;
+   {
+      ProfilerRegistry &registry = GetProfilerRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      same = (registry.names[tree.nodes[tree.current].key] == name);
+   }
+   if (same) { End(tree.current); }
+}
+
+void Profiler::AddWork(double flops, double bytes)
+{
+   if (!IsRecording() || profiler_skipped_depth > 0) { return; }
+   ProfilerTree &tree = GetProfilerTree();
+   if (tree.current == 0) { return; }
+   tree.nodes[tree.current].flops += flops;
+   tree.nodes[tree.current].bytes += bytes;
+}
+
+void Profiler::Reset()
+{
+   ProfilerTree &tree = GetProfilerTree();
+   const ProfilerClock::time_point now = ProfilerClock::now();
+   for (ProfilerNode &node : tree.nodes)
+   {
+      node.count = 0;
+      node.time = 0.0;
+      node.flops = node.bytes = 0.0;
+      node.start = now;
+   }
+}
+
+void Profiler::PrintReport(std::ostream &os)
+{
+   std::vector<ProfilerEntry> entries;
+   GetProfilerEntries(entries);
+   PrintProfilerReport(entries, false, os);
+}
+
+void Profiler::PrintJSON(std::ostream &os)
+{
+   std::vector<ProfilerEntry> entries;
+   GetProfilerEntries(entries);
+   PrintProfilerJSON(entries, 1, os);
+}
+
+void Profiler::PrintRoofline(std::ostream &os, double peak_gflops,
+                             double peak_gbs)
+{
+   std::vector<ProfilerEntry> entries;
+   GetProfilerEntries(entries);
+   PrintProfilerRoofline(entries, peak_gflops, peak_gbs, os);
+}
+
+#ifdef MFEM_USE_MPI
+void Profiler::PrintReport(MPI_Comm comm, std::ostream &os)
+{
+   std::vector<ProfilerEntry> entries;
+   GetProfilerEntries(comm, entries);
+   int rank, nranks;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nranks);
+   if (rank == 0) { PrintProfilerReport(entries, nranks > 1, os); }
+}
+
+void Profiler::PrintJSON(MPI_Comm comm, std::ostream &os)
+{
+   std::vector<ProfilerEntry> entries;
+   GetProfilerEntries(comm, entries);
+   int rank, nranks;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nranks);
+   if (rank == 0) { PrintProfilerJSON(entries, nranks, os); }
+}
+
+void Profiler::PrintRoofline(MPI_Comm comm, std::ostream &os,
+                             double peak_gflops, double peak_gbs)
+{
+   std::vector<ProfilerEntry> entries;
+   GetProfilerEntries(comm, entries);
+   int rank;
+   MPI_Comm_rank(comm, &rank);
+   if (rank == 0) { PrintProfilerRoofline(entries, peak_gflops, peak_gbs, os); }
+}
+#endif
+
+} // namespace mfem
@@ -0,0 +1,195 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PROFILER_HPP
+#define MFEM_PROFILER_HPP
+
+#include "../config/config.hpp"
+#include "globals.hpp"
+#include <string>
+
+namespace mfem
+{
+
+/** @brief Built-in hierarchical region profiler.
+
+    The library is instrumented with the MFEM_PERF_FUNCTION, MFEM_PERF_SCOPE,
+    MFEM_PERF_BEGIN and MFEM_PERF_END macros of annotation.hpp, which open and
+    close profiler regions, in addition to the Caliper annotations when MFEM is
+    built with Caliper.
+
+    The regions form a tree: a region opened while another one is open is
+    recorded as its child, so a region entered from different places has
+    different entries in the tree. For each entry, the profiler records the
+    number of calls and the inclusive time, i.e. the total time spent in the
+    region. The exclusive time is the inclusive time minus the inclusive time
+    of the child regions.
+
+    The profiler is enabled by default, see Enable(). It is meant for coarse
+    regions, such as assembly, solves or mesh and space updates, and only
+    records the regions opened by the thread that enabled it (the main thread
+    by default), outside of OpenMP parallel regions. The fine-grained regions,
+    such as the element restrictions, the partial assembly kernels and the
+    iterations of the Krylov solvers, are opened with the MFEM_PERF_DETAIL_*
+    macros and are only recorded after EnableDetails().
+
+    The regions are identified by a key, given by RegisterRegion() for their
+    name. The annotation macros register the name of a region once per call
+    site, so opening a region does not compare names. The regions opened
+    by other threads are ignored, so the profiler can be used in threaded
+    applications, but the reports and Reset() should be called from the
+    recording thread.
+
+    The compute kernels can register their analytic numbers of floating point
+    operations and of bytes moved to or from memory with AddWork(), usually
+    through the MFEM_PERF_WORK macro, e.g. in terms of the number of elements
+    and of the number of 1D dofs and quadrature points of the partial assembly
+    kernels. PrintRoofline() then reports the achieved GFLOP/s, GB/s and the
+    arithmetic intensity of these regions, and compares them to the roofline
+    of the machine when its peak performance and bandwidth are given.
+
+    The reports are printed in text or JSON format. In parallel, the counts and
+    the times are aggregated over the processors of a communicator, giving
+    their minimum, average and maximum. */
+class Profiler
+{
+public:
+   /** @brief Enable or disable the recording of new regions, enabled by
+       default.
+
+       When enabling, the calling thread becomes the thread that records the
+       regions. */
+   static void Enable(bool enable = true);
+
+   /// Return true if the profiler is enabled.
+   static bool IsEnabled();
+
+   /** @brief Enable or disable the recording of the fine-grained regions,
+       opened with @a detail = true, disabled by default. */
+   static void EnableDetails(bool enable = true);
+
+   /// Return true if the fine-grained regions are recorded.
+   static bool DetailsEnabled();
+
+   /** @brief Return the key of the region @a name, the same for all calls
+       with the same name. This function is thread-safe. */
+   static int RegisterRegion(const char *name);
+
+   /** @brief Open the region with the given @a key, see RegisterRegion(), as
+       a child of the current region and return its id, or a negative value
+       if the region is not recorded: if the profiler is disabled, if the
+       calling thread is not the recording thread or if the region is a
+       fine-grained region, with @a detail = true, and EnableDetails() was not
+       called. */
+   static int Begin(int key, bool detail = false);
+
+   /** @brief Open the region @a name, see Begin(int, bool). The name is
+       registered with RegisterRegion() only if the region is recorded. */
+   static int Begin(const char *name, bool detail = false);
+
+   /** @brief Close the region with the given @a id, returned by Begin().
+
+       Nothing is done if @a id is not the current region, e.g. if it is -1. */
+   static void End(int id);
+
+   /// Close the current region if its name is @a name.
+   static void End(const char *name);
+
+   /** @brief Add @a flops floating point operations and @a bytes of memory
+       traffic to the work of the current region. Nothing is added inside a
+       fine-grained region that is not recorded.
+
+       The device kernels are asynchronous, so without SetDeviceSync() the
+       times of these regions only include the kernel launches. */
+   static void AddWork(double flops, double bytes);
+
+   /** @brief Synchronize the device when closing the regions with work, so
+       that their times include the kernel execution, disabled by default.
+
+       This is used for the roofline reports, see PrintRoofline(), and adds a
+       synchronization per region with work, which serializes the host and
+       the device. */
+   static void SetDeviceSync(bool sync = true);
+
+   /** @brief Clear the counts and the times of all regions.
+
+       The regions that are open remain open, and the time they spend after
+       the call is recorded when they are closed. */
+   static void Reset();
+
+   /** @brief Print a text report with the number of calls, the inclusive and
+       exclusive times and the percentage of the total time of each region. */
+   static void PrintReport(std::ostream &os = mfem::out);
+
+   /** @brief Print the region tree in JSON format, with the number of calls,
+       the inclusive and exclusive times (in seconds) of each region. */
+   static void PrintJSON(std::ostream &os = mfem::out);
+
+   /** @brief Print the roofline report of the regions with work: the number
+       of calls, the time, the achieved GFLOP/s and GB/s and the arithmetic
+       intensity, in flops per byte.
+
+       When the device is enabled, the times are only meaningful if the
+       regions were recorded with SetDeviceSync().
+
+       If the peak performance @a peak_gflops (GFLOP/s) and bandwidth
+       @a peak_gbs (GB/s) of the machine are positive, the report also gives
+       the bound of each region, memory or compute, and the percentage of its
+       attainable performance, min(peak_gflops, intensity*peak_gbs). */
+   static void PrintRoofline(std::ostream &os = mfem::out,
+                             double peak_gflops = 0.0, double peak_gbs = 0.0);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Print a text report with the minimum, average and maximum over
+       the processors in @a comm of the counts and the times of each region.
+
+       This function is collective on @a comm and prints on its rank 0. A
+       region missing on a processor has zero calls and time there. */
+   static void PrintReport(MPI_Comm comm, std::ostream &os = mfem::out);
+
+   /** @brief Print the region tree in JSON format, with the minimum, average
+       and maximum over the processors in @a comm of the counts and times.
+
+       This function is collective on @a comm and prints on its rank 0. */
+   static void PrintJSON(MPI_Comm comm, std::ostream &os = mfem::out);
+
+   /** @brief Print the roofline report with the average over the processors
+       in @a comm of the times and the work, i.e. with the rates of a
+       processor, where the peaks are those of a processor.
+
+       This function is collective on @a comm and prints on its rank 0. */
+   static void PrintRoofline(MPI_Comm comm, std::ostream &os = mfem::out,
+                             double peak_gflops = 0.0, double peak_gbs = 0.0);
+#endif
+};
+
+/// Profiler region, open during the lifetime of the object.
+class ProfilerRegion
+{
+private:
+   const int id;
+
+public:
+   explicit ProfilerRegion(int key, bool detail = false)
+      : id(Profiler::Begin(key, detail)) { }
+
+   explicit ProfilerRegion(const char *name, bool detail = false)
+      : id(Profiler::Begin(name, detail)) { }
+
+   explicit ProfilerRegion(const std::string &name, bool detail = false)
+      : id(Profiler::Begin(name.c_str(), detail)) { }
+
+   ~ProfilerRegion() { Profiler::End(id); }
+};
+
+} // namespace mfem
+
+#endif
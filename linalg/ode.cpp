@@ -11,10 +11,52 @@
 
 #include "operator.hpp"
 #include "ode.hpp"
+#include "../general/forall.hpp"
 
 namespace mfem
 {
 
+// Set y = x + h sum_{j<m} a[j] k[j], or y = h sum_{j<m} a[j] k[j] if x is NULL,
+// where x may be the same as y. The zero coefficients are skipped and the sum
+// is fused with MultiAxpy().
+static void AddStages(const Vector *x, const int m, const double *a,
+                      const double h, const Vector *k, Vector &y)
+{
+   // the buffers are only allocated for tableaus with many stages
+   const int max_stages = 16;
+   const Vector *kp_buf[max_stages];
+   double ha_buf[max_stages];
+   Array<const Vector*> kp_heap;
+   Array<double> ha_heap;
+   const Vector **kp = kp_buf;
+   double *ha = ha_buf;
+   if (m > max_stages)
+   {
+      kp_heap.SetSize(m);
+      ha_heap.SetSize(m);
+      kp = kp_heap.GetData();
+      ha = ha_heap.GetData();
+   }
+   int nk = 0;
+   for (int j = 0; j < m; j++)
+   {
+      if (a[j] != 0.0)
+      {
+         kp[nk] = &k[j];
+         ha[nk++] = h*a[j];
+      }
+   }
+   if (nk == 0)
+   {
+      if (x == NULL) { y = 0.0; }
+      else if (x != &y) { y = *x; }
+      return;
+   }
+   if (x == NULL) { y.Set(ha[0], *kp[0]); }
+   else { add(*x, ha[0], *kp[0], y); }
+   MultiAxpy(nk-1, ha+1, kp+1, y);
+}
+
 void ODESolver::Init(TimeDependentOperator &f_)
 {
    this->f = &f_;
@@ -168,21 +210,14 @@ void ExplicitRKSolver::Step(Vector &x, double &t, double &dt)
 
    f->SetTime(t);
    f->Mult(x, k[0]);
-   for (int l = 0, i = 1; i < s; i++)
+   for (int l = 0, i = 1; i < s; l += i, i++)
    {
-      add(x, a[l++]*dt, k[0], y);
-      for (int j = 1; j < i; j++)
-      {
-         y.Add(a[l++]*dt, k[j]);
-      }
+      AddStages(&x, i, a + l, dt, k, y);
 
       f->SetTime(t + c[i-1]*dt);
       f->Mult(y, k[i]);
    }
-   for (int i = 0; i < s; i++)
-   {
-      x.Add(b[i]*dt, k[i]);
-   }
+   AddStages(&x, s, b, dt, k, x);
    t += dt;
 }
 
@@ -343,6 +378,390 @@ const double RK8Solver::c[] =
    1.,
 };
 
+double PIStepController::Factor(double err, int k, bool accepted)
+{
+   if (!std::isfinite(err)) { return min_factor; }
+   // avoid overflow for vanishing errors
+   err = std::max(err, 1e-10);
+   double factor;
+   if (accepted)
+   {
+      factor = safety*std::pow(err, -(k_I + k_P)/k)*std::pow(err_prev, k_P/k);
+      err_prev = std::max(err, 1e-4);
+   }
+   else
+   {
+      factor = std::min(safety*std::pow(err, -1.0/k), 1.0);
+   }
+   return std::min(std::max(factor, min_factor), max_factor);
+}
+
+AdaptiveODESolver::AdaptiveODESolver(int order_, int emb_order_)
+   : order(order_), emb_order(emb_order_), rtol(1e-4), atol(1e-8),
+     dt_min(0.0), dt_max(infinity()), dt_next(0.0), t_final(infinity()),
+     t_last(-infinity()),
+     step_control(emb_order_ > 0), num_steps(0), num_rejected(0),
+     last_err(0.0)
+#ifdef MFEM_USE_MPI
+   , comm(MPI_COMM_NULL)
+#endif
+{ }
+
+void AdaptiveODESolver::Init(TimeDependentOperator &f_)
+{
+   ODESolver::Init(f_);
+   y.SetSize(f->Width(), mem_type);
+   err.SetSize(f->Width(), mem_type);
+   dt_next = 0.0;
+   t_final = infinity();
+   t_last = -infinity();
+   num_steps = num_rejected = 0;
+   last_err = 0.0;
+   controller.Reset();
+}
+
+double AdaptiveODESolver::ErrorNorm(const Vector &x)
+{
+   const int n = x.Size();
+   const double rt = rtol, at = atol;
+   auto X = x.Read();
+   auto Y = y.Read();
+   auto E = err.ReadWrite();
+   MFEM_FORALL(i, n,
+   {
+      E[i] /= at + rt*fmax(fabs(X[i]), fabs(Y[i]));
+   });
+   double sum[2] = { err*err, (double)n };
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, sum, 2, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+   return (sum[1] > 0.0) ? std::sqrt(sum[0]/sum[1]) : 0.0;
+}
+
+bool AdaptiveODESolver::IsLastSolution(const Vector &x, double t,
+                                       Vector &tmp)
+{
+   // y still holds the solution of the last accepted step
+   int same = (t == t_last && x.Size() == y.Size());
+   if (same && &x != &y)
+   {
+      const int n = x.Size();
+      tmp.SetSize(n);
+      auto X = x.Read();
+      auto Y = y.Read();
+      auto T = tmp.Write();
+      MFEM_FORALL(i, n, T[i] = (X[i] == Y[i]) ? 1.0 : 0.0;);
+      same = (n == 0 || tmp.Min() > 0.0);
+   }
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, &same, 1, MPI_INT, MPI_MIN, comm);
+   }
+#endif
+   return same;
+}
+
+void AdaptiveODESolver::Step(Vector &x, double &t, double &dt)
+{
+   double h = dt;
+   if (step_control)
+   {
+      if (dt_next > 0.0) { h = dt_next; }
+      h = std::min(std::max(h, dt_min), dt_max);
+      // the step to the final time of Run() may be shorter than dt_min
+      h = std::min(h, t_final - t);
+   }
+   // the error estimate is of order emb_order + 1 in h
+   const int k = emb_order + 1;
+   while (true)
+   {
+      EmbeddedStep(x, t, h, y, err);
+      if (!step_control) { break; }
+      last_err = ErrorNorm(x);
+      if (last_err <= 1.0 || h <= dt_min)
+      {
+         dt_next = h*controller.Factor(last_err, k, true);
+         dt_next = std::min(std::max(dt_next, dt_min), dt_max);
+         break;
+      }
+      num_rejected++;
+      h = std::max(h*controller.Factor(last_err, k, false), dt_min);
+      h = std::min(h, t_final - t);
+      MFEM_VERIFY(t + h > t, "the time step size underflowed");
+   }
+   // land exactly on the final time of Run()
+   t_last = (h == t_final - t) ? t_final : t + h;
+   StepAccepted();
+   x = y;
+   t = t_last;
+   dt = h;
+   num_steps++;
+}
+
+void AdaptiveODESolver::Run(Vector &x, double &t, double &dt, double tf)
+{
+   if (!step_control) { ODESolver::Run(x, t, dt, tf); return; }
+   // limit the steps, including the last one, to reach tf
+   t_final = tf;
+   while (t < tf)
+   {
+      Step(x, t, dt);
+   }
+   t_final = infinity();
+}
+
+EmbeddedRKSolver::EmbeddedRKSolver(int s_, const double *a_,
+                                   const double *b_, const double *bh_,
+                                   const double *c_, int order_,
+                                   int emb_order_)
+   : AdaptiveODESolver(order_, emb_order_), s(s_), a(a_), b(b_), c(c_),
+     d(s_), k0_valid(false), k0_fsal(false)
+{
+   for (int i = 0; i < s; i++) { d[i] = b[i] - bh_[i]; }
+   // the last row of the tableau, of stage s-1, is equal to b
+   const double *a_last = a + (s-1)*(s-2)/2;
+   fsal = (c[s-2] == 1.0 && b[s-1] == 0.0);
+   for (int j = 0; j < s-1; j++) { fsal = fsal && (a_last[j] == b[j]); }
+   k = new Vector[s];
+}
+
+void EmbeddedRKSolver::Init(TimeDependentOperator &f_)
+{
+   AdaptiveODESolver::Init(f_);
+   const int n = f->Width();
+   z.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+   k0_valid = k0_fsal = false;
+}
+
+void EmbeddedRKSolver::EmbeddedStep(const Vector &x, double t, double h,
+                                    Vector &y_, Vector &err_)
+{
+   // The last stage of the previous step is only reused if the step starts
+   // from its solution, i.e. if x and t were not modified in between.
+   if (k0_fsal)
+   {
+      k0_valid = IsLastSolution(x, t, z);
+      k0_fsal = false;
+   }
+   // The first stage does not depend on h, so it is reused by the repeated
+   // rejected steps.
+   if (!k0_valid)
+   {
+      f->SetTime(t);
+      f->Mult(x, k[0]);
+      k0_valid = true;
+   }
+   for (int l = 0, i = 1; i < s; l += i, i++)
+   {
+      AddStages(&x, i, a + l, h, k, z);
+
+      f->SetTime(t + c[i-1]*h);
+      f->Mult(z, k[i]);
+   }
+   AddStages(&x, s, b, h, k, y_);
+   AddStages(NULL, s, d.GetData(), h, k, err_);
+}
+
+void EmbeddedRKSolver::StepAccepted()
+{
+   if (fsal) { k[0].Swap(k[s-1]); }
+   k0_valid = false;
+   k0_fsal = fsal;
+}
+
+EmbeddedRKSolver::~EmbeddedRKSolver()
+{
+   delete [] k;
+}
+
+const double EmbeddedRK32Solver::a[] =
+{
+   1.0/2.0,
+   0.0, 3.0/4.0,
+   2.0/9.0, 1.0/3.0, 4.0/9.0
+};
+const double EmbeddedRK32Solver::b[] =
+{
+   2.0/9.0, 1.0/3.0, 4.0/9.0, 0.0
+};
+const double EmbeddedRK32Solver::bh[] =
+{
+   7.0/24.0, 1.0/4.0, 1.0/3.0, 1.0/8.0
+};
+const double EmbeddedRK32Solver::c[] =
+{
+   1.0/2.0, 3.0/4.0, 1.0
+};
+
+const double EmbeddedRK54Solver::a[] =
+{
+   1.0/5.0,
+   3.0/40.0, 9.0/40.0,
+   44.0/45.0, -56.0/15.0, 32.0/9.0,
+   19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0,
+   9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0,
+   35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0
+};
+const double EmbeddedRK54Solver::b[] =
+{
+   35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0, 0.0
+};
+const double EmbeddedRK54Solver::bh[] =
+{
+   5179.0/57600.0, 0.0, 7571.0/16695.0, 393.0/640.0, -92097.0/339200.0,
+   187.0/2100.0, 1.0/40.0
+};
+const double EmbeddedRK54Solver::c[] =
+{
+   1.0/5.0, 3.0/10.0, 4.0/5.0, 8.0/9.0, 1.0, 1.0
+};
+
+const double EmbeddedRK65Solver::a[] =
+{
+   1.0/6.0,
+   4.0/75.0, 16.0/75.0,
+   5.0/6.0, -8.0/3.0, 5.0/2.0,
+   -165.0/64.0, 55.0/6.0, -425.0/64.0, 85.0/96.0,
+   12.0/5.0, -8.0, 4015.0/612.0, -11.0/36.0, 88.0/255.0,
+   -8263.0/15000.0, 124.0/75.0, -643.0/680.0, -81.0/250.0, 2484.0/10625.0, 0.0,
+   3501.0/1720.0, -300.0/43.0, 297275.0/52632.0, -319.0/2322.0, 24068.0/84065.0,
+   0.0, 3850.0/26703.0
+};
+const double EmbeddedRK65Solver::b[] =
+{
+   3.0/40.0, 0.0, 875.0/2244.0, 23.0/72.0, 264.0/1955.0, 0.0, 125.0/11592.0,
+   43.0/616.0
+};
+const double EmbeddedRK65Solver::bh[] =
+{
+   13.0/160.0, 0.0, 2375.0/5984.0, 5.0/16.0, 12.0/85.0, 3.0/44.0, 0.0, 0.0
+};
+const double EmbeddedRK65Solver::c[] =
+{
+   1.0/6.0, 4.0/15.0, 2.0/3.0, 5.0/6.0, 1.0, 1.0/15.0, 1.0
+};
+
+LowStorageRKSolver::LowStorageRKSolver(int s_, const double *A_,
+                                       const double *B_, const double *c_)
+   : s(s_), A(A_), B(B_), c(c_)
+{
+   MFEM_VERIFY(A[0] == 0.0, "the first stage must not use dx");
+}
+
+void LowStorageRKSolver::Init(TimeDependentOperator &f_)
+{
+   ODESolver::Init(f_);
+   dx.SetSize(f->Width(), mem_type);
+   k.SetSize(f->Width(), mem_type);
+   dx = 0.0;
+}
+
+void LowStorageRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   const int n = x.Size();
+   for (int i = 0; i < s; i++)
+   {
+      f->SetTime(t + c[i]*dt);
+      f->Mult(x, k);
+
+      const double a = A[i], b = B[i], h = dt;
+      auto X = x.ReadWrite();
+      auto DX = dx.ReadWrite();
+      auto K = k.Read();
+      MFEM_FORALL(j, n,
+      {
+         const double d = a*DX[j] + h*K[j];
+         DX[j] = d;
+         X[j] += b*d;
+      });
+   }
+   t += dt;
+}
+
+const double LSRK3Solver::A[] =
+{
+   0.0, -5.0/9.0, -153.0/128.0
+};
+const double LSRK3Solver::B[] =
+{
+   1.0/3.0, 15.0/16.0, 8.0/15.0
+};
+const double LSRK3Solver::c[] =
+{
+   0.0, 1.0/3.0, 3.0/4.0
+};
+
+const double LSRK54Solver::A[] =
+{
+   0.0, -567301805773.0/1357537059087.0, -2404267990393.0/2016746695238.0,
+   -3550918686646.0/2091501179385.0, -1275806237668.0/842570457699.0
+};
+const double LSRK54Solver::B[] =
+{
+   1432997174477.0/9575080441755.0, 5161836677717.0/13612068292357.0,
+   1720146321549.0/2090206949498.0, 3134564353537.0/4481467310338.0,
+   2277821191437.0/14882151754819.0
+};
+const double LSRK54Solver::c[] =
+{
+   0.0, 1432997174477.0/9575080441755.0, 2526269341429.0/6820363962896.0,
+   2006345519317.0/3224310063776.0, 2802321613138.0/2924317926251.0
+};
+
+void SSPRK104Solver::Init(TimeDependentOperator &f_)
+{
+   ODESolver::Init(f_);
+   q.SetSize(f->Width(), mem_type);
+   k.SetSize(f->Width(), mem_type);
+}
+
+void SSPRK104Solver::Step(Vector &x, double &t, double &dt)
+{
+   const int n = x.Size();
+   q = x;
+   for (int i = 0; i < 5; i++)
+   {
+      f->SetTime(t + i*dt/6.0);
+      f->Mult(x, k);
+      x.Add(dt/6.0, k);
+   }
+   {
+      // q = q/25 + 9/25 x, x = 15 q - 5 x
+      auto X = x.ReadWrite();
+      auto Q = q.ReadWrite();
+      MFEM_FORALL(j, n,
+      {
+         const double qj = Q[j]/25.0 + 9.0*X[j]/25.0;
+         Q[j] = qj;
+         X[j] = 15.0*qj - 5.0*X[j];
+      });
+   }
+   for (int i = 2; i < 6; i++)
+   {
+      f->SetTime(t + i*dt/6.0);
+      f->Mult(x, k);
+      x.Add(dt/6.0, k);
+   }
+   f->SetTime(t + dt);
+   f->Mult(x, k);
+   {
+      // x = q + 3/5 x + dt/10 k
+      const double h = dt;
+      auto X = x.ReadWrite();
+      auto Q = q.Read();
+      auto K = k.Read();
+      MFEM_FORALL(j, n, X[j] = Q[j] + 0.6*X[j] + 0.1*h*K[j];);
+   }
+   t += dt;
+}
 
 AdamsBashforthSolver::AdamsBashforthSolver(int s_, const double *a_)
 {
@@ -781,6 +1200,279 @@ void ESDIRK33Solver::Step(Vector &x, double &t, double &dt)
    t += dt;
 }
 
+EmbeddedESDIRKSolver::EmbeddedESDIRKSolver(int s_, const double *a_,
+                                           const double *b_,
+                                           const double *bh_,
+                                           const double *c_, int order_,
+                                           int emb_order_)
+   : AdaptiveODESolver(order_, emb_order_), s(s_), a(a_), b(b_), c(c_),
+     d(s_), k0_valid(false), k0_fsal(false)
+{
+   for (int i = 0; i < s; i++) { d[i] = b[i] - bh_[i]; }
+   k = new Vector[s];
+}
+
+void EmbeddedESDIRKSolver::Init(TimeDependentOperator &f_)
+{
+   AdaptiveODESolver::Init(f_);
+   const int n = f->Width();
+   z.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+   k0_valid = k0_fsal = false;
+}
+
+void EmbeddedESDIRKSolver::EmbeddedStep(const Vector &x, double t, double h,
+                                        Vector &y_, Vector &err_)
+{
+   // as in EmbeddedRKSolver, the last stage is only reused from the solution
+   if (k0_fsal)
+   {
+      k0_valid = IsLastSolution(x, t, z);
+      k0_fsal = false;
+   }
+   if (!k0_valid)
+   {
+      f->SetTime(t);
+      f->Mult(x, k[0]);
+      k0_valid = true;
+   }
+   for (int l = 0, i = 1; i < s; l += i+1, i++)
+   {
+      AddStages(&x, i, a + l, h, k, z);
+
+      f->SetTime(t + c[i-1]*h);
+      f->ImplicitSolve(a[l+i]*h, z, k[i]);
+   }
+   AddStages(&x, s, b, h, k, y_);
+   AddStages(NULL, s, d.GetData(), h, k, err_);
+}
+
+void EmbeddedESDIRKSolver::StepAccepted()
+{
+   // stiffly accurate: the last stage is evaluated at the solution
+   k[0].Swap(k[s-1]);
+   k0_valid = false;
+   k0_fsal = true;
+}
+
+EmbeddedESDIRKSolver::~EmbeddedESDIRKSolver()
+{
+   delete [] k;
+}
+
+const double EmbeddedESDIRK32Solver::a[] =
+{
+   1767732205903.0/4055673282236.0, 1767732205903.0/4055673282236.0,
+   2746238789719.0/10658868560708.0, -640167445237.0/6845629431997.0,
+   1767732205903.0/4055673282236.0,
+   1471266399579.0/7840856788654.0, -4482444167858.0/7529755066697.0,
+   11266239266428.0/11593286722821.0, 1767732205903.0/4055673282236.0
+};
+const double EmbeddedESDIRK32Solver::b[] =
+{
+   1471266399579.0/7840856788654.0, -4482444167858.0/7529755066697.0,
+   11266239266428.0/11593286722821.0, 1767732205903.0/4055673282236.0
+};
+const double EmbeddedESDIRK32Solver::bh[] =
+{
+   2756255671327.0/12835298489170.0, -10771552573575.0/22201958757719.0,
+   9247589265047.0/10645013368117.0, 2193209047091.0/5459859503100.0
+};
+const double EmbeddedESDIRK32Solver::c[] =
+{
+   1767732205903.0/2027836641118.0, 3.0/5.0, 1.0
+};
+
+const double EmbeddedESDIRK43Solver::a[] =
+{
+   1.0/4.0, 1.0/4.0,
+   8611.0/62500.0, -1743.0/31250.0, 1.0/4.0,
+   5012029.0/34652500.0, -654441.0/2922500.0, 174375.0/388108.0, 1.0/4.0,
+   15267082809.0/155376265600.0, -71443401.0/120774400.0,
+   730878875.0/902184768.0, 2285395.0/8070912.0, 1.0/4.0,
+   82889.0/524892.0, 0.0, 15625.0/83664.0, 69875.0/102672.0, -2260.0/8211.0,
+   1.0/4.0
+};
+const double EmbeddedESDIRK43Solver::b[] =
+{
+   82889.0/524892.0, 0.0, 15625.0/83664.0, 69875.0/102672.0, -2260.0/8211.0,
+   1.0/4.0
+};
+const double EmbeddedESDIRK43Solver::bh[] =
+{
+   4586570599.0/29645900160.0, 0.0, 178811875.0/945068544.0,
+   814220225.0/1159782912.0, -3700637.0/11593932.0, 61727.0/225920.0
+};
+const double EmbeddedESDIRK43Solver::c[] =
+{
+   1.0/2.0, 83.0/250.0, 31.0/50.0, 17.0/20.0, 1.0
+};
+
+IMEXRKSolver::IMEXRKSolver(int s_, const double *ae_, const double *ai_,
+                           const double *be_, const double *bi_,
+                           const double *bh_, const double *c_, int order_,
+                           int emb_order_)
+   : AdaptiveODESolver(order_, emb_order_), s(s_), ae(ae_), ai(ai_),
+     be(be_), bi(bi_), c(c_), de(s_), di(s_), k0_valid(false)
+{
+   for (int i = 0; i < s; i++)
+   {
+      de[i] = bh_ ? be[i] - bh_[i] : 0.0;
+      di[i] = bh_ ? bi[i] - bh_[i] : 0.0;
+   }
+   ke = new Vector[s];
+   ki = new Vector[s];
+}
+
+void IMEXRKSolver::Init(TimeDependentOperator &f_)
+{
+   AdaptiveODESolver::Init(f_);
+   const int n = f->Width();
+   z.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      ke[i].SetSize(n, mem_type);
+      ki[i].SetSize(n, mem_type);
+   }
+   k0_valid = false;
+}
+
+void IMEXRKSolver::EmbeddedStep(const Vector &x, double t, double h,
+                                Vector &y_, Vector &err_)
+{
+   const TimeDependentOperator::EvalMode mode = f->GetEvalMode();
+   if (!k0_valid)
+   {
+      f->SetTime(t);
+      f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_1);
+      f->Mult(x, ke[0]);
+      f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+      f->Mult(x, ki[0]);
+      k0_valid = true;
+   }
+   for (int le = 0, li = 0, i = 1; i < s; le += i, li += i+1, i++)
+   {
+      AddStages(&x, i, ae + le, h, ke, z);
+      AddStages(&z, i, ai + li, h, ki, z);
+
+      // solve for the implicit term, then evaluate the explicit term at the
+      // stage solution
+      const double a_ii = ai[li+i];
+      f->SetTime(t + c[i-1]*h);
+      f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+      f->ImplicitSolve(a_ii*h, z, ki[i]);
+      z.Add(a_ii*h, ki[i]);
+      f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_1);
+      f->Mult(z, ke[i]);
+   }
+   f->SetEvalMode(mode);
+
+   AddStages(&x, s, be, h, ke, y_);
+   AddStages(&y_, s, bi, h, ki, y_);
+   AddStages(NULL, s, de.GetData(), h, ke, err_);
+   AddStages(&err_, s, di.GetData(), h, ki, err_);
+}
+
+IMEXRKSolver::~IMEXRKSolver()
+{
+   delete [] ke;
+   delete [] ki;
+}
+
+// ARS(2,2,2) with gamma = 1 - 1/sqrt(2) and delta = 1 - 1/(2 gamma)
+const double IMEXARS222Solver::ae[] =
+{
+   1.0 - 1.0/sqrt(2.0),
+   1.0 - 1.0/(2.0 - sqrt(2.0)), 1.0/(2.0 - sqrt(2.0))
+};
+const double IMEXARS222Solver::ai[] =
+{
+   0.0, 1.0 - 1.0/sqrt(2.0),
+   0.0, 1.0/sqrt(2.0), 1.0 - 1.0/sqrt(2.0)
+};
+const double IMEXARS222Solver::be[] =
+{
+   1.0 - 1.0/(2.0 - sqrt(2.0)), 1.0/(2.0 - sqrt(2.0)), 0.0
+};
+const double IMEXARS222Solver::bi[] =
+{
+   0.0, 1.0/sqrt(2.0), 1.0 - 1.0/sqrt(2.0)
+};
+const double IMEXARS222Solver::c[] =
+{
+   1.0 - 1.0/sqrt(2.0), 1.0
+};
+
+const double IMEXARK32Solver::ae[] =
+{
+   1767732205903.0/2027836641118.0,
+   5535828885825.0/10492691773637.0, 788022342437.0/10882634858940.0,
+   6485989280629.0/16251701735622.0, -4246266847089.0/9704473918619.0,
+   10755448449292.0/10357097424841.0
+};
+const double IMEXARK32Solver::ai[] =
+{
+   1767732205903.0/4055673282236.0, 1767732205903.0/4055673282236.0,
+   2746238789719.0/10658868560708.0, -640167445237.0/6845629431997.0,
+   1767732205903.0/4055673282236.0,
+   1471266399579.0/7840856788654.0, -4482444167858.0/7529755066697.0,
+   11266239266428.0/11593286722821.0, 1767732205903.0/4055673282236.0
+};
+const double IMEXARK32Solver::b[] =
+{
+   1471266399579.0/7840856788654.0, -4482444167858.0/7529755066697.0,
+   11266239266428.0/11593286722821.0, 1767732205903.0/4055673282236.0
+};
+const double IMEXARK32Solver::bh[] =
+{
+   2756255671327.0/12835298489170.0, -10771552573575.0/22201958757719.0,
+   9247589265047.0/10645013368117.0, 2193209047091.0/5459859503100.0
+};
+const double IMEXARK32Solver::c[] =
+{
+   1767732205903.0/2027836641118.0, 3.0/5.0, 1.0
+};
+
+const double IMEXARK43Solver::ae[] =
+{
+   1.0/2.0,
+   13861.0/62500.0, 6889.0/62500.0,
+   -116923316275.0/2393684061468.0, -2731218467317.0/15368042101831.0,
+   9408046702089.0/11113171139209.0,
+   -451086348788.0/2902428689909.0, -2682348792572.0/7519795681897.0,
+   12662868775082.0/11960479115383.0, 3355817975965.0/11060851509271.0,
+   647845179188.0/3216320057751.0, 73281519250.0/8382639484533.0,
+   552539513391.0/3454668386233.0, 3354512671639.0/8306763924573.0,
+   4040.0/17871.0
+};
+const double IMEXARK43Solver::ai[] =
+{
+   1.0/4.0, 1.0/4.0,
+   8611.0/62500.0, -1743.0/31250.0, 1.0/4.0,
+   5012029.0/34652500.0, -654441.0/2922500.0, 174375.0/388108.0, 1.0/4.0,
+   15267082809.0/155376265600.0, -71443401.0/120774400.0,
+   730878875.0/902184768.0, 2285395.0/8070912.0, 1.0/4.0,
+   82889.0/524892.0, 0.0, 15625.0/83664.0, 69875.0/102672.0, -2260.0/8211.0,
+   1.0/4.0
+};
+const double IMEXARK43Solver::b[] =
+{
+   82889.0/524892.0, 0.0, 15625.0/83664.0, 69875.0/102672.0, -2260.0/8211.0,
+   1.0/4.0
+};
+const double IMEXARK43Solver::bh[] =
+{
+   4586570599.0/29645900160.0, 0.0, 178811875.0/945068544.0,
+   814220225.0/1159782912.0, -3700637.0/11593932.0, 61727.0/225920.0
+};
+const double IMEXARK43Solver::c[] =
+{
+   1.0/2.0, 83.0/250.0, 31.0/50.0, 17.0/20.0, 1.0
+};
+
 void GeneralizedAlphaSolver::Init(TimeDependentOperator &f_)
 {
    ODESolver::Init(f_);
@@ -223,6 +223,284 @@ public:
 };
 
 
+/** @brief Proportional-integral (PI) step size controller for the adaptive
+    ODE solvers, see AdaptiveODESolver.
+
+    After a step with scaled error estimate err, where err <= 1 is acceptable,
+    the step size is multiplied by the factor
+        safety * err^(-(k_I + k_P)/k) * err_prev^(k_P/k),
+    where k is the order of the error estimate plus one and err_prev is the
+    error of the previous accepted step. The factor is limited to the range
+    [min_factor, max_factor]. After a rejected step, the factor is
+    safety * err^(-1/k), at most one. */
+class PIStepController
+{
+protected:
+   double k_I, k_P, safety, min_factor, max_factor;
+   double err_prev;
+
+public:
+   PIStepController(double k_I_ = 0.3, double k_P_ = 0.4)
+      : k_I(k_I_), k_P(k_P_), safety(0.9), min_factor(0.2),
+        max_factor(5.0), err_prev(1.0) { }
+
+   /// Set the integral and proportional gains.
+   void SetGains(double k_I_, double k_P_) { k_I = k_I_; k_P = k_P_; }
+
+   void SetSafetyFactor(double safety_) { safety = safety_; }
+
+   /// Set the limits of the step size factor.
+   void SetFactorLimits(double min_factor_, double max_factor_)
+   { min_factor = min_factor_; max_factor = max_factor_; }
+
+   /// Forget the error of the previous step.
+   void Reset() { err_prev = 1.0; }
+
+   /** @brief Return the step size factor after a step of error @a err, for an
+       error estimate of order @a k - 1. The error is stored as the previous
+       error if the step is @a accepted. */
+   double Factor(double err, int k, bool accepted);
+};
+
+
+/** @brief Abstract base class for the ODE solvers with an embedded error
+    estimate and adaptive step size control.
+
+    Each step computes a solution of order #order and an error estimate of
+    order #emb_order. The error is measured in the weighted root mean square
+    norm
+        sqrt( 1/N sum_i ( e_i / (atol + rtol max(|x_i|, |y_i|)) )^2 ),
+    where x and y are the solutions at the beginning and at the end of the
+    step. A step is accepted if the error norm is at most one, otherwise it is
+    repeated with a smaller step size. The step sizes are chosen by a
+    PIStepController.
+
+    In parallel, the solution vectors are typically the true-dof vectors of a
+    ParFiniteElementSpace: the norm is then reduced over the communicator set
+    with SetComm().
+
+    With step control, the input @a dt of the first Step() after Init() is the
+    initial step size, and the following steps use the size proposed by the
+    controller, see GetNextTimeStep(). The output @a dt is the size of the
+    accepted step. Run() limits the last step to reach the final time. Without
+    step control, see EnableStepControl(), the steps use the input @a dt. */
+class AdaptiveODESolver : public ODESolver
+{
+protected:
+   const int order, emb_order;
+   double rtol, atol, dt_min, dt_max, dt_next;
+   /// Final time of Run(), limiting the step sizes, or infinity.
+   double t_final;
+   /// Time of the solution of the last accepted step, stored in @a y.
+   double t_last;
+   bool step_control;
+   int num_steps, num_rejected;
+   double last_err;
+   PIStepController controller;
+#ifdef MFEM_USE_MPI
+   /// Communicator for the error norm, MPI_COMM_NULL in serial.
+   MPI_Comm comm;
+#endif
+   /// Solution at the end of the step and its error estimate.
+   Vector y, err;
+
+   /** @brief Compute the solution @a y_ at time @a t + @a h and the error
+       estimate @a err_ of one step of size @a h from the solution @a x at time
+       @a t. */
+   virtual void EmbeddedStep(const Vector &x, double t, double h, Vector &y_,
+                             Vector &err_) = 0;
+
+   /// Called after a step is accepted, before the solution is updated.
+   virtual void StepAccepted() { }
+
+   /// Return the weighted root mean square norm of the error estimate.
+   double ErrorNorm(const Vector &x);
+
+   /** @brief Return true if @a x and @a t are the solution and the time of
+       the last accepted step, on all ranks of the communicator. The vector
+       @a tmp is used as a work vector. */
+   bool IsLastSolution(const Vector &x, double t, Vector &tmp);
+
+public:
+   AdaptiveODESolver(int order_, int emb_order_);
+
+   /// Set the relative and absolute tolerances of the error estimate.
+   void SetTolerances(double rtol_, double atol_)
+   { rtol = rtol_; atol = atol_; }
+
+   /// Set the minimal and maximal step sizes.
+   void SetStepSizeLimits(double dt_min_, double dt_max_)
+   { dt_min = dt_min_; dt_max = dt_max_; }
+
+   /** @brief Enable or disable the step size control, enabled by default if
+       the method has an error estimate. */
+   void EnableStepControl(bool enable = true)
+   {
+      MFEM_VERIFY(!enable || emb_order > 0, "the method has no error estimate");
+      step_control = enable;
+   }
+
+#ifdef MFEM_USE_MPI
+   /// Set the communicator used to reduce the error norm.
+   void SetComm(MPI_Comm comm_) { comm = comm_; }
+#endif
+
+   PIStepController &GetController() { return controller; }
+
+   /// Return the order of the solution.
+   int GetOrder() const { return order; }
+
+   /// Return the step size proposed for the next step.
+   double GetNextTimeStep() const { return dt_next; }
+
+   /// Return the number of accepted steps since Init().
+   int GetNumSteps() const { return num_steps; }
+
+   /// Return the number of rejected steps since Init().
+   int GetNumRejectedSteps() const { return num_rejected; }
+
+   /// Return the error norm of the last step.
+   double GetLastError() const { return last_err; }
+
+   void Init(TimeDependentOperator &f_) override;
+
+   void Step(Vector &x, double &t, double &dt) override;
+
+   void Run(Vector &x, double &t, double &dt, double tf) override;
+};
+
+
+/** @brief An explicit embedded Runge-Kutta pair, given by a Butcher tableau
+    as in ExplicitRKSolver, with the weights @a b of the solution and @a bh of
+    the embedded solution used for the error estimate.
+
+    If the last stage is evaluated at the solution (first same as last, FSAL),
+    it is reused as the first stage of the next step, unless the next step
+    starts from a different solution @a x or time @a t. */
+class EmbeddedRKSolver : public AdaptiveODESolver
+{
+private:
+   int s;
+   const double *a, *b, *c;
+   Array<double> d; // b - bh
+   bool fsal, k0_valid, k0_fsal;
+   Vector z, *k;
+
+protected:
+   void EmbeddedStep(const Vector &x, double t, double h, Vector &y_,
+                     Vector &err_) override;
+
+   void StepAccepted() override;
+
+public:
+   EmbeddedRKSolver(int s_, const double *a_, const double *b_,
+                    const double *bh_, const double *c_, int order_,
+                    int emb_order_);
+
+   void Init(TimeDependentOperator &f_) override;
+
+   virtual ~EmbeddedRKSolver();
+};
+
+
+/// The 4-stage, 3rd order Bogacki-Shampine pair with a 2nd order estimate.
+class EmbeddedRK32Solver : public EmbeddedRKSolver
+{
+private:
+   static const double a[6], b[4], bh[4], c[3];
+
+public:
+   EmbeddedRK32Solver() : EmbeddedRKSolver(4, a, b, bh, c, 3, 2) { }
+};
+
+
+/// The 7-stage, 5th order Dormand-Prince pair with a 4th order estimate.
+class EmbeddedRK54Solver : public EmbeddedRKSolver
+{
+private:
+   static const double a[21], b[7], bh[7], c[6];
+
+public:
+   EmbeddedRK54Solver() : EmbeddedRKSolver(7, a, b, bh, c, 5, 4) { }
+};
+
+
+/** The 8-stage, 6th order Verner pair with a 5th order estimate, from
+    Verner's 1978 6(5) pair, also used by DVERK. */
+class EmbeddedRK65Solver : public EmbeddedRKSolver
+{
+private:
+   static const double a[28], b[8], bh[8], c[7];
+
+public:
+   EmbeddedRK65Solver() : EmbeddedRKSolver(8, a, b, bh, c, 6, 5) { }
+};
+
+
+/** @brief A low-storage explicit Runge-Kutta method in the 2N form of
+    Williamson.
+
+    Each stage i = 0, ..., s-1 performs the updates
+        dx = A[i] dx + dt f(x, t + c[i] dt),   x = x + B[i] dx,
+    with A[0] = 0. Besides the solution, only the vectors dx and f(x) are
+    stored, independently of the number of stages, and the two updates are
+    fused in one kernel. */
+class LowStorageRKSolver : public ODESolver
+{
+private:
+   int s;
+   const double *A, *B, *c;
+   Vector dx, k;
+
+public:
+   LowStorageRKSolver(int s_, const double *A_, const double *B_,
+                      const double *c_);
+
+   void Init(TimeDependentOperator &f_) override;
+
+   void Step(Vector &x, double &t, double &dt) override;
+};
+
+
+/// Williamson's 3-stage, 3rd order low-storage method.
+class LSRK3Solver : public LowStorageRKSolver
+{
+private:
+   static const double A[3], B[3], c[3];
+
+public:
+   LSRK3Solver() : LowStorageRKSolver(3, A, B, c) { }
+};
+
+
+/// The 5-stage, 4th order low-storage method of Carpenter and Kennedy.
+class LSRK54Solver : public LowStorageRKSolver
+{
+private:
+   static const double A[5], B[5], c[5];
+
+public:
+   LSRK54Solver() : LowStorageRKSolver(5, A, B, c) { }
+};
+
+
+/** @brief The 10-stage, 4th order strong stability preserving (SSP) method
+    SSPRK(10,4) of Ketcheson, with SSP coefficient 6.
+
+    The method uses two registers: besides the solution, only one vector and
+    the evaluation of f(x) are stored. */
+class SSPRK104Solver : public ODESolver
+{
+private:
+   Vector q, k;
+
+public:
+   void Init(TimeDependentOperator &f_) override;
+
+   void Step(Vector &x, double &t, double &dt) override;
+};
+
+
 /** An explicit Adams-Bashforth method. */
 class AdamsBashforthSolver : public ODESolver
 {
@@ -504,6 +782,150 @@ public:
 };
 
 
+/** @brief An embedded explicit singly diagonal implicit Runge-Kutta (ESDIRK)
+    pair with adaptive step size control.
+
+    The first stage is explicit, the other stages are solved with
+    TimeDependentOperator::ImplicitSolve(). The tableau is given by the rows
+    a[] of the stages 1 to s-1, including the diagonal entry, i.e. row i has
+    i+1 entries, the nodes c_1, ..., c_{s-1} and the weights @a b and @a bh.
+    The supported pairs are stiffly accurate, so the last stage is reused as
+    the first stage of the next step, see EmbeddedRKSolver. */
+class EmbeddedESDIRKSolver : public AdaptiveODESolver
+{
+private:
+   int s;
+   const double *a, *b, *c;
+   Array<double> d; // b - bh
+   bool k0_valid, k0_fsal;
+   Vector z, *k;
+
+protected:
+   void EmbeddedStep(const Vector &x, double t, double h, Vector &y_,
+                     Vector &err_) override;
+
+   void StepAccepted() override;
+
+public:
+   EmbeddedESDIRKSolver(int s_, const double *a_, const double *b_,
+                        const double *bh_, const double *c_, int order_,
+                        int emb_order_);
+
+   void Init(TimeDependentOperator &f_) override;
+
+   virtual ~EmbeddedESDIRKSolver();
+};
+
+
+/** The 4-stage, 3rd order ESDIRK3(2)4L[2]SA pair of Kennedy and Carpenter
+    with a 2nd order estimate. L-stable. */
+class EmbeddedESDIRK32Solver : public EmbeddedESDIRKSolver
+{
+private:
+   static const double a[9], b[4], bh[4], c[3];
+
+public:
+   EmbeddedESDIRK32Solver() : EmbeddedESDIRKSolver(4, a, b, bh, c, 3, 2) { }
+};
+
+
+/** The 6-stage, 4th order ESDIRK4(3)6L[2]SA pair of Kennedy and Carpenter
+    with a 3rd order estimate. L-stable. */
+class EmbeddedESDIRK43Solver : public EmbeddedESDIRKSolver
+{
+private:
+   static const double a[20], b[6], bh[6], c[5];
+
+public:
+   EmbeddedESDIRK43Solver() : EmbeddedESDIRKSolver(6, a, b, bh, c, 4, 3) { }
+};
+
+
+/** @brief An implicit-explicit (IMEX) additive Runge-Kutta method for the
+    additive split f(x,t) = f1(x,t) + f2(x,t), where f1 is integrated
+    explicitly and f2 implicitly.
+
+    The terms are evaluated with the evaluation modes of the
+    TimeDependentOperator, see TimeDependentOperator::SetEvalMode():
+    - in the mode ADDITIVE_TERM_1, Mult() evaluates the explicit term f1;
+    - in the mode ADDITIVE_TERM_2, Mult() evaluates the implicit term f2 and
+      ImplicitSolve() solves k = f2(x + dt k, t).
+    This is the same convention as the IMEX mode of ARKStepSolver. For example,
+    with a non-stiff advection term f1 and a linear diffusion term f2, the
+    implicit stages only solve linear diffusion problems, e.g. with partial
+    assembly and CG.
+
+    The explicit tableau is given by the rows @a ae of the stages 1 to s-1, as
+    in ExplicitRKSolver, and the implicit tableau by the rows @a ai of the
+    stages 1 to s-1, including the diagonal entry, as in EmbeddedESDIRKSolver.
+    The two tableaus share the nodes @a c, and have their own weights @a be
+    and @a bi. If the embedded weights @a bh, shared by the two tableaus, are
+    given, the step size is controlled as in AdaptiveODESolver. */
+class IMEXRKSolver : public AdaptiveODESolver
+{
+private:
+   int s;
+   const double *ae, *ai, *be, *bi, *c;
+   Array<double> de, di; // be - bh, bi - bh
+   bool k0_valid;
+   Vector z, *ke, *ki;
+
+protected:
+   void EmbeddedStep(const Vector &x, double t, double h, Vector &y_,
+                     Vector &err_) override;
+
+   void StepAccepted() override { k0_valid = false; }
+
+public:
+   /** @brief Construct the method from the tableaus @a ae, @a ai, their
+       weights @a be, @a bi and the embedded weights @a bh, where @a bh may be
+       NULL if the method has no embedded error estimate. */
+   IMEXRKSolver(int s_, const double *ae_, const double *ai_,
+                const double *be_, const double *bi_, const double *bh_,
+                const double *c_, int order_, int emb_order_);
+
+   void Init(TimeDependentOperator &f_) override;
+
+   virtual ~IMEXRKSolver();
+};
+
+
+/** The 3-stage, 2nd order ARS(2,2,2) IMEX method of Ascher, Ruuth and
+    Spiteri. The implicit part is L-stable. No error estimate. */
+class IMEXARS222Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[3], ai[5], be[3], bi[3], c[2];
+
+public:
+   IMEXARS222Solver() : IMEXRKSolver(3, ae, ai, be, bi, NULL, c, 2, 0) { }
+};
+
+
+/** The 4-stage, 3rd order ARK3(2)4L[2]SA IMEX method of Kennedy and Carpenter
+    with a 2nd order error estimate. The implicit part is L-stable. */
+class IMEXARK32Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[6], ai[9], b[4], bh[4], c[3];
+
+public:
+   IMEXARK32Solver() : IMEXRKSolver(4, ae, ai, b, b, bh, c, 3, 2) { }
+};
+
+
+/** The 6-stage, 4th order ARK4(3)6L[2]SA IMEX method of Kennedy and Carpenter
+    with a 3rd order error estimate. The implicit part is L-stable. */
+class IMEXARK43Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[15], ai[20], b[6], bh[6], c[5];
+
+public:
+   IMEXARK43Solver() : IMEXRKSolver(6, ae, ai, b, b, bh, c, 4, 3) { }
+};
+
+
 /// Generalized-alpha ODE solver from "A generalized-α method for integrating
 /// the filtered Navier-Stokes equations with a stabilized finite element
 /// method" by K.E. Jansen, C.H. Whiting and G.M. Hulbert.
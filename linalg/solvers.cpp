@@ -68,6 +68,19 @@ double IterativeSolver::Dot(const Vector &x, const Vector &y) const
 #endif
 }
 
+void IterativeSolver::SumDots(double *vals, int n) const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, vals, n, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#else
+   MFEM_CONTRACT_VAR(vals);
+   MFEM_CONTRACT_VAR(n);
+#endif
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
    print_options = FromLegacyPrintLevel(print_lvl);
@@ -518,12 +531,14 @@ void OperatorChebyshevSmoother::Mult(const Vector& x, Vector &y) const
 
 void SLISolver::UpdateVectors()
 {
+   MemoryUsageTag mem_tag("Solver");
    r.SetSize(width);
    z.SetSize(width);
 }
 
 void SLISolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    int i;
 
    // Optimized preconditioned SLI with fixed number of iterations and given
@@ -604,6 +619,7 @@ void SLISolver::Mult(const Vector &b, Vector &x) const
    final_iter = max_iter;
    for (i = 1; true; )
    {
+      MFEM_PERF_DETAIL_SCOPE("SLISolver::Iteration");
       if (prec) //  x = x + B (b - A x)
       {
          add(x, 1.0, z, x);
@@ -701,6 +717,7 @@ void SLI(const Operator &A, Solver &B, const Vector &b, Vector &x,
 
 void CGSolver::UpdateVectors()
 {
+   MemoryUsageTag mem_tag("Solver");
    MemoryType mt = GetMemoryType(oper->GetMemoryClass());
 
    r.SetSize(width, mt); r.UseDevice(true);
@@ -710,6 +727,7 @@ void CGSolver::UpdateVectors()
 
 void CGSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    int i;
    double r0, den, nom, nom0, betanom, alpha, beta;
 
@@ -788,18 +806,23 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    final_iter = max_iter;
    for (i = 1; true; )
    {
+      MFEM_PERF_DETAIL_SCOPE("CGSolver::Iteration");
       alpha = nom/den;
       add(x,  alpha, d, x);     //  x = x + alpha d
-      add(r, -alpha, z, r);     //  r = r - alpha A d
 
       if (prec)
       {
+         // The reduction (r, B r) needs the preconditioner applied to the
+         // updated residual, so it cannot be fused with the update.
+         add(r, -alpha, z, r);  //  r = r - alpha A d
          prec->Mult(r, z);      //  z = B r
          betanom = Dot(r, z);
       }
       else
       {
-         betanom = Dot(r, r);
+         // r = r - alpha A d and (r, r), fused in one pass
+         betanom = AxpbyDot(-alpha, z, 1.0, r, r);
+         SumDots(&betanom, 1);
       }
       MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
       if (betanom < 0.0)
@@ -962,21 +985,20 @@ inline void Update(Vector &x, int k, DenseMatrix &h, Vector &s,
       }
    }
 
-   for (int j = 0; j <= k; j++)
-   {
-      x.Add(y(j), *v[j]);
-   }
+   MultiAxpy(k+1, y.GetData(), v.GetData(), x);
 }
 
 void GMRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
+   MemoryUsageTag mem_tag("Solver");
    // Generalized Minimum Residual method following the algorithm
    // on p. 20 of the SIAM Templates book.
 
    int n = width;
 
    DenseMatrix H(m+1, m);
-   Vector s(m+1), cs(m+1), sn(m+1);
+   Vector s(m+1), cs(m+1), sn(m+1), hv(m+1);
    Vector r(n), w(n);
    Array<Vector *> v;
 
@@ -1048,6 +1070,7 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
 
       for (i = 0; i < m && j <= max_iter; i++, j++)
       {
+         MFEM_PERF_DETAIL_SCOPE("GMRESSolver::Iteration");
          if (prec)
          {
             oper->Mult(*v[i], r);
@@ -1058,10 +1081,30 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
             oper->Mult(*v[i], w);
          }
 
-         for (k = 0; k <= i; k++)
+         if (orthog == CGS2)
          {
-            H(k,i) = Dot(w, *v[k]);  // H(k,i) = w * v[k]
-            w.Add(-H(k,i), *v[k]);   // w -= H(k,i) * v[k]
+            // Classical Gram-Schmidt with one reorthogonalization, with fused
+            // inner products and updates, and one reduction per pass
+            for (k = 0; k <= i; k++) { H(k,i) = 0.0; }
+            for (int pass = 0; pass < 2; pass++)
+            {
+               MultiDot(i+1, v.GetData(), w, hv.GetData()); // hv(k) = w*v[k]
+               SumDots(hv.GetData(), i+1);
+               for (k = 0; k <= i; k++)
+               {
+                  H(k,i) += hv(k);
+                  hv(k) = -hv(k);
+               }
+               MultiAxpy(i+1, hv.GetData(), v.GetData(), w); // w -= hv(k)v[k]
+            }
+         }
+         else
+         {
+            for (k = 0; k <= i; k++)
+            {
+               H(k,i) = Dot(w, *v[k]);  // H(k,i) = w * v[k]
+               w.Add(-H(k,i), *v[k]);   // w -= H(k,i) * v[k]
+            }
          }
 
          H(i+1,i) = Norm(w);           // H(i+1,i) = ||w||
@@ -1158,8 +1201,10 @@ finish:
 
 void FGMRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
+   MemoryUsageTag mem_tag("Solver");
    DenseMatrix H(m+1,m);
-   Vector s(m+1), cs(m+1), sn(m+1);
+   Vector s(m+1), cs(m+1), sn(m+1), hv(m+1);
    Vector r(b.Size());
 
    int i, j, k;
@@ -1219,6 +1264,7 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
 
       for (i = 0; i < m && j <= max_iter; i++, j++)
       {
+         MFEM_PERF_DETAIL_SCOPE("FGMRESSolver::Iteration");
 
          if (z[i] == NULL) { z[i] = new Vector(b.Size()); }
          (*z[i]) = 0.0;
@@ -1233,10 +1279,29 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
          }
          oper->Mult(*z[i], r);
 
-         for (k = 0; k <= i; k++)
+         if (orthog == GMRESSolver::CGS2)
+         {
+            // Classical Gram-Schmidt with one reorthogonalization
+            for (k = 0; k <= i; k++) { H(k,i) = 0.0; }
+            for (int pass = 0; pass < 2; pass++)
+            {
+               MultiDot(i+1, v.GetData(), r, hv.GetData()); // hv(k) = r*v[k]
+               SumDots(hv.GetData(), i+1);
+               for (k = 0; k <= i; k++)
+               {
+                  H(k,i) += hv(k);
+                  hv(k) = -hv(k);
+               }
+               MultiAxpy(i+1, hv.GetData(), v.GetData(), r); // r -= hv(k)v[k]
+            }
+         }
+         else
          {
-            H(k,i) = Dot( r, *v[k]); // H(k,i) = r * v[k]
-            r.Add(-H(k,i), (*v[k])); // r -= H(k,i) * v[k]
+            for (k = 0; k <= i; k++)
+            {
+               H(k,i) = Dot( r, *v[k]); // H(k,i) = r * v[k]
+               r.Add(-H(k,i), (*v[k])); // r -= H(k,i) * v[k]
+            }
          }
 
          H(i+1,i)  = Norm(r);       // H(i+1,i) = ||r||
@@ -1360,6 +1425,7 @@ void GMRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
 
 void BiCGSTABSolver::UpdateVectors()
 {
+   MemoryUsageTag mem_tag("Solver");
    p.SetSize(width);
    phat.SetSize(width);
    s.SetSize(width);
@@ -1372,6 +1438,7 @@ void BiCGSTABSolver::UpdateVectors()
 
 void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    // BiConjugate Gradient Stabilized method following the algorithm
    // on p. 27 of the SIAM Templates book.
 
@@ -1413,6 +1480,7 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
 
    for (i = 1; i <= max_iter; i++)
    {
+      MFEM_PERF_DETAIL_SCOPE("BiCGSTABSolver::Iteration");
       rho_1 = Dot(rtilde, r);
       if (rho_1 == 0)
       {
@@ -1587,6 +1655,7 @@ void BiCGSTAB(const Operator &A, Solver &B, const Vector &b, Vector &x,
 
 void MINRESSolver::SetOperator(const Operator &op)
 {
+   MemoryUsageTag mem_tag("Solver");
    IterativeSolver::SetOperator(op);
    v0.SetSize(width);
    v1.SetSize(width);
@@ -1601,6 +1670,7 @@ void MINRESSolver::SetOperator(const Operator &op)
 
 void MINRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    // Based on the MINRES algorithm on p. 86, Fig. 6.9 in
    // "Iterative Krylov Methods for Large Linear Systems",
    // by Henk A. van der Vorst, 2003.
@@ -1650,6 +1720,7 @@ void MINRESSolver::Mult(const Vector &b, Vector &x) const
 
    for (it = 1; it <= max_iter; it++)
    {
+      MFEM_PERF_DETAIL_SCOPE("MINRESSolver::Iteration");
       v1 /= beta;
       if (prec)
       {
@@ -1803,6 +1874,7 @@ void NewtonSolver::SetOperator(const Operator &op)
 
 void NewtonSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    MFEM_ASSERT(oper != NULL, "the Operator is not set (use SetOperator).");
    MFEM_ASSERT(prec != NULL, "the Solver is not set (use SetSolver).");
 
@@ -1836,6 +1908,7 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
    // x_{i+1} = x_i - [DF(x_i)]^{-1} [F(x_i)-b]
    for (it = 0; true; it++)
    {
+      MFEM_PERF_SCOPE("NewtonSolver::Iteration");
       MFEM_ASSERT(IsFinite(norm), "norm = " << norm);
       if (print_options.iterations)
       {
@@ -1991,6 +2064,7 @@ void NewtonSolver::AdaptiveLinRtolPostSolve(const Vector &x,
 
 void LBFGSSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
    MFEM_VERIFY(oper != NULL, "the Operator is not set (use SetOperator).");
 
    // Quadrature points that are checked for negative Jacobians etc.
@@ -2030,6 +2104,7 @@ void LBFGSSolver::Mult(const Vector &b, Vector &x) const
    norm_goal = std::max(rel_tol*norm, abs_tol);
    for (it = 0; true; it++)
    {
+      MFEM_PERF_SCOPE("LBFGSSolver::Iteration");
       MFEM_ASSERT(IsFinite(norm), "norm = " << norm);
       if (print_options.iterations)
       {
@@ -169,6 +169,9 @@ protected:
 
    double Dot(const Vector &x, const Vector &y) const;
    double Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
+   /** @brief Sum the @a n local inner products in @a vals over the processors,
+       as in Dot(), e.g. after AxpbyDot() or MultiDot(). */
+   void SumDots(double *vals, int n) const;
    void Monitor(int it, double norm, const Vector& r, const Vector& x,
                 bool final=false) const;
 
@@ -496,19 +499,38 @@ void PCG(const Operator &A, Solver &B, const Vector &b, Vector &x,
 /// GMRES method
 class GMRESSolver : public IterativeSolver
 {
+public:
+   /// Orthogonalization methods of the Krylov basis, see SetOrthogonalization.
+   enum Orthogonalization
+   {
+      MGS,  ///< Modified Gram-Schmidt, one reduction per basis vector
+      CGS2  ///< Classical Gram-Schmidt with reorthogonalization, two reductions
+   };
+
 protected:
    int m; // see SetKDim()
+   Orthogonalization orthog; // see SetOrthogonalization()
 
 public:
-   GMRESSolver() { m = 50; }
+   GMRESSolver() { m = 50; orthog = MGS; }
 
 #ifdef MFEM_USE_MPI
-   GMRESSolver(MPI_Comm comm_) : IterativeSolver(comm_) { m = 50; }
+   GMRESSolver(MPI_Comm comm_) : IterativeSolver(comm_)
+   { m = 50; orthog = MGS; }
 #endif
 
    /// Set the number of iteration to perform between restarts, default is 50.
    void SetKDim(int dim) { m = dim; }
 
+   /** @brief Set the orthogonalization method of the Krylov basis, default is
+       MGS. */
+   /** With CGS2, the inner products with all basis vectors are computed in one
+       pass over the data and summed in one reduction, twice per iteration,
+       instead of once per basis vector with MGS. This reduces the memory
+       traffic and the number of global reductions in parallel, at the cost
+       of twice the floating point work. */
+   void SetOrthogonalization(Orthogonalization type) { orthog = type; }
+
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
@@ -517,16 +539,23 @@ class FGMRESSolver : public IterativeSolver
 {
 protected:
    int m;
+   GMRESSolver::Orthogonalization orthog;
 
 public:
-   FGMRESSolver() { m = 50; }
+   FGMRESSolver() { m = 50; orthog = GMRESSolver::MGS; }
 
 #ifdef MFEM_USE_MPI
-   FGMRESSolver(MPI_Comm comm_) : IterativeSolver(comm_) { m = 50; }
+   FGMRESSolver(MPI_Comm comm_) : IterativeSolver(comm_)
+   { m = 50; orthog = GMRESSolver::MGS; }
 #endif
 
    void SetKDim(int dim) { m = dim; }
 
+   /** @brief Set the orthogonalization method of the Krylov basis, default is
+       GMRESSolver::MGS, see GMRESSolver::SetOrthogonalization(). */
+   void SetOrthogonalization(GMRESSolver::Orthogonalization type)
+   { orthog = type; }
+
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
@@ -29,6 +29,17 @@ DenseSymmetricMatrix::DenseSymmetricMatrix(int s) : Matrix(s)
    }
 }
 
+DenseSymmetricMatrix::DenseSymmetricMatrix(const DenseSymmetricMatrix &m)
+   : Matrix(m.Height())
+{
+   const int s2 = (height*(height+1))/2;
+   if (s2 > 0)
+   {
+      data.New(s2);
+      for (int i = 0; i < s2; i++) { data[i] = m.data[i]; }
+   }
+}
+
 void DenseSymmetricMatrix::SetSize(int s)
 {
    MFEM_ASSERT(s >= 0,
@@ -58,6 +69,16 @@ DenseSymmetricMatrix &DenseSymmetricMatrix::operator=(double c)
    return *this;
 }
 
+DenseSymmetricMatrix &DenseSymmetricMatrix::operator=(
+   const DenseSymmetricMatrix &m)
+{
+   if (this == &m) { return *this; }
+   SetSize(m.Height());
+   const int s2 = (height*(height+1))/2;
+   for (int i = 0; i < s2; i++) { data[i] = m.data[i]; }
+   return *this;
+}
+
 double &DenseSymmetricMatrix::Elem(int i, int j)
 {
    return (*this)(i,j);
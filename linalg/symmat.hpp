@@ -35,6 +35,9 @@ public:
    /// Creates square matrix of size s.
    explicit DenseSymmetricMatrix(int s);
 
+   /// Copy constructor, copies the data of @a m.
+   DenseSymmetricMatrix(const DenseSymmetricMatrix &m);
+
    /// Construct a DenseSymmetricMatrix using an existing data array.
    /** The DenseSymmetricMatrix does not assume ownership of the data array, i.e. it will
        not delete the array. */
@@ -97,6 +100,9 @@ public:
    /// Sets the matrix elements equal to constant c
    DenseSymmetricMatrix &operator=(double c);
 
+   /// Copy the size and the data of @a m.
+   DenseSymmetricMatrix &operator=(const DenseSymmetricMatrix &m);
+
    DenseSymmetricMatrix &operator*=(double c);
 
    long MemoryUsage() const { return data.Capacity() * sizeof(double); }
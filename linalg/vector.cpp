@@ -507,6 +507,102 @@ void subtract(const double a, const Vector &x, const Vector &y, Vector &z)
    }
 }
 
+double AxpbyDot(const double a, const Vector &x, const double b, Vector &y,
+                const Vector &z)
+{
+   MFEM_ASSERT(x.Size() == y.Size() && x.Size() == z.Size(),
+               "incompatible Vectors!");
+
+   const bool use_dev = x.UseDevice() || y.UseDevice() || z.UseDevice();
+   if (use_dev && Device::Allows(Backend::DEVICE_MASK | Backend::OMP_MASK))
+   {
+      // use the reduction kernels of operator*
+      add(a, x, b, y, y);
+      return y * z;
+   }
+   const int N = x.Size();
+   const double *xp = x.HostRead();
+   // Note: get write access first, in case z is the same as y.
+   double *yp = y.HostReadWrite();
+   const double *zp = z.HostRead();
+   double dot = 0.0;
+   for (int i = 0; i < N; i++)
+   {
+      const double yi = a * xp[i] + b * yp[i];
+      yp[i] = yi;
+      dot += yi * zp[i];
+   }
+   return dot;
+}
+
+void MultiAxpy(const int m, const double *a, const Vector *const *x,
+               Vector &y)
+{
+   bool use_dev = y.UseDevice();
+   for (int k = 0; k < m; k++)
+   {
+      MFEM_ASSERT(x[k]->Size() == y.Size(), "incompatible Vectors!");
+      use_dev = use_dev || x[k]->UseDevice();
+   }
+   const int N = y.Size();
+   for (int k = 0; k < m; k += 4)
+   {
+      // pad the last group with zero coefficients
+      const int nv = std::min(4, m - k);
+      const double a0 = a[k];
+      const double a1 = (nv > 1) ? a[k+1] : 0.0;
+      const double a2 = (nv > 2) ? a[k+2] : 0.0;
+      const double a3 = (nv > 3) ? a[k+3] : 0.0;
+      auto x0 = x[k]->Read(use_dev);
+      auto x1 = (nv > 1) ? x[k+1]->Read(use_dev) : x0;
+      auto x2 = (nv > 2) ? x[k+2]->Read(use_dev) : x0;
+      auto x3 = (nv > 3) ? x[k+3]->Read(use_dev) : x0;
+      auto yd = y.ReadWrite(use_dev);
+      MFEM_FORALL_SWITCH(use_dev, i, N,
+      {
+         yd[i] += a0*x0[i] + a1*x1[i] + a2*x2[i] + a3*x3[i];
+      });
+   }
+}
+
+void MultiDot(const int m, const Vector *const *x, const Vector &y,
+              double *dots)
+{
+   bool use_dev = y.UseDevice();
+   for (int k = 0; k < m; k++)
+   {
+      MFEM_ASSERT(x[k]->Size() == y.Size(), "incompatible Vectors!");
+      use_dev = use_dev || x[k]->UseDevice();
+   }
+   if (use_dev && Device::Allows(Backend::DEVICE_MASK | Backend::OMP_MASK))
+   {
+      // use the reduction kernels of operator*
+      for (int k = 0; k < m; k++) { dots[k] = (*x[k]) * y; }
+      return;
+   }
+   const int N = y.Size();
+   const double *yp = y.HostRead();
+   for (int k = 0; k < m; k += 4)
+   {
+      const int nv = std::min(4, m - k);
+      const double *x0 = x[k]->HostRead();
+      const double *x1 = (nv > 1) ? x[k+1]->HostRead() : x0;
+      const double *x2 = (nv > 2) ? x[k+2]->HostRead() : x0;
+      const double *x3 = (nv > 3) ? x[k+3]->HostRead() : x0;
+      double d0 = 0.0, d1 = 0.0, d2 = 0.0, d3 = 0.0;
+      for (int i = 0; i < N; i++)
+      {
+         const double yi = yp[i];
+         d0 += x0[i] * yi;
+         d1 += x1[i] * yi;
+         d2 += x2[i] * yi;
+         d3 += x3[i] * yi;
+      }
+      const double d[4] = { d0, d1, d2, d3 };
+      for (int j = 0; j < nv; j++) { dots[k+j] = d[j]; }
+   }
+}
+
 void Vector::median(const Vector &lo, const Vector &hi)
 {
    MFEM_ASSERT(size == lo.size && size == hi.size,
@@ -690,6 +690,35 @@ inline double InnerProduct(MPI_Comm comm, const Vector &x, const Vector &y)
 }
 #endif
 
+/** @name Fused BLAS-1 operations
+
+    These functions combine several vector updates and inner products into a
+    single pass over the data, reducing the memory traffic of the Krylov and
+    Runge-Kutta methods. As InnerProduct(const Vector&, const Vector&), the
+    returned inner products are local to each MPI rank. */
+///@{
+
+/** @brief Compute y = a x + b y and return the (local) inner product (y, z)
+    of the updated y with z, in one pass.
+
+    The vector @a z may be the same as @a y, giving the squared norm of the
+    updated vector. */
+double AxpbyDot(const double a, const Vector &x, const double b, Vector &y,
+                const Vector &z);
+
+/** @brief Compute y += sum_{i<m} a[i] x[i], processing the vectors @a x in
+    groups of four, each group in one pass over y. */
+void MultiAxpy(const int m, const double *a, const Vector *const *x,
+               Vector &y);
+
+/** @brief Compute the (local) inner products dots[i] = (x[i], y), i < m,
+    processing the vectors @a x in groups of four, each group in one pass over
+    y. */
+void MultiDot(const int m, const Vector *const *x, const Vector &y,
+              double *dots);
+
+///@}
+
 } // namespace mfem
 
 #endif
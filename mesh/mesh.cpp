@@ -18,8 +18,12 @@
 #include "../general/text.hpp"
 #include "../general/device.hpp"
 #include "../general/tic_toc.hpp"
+#include "../general/annotation.hpp"
 #include "../general/gecko.hpp"
+#include "../general/forall.hpp"
 #include "../fem/quadinterpolator.hpp"
+#include "../linalg/dtensor.hpp"
+#include "../linalg/kernels.hpp"
 
 #include <iostream>
 #include <sstream>
@@ -841,18 +845,63 @@ const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
                                                   const int flags,
                                                   MemoryType d_mt)
 {
+   // requests with the COMPRESSED flag can also use uncompressed factors, the
+   // other requests can use the COMPRESSED factors of non-affine meshes
+   const int factors = flags & ~GeometricFactors::COMPRESSED;
+   const bool compressed_ok = (flags & GeometricFactors::COMPRESSED) ||
+                              !(factors & (GeometricFactors::JACOBIANS |
+                                           GeometricFactors::DETERMINANTS));
    for (int i = 0; i < geom_factors.Size(); i++)
    {
       GeometricFactors *gf = geom_factors[i];
-      if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags)
+      if (gf->IntRule == &ir && (gf->computed_factors & factors) == factors &&
+          (compressed_ok || !gf->compressed))
       {
+         if (gf->nodes_sequence != nodes_sequence)
+         {
+            // the nodes were modified, recompute in place
+            this->EnsureNodes();
+            gf->Compute(*Nodes, d_mt);
+            gf->nodes_sequence = nodes_sequence;
+            if (gf->compressed && !compressed_ok) { continue; }
+         }
          return gf;
       }
    }
 
    this->EnsureNodes();
+   if (!affine_factors)
+   {
+      affine_factors = new AffineFactors;
+      affine_factors->nodes_sequence = -1;
+   }
 
-   GeometricFactors *gf = new GeometricFactors(this, ir, flags, d_mt);
+   // share the coordinates with the factors of the same rule, e.g. when both
+   // COMPRESSED and uncompressed Jacobians are requested on an affine mesh
+   const MemoryType mt = (d_mt != MemoryType::DEFAULT) ? d_mt :
+                         Device::GetDeviceMemoryType();
+   GeometricFactors *coords = NULL;
+   for (int i = 0; i < geom_factors.Size(); i++)
+   {
+      GeometricFactors *gf = geom_factors[i];
+      if ((flags & GeometricFactors::COORDINATES) && gf->IntRule == &ir &&
+          (gf->computed_factors & GeometricFactors::COORDINATES) &&
+          gf->nodes_sequence == nodes_sequence &&
+          gf->X.GetMemory().GetMemoryType() == mt)
+      {
+         coords = gf;
+         break;
+      }
+   }
+
+   const int new_flags =
+      coords ? flags & ~GeometricFactors::COORDINATES : flags;
+   GeometricFactors *gf = new GeometricFactors(*this, ir, new_flags, d_mt);
+   if (coords)
+   {
+      gf->computed_factors |= GeometricFactors::COORDINATES;
+      gf->X.MakeRef(coords->X, 0, coords->X.Size());
+   }
    geom_factors.Append(gf);
    return gf;
 }
@@ -867,6 +916,13 @@ const FaceGeometricFactors* Mesh::GetFaceGeometricFactors(
       if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags &&
           gf->type==type)
       {
+         if (gf->nodes_sequence != nodes_sequence)
+         {
+            // the nodes were modified, recompute in place
+            this->EnsureNodes();
+            gf->Compute(*Nodes);
+            gf->nodes_sequence = nodes_sequence;
+         }
          return gf;
       }
    }
@@ -890,6 +946,44 @@ void Mesh::DeleteGeometricFactors()
       delete face_geom_factors[i];
    }
    face_geom_factors.SetSize(0);
+   // the compressed factors alias the shared affine factors, delete them last
+   delete affine_factors;
+   affine_factors = NULL;
+   delete point_locator;
+   point_locator = NULL;
+}
+
+const PointLocator &Mesh::GetPointLocator()
+{
+   if (point_locator == NULL)
+   {
+      point_locator = new PointLocator(*this);
+   }
+   else if (!point_locator->IsUpToDate())
+   {
+      point_locator->Update();
+   }
+   return *point_locator;
+}
+
+long Mesh::GeometricFactorsMemoryUsage() const
+{
+   long mem = geom_factors.MemoryUsage() + face_geom_factors.MemoryUsage();
+   if (point_locator) { mem += point_locator->MemoryUsage(); }
+   if (affine_factors)
+   {
+      mem += (affine_factors->J.Capacity() +
+              affine_factors->detJ.Capacity()) * sizeof(double);
+   }
+   for (int i = 0; i < geom_factors.Size(); i++)
+   {
+      mem += geom_factors[i]->MemoryUsage();
+   }
+   for (int i = 0; i < face_geom_factors.Size(); i++)
+   {
+      mem += face_geom_factors[i]->MemoryUsage();
+   }
+   return mem;
 }
 
 void Mesh::GetLocalFaceTransformation(
@@ -1444,10 +1538,13 @@ void Mesh::Init()
    nbBoundaryFaces = -1;
    meshgen = mesh_geoms = 0;
    sequence = 0;
+   nodes_sequence = 0;
    Nodes = NULL;
    own_nodes = 1;
    NURBSext = NULL;
    ncmesh = NULL;
+   point_locator = NULL;
+   affine_factors = NULL;
    last_operation = Mesh::NONE;
 }
 
@@ -3046,6 +3143,7 @@ void Mesh::Finalize(bool refine, bool fix_orientation)
 void Mesh::Make3D(int nx, int ny, int nz, Element::Type type,
                   double sx, double sy, double sz, bool sfc_ordering)
 {
+   MemoryUsageTag mem_tag("Mesh");
    int x, y, z;
 
    int NVert, NElem, NBdrElem;
@@ -3328,6 +3426,7 @@ void Mesh::Make2D(int nx, int ny, Element::Type type,
                   double sx, double sy,
                   bool generate_edges, bool sfc_ordering)
 {
+   MemoryUsageTag mem_tag("Mesh");
    int i, j, k;
 
    SetEmpty();
@@ -3504,6 +3603,7 @@ void Mesh::Make2D(int nx, int ny, Element::Type type,
 
 void Mesh::Make1D(int n, double sx)
 {
+   MemoryUsageTag mem_tag("Mesh");
    int j, ind[1];
 
    SetEmpty();
@@ -3564,7 +3664,10 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
 
    // Create the new Mesh instance without a record of its refinement history
    sequence = 0;
+   nodes_sequence = 0;
    last_operation = Mesh::NONE;
+   point_locator = NULL;
+   affine_factors = NULL;
 
    // Duplicate the elements
    elements.SetSize(NumOfElements);
@@ -3992,6 +4095,7 @@ void Mesh::SetMeshGen()
 void Mesh::Loader(std::istream &input, int generate_edges,
                   std::string parse_tag)
 {
+   MemoryUsageTag mem_tag("Mesh");
    int curved = 0, read_gf = 1;
    bool finalize_topo = true;
 
@@ -7822,6 +7926,7 @@ void Mesh::MoveVertices(const Vector &displacements)
       {
          vertices[i](j) += displacements(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetVertices(Vector &vert_coord) const
@@ -7842,6 +7947,7 @@ void Mesh::SetVertices(const Vector &vert_coord)
       {
          vertices[i](j) = vert_coord(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetNode(int i, double *coord) const
@@ -7881,6 +7987,7 @@ void Mesh::SetNode(int i, const double *coord)
       }
 
    }
+   NodesUpdated();
 }
 
 void Mesh::MoveNodes(const Vector &displacements)
@@ -7893,6 +8000,7 @@ void Mesh::MoveNodes(const Vector &displacements)
    {
       MoveVertices(displacements);
    }
+   NodesUpdated();
 }
 
 void Mesh::GetNodes(Vector &node_coord) const
@@ -7917,6 +8025,7 @@ void Mesh::SetNodes(const Vector &node_coord)
    {
       SetVertices(node_coord);
    }
+   NodesUpdated();
 }
 
 void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
@@ -7936,12 +8045,14 @@ void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
    {
       ncmesh->MakeTopologyOnly();
    }
+   NodesUpdated();
 }
 
 void Mesh::SwapNodes(GridFunction *&nodes, int &own_nodes_)
 {
    mfem::Swap<GridFunction*>(Nodes, nodes);
    mfem::Swap<int>(own_nodes, own_nodes_);
+   NodesUpdated();
    // TODO:
    // if (nodes)
    //    nodes->FESpace()->MakeNURBSextOwner();
@@ -8140,6 +8251,25 @@ static inline double sqr(const double &x)
    return x*x;
 }
 
+// Point matrices of the 8 children of the reference cube in a uniform
+// refinement of hexahedra.
+static double *HexChildrenPointMatrices()
+{
+   static const double A = 0.0, B = 0.5, C = 1.0;
+   static double hex_children[3*8*8] =
+   {
+      A,A,A, B,A,A, B,B,A, A,B,A, A,A,B, B,A,B, B,B,B, A,B,B,
+      B,A,A, C,A,A, C,B,A, B,B,A, B,A,B, C,A,B, C,B,B, B,B,B,
+      B,B,A, C,B,A, C,C,A, B,C,A, B,B,B, C,B,B, C,C,B, B,C,B,
+      A,B,A, B,B,A, B,C,A, A,C,A, A,B,B, B,B,B, B,C,B, A,C,B,
+      A,A,B, B,A,B, B,B,B, A,B,B, A,A,C, B,A,C, B,B,C, A,B,C,
+      B,A,B, C,A,B, C,B,B, B,B,B, B,A,C, C,A,C, C,B,C, B,B,C,
+      B,B,B, C,B,B, C,C,B, B,C,B, B,B,C, C,B,C, C,C,C, B,C,C,
+      A,B,B, B,B,B, B,C,B, A,C,B, A,B,C, B,B,C, B,C,C, A,C,C
+   };
+   return hex_children;
+}
+
 void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
                                     bool update_nodes)
 {
@@ -8156,6 +8286,13 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
       GetElementToFaceTable();
    }
 
+   // Serial all-hex meshes: generate the refined topology directly.
+   if (!f2qf_ptr && !v_to_v_p && meshgen == 2 && faces.Size() == NumOfFaces)
+   {
+      UniformRefinementHex3D(update_nodes);
+      return;
+   }
+
    Array<int> f2qf_loc;
    Array<int> &f2qf = f2qf_ptr ? *f2qf_ptr : f2qf_loc;
    f2qf.SetSize(0);
@@ -8778,17 +8915,6 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
       B,A,B, C,A,B, B,B,B, B,A,C, C,A,C, B,B,C,
       A,B,B, B,B,B, A,C,B, A,B,C, B,B,C, A,C,C
    };
-   static double hex_children[3*8*8] =
-   {
-      A,A,A, B,A,A, B,B,A, A,B,A, A,A,B, B,A,B, B,B,B, A,B,B,
-      B,A,A, C,A,A, C,B,A, B,B,A, B,A,B, C,A,B, C,B,B, B,B,B,
-      B,B,A, C,B,A, C,C,A, B,C,A, B,B,B, C,B,B, C,C,B, B,C,B,
-      A,B,A, B,B,A, B,C,A, A,C,A, A,B,B, B,B,B, B,C,B, A,C,B,
-      A,A,B, B,A,B, B,B,B, A,B,B, A,A,C, B,A,C, B,B,C, A,B,C,
-      B,A,B, C,A,B, C,B,B, B,B,B, B,A,C, C,A,C, C,B,C, B,B,C,
-      B,B,B, C,B,B, C,C,B, B,C,B, B,B,C, C,B,C, C,C,C, B,C,C,
-      A,B,B, B,B,B, B,C,B, A,C,B, A,B,C, B,B,C, B,C,C, A,C,C
-   };
 
    CoarseFineTr.point_matrices[Geometry::TETRAHEDRON]
    .UseExternalData(tet_children, 3, 4, 16);
@@ -8797,7 +8923,7 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
    CoarseFineTr.point_matrices[Geometry::PRISM]
    .UseExternalData(pri_children, 3, 6, 8);
    CoarseFineTr.point_matrices[Geometry::CUBE]
-   .UseExternalData(hex_children, 3, 8, 8);
+   .UseExternalData(HexChildrenPointMatrices(), 3, 8, 8);
 
    for (int i = 0; i < elements.Size(); i++)
    {
@@ -8828,6 +8954,300 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
    if (update_nodes) { UpdateNodes(); }
 }
 
+// Return the position of vertex 'v' in the vertex list 'qv' of a quadrilateral.
+static inline int FindQuadVertex(const int *qv, int v)
+{
+   return (qv[0] == v) ? 0 : (qv[1] == v) ? 1 : (qv[2] == v) ? 2 : 3;
+}
+
+// Return the local index of the edge (v0,v1) of a quadrilateral with vertices
+// 'qv', using the edge numbering of Geometry::SQUARE.
+static inline int FindQuadEdge(const int *qv, int v0, int v1)
+{
+   const int p0 = FindQuadVertex(qv, v0), p1 = FindQuadVertex(qv, v1);
+   return ((p0 + 1) % 4 == p1) ? p0 : p1;
+}
+
+// Replace the contents of 'tbl' with 'nrows' rows of 'row_size' entries each.
+// The table takes ownership of the array 'J', allocated with new[].
+static void SetFixedRowTable(Table &tbl, int nrows, int row_size, int *J)
+{
+   int *I = new int[nrows+1];
+   for (int i = 0; i <= nrows; i++) { I[i] = i*row_size; }
+   tbl.SetIJ(I, J, nrows);
+}
+
+void Mesh::UniformRefinementHex3D(bool update_nodes)
+{
+   const int NE = NumOfElements, NBE = NumOfBdrElements;
+   const int NEdges = NumOfEdges, NFaces = NumOfFaces;
+
+   // Offsets for new vertices from edges, faces and elements, same as in
+   // UniformRefinement3D_base().
+   const int oedge = NumOfVertices;
+   const int oface = oedge + NEdges;
+   const int oelem = oface + NFaces;
+
+   // Before the final renumbering, the edges of the refined mesh are indexed
+   // as follows: the two halves of each parent edge (the first one contains
+   // the end-point with the smaller vertex index), then four edges inside each
+   // parent face (one per face edge) and six edges inside each element (one
+   // per element face). Similarly, the faces are indexed as: four sub-faces of
+   // each parent face (one per face vertex) followed by twelve faces inside
+   // each element (one per element edge).
+   const int ofedge = 2*NEdges;
+   const int oeedge = ofedge + 4*NFaces;
+   const int new_NEdges = oeedge + 6*NE;
+   const int oeface = 4*NFaces;
+   const int new_NFaces = oeface + 12*NE;
+
+   // The children of the reference cube in terms of the 27 vertices of the
+   // refined cube: 8 vertices, 12 edge midpoints (8 + edge), 6 face centers
+   // (20 + face) and the center (26).
+   static const int hex_child_v[8][8] =
+   {
+      { 0,  8, 20, 11, 16, 21, 26, 24},
+      { 8,  1,  9, 20, 21, 17, 22, 26},
+      {20,  9,  2, 10, 26, 22, 18, 23},
+      {11, 20, 10,  3, 24, 26, 23, 19},
+      {16, 21, 26, 24,  4, 12, 25, 15},
+      {21, 17, 22, 26, 12,  5, 13, 25},
+      {26, 22, 18, 23, 25, 13,  6, 14},
+      {24, 26, 23, 19, 15, 25, 14,  7}
+   };
+   // The children of the reference square in terms of the 9 vertices of the
+   // refined square: 4 vertices, 4 edge midpoints (4 + edge) and the center.
+   // Child k contains vertex k of the parent.
+   static const int quad_child_v[4][4] =
+   {
+      {0, 4, 8, 7}, {4, 1, 5, 8}, {8, 5, 2, 6}, {7, 8, 6, 3}
+   };
+
+   // New vertices
+   Array<int> edge_v(2*NEdges);
+   for (int i = 0; i < NE; i++)
+   {
+      const int *v = elements[i]->GetVertices();
+      const int *e = el_to_edge->GetRow(i);
+      for (int ei = 0; ei < 12; ei++)
+      {
+         edge_v[2*e[ei]+0] = v[hex_t::Edges[ei][0]];
+         edge_v[2*e[ei]+1] = v[hex_t::Edges[ei][1]];
+      }
+   }
+
+   vertices.SetSize(oelem + NE);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NEdges; i++)
+   {
+      AverageVertices(&edge_v[2*i], 2, oedge + i);
+   }
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NFaces; i++)
+   {
+      AverageVertices(faces[i]->GetVertices(), 4, oface + i);
+   }
+
+   // Refine the elements, recording the edges and faces of the children
+   Array<Element*> new_elements(8*NE);
+   int *el_edge = new int[8*NE*12];
+   int *el_face = new int[8*NE*6];
+   CoarseFineTr.embeddings.SetSize(8*NE);
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NE; i++)
+   {
+      const int attr = elements[i]->GetAttribute();
+      const int *v = elements[i]->GetVertices();
+      const int *e = el_to_edge->GetRow(i);
+      const int *f = el_to_face->GetRow(i);
+
+      int rv[27];
+      for (int k = 0; k < 8; k++) { rv[k] = v[k]; }
+      for (int k = 0; k < 12; k++) { rv[8+k] = oedge + e[k]; }
+      for (int k = 0; k < 6; k++) { rv[20+k] = oface + f[k]; }
+      rv[26] = oelem + i;
+
+      AverageVertices(v, 8, oelem + i);
+
+      for (int c = 0; c < 8; c++)
+      {
+         const int *cv = hex_child_v[c];
+         const int j = 8*i + c;
+
+         new_elements[j] =
+            new Hexahedron(rv[cv[0]], rv[cv[1]], rv[cv[2]], rv[cv[3]],
+                           rv[cv[4]], rv[cv[5]], rv[cv[6]], rv[cv[7]], attr);
+         CoarseFineTr.embeddings[j] = Embedding(i, Geometry::CUBE, c);
+
+         for (int ce = 0; ce < 12; ce++)
+         {
+            const int a = cv[hex_t::Edges[ce][0]];
+            const int b = cv[hex_t::Edges[ce][1]];
+            const int lo = std::min(a, b), hi = std::max(a, b);
+            int id;
+            if (lo < 8) // half of parent edge (hi-8)
+            {
+               const int *ev = hex_t::Edges[hi-8];
+               const int other = (v[ev[0]] == v[lo]) ? v[ev[1]] : v[ev[0]];
+               id = 2*e[hi-8] + (v[lo] < other ? 0 : 1);
+            }
+            else if (lo < 20) // inside parent face (hi-20)
+            {
+               const int *ev = hex_t::Edges[lo-8];
+               const int pf = f[hi-20];
+               id = ofedge + 4*pf +
+                    FindQuadEdge(faces[pf]->GetVertices(), v[ev[0]], v[ev[1]]);
+            }
+            else // inside the element
+            {
+               id = oeedge + 6*i + (lo-20);
+            }
+            el_edge[12*j + ce] = id;
+         }
+
+         for (int cf = 0; cf < 6; cf++)
+         {
+            const int *fv = hex_t::FaceVert[cf];
+            int lo = cv[fv[0]], hi = lo;
+            for (int k = 1; k < 4; k++)
+            {
+               lo = std::min(lo, cv[fv[k]]);
+               hi = std::max(hi, cv[fv[k]]);
+            }
+            int id;
+            if (lo < 8) // sub-face of parent face (hi-20)
+            {
+               const int pf = f[hi-20];
+               id = 4*pf + FindQuadVertex(faces[pf]->GetVertices(), v[lo]);
+            }
+            else // inside the element, through parent edge (lo-8)
+            {
+               id = oeface + 12*i + (lo-8);
+            }
+            el_face[6*j + cf] = id;
+         }
+      }
+      FreeElement(elements[i]);
+   }
+
+   // Refine the boundary elements
+   Array<Element*> new_boundary(4*NBE);
+   Array<int> new_be_to_face(4*NBE);
+   int *bel_edge = new int[4*NBE*4];
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NBE; i++)
+   {
+      const int attr = boundary[i]->GetAttribute();
+      const int *v = boundary[i]->GetVertices();
+      const int *e = bel_to_edge->GetRow(i);
+      const int pf = be_to_face[i];
+      const int *pfv = faces[pf]->GetVertices();
+
+      int rv[9];
+      for (int k = 0; k < 4; k++) { rv[k] = v[k]; }
+      for (int k = 0; k < 4; k++) { rv[4+k] = oedge + e[k]; }
+      rv[8] = oface + pf;
+
+      for (int c = 0; c < 4; c++)
+      {
+         const int *cv = quad_child_v[c];
+         const int j = 4*i + c;
+
+         new_boundary[j] =
+            new Quadrilateral(rv[cv[0]], rv[cv[1]], rv[cv[2]], rv[cv[3]], attr);
+         new_be_to_face[j] = 4*pf + FindQuadVertex(pfv, v[c]);
+
+         for (int ce = 0; ce < 4; ce++)
+         {
+            const int a = cv[quad_t::Edges[ce][0]];
+            const int b = cv[quad_t::Edges[ce][1]];
+            const int lo = std::min(a, b), hi = std::max(a, b);
+            const int *ev = quad_t::Edges[(lo < 4) ? hi-4 : lo-4];
+            int id;
+            if (lo < 4) // half of parent edge (hi-4)
+            {
+               const int other = (v[ev[0]] == v[lo]) ? v[ev[1]] : v[ev[0]];
+               id = 2*e[hi-4] + (v[lo] < other ? 0 : 1);
+            }
+            else // inside the parent face
+            {
+               id = ofedge + 4*pf + FindQuadEdge(pfv, v[ev[0]], v[ev[1]]);
+            }
+            bel_edge[4*j + ce] = id;
+         }
+      }
+      FreeElement(boundary[i]);
+   }
+
+   // Renumber the edges and the faces in the order of their first appearance
+   // in the element loop, as done by GetElementToEdgeTable() (DSTable) and
+   // GetElementToFaceTable() (STable3D).
+   Array<int> new_id(new_NEdges);
+   new_id = -1;
+   int cnt = 0;
+   for (int k = 0; k < 8*NE*12; k++)
+   {
+      int &id = new_id[el_edge[k]];
+      if (id < 0) { id = cnt++; }
+      el_edge[k] = id;
+   }
+   MFEM_VERIFY(cnt == new_NEdges, "invalid mesh topology");
+   for (int k = 0; k < 4*NBE*4; k++) { bel_edge[k] = new_id[bel_edge[k]]; }
+
+   new_id.SetSize(new_NFaces);
+   new_id = -1;
+   cnt = 0;
+   for (int k = 0; k < 8*NE*6; k++)
+   {
+      int &id = new_id[el_face[k]];
+      if (id < 0) { id = cnt++; }
+      el_face[k] = id;
+   }
+   MFEM_VERIFY(cnt == new_NFaces, "invalid mesh topology");
+   for (int k = 0; k < new_be_to_face.Size(); k++)
+   {
+      new_be_to_face[k] = new_id[new_be_to_face[k]];
+   }
+
+   mfem::Swap(elements, new_elements);
+   mfem::Swap(boundary, new_boundary);
+   mfem::Swap(be_to_face, new_be_to_face);
+
+   NumOfVertices    = vertices.Size();
+   NumOfElements    = 8 * NE;
+   NumOfBdrElements = 4 * NBE;
+   NumOfEdges       = new_NEdges;
+   NumOfFaces       = new_NFaces;
+
+   SetFixedRowTable(*el_to_edge, NumOfElements, 12, el_edge);
+   SetFixedRowTable(*el_to_face, NumOfElements, 6, el_face);
+   SetFixedRowTable(*bel_to_edge, NumOfBdrElements, 4, bel_edge);
+
+   CoarseFineTr.point_matrices[Geometry::CUBE]
+   .UseExternalData(HexChildrenPointMatrices(), 3, 8, 8);
+
+   GenerateFaces();
+
+#ifdef MFEM_DEBUG
+   CheckBdrElementOrientation(false);
+#endif
+
+   last_operation = Mesh::REFINE;
+   sequence++;
+
+   if (update_nodes) { UpdateNodes(); }
+}
+
 void Mesh::LocalRefinement(const Array<int> &marked_el, int type)
 {
    int i, j, ind, nedges;
@@ -9294,6 +9714,29 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
    mfem::Swap(bdr_attributes, other.bdr_attributes);
 
    mfem::Swap(geom_factors, other.geom_factors);
+   mfem::Swap(face_geom_factors, other.face_geom_factors);
+   mfem::Swap(affine_factors, other.affine_factors);
+   mfem::Swap(nodes_sequence, other.nodes_sequence);
+   for (int i = 0; i < geom_factors.Size(); i++)
+   {
+      geom_factors[i]->mesh = this;
+   }
+   for (int i = 0; i < face_geom_factors.Size(); i++)
+   {
+      face_geom_factors[i]->mesh = this;
+   }
+   for (int i = 0; i < other.geom_factors.Size(); i++)
+   {
+      other.geom_factors[i]->mesh = &other;
+   }
+   for (int i = 0; i < other.face_geom_factors.Size(); i++)
+   {
+      other.face_geom_factors[i]->mesh = &other;
+   }
+   // the element search indices refer to their meshes, rebuild them on demand
+   delete point_locator;
+   delete other.point_locator;
+   point_locator = other.point_locator = NULL;
 
 #ifdef MFEM_USE_MEMALLOC
    TetMemory.Swap(other.TetMemory);
@@ -9353,6 +9796,7 @@ static Array<int>& AllElements(Array<int> &list, int nelem)
 
 void Mesh::UniformRefinement(int ref_algo)
 {
+   MemoryUsageTag mem_tag("Mesh");
    Array<int> list;
 
    if (NURBSext)
@@ -9383,6 +9827,8 @@ void Mesh::UniformRefinement(int ref_algo)
 void Mesh::GeneralRefinement(const Array<Refinement> &refinements,
                              int nonconforming, int nc_limit)
 {
+   MFEM_PERF_FUNCTION;
+   MemoryUsageTag mem_tag("Mesh");
    if (ncmesh)
    {
       nonconforming = 1;
@@ -11628,6 +12074,7 @@ void Mesh::Transform(void (*f)(const Vector&, Vector&))
       xnew.ProjectCoefficient(f_pert);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::Transform(VectorCoefficient &deformation)
@@ -11652,6 +12099,7 @@ void Mesh::Transform(VectorCoefficient &deformation)
       xnew.ProjectCoefficient(deformation);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::RemoveUnusedVertices()
@@ -11886,100 +12334,8 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
    elem_ids = -1;
    if (!GetNE()) { return 0; }
 
-   double *data = point_mat.GetData();
-   InverseElementTransformation *inv_tr = inv_trans;
-   inv_tr = inv_tr ? inv_tr : new InverseElementTransformation;
-
-   // For each point in 'point_mat', find the element whose center is closest.
-   Vector min_dist(npts);
-   Array<int> e_idx(npts);
-   min_dist = std::numeric_limits<double>::max();
-   e_idx = -1;
-
-   Vector pt(spaceDim);
-   for (int i = 0; i < GetNE(); i++)
-   {
-      GetElementTransformation(i)->Transform(
-         Geometries.GetCenter(GetElementBaseGeometry(i)), pt);
-      for (int k = 0; k < npts; k++)
-      {
-         double dist = pt.DistanceTo(data+k*spaceDim);
-         if (dist < min_dist(k))
-         {
-            min_dist(k) = dist;
-            e_idx[k] = i;
-         }
-      }
-   }
-
-   // Checks if the points lie in the closest element
-   int pts_found = 0;
-   pt.NewDataAndSize(NULL, spaceDim);
-   for (int k = 0; k < npts; k++)
-   {
-      pt.SetData(data+k*spaceDim);
-      inv_tr->SetTransformation(*GetElementTransformation(e_idx[k]));
-      int res = inv_tr->Transform(pt, ips[k]);
-      if (res == InverseElementTransformation::Inside)
-      {
-         elem_ids[k] = e_idx[k];
-         pts_found++;
-      }
-   }
-   if (pts_found != npts)
-   {
-      Array<int> elvertices;
-      Table *vtoel = GetVertexToElementTable();
-      for (int k = 0; k < npts; k++)
-      {
-         if (elem_ids[k] != -1) { continue; }
-         // Try all vertex-neighbors of element e_idx[k]
-         pt.SetData(data+k*spaceDim);
-         GetElementVertices(e_idx[k], elvertices);
-         for (int v = 0; v < elvertices.Size(); v++)
-         {
-            int vv = elvertices[v];
-            int ne = vtoel->RowSize(vv);
-            const int* els = vtoel->GetRow(vv);
-            for (int e = 0; e < ne; e++)
-            {
-               if (els[e] == e_idx[k]) { continue; }
-               inv_tr->SetTransformation(*GetElementTransformation(els[e]));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = els[e];
-                  pts_found++;
-                  goto next_point;
-               }
-            }
-         }
-         // Try neighbors for non-conforming meshes
-         if (ncmesh)
-         {
-            Array<int> neigh;
-            int le = ncmesh->leaf_elements[e_idx[k]];
-            ncmesh->FindNeighbors(le,neigh);
-            for (int e = 0; e < neigh.Size(); e++)
-            {
-               int nn = neigh[e];
-               if (ncmesh->IsGhost(ncmesh->elements[nn])) { continue; }
-               int el = ncmesh->elements[nn].index;
-               inv_tr->SetTransformation(*GetElementTransformation(el));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = el;
-                  pts_found++;
-                  goto next_point;
-               }
-            }
-         }
-      next_point: ;
-      }
-      delete vtoel;
-   }
-   if (inv_trans == NULL) { delete inv_tr; }
+   const int pts_found =
+      GetPointLocator().FindPoints(point_mat, elem_ids, ips, inv_trans);
 
    if (warn && pts_found != npts)
    {
@@ -11989,12 +12345,37 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
 }
 
 
+// Check if the points of 'ir' are a lexicographically ordered tensor product of
+// 1D points, as assumed by the tensor-product kernels of the
+// QuadratureInterpolator. This is not the case e.g. for the nodes of H1 finite
+// elements.
+static bool IsTensorProductRule(const IntegrationRule &ir, int dim)
+{
+   const int nq = ir.GetNPoints();
+   const int nq1 = (int) std::floor(std::pow(nq, 1.0/dim) + 0.5);
+   int n = 1;
+   for (int d = 0; d < dim; d++) { n *= nq1; }
+   if (n != nq) { return false; }
+   for (int i = 0; i < nq; i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      const int ix = i % nq1, iy = (i / nq1) % nq1, iz = i / (nq1*nq1);
+      if (ip.x != ir.IntPoint(ix).x) { return false; }
+      if (dim > 1 && ip.y != ir.IntPoint(nq1*iy).y) { return false; }
+      if (dim > 2 && ip.z != ir.IntPoint(nq1*nq1*iz).z) { return false; }
+   }
+   return true;
+}
+
 GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
                                    int flags, MemoryType d_mt)
 {
    this->mesh = mesh;
    IntRule = &ir;
    computed_factors = flags;
+   nodes_sequence = mesh->GetNodesSequence();
+   mesh_owned = false;
+   compressed = false;
 
    MFEM_ASSERT(mesh->GetNumGeometries(mesh->Dimension()) <= 1,
                "mixed meshes are not supported!");
@@ -12003,6 +12384,23 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    Compute(*mesh->GetNodes(), d_mt);
 }
 
+GeometricFactors::GeometricFactors(Mesh &mesh, const IntegrationRule &ir,
+                                   int flags, MemoryType d_mt)
+{
+   this->mesh = &mesh;
+   IntRule = &ir;
+   computed_factors = flags;
+   nodes_sequence = mesh.GetNodesSequence();
+   mesh_owned = true;
+   compressed = false;
+
+   MFEM_ASSERT(mesh.GetNumGeometries(mesh.Dimension()) <= 1,
+               "mixed meshes are not supported!");
+   MFEM_ASSERT(mesh.GetNodes(), "meshes without nodes are not supported!");
+
+   Compute(*mesh.GetNodes(), d_mt);
+}
+
 GeometricFactors::GeometricFactors(const GridFunction &nodes,
                                    const IntegrationRule &ir,
                                    int flags, MemoryType d_mt)
@@ -12010,6 +12408,9 @@ GeometricFactors::GeometricFactors(const GridFunction &nodes,
    this->mesh = nodes.FESpace()->GetMesh();
    IntRule = &ir;
    computed_factors = flags;
+   nodes_sequence = mesh->GetNodesSequence();
+   mesh_owned = false;
+   compressed = false;
 
    Compute(nodes, d_mt);
 }
@@ -12029,27 +12430,37 @@ void GeometricFactors::Compute(const GridFunction &nodes,
    unsigned eval_flags = 0;
    MemoryType my_d_mt = (d_mt != MemoryType::DEFAULT) ? d_mt :
                         Device::GetDeviceMemoryType();
+   if (compressed && mesh_owned)
+   {
+      // drop the references to the shared affine factors of the mesh
+      J.Destroy();
+      detJ.Destroy();
+   }
+   compressed = (computed_factors & GeometricFactors::COMPRESSED) &&
+                ComputeAffine(nodes, my_d_mt);
    if (computed_factors & GeometricFactors::COORDINATES)
    {
       X.SetSize(vdim*NQ*NE, my_d_mt); // NQ x SDIM x NE
       eval_flags |= QuadratureInterpolator::VALUES;
    }
-   if (computed_factors & GeometricFactors::JACOBIANS)
+   if ((computed_factors & GeometricFactors::JACOBIANS) && !compressed)
    {
       J.SetSize(dim*vdim*NQ*NE, my_d_mt); // NQ x SDIM x DIM x NE
       eval_flags |= QuadratureInterpolator::DERIVATIVES;
    }
-   if (computed_factors & GeometricFactors::DETERMINANTS)
+   if ((computed_factors & GeometricFactors::DETERMINANTS) && !compressed)
    {
       detJ.SetSize(NQ*NE, my_d_mt); // NQ x NE
       eval_flags |= QuadratureInterpolator::DETERMINANTS;
    }
+   if (!eval_flags) { return; }
 
    const QuadratureInterpolator *qi = fespace->GetQuadratureInterpolator(*IntRule);
    // All X, J, and detJ use this layout:
    qi->SetOutputLayout(QVectorLayout::byNODES);
 
-   const bool use_tensor_products = UsesTensorBasis(*fespace);
+   const bool use_tensor_products = UsesTensorBasis(*fespace) &&
+                                    IsTensorProductRule(*IntRule, dim);
 
    qi->DisableTensorProducts(!use_tensor_products);
    const ElementDofOrdering e_ordering = use_tensor_products ?
@@ -12069,6 +12480,147 @@ void GeometricFactors::Compute(const GridFunction &nodes,
    }
 }
 
+// Compute the Jacobians (SDIM x DIM x NE) and their determinants (NE) at the
+// first vertex of each element of the nodes of order 1. Return true if all
+// elements are affine, i.e. their Jacobians at the vertices agree.
+static bool ComputeAffineFactors(const GridFunction &nodes, MemoryType d_mt,
+                                 Vector &J, Vector &detJ)
+{
+   const FiniteElementSpace *fespace = nodes.FESpace();
+   const FiniteElement *fe = fespace->GetFE(0);
+   const int dim  = fe->GetDim();
+   const int vdim = fespace->GetVDim();
+   if (fe->GetOrder() != 1 || fespace->GetNURBSext() || dim == 1 ||
+       (vdim != dim && !(vdim == 3 && dim == 2)))
+   {
+      return false;
+   }
+
+   const int NE   = fespace->GetNE();
+   const IntegrationRule &vir = *Geometries.GetVertices(fe->GetGeomType());
+   const int NV   = vir.GetNPoints();
+   const int VD   = vdim*dim;
+
+   const Operator *elem_restr =
+      fespace->GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector Enodes(elem_restr->Height(), d_mt);
+   elem_restr->Mult(nodes, Enodes);
+
+   QuadratureInterpolator qi(*fespace, vir);
+   qi.SetOutputLayout(QVectorLayout::byNODES);
+   qi.DisableTensorProducts();
+   Vector Jv(NV*VD*NE, d_mt), empty;
+   qi.Mult(Enodes, QuadratureInterpolator::DERIVATIVES, empty, Jv, empty);
+
+   Vector affine(NE, d_mt);
+   J.SetSize(VD*NE, d_mt);
+   detJ.SetSize(NE, d_mt);
+   const auto JV = Reshape(Jv.Read(), NV, VD, NE);
+   auto JC = Reshape(J.Write(), VD, NE);
+   auto DJ = detJ.Write();
+   auto A = affine.Write();
+   MFEM_FORALL(e, NE,
+   {
+      double jmax = 0.0, diff = 0.0;
+      double Je[9];
+      for (int k = 0; k < VD; k++)
+      {
+         Je[k] = JV(0,k,e);
+         jmax = fmax(jmax, fabs(Je[k]));
+         for (int v = 1; v < NV; v++)
+         {
+            diff = fmax(diff, fabs(JV(v,k,e) - Je[k]));
+         }
+         JC(k,e) = Je[k];
+      }
+      A[e] = (diff > 1e-12*jmax) ? 0.0 : 1.0;
+      if (vdim == dim)
+      {
+         DJ[e] = (dim == 2) ? kernels::Det<2>(Je) : kernels::Det<3>(Je);
+      }
+      else
+      {
+         // surface in 3D: sqrt(det(J^t J))
+         double E = 0.0, F = 0.0, G = 0.0;
+         for (int i = 0; i < 3; i++)
+         {
+            E += Je[i]*Je[i];
+            F += Je[i]*Je[3+i];
+            G += Je[3+i]*Je[3+i];
+         }
+         DJ[e] = sqrt(E*G - F*F);
+      }
+   });
+   // a single reduction, done once per nodes sequence for the mesh nodes
+   return affine.Min() > 0.0;
+}
+
+bool GeometricFactors::ComputeAffine(const GridFunction &nodes,
+                                     MemoryType d_mt)
+{
+   if (!(computed_factors & (GeometricFactors::JACOBIANS |
+                             GeometricFactors::DETERMINANTS)))
+   {
+      return false;
+   }
+
+   Mesh::AffineFactors *af = mesh->affine_factors;
+   if (!mesh_owned || !af || &nodes != mesh->GetNodes() ||
+       (af->nodes_sequence >= 0 && af->mt != d_mt))
+   {
+      // factors not shared with the mesh: compute them for this object only
+      Vector Jc, detJc;
+      if (!ComputeAffineFactors(nodes, d_mt, Jc, detJc)) { return false; }
+      if (computed_factors & GeometricFactors::JACOBIANS) { J.Swap(Jc); }
+      if (computed_factors & GeometricFactors::DETERMINANTS)
+      {
+         detJ.Swap(detJc);
+      }
+      return true;
+   }
+
+   if (af->nodes_sequence != mesh->GetNodesSequence())
+   {
+      // the other compressed factors are out of date: drop their references
+      // to the shared factors before these are recomputed and maybe resized
+      for (int i = 0; i < mesh->geom_factors.Size(); i++)
+      {
+         GeometricFactors *gf = mesh->geom_factors[i];
+         if (gf != this && gf->compressed && gf->mesh_owned &&
+             gf->nodes_sequence != mesh->GetNodesSequence())
+         {
+            gf->J.Destroy();
+            gf->detJ.Destroy();
+            gf->compressed = false;
+         }
+      }
+      af->affine = ComputeAffineFactors(nodes, d_mt, af->J, af->detJ);
+      af->nodes_sequence = mesh->GetNodesSequence();
+      af->mt = d_mt;
+   }
+   if (!af->affine) { return false; }
+
+   if (computed_factors & GeometricFactors::JACOBIANS)
+   {
+      J.MakeRef(af->J, 0, af->J.Size());
+   }
+   if (computed_factors & GeometricFactors::DETERMINANTS)
+   {
+      detJ.MakeRef(af->detJ, 0, af->detJ.Size());
+   }
+   return true;
+}
+
+long GeometricFactors::MemoryUsage() const
+{
+   // the shared coordinates and compressed factors are not counted here
+   long mem = 0;
+   if (X.OwnsData()) { mem += X.Capacity(); }
+   if (J.OwnsData()) { mem += J.Capacity(); }
+   if (detJ.OwnsData()) { mem += detJ.Capacity(); }
+   return mem * sizeof(double);
+}
+
 FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
                                            const IntegrationRule &ir,
                                            int flags, FaceType type)
@@ -12077,9 +12629,16 @@ FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
    this->mesh = mesh;
    IntRule = &ir;
    computed_factors = flags;
+   nodes_sequence = mesh->GetNodesSequence();
 
-   const GridFunction *nodes = mesh->GetNodes();
-   const FiniteElementSpace *fespace = nodes->FESpace();
+   Compute(*mesh->GetNodes());
+}
+
+void FaceGeometricFactors::Compute(const GridFunction &nodes)
+{
+   const FiniteElementSpace *fespace = nodes.FESpace();
+   const IntegrationRule &ir = *IntRule;
+   const int flags = computed_factors;
    const int vdim = fespace->GetVDim();
    const int NF   = fespace->GetNFbyType(type);
    const int NQ   = ir.GetNPoints();
@@ -12089,7 +12648,7 @@ FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
                                           type,
                                           L2FaceValues::SingleValued );
    Vector Fnodes(face_restr->Height());
-   face_restr->Mult(*nodes, Fnodes);
+   face_restr->Mult(nodes, Fnodes);
 
    unsigned eval_flags = 0;
    if (flags & FaceGeometricFactors::COORDINATES)
@@ -12118,6 +12677,12 @@ FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
    qi->Mult(Fnodes, eval_flags, X, J, detJ, normal);
 }
 
+long FaceGeometricFactors::MemoryUsage() const
+{
+   return (X.Capacity() + J.Capacity() + detJ.Capacity() +
+           normal.Capacity()) * sizeof(double);
+}
+
 NodeExtrudeCoefficient::NodeExtrudeCoefficient(const int dim, const int n_,
                                                const double s_)
    : VectorCoefficient(dim), n(n_), s(s_), tip(p, dim-1)
@@ -35,6 +35,7 @@ namespace mfem
 
 class GeometricFactors;
 class FaceGeometricFactors;
+class PointLocator;
 class KnotVector;
 class NURBSExtension;
 class FiniteElementSpace;
@@ -57,6 +58,7 @@ class Mesh
 #endif
    friend class NCMesh;
    friend class NURBSExtension;
+   friend class GeometricFactors;
 
 #ifdef MFEM_USE_ADIOS2
    friend class adios2stream;
@@ -82,6 +84,10 @@ protected:
    // Mesh, such as FiniteElementSpace, GridFunction, etc.
    long sequence;
 
+   // Counter for modifications of the mesh nodes, see NodesUpdated(). Used to
+   // recompute the stored GeometricFactors and FaceGeometricFactors.
+   long nodes_sequence;
+
    Array<Element *> elements;
    // Vertices are only at the corners of elements, where you would expect them
    // in the lowest-order mesh. In some cases, e.g. in a Mesh that defines the
@@ -274,6 +280,18 @@ public:
    Array<GeometricFactors*> geom_factors; ///< Optional geometric factors.
    Array<FaceGeometricFactors*>
    face_geom_factors; ///< Optional face geometric factors.
+   PointLocator *point_locator; ///< Optional element search index.
+
+   /** @brief Per-element Jacobians and determinants of the mesh nodes, shared
+       by the compressed GeometricFactors of all integration rules. */
+   struct AffineFactors
+   {
+      long nodes_sequence; ///< Value of nodes_sequence when computed.
+      MemoryType mt;       ///< Memory type of @a J and @a detJ.
+      bool affine;         ///< True if all elements are affine.
+      Vector J, detJ;      ///< Layouts (SDIM x DIM x NE) and (NE).
+   };
+   AffineFactors *affine_factors; ///< Optional, see GetGeometricFactors().
 
    // Global parameter that can be used to control the removal of unused
    // vertices performed when reading a mesh in MFEM format. The default value
@@ -398,6 +416,15 @@ protected:
                                  DSTable *v_to_v_p = NULL,
                                  bool update_nodes = true);
 
+   /** Refine an all-hex 3D mesh uniformly. The refined topology (edges, faces
+       and the element/boundary-to-edge/face tables) is generated directly from
+       the parent connectivity using flat, pre-sized arrays without the
+       DSTable/STable3D structures; the numbering of edges and faces is the
+       same as the one produced by GetElementToEdgeTable() and
+       GetElementToFaceTable(). With OpenMP, the loops over the entities are
+       threaded. Called from UniformRefinement3D_base(). */
+   void UniformRefinementHex3D(bool update_nodes = true);
+
    /// Refine a mixed 3D mesh uniformly.
    virtual void UniformRefinement3D() { UniformRefinement3D_base(); }
 
@@ -970,7 +997,16 @@ public:
        either calling Mesh::DeleteGeometricFactors or the Mesh destructor). If
        the device MemoryType parameter @a d_mt is specified, then the returned
        object will use that type unless it was previously allocated with a
-       different type. */
+       different type.
+
+       If @a flags includes GeometricFactors::COMPRESSED and all elements of
+       the mesh are affine, the returned object stores only one Jacobian and
+       determinant per element, see GeometricFactors::compressed. Objects with
+       compressed storage are never returned for requests without the
+       COMPRESSED flag.
+
+       If the mesh nodes were modified since the returned object was computed
+       (see NodesUpdated()), the object is recomputed in place. */
    const GeometricFactors* GetGeometricFactors(
       const IntegrationRule& ir,
       const int flags,
@@ -982,16 +1018,44 @@ public:
        The IntegrationRule used with GetFaceGeometricFactors needs to remain
        valid until the internally stored FaceGeometricFactors objects are
        destroyed (by either calling Mesh::DeleteGeometricFactors or the Mesh
-       destructor). */
+       destructor). If the mesh nodes were modified since the returned object
+       was computed (see NodesUpdated()), the object is recomputed in place. */
    const FaceGeometricFactors* GetFaceGeometricFactors(const IntegrationRule& ir,
                                                        const int flags,
                                                        FaceType type);
 
    /// Destroy all GeometricFactors stored by the Mesh.
-   /** This method can be used to force recomputation of the GeometricFactors,
-       for example, after the mesh nodes are modified externally. */
+   /** This method can be used to release the memory used by the
+       GeometricFactors. To recompute them after the mesh nodes are modified,
+       use NodesUpdated() instead. */
    void DeleteGeometricFactors();
 
+   /** @brief Notify the Mesh that its nodes (or vertices) have been modified.
+
+       The stored GeometricFactors and FaceGeometricFactors are marked as out
+       of date and are recomputed (in place) the next time they are requested
+       through GetGeometricFactors() or GetFaceGeometricFactors(). This method
+       is called by the Mesh methods that modify the nodes, e.g., MoveNodes(),
+       SetNodes() and Transform(). It needs to be called explicitly when the
+       node GridFunction returned by GetNodes() is modified directly. */
+   void NodesUpdated() { nodes_sequence++; }
+
+   /// Return the number of node modifications, see NodesUpdated().
+   long GetNodesSequence() const { return nodes_sequence; }
+
+   /** @brief Return the spatial index of the elements used by FindPoints().
+
+       The PointLocator is built on first use and rebuilt when the mesh or its
+       nodes are modified, as detected by GetSequence(), GetNodesSequence()
+       and a checksum of the node coordinates, so that the node GridFunction
+       returned by GetNodes() can also be modified directly, see
+       PointLocator::IsUpToDate(). It is destroyed with the GeometricFactors,
+       see DeleteGeometricFactors(). */
+   const PointLocator &GetPointLocator();
+
+   /// Return the memory (in bytes) used by the stored geometric factors.
+   long GeometricFactorsMemoryUsage() const;
+
    /// Equals 1 + num_holes - num_loops
    inline int EulerNumber() const
    { return NumOfVertices - NumOfEdges + NumOfFaces - NumOfElements; }
@@ -1769,6 +1833,12 @@ public:
        The DenseMatrix @a point_mat describes the given points - one point for
        each column; it should have SpaceDimension() rows.
 
+       The candidate elements for each point are obtained from the spatial
+       index returned by GetPointLocator(), so that only the elements whose
+       bounding boxes contain the point are inverted. The index is reused by
+       the following calls, and rebuilt when the mesh or its nodes are
+       modified.
+
        The InverseElementTransformation object, @a inv_trans, is used to attempt
        the element transformation inversion. If NULL pointer is given, the
        method will use a default constructed InverseElementTransformation. Note
@@ -1818,9 +1888,26 @@ class GeometricFactors
 {
 
 private:
+   friend class Mesh;
+
+   /// Value of Mesh::GetNodesSequence() when the factors were computed.
+   long nodes_sequence;
+
+   /** True if the factors are owned by the Mesh and the compressed J and detJ
+       can alias the Mesh::AffineFactors shared by all integration rules. */
+   bool mesh_owned;
+
+   /// Used by Mesh::GetGeometricFactors().
+   GeometricFactors(Mesh &mesh, const IntegrationRule &ir, int flags,
+                    MemoryType d_mt);
+
    void Compute(const GridFunction &nodes,
                 MemoryType d_mt = MemoryType::DEFAULT);
 
+   /** Compute the compressed Jacobians and determinants if all elements are
+       affine, otherwise return false. */
+   bool ComputeAffine(const GridFunction &nodes, MemoryType d_mt);
+
 public:
    const Mesh *mesh;
    const IntegrationRule *IntRule;
@@ -1831,8 +1918,22 @@ public:
       COORDINATES  = 1 << 0,
       JACOBIANS    = 1 << 1,
       DETERMINANTS = 1 << 2,
+      /** Not a factor: allow storing J and detJ once per element if all
+          elements are affine, see @ref compressed. */
+      COMPRESSED   = 1 << 3,
    };
 
+   /** @brief True if J and detJ are stored once per element (i.e., with NQ =
+       1 in the layouts described below).
+
+       This is only possible if COMPRESSED was requested and all elements are
+       affine, i.e., their Jacobians are constant. This is detected for meshes
+       whose nodes are in a space of order 1. The coordinates X are always
+       stored at all quadrature points. The compressed factors returned by
+       Mesh::GetGeometricFactors() share J and detJ for all integration
+       rules. */
+   bool compressed;
+
    GeometricFactors(const Mesh *mesh, const IntegrationRule &ir, int flags,
                     MemoryType d_mt = MemoryType::DEFAULT);
 
@@ -1862,6 +1963,9 @@ public:
        - NQ = number of quadrature points per element, and
        - NE = number of elements in the mesh. */
    Vector detJ;
+
+   /// Return the memory (in bytes) used by the stored factors.
+   long MemoryUsage() const;
 };
 
 /** @brief Structure for storing face geometric factors: coordinates, Jacobians,
@@ -1870,6 +1974,14 @@ public:
     Mesh. See Mesh::GetFaceGeometricFactors(). */
 class FaceGeometricFactors
 {
+private:
+   friend class Mesh;
+
+   /// Value of Mesh::GetNodesSequence() when the factors were computed.
+   long nodes_sequence;
+
+   void Compute(const GridFunction &nodes);
+
 public:
    const Mesh *mesh;
    const IntegrationRule *IntRule;
@@ -1916,6 +2028,9 @@ public:
        - SDIM = space dimension of the mesh = mesh.SpaceDimension(), and
        - NF = number of faces in the mesh. */
    Vector normal;
+
+   /// Return the memory (in bytes) used by the stored factors.
+   long MemoryUsage() const;
 };
 
 /// Class used to extrude the nodes of a mesh
@@ -230,6 +230,8 @@ void NCMesh::InitGeomFlags()
 
 void NCMesh::Update()
 {
+   StageTimer timer(timings.update);
+
    UpdateLeafElements();
    UpdateVertices();
 
@@ -1523,6 +1525,9 @@ void NCMesh::RefineElement(int elem, char ref_type)
 
 void NCMesh::Refine(const Array<Refinement>& refinements)
 {
+   StopWatch sw;
+   sw.Start();
+
    // push all refinements on the stack in reverse order
    ref_stack.Reserve(refinements.Size());
    for (int i = refinements.Size()-1; i >= 0; i--)
@@ -1561,6 +1566,8 @@ void NCMesh::Refine(const Array<Refinement>& refinements)
    ref_stack.DeleteAll();
    shadow.DeleteAll();
 
+   timings.refine += sw.RealTime();
+
    Update();
 }
 
@@ -1851,6 +1858,9 @@ void NCMesh::Derefine(const Array<int> &derefs)
    MFEM_VERIFY(Dim < 3 || Iso,
                "derefinement of 3D anisotropic meshes not implemented yet.");
 
+   StopWatch sw;
+   sw.Start();
+
    InitDerefTransforms();
 
    Array<int> fine_coarse;
@@ -1872,6 +1882,8 @@ void NCMesh::Derefine(const Array<int> &derefs)
       DerefineElement(parent);
    }
 
+   timings.derefine += sw.RealTime();
+
    // update leaf_elements, Element::index etc.
    Update();
 
@@ -2300,6 +2312,8 @@ const double* NCMesh::CalcVertexPos(int node) const
 
 void NCMesh::GetMeshComponents(Mesh &mesh) const
 {
+   StageTimer timer(timings.mesh_components);
+
    mesh.vertices.SetSize(vertex_nodeId.Size());
    if (coordinates.Size())
    {
@@ -2395,6 +2409,8 @@ void NCMesh::GetMeshComponents(Mesh &mesh) const
 
 void NCMesh::OnMeshUpdated(Mesh *mesh)
 {
+   StageTimer timer(timings.mesh_updated);
+
    //// PART 1: pull indices of regular edges/faces from the Mesh
 
    NEdges = mesh->GetNEdges();
@@ -2977,8 +2993,27 @@ void NCMesh::BuildFaceList()
 
    MatrixMap matrix_maps[Geometry::NumGeom];
 
+   // look up the faces of all leaf elements first: the hash table is only
+   // read here, so the lookups can be done in parallel
+   const int nleaves = leaf_elements.Size();
+   Array<int> leaf_faces(6*nleaves);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < nleaves; i++)
+   {
+      const Element &el = elements[leaf_elements[i]];
+      const GeomInfo& gi = GI[el.Geom()];
+      for (int j = 0; j < gi.nf; j++)
+      {
+         const int* fv = gi.faces[j];
+         leaf_faces[6*i + j] = faces.FindId(el.node[fv[0]], el.node[fv[1]],
+                                            el.node[fv[2]], el.node[fv[3]]);
+      }
+   }
+
    // visit faces of leaf elements
-   for (int i = 0; i < leaf_elements.Size(); i++)
+   for (int i = 0; i < nleaves; i++)
    {
       int elem = leaf_elements[i];
       Element &el = elements[elem];
@@ -2994,7 +3029,7 @@ void NCMesh::BuildFaceList()
             node[k] = el.node[gi.faces[j][k]];
          }
 
-         int face = faces.FindId(node[0], node[1], node[2], node[3]);
+         int face = leaf_faces[6*i + j];
          MFEM_ASSERT(face >= 0, "face not found!");
 
          // tell ParNCMesh about the face
@@ -3097,8 +3132,29 @@ void NCMesh::BuildEdgeList()
 
    MatrixMap matrix_map;
 
+   // look up the edge nodes of all leaf elements first (in parallel, the
+   // hash table is only read here), and also find out which are slave edges
+   const int nleaves = leaf_elements.Size();
+   Array<int> leaf_edges(12*nleaves);
+   Array<bool> leaf_slave(12*nleaves);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < nleaves; i++)
+   {
+      const Element &el = elements[leaf_elements[i]];
+      const GeomInfo& gi = GI[el.Geom()];
+      for (int j = 0; j < gi.ne; j++)
+      {
+         const int* ev = gi.edges[j];
+         const int enode = nodes.FindId(el.node[ev[0]], el.node[ev[1]]);
+         leaf_edges[12*i + j] = enode;
+         leaf_slave[12*i + j] = (enode >= 0 && GetEdgeMaster(enode) >= 0);
+      }
+   }
+
    // visit edges of leaf elements
-   for (int i = 0; i < leaf_elements.Size(); i++)
+   for (int i = 0; i < nleaves; i++)
    {
       int elem = leaf_elements[i];
       Element &el = elements[elem];
@@ -3111,7 +3167,7 @@ void NCMesh::BuildEdgeList()
          const int* ev = gi.edges[j];
          int node[2] = { el.node[ev[0]], el.node[ev[1]] };
 
-         int enode = nodes.FindId(node[0], node[1]);
+         int enode = leaf_edges[12*i + j];
          MFEM_ASSERT(enode >= 0, "edge node not found!");
 
          Node &nd = nodes[enode];
@@ -3133,7 +3189,7 @@ void NCMesh::BuildEdgeList()
          edge_local[nd.edge_index] = j;
 
          // skip slave edges here, they will be reached from their masters
-         if (GetEdgeMaster(enode) >= 0) { continue; }
+         if (leaf_slave[12*i + j]) { continue; }
 
          // have we already processed this edge? skip if yes
          if (processed_edges[enode]) { continue; }
@@ -6062,6 +6118,32 @@ int NCMesh::PrintMemoryDetail() const
    return elements.Size() - free_element_ids.Size();
 }
 
+void NCMesh::Timings::Reset()
+{
+   refine = derefine = update = 0.0;
+   mesh_components = mesh_updated = 0.0;
+   face_list = edge_list = vertex_list = 0.0;
+}
+
+void NCMesh::PrintTimings(std::ostream &os) const
+{
+   const Timings &t = timings;
+   const double total = t.refine + t.derefine + t.update + t.mesh_components
+                        + t.mesh_updated + t.face_list + t.edge_list
+                        + t.vertex_list;
+
+   os << "NCMesh update times [s]:\n"
+      << "   Refine           " << t.refine << "\n"
+      << "   Derefine         " << t.derefine << "\n"
+      << "   Update           " << t.update << "\n"
+      << "   Mesh components  " << t.mesh_components << "\n"
+      << "   Mesh numbering   " << t.mesh_updated << "\n"
+      << "   Face list        " << t.face_list << "\n"
+      << "   Edge list        " << t.edge_list << "\n"
+      << "   Vertex list      " << t.vertex_list << "\n"
+      << "   Total            " << total << std::endl;
+}
+
 #ifdef MFEM_DEBUG
 void NCMesh::DebugLeafOrder(std::ostream &os) const
 {
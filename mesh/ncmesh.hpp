@@ -16,6 +16,7 @@
 #include "../general/hash.hpp"
 #include "../general/globals.hpp"
 #include "../general/sort_pairs.hpp"
+#include "../general/tic_toc.hpp"
 #include "../linalg/densemat.hpp"
 #include "element.hpp"
 #include "vertex.hpp"
@@ -252,14 +253,22 @@ public:
    /// Return the current list of conforming and nonconforming faces.
    const NCList& GetFaceList()
    {
-      if (face_list.Empty()) { BuildFaceList(); }
+      if (face_list.Empty())
+      {
+         StageTimer timer(timings.face_list);
+         BuildFaceList();
+      }
       return face_list;
    }
 
    /// Return the current list of conforming and nonconforming edges.
    const NCList& GetEdgeList()
    {
-      if (edge_list.Empty()) { BuildEdgeList(); }
+      if (edge_list.Empty())
+      {
+         StageTimer timer(timings.edge_list);
+         BuildEdgeList();
+      }
       return edge_list;
    }
 
@@ -267,7 +276,11 @@ public:
        for uniformity/completeness. Needed in ParNCMesh/ParFESpace. */
    const NCList& GetVertexList()
    {
-      if (vertex_list.Empty()) { BuildVertexList(); }
+      if (vertex_list.Empty())
+      {
+         StageTimer timer(timings.vertex_list);
+         BuildVertexList();
+      }
       return vertex_list;
    }
 
@@ -394,6 +407,35 @@ public:
 
    int PrintMemoryDetail() const;
 
+   /** Wall-clock times (in seconds) spent in the individual stages of the
+       NCMesh update, accumulated since the NCMesh was created or since the
+       last call to ResetTimings(). Note that in meshes with tetrahedra the
+       edge list is built as part of the face list, so 'face_list' includes
+       the corresponding 'edge_list' time. */
+   struct Timings
+   {
+      double refine;     ///< Refine(), including forced refinements
+      double derefine;   ///< Derefine()
+      double update;     ///< Update(): leaf elements and vertex numbering
+      double mesh_components; ///< creating the Mesh elements and vertices
+      double mesh_updated;    ///< numbering of edges and faces (from Mesh)
+      double face_list;  ///< building the conforming/master/slave face list
+      double edge_list;  ///< building the conforming/master/slave edge list
+      double vertex_list; ///< building the vertex list
+
+      Timings() { Reset(); }
+      void Reset();
+   };
+
+   /// Return the accumulated times of the NCMesh update stages.
+   const Timings &GetTimings() const { return timings; }
+
+   /// Reset the accumulated times of the NCMesh update stages to zero.
+   void ResetTimings() { timings.Reset(); }
+
+   /// Print the accumulated times of the NCMesh update stages.
+   void PrintTimings(std::ostream &os = mfem::out) const;
+
    typedef std::int64_t RefCoord;
 
 
@@ -541,6 +583,19 @@ protected: // implementation
 
    Table element_vertex; ///< leaf-element to vertex table, see FindSetNeighbors
 
+   /// times of the update stages, see GetTimings()
+   mutable Timings timings;
+
+   /// Add the wall-clock time of the current scope to 'time'.
+   class StageTimer
+   {
+      StopWatch sw;
+      double &time;
+   public:
+      StageTimer(double &time) : time(time) { sw.Start(); }
+      ~StageTimer() { time += sw.RealTime(); }
+   };
+
 
    /// Update the leaf elements indices in leaf_elements
    void UpdateLeafElements();
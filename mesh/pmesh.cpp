@@ -19,6 +19,7 @@
 #include "../general/sort_pairs.hpp"
 #include "../general/text.hpp"
 #include "../general/globals.hpp"
+#include "../general/annotation.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -111,6 +112,8 @@ ParMesh::ParMesh(MPI_Comm comm, Mesh &mesh, int *partitioning_,
    , glob_offset_sequence(-1)
    , gtopo(comm)
 {
+   MFEM_PERF_FUNCTION;
+   MemoryUsageTag mem_tag("Mesh");
    int *partitioning = NULL;
    Array<bool> activeBdrElem;
 
@@ -926,6 +929,8 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
    , glob_offset_sequence(-1)
    , gtopo(comm)
 {
+   MFEM_PERF_FUNCTION;
+   MemoryUsageTag mem_tag("Mesh");
    MyComm = comm;
    MPI_Comm_size(MyComm, &NRanks);
    MPI_Comm_rank(MyComm, &MyRank);
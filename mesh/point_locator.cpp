@@ -0,0 +1,369 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "point_locator.hpp"
+#include "mesh_headers.hpp"
+#include "../fem/fem.hpp"
+#include "../linalg/dtensor.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace mfem
+{
+
+PointLocator::PointLocator(Mesh &mesh_, double bb_tol)
+   : mesh(&mesh_), sequence(-1), nodes_sequence(-1), nodes_data(NULL),
+     nodes_size(0), nodes_checksum(0.0), bb_tol(bb_tol)
+{
+   Update();
+}
+
+void PointLocator::Update()
+{
+   sdim = mesh->SpaceDimension();
+   MFEM_VERIFY(sdim >= 1 && sdim <= 3, "invalid space dimension");
+   ComputeElementBoxes();
+   BuildGrid();
+   sequence = mesh->GetSequence();
+   nodes_sequence = mesh->GetNodesSequence();
+   const GridFunction *nodes = mesh->GetNodes();
+   nodes_data = nodes ? nodes->GetData() : NULL;
+   nodes_size = nodes ? nodes->Size() : mesh->GetNV();
+   nodes_checksum = ComputeNodesChecksum();
+}
+
+bool PointLocator::IsUpToDate() const
+{
+   if (sequence != mesh->GetSequence() ||
+       nodes_sequence != mesh->GetNodesSequence() ||
+       elem_bbox.Size() != 2*sdim*mesh->GetNE())
+   {
+      return false;
+   }
+   const GridFunction *nodes = mesh->GetNodes();
+   if ((nodes ? nodes->GetData() : NULL) != nodes_data ||
+       (nodes ? nodes->Size() : mesh->GetNV()) != nodes_size)
+   {
+      return false;
+   }
+   return ComputeNodesChecksum() == nodes_checksum;
+}
+
+double PointLocator::ComputeNodesChecksum() const
+{
+   // Weight the coordinates by their position, so that permuted or swapped
+   // values also change the checksum.
+   double sum = 0.0;
+   const GridFunction *nodes = mesh->GetNodes();
+   if (nodes)
+   {
+      const double *x = nodes->HostRead();
+      for (int i = 0; i < nodes->Size(); i++)
+      {
+         sum += (1.0 + (i % 1021)) * x[i];
+      }
+      return sum;
+   }
+   const int dim = mesh->SpaceDimension();
+   for (int i = 0; i < mesh->GetNV(); i++)
+   {
+      const double *v = mesh->GetVertex(i);
+      for (int d = 0; d < dim; d++)
+      {
+         sum += (1.0 + ((dim*i + d) % 1021)) * v[d];
+      }
+   }
+   return sum;
+}
+
+void PointLocator::ComputeElementBoxes()
+{
+   const int NE = mesh->GetNE();
+   elem_bbox.SetSize(2*sdim*NE);
+   IsoparametricTransformation T;
+   DenseMatrix pts;
+   for (int e = 0; e < NE; e++)
+   {
+      mesh->GetElementTransformation(e, &T);
+      const Geometry::Type geom = mesh->GetElementBaseGeometry(e);
+      // Multilinear elements are contained in the bounding box of their
+      // vertices, curved elements are sampled and their box is enlarged.
+      const bool curved = T.Order() > 1;
+      const int times = curved ? 2*T.Order() : 1;
+      RefinedGeometry *RefG = GlobGeometryRefiner.Refine(geom, times);
+      T.Transform(RefG->RefPts, pts);
+
+      double *box = elem_bbox.GetData() + 2*sdim*e;
+      double size = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         double lo = pts(d,0), hi = pts(d,0);
+         for (int j = 1; j < pts.Width(); j++)
+         {
+            lo = std::min(lo, pts(d,j));
+            hi = std::max(hi, pts(d,j));
+         }
+         box[d] = lo;
+         box[sdim + d] = hi;
+         size = std::max(size, hi - lo);
+      }
+      const double pad = (curved ? bb_tol : 1e-10) * size;
+      for (int d = 0; d < sdim; d++)
+      {
+         box[d] -= pad;
+         box[sdim + d] += pad;
+      }
+   }
+}
+
+void PointLocator::BuildGrid()
+{
+   const int NE = mesh->GetNE();
+   const auto box = Reshape(elem_bbox.HostRead(), sdim, 2, NE);
+
+   for (int d = 0; d < sdim; d++)
+   {
+      grid_min[d] = std::numeric_limits<double>::max();
+      grid_max[d] = -std::numeric_limits<double>::max();
+      for (int e = 0; e < NE; e++)
+      {
+         grid_min[d] = std::min(grid_min[d], box(d,0,e));
+         grid_max[d] = std::max(grid_max[d], box(d,1,e));
+      }
+   }
+
+   // About one cell per element, with cells as cubical as possible. The
+   // directions thinner than a cell, e.g. the normal of a surface mesh in 3D,
+   // get a single cell and are not included in the cell size.
+   bool flat[3] = { true, true, true };
+   int ndims = 0;
+   for (int d = 0; d < sdim; d++)
+   {
+      flat[d] = !(grid_max[d] - grid_min[d] > 0.0);
+      if (!flat[d]) { ndims++; }
+   }
+   double h = 0.0;
+   for (bool changed = true; changed && ndims > 0; )
+   {
+      double vol = 1.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         if (!flat[d]) { vol *= grid_max[d] - grid_min[d]; }
+      }
+      h = std::pow(vol / std::max(NE, 1), 1.0/ndims);
+      changed = false;
+      for (int d = 0; d < sdim; d++)
+      {
+         if (!flat[d] && grid_max[d] - grid_min[d] < h)
+         {
+            flat[d] = true;
+            ndims--;
+            changed = true;
+         }
+      }
+   }
+   long long total = 1;
+   for (int d = 0; d < 3; d++)
+   {
+      ncells[d] = 1;
+      if (d >= sdim || NE == 0 || flat[d]) { continue; }
+      const double n = std::ceil((grid_max[d] - grid_min[d]) / h);
+      ncells[d] = (int) std::max(1.0, std::min((double) NE, n));
+      total *= ncells[d];
+   }
+   // Cap the total number of cells at about the number of elements
+   if (total > std::max(NE, 1))
+   {
+      const double scale = std::pow(std::max(NE, 1) / (double) total,
+                                    1.0/std::max(ndims, 1));
+      for (int d = 0; d < 3; d++)
+      {
+         ncells[d] = std::max(1, (int) std::floor(ncells[d]*scale));
+      }
+   }
+   for (int d = 0; d < 3; d++)
+   {
+      const double ext = grid_max[d] - grid_min[d];
+      grid_inv_h[d] = (d < sdim && ext > 0.0) ? ncells[d] / ext : 0.0;
+   }
+   const int nc = ncells[0]*ncells[1]*ncells[2];
+
+   // Bin the elements in the cells overlapped by their bounding boxes
+   int lo[3], hi[3];
+   auto cell_range = [&](int e)
+   {
+      for (int d = 0; d < 3; d++)
+      {
+         lo[d] = hi[d] = 0;
+         if (d >= sdim) { continue; }
+         lo[d] = (int) std::floor((box(d,0,e) - grid_min[d]) * grid_inv_h[d]);
+         hi[d] = (int) std::floor((box(d,1,e) - grid_min[d]) * grid_inv_h[d]);
+         lo[d] = std::max(0, std::min(lo[d], ncells[d]-1));
+         hi[d] = std::max(0, std::min(hi[d], ncells[d]-1));
+      }
+   };
+   cell_offsets.SetSize(nc + 1);
+   cell_offsets = 0;
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int e = 0; e < NE; e++)
+      {
+         cell_range(e);
+         for (int k = lo[2]; k <= hi[2]; k++)
+         {
+            for (int j = lo[1]; j <= hi[1]; j++)
+            {
+               for (int i = lo[0]; i <= hi[0]; i++)
+               {
+                  const int c = i + ncells[0]*(j + ncells[1]*k);
+                  if (pass == 0) { cell_offsets[c+1]++; }
+                  else { cell_elements[cell_offsets[c]++] = e; }
+               }
+            }
+         }
+      }
+      if (pass == 0)
+      {
+         cell_offsets.PartialSum();
+         cell_elements.SetSize(cell_offsets[nc]);
+      }
+      else
+      {
+         // restore the offsets shifted by the insertion
+         for (int c = nc; c > 0; c--) { cell_offsets[c] = cell_offsets[c-1]; }
+         cell_offsets[0] = 0;
+      }
+   }
+}
+
+int PointLocator::GetCell(const double *x) const
+{
+   int c = 0, stride = 1;
+   for (int d = 0; d < sdim; d++)
+   {
+      const double r = (x[d] - grid_min[d]) * grid_inv_h[d];
+      int i = (int) std::floor(r);
+      // points on the upper boundary of the grid belong to the last cell
+      if (i == ncells[d] && r <= ncells[d]) { i = ncells[d]-1; }
+      if (i < 0 || i >= ncells[d]) { return -1; }
+      c += stride*i;
+      stride *= ncells[d];
+   }
+   return c;
+}
+
+bool PointLocator::InsideBox(int e, const double *x) const
+{
+   const double *box = elem_bbox.GetData() + 2*sdim*e;
+   for (int d = 0; d < sdim; d++)
+   {
+      if (x[d] < box[d] || x[d] > box[sdim + d]) { return false; }
+   }
+   return true;
+}
+
+int PointLocator::LocatePoint(const double *x, IsoparametricTransformation &T,
+                              InverseElementTransformation &inv_tr,
+                              IntegrationPoint &ip) const
+{
+   const int c = GetCell(x);
+   if (c < 0) { return -1; }
+   Vector pt(const_cast<double*>(x), sdim);
+   for (int j = cell_offsets[c]; j < cell_offsets[c+1]; j++)
+   {
+      const int e = cell_elements[j];
+      if (!InsideBox(e, x)) { continue; }
+      mesh->GetElementTransformation(e, &T);
+      inv_tr.SetTransformation(T);
+      if (inv_tr.Transform(pt, ip) == InverseElementTransformation::Inside)
+      {
+         return e;
+      }
+   }
+   return -1;
+}
+
+void PointLocator::GetCandidates(const Vector &x, Array<int> &elems) const
+{
+   MFEM_VERIFY(x.Size() == sdim, "invalid point dimension");
+   elems.SetSize(0);
+   const int c = GetCell(x.GetData());
+   if (c < 0) { return; }
+   for (int j = cell_offsets[c]; j < cell_offsets[c+1]; j++)
+   {
+      const int e = cell_elements[j];
+      if (InsideBox(e, x.GetData())) { elems.Append(e); }
+   }
+}
+
+int PointLocator::FindPoints(const DenseMatrix &point_mat,
+                             Array<int> &elem_ids,
+                             Array<IntegrationPoint> &ips,
+                             InverseElementTransformation *inv_trans) const
+{
+   MFEM_VERIFY(IsUpToDate(), "the mesh was modified, call Update()");
+   MFEM_VERIFY(point_mat.Height() == sdim, "invalid points matrix");
+   const int npts = point_mat.Width();
+   elem_ids.SetSize(npts);
+   ips.SetSize(npts);
+   const double *data = point_mat.Data();
+
+   int pts_found = 0;
+   if (inv_trans)
+   {
+      IsoparametricTransformation T;
+      for (int k = 0; k < npts; k++)
+      {
+         elem_ids[k] = LocatePoint(data + k*sdim, T, *inv_trans, ips[k]);
+         if (elem_ids[k] >= 0) { pts_found++; }
+      }
+      return pts_found;
+   }
+
+   // The finite elements are only safe to use concurrently when MFEM is built
+   // with MFEM_THREAD_SAFE.
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+   #pragma omp parallel reduction(+:pts_found)
+#endif
+   {
+      IsoparametricTransformation T;
+      InverseElementTransformation inv_tr;
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+      #pragma omp for
+#endif
+      for (int k = 0; k < npts; k++)
+      {
+         elem_ids[k] = LocatePoint(data + k*sdim, T, inv_tr, ips[k]);
+         if (elem_ids[k] >= 0) { pts_found++; }
+      }
+   }
+   return pts_found;
+}
+
+void PointLocator::GetBoundingBox(Vector &min, Vector &max) const
+{
+   min.SetSize(sdim);
+   max.SetSize(sdim);
+   for (int d = 0; d < sdim; d++)
+   {
+      min(d) = grid_min[d];
+      max(d) = grid_max[d];
+   }
+}
+
+long PointLocator::MemoryUsage() const
+{
+   return elem_bbox.Capacity()*sizeof(double) + cell_offsets.MemoryUsage() +
+          cell_elements.MemoryUsage();
+}
+
+}
@@ -0,0 +1,136 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_POINT_LOCATOR
+#define MFEM_POINT_LOCATOR
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "../linalg/densemat.hpp"
+#include "../fem/intrules.hpp"
+
+namespace mfem
+{
+
+class Mesh;
+class IsoparametricTransformation;
+class InverseElementTransformation;
+
+/** @brief Spatial index of the elements of a Mesh, used to locate physical
+    points without searching the whole mesh.
+
+    The bounding boxes of the elements are binned in a uniform Cartesian grid
+    with about one cell per element. Locating a point then only requires
+    inverting the transformations of the few elements binned in the grid cell
+    that contains the point.
+
+    The bounding boxes of curved elements are computed from the images of a
+    uniform set of reference points and enlarged by the relative tolerance
+    given to the constructor.
+
+    The index is usually obtained with Mesh::GetPointLocator(), which rebuilds
+    it when the mesh or its nodes are modified, see IsUpToDate(). */
+class PointLocator
+{
+protected:
+   Mesh *mesh;
+
+   /// Values of Mesh::GetSequence() and Mesh::GetNodesSequence() when the
+   /// index was built.
+   long sequence, nodes_sequence;
+
+   /** @brief Data pointer, size and checksum of the mesh nodes (or vertices)
+       when the index was built, used to detect nodes modified in place
+       without a call to Mesh::NodesUpdated(). */
+   const double *nodes_data;
+   int nodes_size;
+   double nodes_checksum;
+
+   /// Relative enlargement of the bounding boxes of curved elements.
+   double bb_tol;
+
+   int sdim;
+   int ncells[3];
+   double grid_min[3], grid_max[3], grid_inv_h[3];
+
+   /// Bounding boxes of the elements, (sdim, 2, NE): min and max corners.
+   Vector elem_bbox;
+
+   /// Elements binned in each grid cell, in CSR format.
+   Array<int> cell_offsets, cell_elements;
+
+   /** @brief Return a position-dependent checksum of the coordinates of the
+       mesh nodes, or of the vertices if the mesh has no nodes. */
+   double ComputeNodesChecksum() const;
+
+   void ComputeElementBoxes();
+   void BuildGrid();
+
+   /// Return the index of the grid cell containing @a x, or -1 if outside.
+   int GetCell(const double *x) const;
+
+   /// Check if @a x is inside the bounding box of element @a e.
+   bool InsideBox(int e, const double *x) const;
+
+   /** Locate the point @a x, returning its element (-1 if not found) and its
+       reference coordinates in @a ip. */
+   int LocatePoint(const double *x, IsoparametricTransformation &T,
+                   InverseElementTransformation &inv_tr,
+                   IntegrationPoint &ip) const;
+
+public:
+   /** @brief Build the index of the elements of @a mesh_. The bounding boxes
+       of curved elements are enlarged by @a bb_tol times their size. */
+   PointLocator(Mesh &mesh_, double bb_tol = 0.05);
+
+   /// Rebuild the index, e.g. after the mesh nodes were moved.
+   void Update();
+
+   /** @brief Return true if the index reflects the current mesh and its
+       nodes.
+
+       Besides the mesh and nodes sequences, the node coordinates are compared
+       with a checksum, so that nodes modified in place through
+       Mesh::GetNodes() are detected even without Mesh::NodesUpdated(). The
+       check is linear in the number of nodes. */
+   bool IsUpToDate() const;
+
+   /** @brief Return in @a elems the elements whose bounding boxes contain the
+       point @a x, i.e. the candidates for containing the point. */
+   void GetCandidates(const Vector &x, Array<int> &elems) const;
+
+   /** @brief Find the elements and reference coordinates of the points given
+       by the columns of @a point_mat.
+
+       If the i-th point is not found, @a elem_ids[i] is set to -1. When
+       @a inv_trans is NULL, a default InverseElementTransformation is used;
+       in that case, and if MFEM is built with OpenMP and MFEM_THREAD_SAFE,
+       the points are located concurrently.
+
+       @returns The number of points found. */
+   int FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                  Array<IntegrationPoint> &ips,
+                  InverseElementTransformation *inv_trans = NULL) const;
+
+   /** @brief Return the bounding box of all elements, including the
+       enlargement of the boxes of curved elements. The box is empty, with
+       @a min > @a max, when the mesh has no elements. */
+   void GetBoundingBox(Vector &min, Vector &max) const;
+
+   /// Return the number of cells of the search grid.
+   int GetNCells() const { return cell_offsets.Size() - 1; }
+
+   long MemoryUsage() const;
+};
+
+}
+
+#endif
@@ -0,0 +1,595 @@
+//                      MFEM Solve Pipeline Benchmark
+//
+// Compile with: make pipeline
+//
+// Sample runs:  pipeline -m ../../data/star.mesh -o "1 2 3" -r "0 1 2"
+//               pipeline -m ../../data/fichera.mesh -a "full partial" -pc "jacobi lor"
+//               pipeline -d omp -csv pipeline.csv -json pipeline.json
+//               mpirun -np 4 pipeline -m ../../data/fichera.mesh -o "2 4" -r "1 2" -pc "amg lor pmg"
+//               mpirun -np 4 pipeline -d cuda -a partial -pc "lor pmg" -csv pipeline.csv
+//
+// Description:  This miniapp times the end-to-end solution of the Laplace
+//               problem -Delta u = 1 with homogeneous Dirichlet boundary
+//               conditions, in the following stages:
+//
+//               mesh     - loading the mesh file,
+//               refine   - the uniform refinement of the mesh, including its
+//                          partitioning in parallel,
+//               space    - the setup of the finite element space and of its
+//                          essential true dofs,
+//               assembly - the assembly of the right-hand side and of the
+//                          form, and the formation of the linear system,
+//               setup    - the setup of the preconditioner,
+//               solve    - the conjugate gradient solve,
+//               output   - the recovery of the finite element solution and
+//                          the output of the mesh and of the solution.
+//
+//               The stages are run for all the combinations of the given
+//               lists of orders (-o), refinement levels (-r), assembly levels
+//               (-a) and preconditioners (-pc), where the incompatible pairs
+//               of assembly levels and preconditioners are skipped. Each stage
+//               is timed after synchronizing the device and the processors,
+//               and its time is the maximum over the processors.
+//
+//               The results are printed in a table, and can be appended to a
+//               CSV file (-csv) and written to a JSON file (-json), together
+//               with the metadata of the machine and of the MFEM build, so
+//               that the performance of different machines, configurations or
+//               releases can be compared. The device is configured once per
+//               run: to compare backends, run the miniapp with each of them
+//               and the same CSV file. The stages are also recorded as regions
+//               of the built-in profiler, whose report, with the regions of
+//               the library, is printed with -prof, and the report of the
+//               memory usage accounting with -mem.
+
+#include "mfem.hpp"
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <thread>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace mfem;
+
+#ifdef MFEM_USE_MPI
+typedef ParMesh PipelineMesh;
+typedef ParFiniteElementSpace PipelineSpace;
+typedef ParBilinearForm PipelineBilinearForm;
+typedef ParLinearForm PipelineLinearForm;
+typedef ParGridFunction PipelineGridFunction;
+#else
+typedef Mesh PipelineMesh;
+typedef FiniteElementSpace PipelineSpace;
+typedef BilinearForm PipelineBilinearForm;
+typedef LinearForm PipelineLinearForm;
+typedef GridFunction PipelineGridFunction;
+#endif
+
+enum Stage { MESH, REFINE, SPACE, ASSEMBLY, SETUP, SOLVE, OUTPUT, NUM_STAGES };
+
+const char *stage_names[NUM_STAGES] =
+{ "mesh", "refine", "space", "assembly", "setup", "solve", "output" };
+
+// Results of one combination of the parameters.
+struct Record
+{
+   int order, ref_levels;
+   long elements, dofs;
+   string assembly, pc;
+   int iterations;
+   bool converged;
+   double time[NUM_STAGES];
+};
+
+// Wall clock timer of the stages.
+class StageTimer
+{
+private:
+   StopWatch sw;
+   int id;
+
+   static void Sync()
+   {
+      MFEM_DEVICE_SYNC;
+#ifdef MFEM_USE_MPI
+      MPI_Barrier(MPI_COMM_WORLD);
+#endif
+   }
+
+public:
+   StageTimer() : id(-1) { }
+
+   void Start(Stage stage)
+   {
+      Sync();
+      sw.Clear();
+      sw.Start();
+      id = Profiler::Begin(stage_names[stage]);
+   }
+
+   // Return the maximum time of the stage over the processors.
+   double Stop()
+   {
+      Sync();
+      Profiler::End(id);
+      sw.Stop();
+      double time = sw.RealTime();
+#ifdef MFEM_USE_MPI
+      MPI_Allreduce(MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX,
+                    MPI_COMM_WORLD);
+#endif
+      return time;
+   }
+};
+
+static AssemblyLevel GetAssemblyLevel(const string &name)
+{
+   if (name == "legacy") { return AssemblyLevel::LEGACY; }
+   if (name == "full") { return AssemblyLevel::FULL; }
+   if (name == "element") { return AssemblyLevel::ELEMENT; }
+   if (name == "partial") { return AssemblyLevel::PARTIAL; }
+   if (name == "none") { return AssemblyLevel::NONE; }
+   MFEM_ABORT("unknown assembly level: " << name);
+   return AssemblyLevel::LEGACY;
+}
+
+// Return an empty string if the preconditioner @a pc can be used with the
+// assembly level @a assembly and the order @a order, or the reason otherwise.
+static string Unsupported(const string &pc, const string &assembly,
+                          int order)
+{
+   if (pc == "none" || pc == "jacobi" || pc == "lor") { return ""; }
+#ifdef MFEM_USE_MPI
+   if (pc == "amg")
+   {
+      return assembly == "legacy" ? "" : "requires legacy assembly";
+   }
+   if (pc == "pmg")
+   {
+      if (assembly != "partial") { return "requires partial assembly"; }
+      return order > 1 ? "" : "requires order > 1";
+   }
+#else
+   if (pc == "amg" || pc == "pmg") { return "requires MPI"; }
+#endif
+   MFEM_ABORT("unknown preconditioner: " << pc);
+   return "";
+}
+
+static vector<string> Split(const char *list)
+{
+   vector<string> words;
+   istringstream is(list);
+   string word;
+   while (is >> word) { words.push_back(word); }
+   return words;
+}
+
+static string Escape(const string &s)
+{
+   string e;
+   for (char c : s)
+   {
+      if (c == '"' || c == '\\') { e += '\\'; }
+      e += (c == '\n') ? ' ' : c;
+   }
+   return e;
+}
+
+// Metadata of the machine, of the MFEM build and of the run.
+static vector<pair<string, string>> GetMetadata(const char *device_config,
+                                                const char *mesh_file)
+{
+   vector<pair<string, string>> meta;
+   char date[32];
+   const time_t now = time(nullptr);
+   strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+   meta.emplace_back("date", date);
+   string host = "unknown";
+#ifndef _WIN32
+   char hostname[256];
+   if (gethostname(hostname, sizeof(hostname)) == 0)
+   {
+      hostname[sizeof(hostname) - 1] = '\0';
+      host = hostname;
+   }
+#endif
+   meta.emplace_back("host", host);
+   meta.emplace_back("hardware_threads",
+                     to_string(thread::hardware_concurrency()));
+   meta.emplace_back("version", GetVersionStr());
+   meta.emplace_back("git", GetGitStr());
+   meta.emplace_back("config", GetConfigStr());
+#ifdef __VERSION__
+   meta.emplace_back("compiler", __VERSION__);
+#endif
+   meta.emplace_back("device", device_config);
+#ifdef MFEM_USE_MPI
+   meta.emplace_back("ranks", to_string(Mpi::WorldSize()));
+#else
+   meta.emplace_back("ranks", "1");
+#endif
+#ifdef MFEM_USE_OPENMP
+   meta.emplace_back("omp_threads", to_string(omp_get_max_threads()));
+#endif
+   meta.emplace_back("mesh_file", mesh_file);
+   return meta;
+}
+
+static void PrintTable(const vector<Record> &records, ostream &os)
+{
+   os << left << setw(6) << "order" << setw(5) << "ref" << right
+      << setw(10) << "elements" << setw(11) << "dofs" << "  " << left
+      << setw(9) << "assembly" << setw(7) << "pc" << right << setw(6) << "its";
+   for (int s = 0; s < NUM_STAGES; s++) { os << setw(10) << stage_names[s]; }
+   os << '\n' << scientific << setprecision(2);
+   for (const Record &r : records)
+   {
+      os << left << setw(6) << r.order << setw(5) << r.ref_levels << right
+         << setw(10) << r.elements << setw(11) << r.dofs << "  " << left
+         << setw(9) << r.assembly << setw(7) << r.pc << right << setw(5)
+         << r.iterations << (r.converged ? ' ' : '*');
+      for (int s = 0; s < NUM_STAGES; s++) { os << setw(10) << r.time[s]; }
+      os << '\n';
+   }
+   os << defaultfloat << flush;
+}
+
+// Append the records to the CSV file @a name, with a header if it is new.
+static void WriteCSV(const char *name,
+                     const vector<pair<string, string>> &meta,
+                     const vector<Record> &records)
+{
+   bool header;
+   {
+      ifstream in(name);
+      header = !in || in.peek() == ifstream::traits_type::eof();
+   }
+   ofstream os(name, ios::app);
+   MFEM_VERIFY(os, "cannot open " << name);
+   if (header)
+   {
+      for (const auto &m : meta) { os << m.first << ','; }
+      os << "order,ref_levels,elements,dofs,assembly,pc,iterations,converged";
+      for (int s = 0; s < NUM_STAGES; s++) { os << ',' << stage_names[s]; }
+      os << '\n';
+   }
+   os << setprecision(6);
+   for (const Record &r : records)
+   {
+      for (const auto &m : meta) { os << '"' << Escape(m.second) << "\","; }
+      os << r.order << ',' << r.ref_levels << ',' << r.elements << ','
+         << r.dofs << ',' << r.assembly << ',' << r.pc << ',' << r.iterations
+         << ',' << r.converged;
+      for (int s = 0; s < NUM_STAGES; s++) { os << ',' << r.time[s]; }
+      os << '\n';
+   }
+}
+
+static void WriteJSON(const char *name,
+                      const vector<pair<string, string>> &meta,
+                      const vector<Record> &records)
+{
+   ofstream os(name);
+   MFEM_VERIFY(os, "cannot open " << name);
+   os << "{\n  \"metadata\": {";
+   for (size_t i = 0; i < meta.size(); i++)
+   {
+      os << (i ? "," : "") << "\n    \"" << meta[i].first << "\": \""
+         << Escape(meta[i].second) << '"';
+   }
+   os << "\n  },\n  \"runs\": [" << setprecision(6);
+   for (size_t i = 0; i < records.size(); i++)
+   {
+      const Record &r = records[i];
+      os << (i ? "," : "") << "\n    {\"order\": " << r.order
+         << ", \"ref_levels\": " << r.ref_levels << ", \"elements\": "
+         << r.elements << ", \"dofs\": " << r.dofs << ", \"assembly\": \""
+         << r.assembly << "\", \"pc\": \"" << r.pc << "\", \"iterations\": "
+         << r.iterations << ", \"converged\": "
+         << (r.converged ? "true" : "false") << ", \"time\": {";
+      for (int s = 0; s < NUM_STAGES; s++)
+      {
+         os << (s ? ", " : "") << '"' << stage_names[s] << "\": " << r.time[s];
+      }
+      os << "}}";
+   }
+   os << "\n  ]\n}\n";
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Initialize MPI and HYPRE.
+#ifdef MFEM_USE_MPI
+   Mpi::Init(argc, argv);
+   Hypre::Init();
+   const bool root = Mpi::Root();
+#else
+   const bool root = true;
+#endif
+
+   // 2. Parse command-line options.
+   const char *mesh_file = "../../data/star.mesh";
+   int ser_ref_levels = 0;
+   Array<int> ref_levels({0, 1});
+   Array<int> orders({1, 2, 3});
+   const char *assembly_list = "legacy full element partial none";
+   const char *pc_list = "none jacobi amg lor pmg";
+   const char *device_config = "cpu";
+   double rel_tol = 1e-8;
+   int max_iter = 1000;
+   bool output = true;
+   bool profile = false;
+   bool memory = false;
+   const char *csv_file = "";
+   const char *json_file = "";
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use.");
+   args.AddOption(&ser_ref_levels, "-rs", "--refine-serial",
+                  "Number of times to refine the mesh uniformly in serial, "
+                  "before the refinement levels of -r, in parallel.");
+   args.AddOption(&ref_levels, "-r", "--refine",
+                  "List of the numbers of uniform refinements of the mesh, "
+                  "e.g. \"0 1 2\".");
+   args.AddOption(&orders, "-o", "--order",
+                  "List of finite element orders, e.g. \"1 2 3\".");
+   args.AddOption(&assembly_list, "-a", "--assembly",
+                  "List of assembly levels: legacy, full, element, partial, "
+                  "none.");
+   args.AddOption(&pc_list, "-pc", "--preconditioner",
+                  "List of preconditioners: none, jacobi, amg (BoomerAMG), "
+                  "lor (low-order-refined AMG, or Gauss-Seidel in serial), "
+                  "pmg (p-multigrid).");
+   args.AddOption(&device_config, "-d", "--device",
+                  "Device configuration string, see Device::Configure().");
+   args.AddOption(&rel_tol, "-tol", "--tolerance",
+                  "Relative tolerance of the conjugate gradient solver.");
+   args.AddOption(&max_iter, "-it", "--max-iterations",
+                  "Maximum number of conjugate gradient iterations.");
+   args.AddOption(&output, "-out", "--output", "-no-out", "--no-output",
+                  "Enable or disable the output of the mesh and solution.");
+   args.AddOption(&profile, "-prof", "--profile", "-no-prof", "--no-profile",
+                  "Print the report of the built-in profiler.");
+   args.AddOption(&memory, "-mem", "--memory", "-no-mem", "--no-memory",
+                  "Enable the memory usage accounting and print its report.");
+   args.AddOption(&csv_file, "-csv", "--csv-file",
+                  "CSV file to which the results are appended.");
+   args.AddOption(&json_file, "-json", "--json-file",
+                  "JSON file to which the results are written.");
+   args.Parse();
+   if (!args.Good())
+   {
+      if (root) { args.PrintUsage(cout); }
+      return 1;
+   }
+   if (root) { args.PrintOptions(cout); }
+
+   const vector<string> assemblies = Split(assembly_list);
+   const vector<string> pcs = Split(pc_list);
+   for (const string &a : assemblies) { GetAssemblyLevel(a); }
+   for (const string &pc : pcs) { Unsupported(pc, "legacy", 2); }
+
+   // 3. Enable hardware devices such as GPUs, and programming models such as
+   //    CUDA, OCCA, RAJA and OpenMP based on command line options.
+   Device device(device_config);
+   if (root) { device.Print(); }
+   MemoryUsage::Enable(memory);
+
+   // 4. Run all the combinations of the orders, refinement levels, assembly
+   //    levels and preconditioners.
+   vector<Record> records;
+   set<string> skipped;
+   StageTimer timer;
+   for (int ref : ref_levels)
+   {
+      for (int order : orders)
+      {
+         Record r;
+         r.order = order;
+         r.ref_levels = ref;
+
+         // 5. Load, refine and distribute the mesh.
+         timer.Start(MESH);
+         Mesh *serial_mesh = new Mesh(mesh_file, 1, 1);
+         r.time[MESH] = timer.Stop();
+
+         timer.Start(REFINE);
+         for (int l = 0; l < ser_ref_levels; l++)
+         {
+            serial_mesh->UniformRefinement();
+         }
+#ifdef MFEM_USE_MPI
+         PipelineMesh mesh(MPI_COMM_WORLD, *serial_mesh);
+         delete serial_mesh;
+#else
+         PipelineMesh &mesh = *serial_mesh;
+#endif
+         for (int l = 0; l < ref; l++) { mesh.UniformRefinement(); }
+         r.time[REFINE] = timer.Stop();
+         r.elements = mesh.GetGlobalNE();
+         const int dim = mesh.Dimension();
+
+         // 6. Define the finite element space and its essential true dofs.
+         timer.Start(SPACE);
+         H1_FECollection fec(order, dim);
+         PipelineSpace fespace(&mesh, &fec);
+         Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+         ess_bdr = 1;
+         fespace.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+         r.time[SPACE] = timer.Stop();
+#ifdef MFEM_USE_MPI
+         r.dofs = fespace.GlobalTrueVSize();
+#else
+         r.dofs = fespace.GetTrueVSize();
+#endif
+
+         for (const string &assembly : assemblies)
+         {
+            // The matrix-free diffusion integrator requires libCEED.
+            if (assembly == "none" && !DeviceCanUseCeed())
+            {
+               const string skip =
+                  "Skipping none assembly: requires a libCEED device";
+               if (root && skipped.insert(skip).second)
+               {
+                  cout << skip << endl;
+               }
+               continue;
+            }
+
+            // 7. Assemble the right-hand side and the form, and form the
+            //    linear system.
+            r.assembly = assembly;
+            ConstantCoefficient one(1.0);
+            PipelineGridFunction x(&fespace);
+            OperatorPtr A;
+            Vector B, X;
+            timer.Start(ASSEMBLY);
+            PipelineLinearForm b(&fespace);
+            b.AddDomainIntegrator(new DomainLFIntegrator(one));
+            b.Assemble();
+            PipelineBilinearForm a(&fespace);
+            a.SetAssemblyLevel(GetAssemblyLevel(assembly));
+            a.AddDomainIntegrator(new DiffusionIntegrator(one));
+            a.Assemble();
+            x = 0.0;
+            a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+            const double assembly_time = timer.Stop();
+
+            for (const string &pc : pcs)
+            {
+               const string reason = Unsupported(pc, assembly, order);
+               if (!reason.empty())
+               {
+                  const string skip = "Skipping " + assembly +
+                                      " assembly with " + pc +
+                                      " preconditioner: " + reason;
+                  if (root && skipped.insert(skip).second)
+                  {
+                     cout << skip << endl;
+                  }
+                  continue;
+               }
+               r.pc = pc;
+               r.time[ASSEMBLY] = assembly_time;
+
+               // 8. Set up the preconditioner.
+               timer.Start(SETUP);
+               Solver *prec = NULL;
+               if (pc == "jacobi")
+               {
+                  prec = new OperatorJacobiSmoother(a, ess_tdof_list);
+               }
+#ifdef MFEM_USE_MPI
+               else if (pc == "amg")
+               {
+                  HypreBoomerAMG *amg =
+                     new HypreBoomerAMG(*A.As<HypreParMatrix>());
+                  amg->SetPrintLevel(0);
+                  prec = amg;
+               }
+               else if (pc == "lor")
+               {
+                  LORSolver<HypreBoomerAMG> *lor =
+                     new LORSolver<HypreBoomerAMG>(a, ess_tdof_list);
+                  lor->GetSolver().SetPrintLevel(0);
+                  prec = lor;
+               }
+               else if (pc == "pmg")
+               {
+                  PMultigridSolver *pmg = new PMultigridSolver(a, ess_bdr);
+                  pmg->Setup();
+                  prec = pmg;
+               }
+#else
+               else if (pc == "lor")
+               {
+                  prec = new LORSolver<GSSmoother>(a, ess_tdof_list);
+               }
+#endif
+               r.time[SETUP] = timer.Stop();
+
+               // 9. Solve the linear system with preconditioned CG.
+#ifdef MFEM_USE_MPI
+               CGSolver cg(MPI_COMM_WORLD);
+#else
+               CGSolver cg;
+#endif
+               cg.SetRelTol(rel_tol);
+               cg.SetMaxIter(max_iter);
+               cg.SetPrintLevel(0);
+               cg.SetOperator(*A);
+               if (prec) { cg.SetPreconditioner(*prec); }
+               X = 0.0;
+               timer.Start(SOLVE);
+               cg.Mult(B, X);
+               r.time[SOLVE] = timer.Stop();
+               r.iterations = cg.GetNumIterations();
+               r.converged = cg.GetConverged();
+               delete prec;
+
+               // 10. Recover the solution and save the mesh and the solution.
+               timer.Start(OUTPUT);
+               a.RecoverFEMSolution(X, b, x);
+               if (output)
+               {
+#ifdef MFEM_USE_MPI
+                  ostringstream mesh_name, sol_name;
+                  mesh_name << "mesh." << setfill('0') << setw(6)
+                            << Mpi::WorldRank();
+                  sol_name << "sol." << setfill('0') << setw(6)
+                           << Mpi::WorldRank();
+                  ofstream mesh_ofs(mesh_name.str().c_str());
+                  ofstream sol_ofs(sol_name.str().c_str());
+#else
+                  ofstream mesh_ofs("refined.mesh");
+                  ofstream sol_ofs("sol.gf");
+#endif
+                  mesh_ofs.precision(8);
+                  mesh.Print(mesh_ofs);
+                  sol_ofs.precision(8);
+                  x.Save(sol_ofs);
+               }
+               r.time[OUTPUT] = timer.Stop();
+               records.push_back(r);
+            }
+         }
+#ifndef MFEM_USE_MPI
+         delete serial_mesh;
+#endif
+      }
+   }
+
+   // 11. Print the results and write them with the metadata.
+#ifdef MFEM_USE_MPI
+   if (profile) { Profiler::PrintReport(MPI_COMM_WORLD); }
+   if (memory) { MemoryUsage::PrintReport(MPI_COMM_WORLD); }
+#else
+   if (profile) { Profiler::PrintReport(); }
+   if (memory) { MemoryUsage::PrintReport(); }
+#endif
+   if (root)
+   {
+      const vector<pair<string, string>> meta =
+         GetMetadata(device_config, mesh_file);
+      cout << '\n';
+      for (const auto &m : meta)
+      {
+         cout << left << setw(18) << m.first << Escape(m.second) << '\n';
+      }
+      cout << right << '\n';
+      PrintTable(records, cout);
+      if (*csv_file) { WriteCSV(csv_file, meta, records); }
+      if (*json_file) { WriteJSON(json_file, meta, records); }
+   }
+
+   return 0;
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#ifdef MFEM_USE_BENCHMARK
+
+/*
+  This benchmark measures the time of Mesh::UniformRefinement on Cartesian 3D
+  meshes with N^3 cells, including the rebuild of the mesh topology (edges,
+  faces and the element-to-edge/face tables). All-hex meshes use the direct
+  topology generation, while tetrahedral meshes go through the generic path.
+
+   * --benchmark_filter=Refine[Hex/Tet]/[N]
+*/
+
+// The maximum number of cells per direction
+const int max_n = 64;
+
+static void Refine(benchmark::State &state, Element::Type type)
+{
+   const int N = state.range(0);
+   int ne = 0;
+   for (auto _ : state)
+   {
+      state.PauseTiming();
+      Mesh mesh = Mesh::MakeCartesian3D(N, N, N, type);
+      state.ResumeTiming();
+
+      mesh.UniformRefinement();
+
+      state.PauseTiming();
+      ne = mesh.GetNE();
+      state.ResumeTiming();
+   }
+   state.counters["Elements"] = bm::Counter(ne);
+   state.counters["MElem/s"] =
+      bm::Counter(1e-6*ne*state.iterations(), bm::Counter::kIsRate);
+}
+
+static void RefineHex(benchmark::State &state)
+{
+   Refine(state, Element::HEXAHEDRON);
+}
+BENCHMARK(RefineHex)->RangeMultiplier(2)->Range(4, max_n)
+->Unit(bm::kMillisecond);
+
+static void RefineTet(benchmark::State &state)
+{
+   Refine(state, Element::TETRAHEDRON);
+}
+BENCHMARK(RefineTet)->RangeMultiplier(2)->Range(4, max_n/2)
+->Unit(bm::kMillisecond);
+
+/**
+ * @brief main entry point
+ * --benchmark_filter=RefineHex/64
+ */
+int main(int argc, char *argv[])
+{
+   bm::ConsoleReporter CR;
+   bm::Initialize(&argc, argv);
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   bm::RunSpecifiedBenchmarks(&CR);
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK
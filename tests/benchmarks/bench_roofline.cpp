@@ -0,0 +1,207 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#ifdef MFEM_USE_BENCHMARK
+
+#include "general/forall.hpp"
+
+/*
+  This benchmark measures the peak bandwidth (STREAM triad) and floating point
+  performance (independent FMA chains) of the selected device, and the work
+  rates of the partial assembly mass and diffusion kernels, which register
+  their analytic flop and byte counts with the Profiler.
+
+  With --benchmark_context=roofline=1, the peaks are measured first and the
+  roofline table of the kernels, see Profiler::PrintRoofline(), is printed at
+  the end of the run.
+*/
+
+constexpr int FMA_ITER = 256; // iterations of the FMA chains
+
+/// STREAM triad a = b + s c, moving 3 doubles per entry
+static double StreamTriad(Vector &a, const Vector &b, const Vector &c)
+{
+   const int N = a.Size();
+   const double s = 3.0;
+   auto d_a = a.Write();
+   auto d_b = b.Read();
+   auto d_c = c.Read();
+   StopWatch sw;
+   sw.Start();
+   MFEM_FORALL(i, N, d_a[i] = d_b[i] + s*d_c[i];);
+   MFEM_DEVICE_SYNC;
+   sw.Stop();
+   return sw.RealTime();
+}
+
+/// Eight independent FMA chains per entry, 16*FMA_ITER flops per entry
+static double FMAChains(Vector &y)
+{
+   const int N = y.Size();
+   auto d_y = y.ReadWrite();
+   StopWatch sw;
+   sw.Start();
+   MFEM_FORALL(i, N,
+   {
+      const double a = 0.999, b = 1e-3;
+      double x[8];
+      for (int j = 0; j < 8; j++) { x[j] = d_y[i] + j; }
+      for (int k = 0; k < FMA_ITER; k++)
+      {
+         MFEM_UNROLL(8)
+         for (int j = 0; j < 8; j++) { x[j] = a*x[j] + b; }
+      }
+      double sum = 0.0;
+      for (int j = 0; j < 8; j++) { sum += x[j]; }
+      d_y[i] = sum;
+   });
+   MFEM_DEVICE_SYNC;
+   sw.Stop();
+   return sw.RealTime();
+}
+
+/// Sustained bandwidth in GB/s, best of the given number of runs
+static double MeasureBandwidth(int N, int runs)
+{
+   Vector a(N), b(N), c(N);
+   a.UseDevice(true);
+   b.UseDevice(true);
+   c.UseDevice(true);
+   b = 1.0;
+   c = 2.0;
+   double best = StreamTriad(a, b, c);
+   for (int r = 1; r < runs; r++)
+   {
+      best = std::min(best, StreamTriad(a, b, c));
+   }
+   return 3.0*sizeof(double)*N/best*1e-9;
+}
+
+/// Peak floating point performance in GFLOP/s, best of the given runs
+static double MeasureFlops(int N, int runs)
+{
+   Vector y(N);
+   y.UseDevice(true);
+   y = 1.0;
+   double best = FMAChains(y);
+   for (int r = 1; r < runs; r++) { best = std::min(best, FMAChains(y)); }
+   return 16.0*FMA_ITER*N/best*1e-9;
+}
+
+static void Stream(bm::State &state)
+{
+   const int N = state.range(0);
+   Vector a(N), b(N), c(N);
+   a.UseDevice(true);
+   b.UseDevice(true);
+   c.UseDevice(true);
+   b = 1.0;
+   c = 2.0;
+   double time = 0.0;
+   while (state.KeepRunning()) { time += StreamTriad(a, b, c); }
+   state.counters["GB/s"] =
+      bm::Counter(3e-9*sizeof(double)*N*state.iterations()/time);
+}
+BENCHMARK(Stream)->RangeMultiplier(4)->Range(1<<16, 1<<24);
+
+static void FMA(bm::State &state)
+{
+   const int N = state.range(0);
+   Vector y(N);
+   y.UseDevice(true);
+   y = 1.0;
+   double time = 0.0;
+   while (state.KeepRunning()) { time += FMAChains(y); }
+   state.counters["GFLOP/s"] =
+      bm::Counter(16e-9*FMA_ITER*N*state.iterations()/time);
+}
+BENCHMARK(FMA)->RangeMultiplier(4)->Range(1<<12, 1<<20);
+
+/// Action of a partial assembly mass or diffusion operator in 3D
+template <typename BFI>
+static void PAKernel(bm::State &state)
+{
+   const int p = state.range(0);
+   const int n = Device::IsEnabled() ? 32 : 8;
+   Mesh mesh = Mesh::MakeCartesian3D(n, n, n, Element::HEXAHEDRON);
+   H1_FECollection fec(p, 3);
+   FiniteElementSpace fes(&mesh, &fec);
+   BilinearForm a(&fes);
+   a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a.AddDomainIntegrator(new BFI);
+   a.Assemble();
+   Vector x(fes.GetVSize()), y(fes.GetVSize());
+   x.UseDevice(true);
+   y.UseDevice(true);
+   x = 1.0;
+   const bool mass = std::is_same<BFI, MassIntegrator>::value;
+   ProfilerRegion region(std::string(mass ? "Mass" : "Diffusion") +
+                         ", p = " + std::to_string(p));
+   while (state.KeepRunning()) { a.Mult(x, y); }
+   MFEM_DEVICE_SYNC;
+   state.counters["MDof/s"] =
+      bm::Counter(1e-6*fes.GetVSize(), bm::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(PAKernel, MassIntegrator)->DenseRange(1, 6);
+BENCHMARK_TEMPLATE(PAKernel, DiffusionIntegrator)->DenseRange(1, 6);
+
+/**
+ * @brief main entry point
+ * --benchmark_context=device=cuda
+ * --benchmark_context=roofline=1
+ */
+int main(int argc, char *argv[])
+{
+   bm::ConsoleReporter CR;
+   bm::Initialize(&argc, argv);
+
+   // Device setup, cpu by default
+   std::string device_config = "cpu";
+   bool roofline = false;
+   if (bmi::global_context != nullptr)
+   {
+      const auto device = bmi::global_context->find("device");
+      if (device != bmi::global_context->end())
+      {
+         mfem::out << device->first << " : " << device->second << std::endl;
+         device_config = device->second;
+      }
+      const auto rl = bmi::global_context->find("roofline");
+      roofline = rl != bmi::global_context->end() && rl->second != "0";
+   }
+   Device device(device_config.c_str());
+   device.Print();
+
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+
+   double peak_gflops = 0.0, peak_gbs = 0.0;
+   if (roofline)
+   {
+      peak_gbs = MeasureBandwidth(1<<24, 10);
+      peak_gflops = MeasureFlops(1<<20, 10);
+      // record the kernel regions and time their execution, not only the
+      // launches
+      Profiler::EnableDetails();
+      Profiler::SetDeviceSync();
+      Profiler::Reset();
+   }
+   bm::RunSpecifiedBenchmarks(&CR);
+   if (roofline)
+   {
+      mfem::out << '\n';
+      Profiler::PrintRoofline(mfem::out, peak_gflops, peak_gbs);
+   }
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK
@@ -142,3 +142,223 @@ TEST_CASE("FormLinearSystem/SolutionScope",
       REQUIRE(AsConst(sol)(bdr_dof) == 0.0);
    }
 }
+
+TEST_CASE("BilinearForm ReassembleGeometry", "[BilinearForm]")
+{
+   const int order = 2;
+   const auto assembly = GENERATE(AssemblyLevel::LEGACY,
+                                  AssemblyLevel::PARTIAL,
+                                  AssemblyLevel::ELEMENT);
+   const int dim = GENERATE(2, 3);
+   CAPTURE(dim, assembly);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+   mesh.SetCurvature(order);
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.SetAssemblyLevel(assembly);
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+   if (assembly == AssemblyLevel::LEGACY) { a.Finalize(); }
+
+   // Move the nodes with a smooth displacement, bypassing the Mesh interface
+   GridFunction &nodes = *mesh.GetNodes();
+   const int nn = nodes.Size() / dim;
+   for (int i = 0; i < nn; i++)
+   {
+      const double x = nodes(i), y = nodes(nn + i);
+      nodes(i) += 0.1*sin(M_PI*y);
+      nodes(nn + i) += 0.1*sin(M_PI*x);
+   }
+   mesh.NodesUpdated();
+   a.ReassembleGeometry();
+   if (assembly == AssemblyLevel::LEGACY) { a.Finalize(); }
+
+   BilinearForm a_ref(&fes);
+   a_ref.AddDomainIntegrator(new MassIntegrator(one));
+   a_ref.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a_ref.Assemble();
+   a_ref.Finalize();
+
+   Vector x(fes.GetVSize()), y(fes.GetVSize()), y_ref(fes.GetVSize());
+   x.Randomize(1);
+   a.Mult(x, y);
+   a_ref.Mult(x, y_ref);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0, 1e-12*y_ref.Normlinf()));
+}
+
+TEST_CASE("BilinearForm multiple domain integrators", "[BilinearForm]")
+{
+   // the element transformation is shared by the integrators of an element
+   auto curved = GENERATE(false, true);
+   auto space = GENERATE(0, 1);
+   Mesh mesh = (space == 1) ?
+               Mesh::MakeCartesian3D(2, 2, 2, Element::TETRAHEDRON) :
+               Mesh::MakeCartesian2D(3, 3, Element::TRIANGLE);
+   const int dim = mesh.Dimension();
+   if (curved) { mesh.SetCurvature(2); }
+
+   H1_FECollection h1_fec(2, dim);
+   ND_FECollection nd_fec(2, dim);
+   FiniteElementSpace fes(&mesh, (space == 1) ? (FiniteElementCollection*)
+                          &nd_fec : &h1_fec);
+   ConstantCoefficient one(1.0), two(2.0);
+   FunctionCoefficient coeff([](const Vector &x) { return 1.0 + x(0)*x(1); });
+
+   BilinearForm a(&fes), a1(&fes), a2(&fes);
+   if (space == 0)
+   {
+      a.AddDomainIntegrator(new MassIntegrator(coeff));
+      a.AddDomainIntegrator(new DiffusionIntegrator(two));
+      a1.AddDomainIntegrator(new MassIntegrator(coeff));
+      a2.AddDomainIntegrator(new DiffusionIntegrator(two));
+   }
+   else
+   {
+      a.AddDomainIntegrator(new CurlCurlIntegrator(coeff));
+      a.AddDomainIntegrator(new VectorFEMassIntegrator(one));
+      a1.AddDomainIntegrator(new CurlCurlIntegrator(coeff));
+      a2.AddDomainIntegrator(new VectorFEMassIntegrator(one));
+   }
+   a.Assemble(0);
+   a.Finalize(0);
+   a1.Assemble(0);
+   a1.Finalize(0);
+   a2.Assemble(0);
+   a2.Finalize(0);
+
+   SparseMatrix *S = Add(a1.SpMat(), a2.SpMat());
+   SparseMatrix *D = Add(1.0, a.SpMat(), -1.0, *S);
+   REQUIRE(D->MaxNorm() == MFEM_Approx(0.0, 1e-12*a.SpMat().MaxNorm()));
+   delete D;
+   delete S;
+}
+
+TEST_CASE("Element assembly cache", "[BilinearForm]")
+{
+   auto curved = GENERATE(false, true);
+   auto space = GENERATE(0, 1, 2);
+   Mesh mesh = (space == 2) ?
+               Mesh::MakeCartesian3D(2, 2, 2, Element::TETRAHEDRON) :
+               Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL);
+   const int dim = mesh.Dimension();
+   if (curved) { mesh.SetCurvature(2); }
+
+   H1_FECollection h1_fec(2, dim);
+   ND_FECollection nd_fec(2, dim);
+   FiniteElementSpace fes(&mesh, (space == 2) ? (FiniteElementCollection*)
+                          &nd_fec : &h1_fec, (space == 1) ? dim : 1);
+   ConstantCoefficient one(1.0), two(2.0);
+   FunctionCoefficient coeff([](const Vector &x) { return 1.0 + x(0)*x(1); });
+
+   const Geometry::Type geom = mesh.GetElementBaseGeometry(0);
+   const IntegrationRule &ir = IntRules.Get(geom, 5);
+   auto add_integrators = [&](BilinearForm &a)
+   {
+      BilinearFormIntegrator *integ[2] = { NULL, NULL };
+      switch (space)
+      {
+         case 0:
+            integ[0] = new MassIntegrator(coeff);
+            integ[1] = new DiffusionIntegrator(two);
+            break;
+         case 1: integ[0] = new ElasticityIntegrator(one, two);
+            break;
+         case 2:
+            integ[0] = new CurlCurlIntegrator(coeff);
+            integ[1] = new VectorFEMassIntegrator(one);
+            break;
+      }
+      // the Jacobians are cached for the rule of the first integrator
+      integ[0]->SetIntRule(&ir);
+      for (int k = 0; k < 2; k++)
+      {
+         if (integ[k]) { a.AddDomainIntegrator(integ[k]); }
+      }
+   };
+
+   BilinearForm a(&fes), a_cached(&fes);
+   add_integrators(a);
+   add_integrators(a_cached);
+   a_cached.UseElementAssemblyCache();
+   const ElementAssemblyCache &cache = *a_cached.GetElementAssemblyCache();
+
+   // the cache is reused by reassembly and rebuilt when the nodes change
+   for (int it = 0; it < 2; it++)
+   {
+      if (it == 1)
+      {
+         mesh.Transform([](const Vector &x, Vector &y)
+         {
+            y = x;
+            y(0) += 0.1*x(0)*x(1);
+         });
+         a = 0.0;
+         a_cached = 0.0;
+      }
+      a.Assemble(0);
+      a.Finalize(0);
+      a_cached.Assemble(0);
+      a_cached.Finalize(0);
+      REQUIRE(cache.IsUpToDate());
+
+      SparseMatrix *D = Add(1.0, a.SpMat(), -1.0, a_cached.SpMat());
+      REQUIRE(D->MaxNorm() == MFEM_Approx(0.0, 1e-12*a.SpMat().MaxNorm()));
+      delete D;
+
+      // the cached tables match the element evaluations
+      const FiniteElement &fe = *fes.GetFE(0);
+      const DenseMatrix *shape = cache.GetShape(geom, ir);
+      const DenseTensor *dshape = cache.GetDShape(geom, ir);
+      const bool scalar = fe.GetRangeType() == FiniteElement::SCALAR;
+      REQUIRE((shape != NULL) == scalar);
+      REQUIRE((dshape != NULL) == scalar);
+      REQUIRE(cache.GetShape(geom, IntRules.Get(geom, 1)) == NULL);
+      double shape_err = 0.0;
+      if (scalar)
+      {
+         Vector s(fe.GetDof());
+         DenseMatrix ds(fe.GetDof(), dim);
+         for (int q = 0; q < ir.GetNPoints(); q++)
+         {
+            fe.CalcShape(ir.IntPoint(q), s);
+            fe.CalcDShape(ir.IntPoint(q), ds);
+            for (int j = 0; j < fe.GetDof(); j++)
+            {
+               shape_err = std::max(shape_err, std::abs(s(j) - (*shape)(j,q)));
+            }
+            ds -= (*dshape)(q);
+            shape_err = std::max(shape_err, ds.MaxMaxNorm());
+         }
+      }
+      REQUIRE(shape_err == MFEM_Approx(0.0));
+
+      double jac_err = 0.0;
+      for (int e = 0; e < mesh.GetNE(); e++)
+      {
+         ElementTransformation &T = *mesh.GetElementTransformation(e);
+         const double *J = cache.GetJacobians(e, ir);
+         REQUIRE(J != NULL);
+         for (int q = 0; q < ir.GetNPoints(); q++)
+         {
+            T.SetIntPoint(&ir.IntPoint(q));
+            const DenseMatrix &Jq = T.Jacobian();
+            for (int k = 0; k < Jq.Height()*Jq.Width(); k++)
+            {
+               jac_err = std::max(jac_err, std::abs(Jq.GetData()[k] -
+                                                    J[q*dim*dim + k]));
+            }
+         }
+      }
+      REQUIRE(jac_err == MFEM_Approx(0.0));
+   }
+   REQUIRE(cache.MemoryUsage() > 0);
+}
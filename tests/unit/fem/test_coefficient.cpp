@@ -11,6 +11,7 @@
 
 #include "mfem.hpp"
 #include "unit_tests.hpp"
+#include "linalg/dtensor.hpp"
 
 using namespace mfem;
 
@@ -306,3 +307,246 @@ TEST_CASE("Piecewise Matrix Coefficient",
       REQUIRE(m.FNorm() == MFEM_Approx(twoNorm));
    }
 }
+
+TEST_CASE("Coefficient Project on QuadratureSpace",
+          "[Coefficient]")
+{
+   const int order = 3;
+   const auto type = GENERATE(Element::QUADRILATERAL, Element::TRIANGLE,
+                              Element::HEXAHEDRON);
+   CAPTURE(type);
+
+   Mesh mesh = (type == Element::HEXAHEDRON) ?
+               Mesh::MakeCartesian3D(2, 2, 2, type, 1.0, 1.5, 2.0) :
+               Mesh::MakeCartesian2D(3, 2, type, true, 1.0, 1.5);
+   mesh.EnsureNodes();
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      mesh.SetAttribute(e, 1 + (e % 3));
+   }
+   mesh.SetAttributes();
+   const int dim = mesh.Dimension();
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   FiniteElementSpace vfes(&mesh, &fec, dim);
+
+   auto f = [](const Vector &x) { return sin(x(0)) + x(1)*x(1); };
+   FunctionCoefficient f_coeff(f);
+   GridFunction gf(&fes);
+   gf.ProjectCoefficient(f_coeff);
+
+   VectorFunctionCoefficient vf_coeff(dim, [](const Vector &x, Vector &v)
+   {
+      for (int i = 0; i < v.Size(); i++) { v(i) = (i + 1)*x(i)*x(i); }
+   });
+   GridFunction vgf(&vfes);
+   vgf.ProjectCoefficient(vf_coeff);
+
+   Vector pw(3);
+   pw(0) = 1.0; pw(1) = -2.0; pw(2) = 3.5;
+
+   ConstantCoefficient c_coeff(2.5);
+   PWConstCoefficient pw_coeff(pw);
+   GridFunctionCoefficient gf_coeff(&gf);
+   GridFunctionCoefficient vgf_coeff(&vgf, 2);
+
+   const IntegrationRule &ir =
+      IntRules.Get(mesh.GetElementBaseGeometry(0), 2*order);
+   QuadratureSpace qs(&mesh, ir);
+   REQUIRE(qs.GetSize() == mesh.GetNE()*ir.GetNPoints());
+
+   Coefficient *coeffs[] = { &c_coeff, &pw_coeff, &f_coeff, &gf_coeff,
+                             &vgf_coeff
+                           };
+   for (Coefficient *coeff : coeffs)
+   {
+      Vector values;
+      coeff->Project(qs, values);
+      REQUIRE(values.Size() == qs.GetSize());
+      values.HostRead();
+
+      double max_err = 0.0;
+      for (int e = 0, i = 0; e < mesh.GetNE(); e++)
+      {
+         ElementTransformation &T = *mesh.GetElementTransformation(e);
+         for (int q = 0; q < ir.GetNPoints(); q++, i++)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(q);
+            T.SetIntPoint(&ip);
+            max_err = std::max(max_err, std::abs(values(i) - coeff->Eval(T, ip)));
+         }
+      }
+      REQUIRE(max_err == MFEM_Approx(0.0));
+   }
+
+   // the coordinates of the quadrature points are not stored in the mesh
+   const long geom_mem = mesh.GeometricFactorsMemoryUsage();
+   QuadratureSpace qs_f(&mesh, 2*order + 1);
+   Vector values;
+   f_coeff.Project(qs_f, values);
+   REQUIRE(mesh.GeometricFactorsMemoryUsage() == geom_mem);
+
+   // the interpolator cached in the space keeps its settings
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   qi->EnableTensorProducts();
+   gf_coeff.Project(qs, values);
+   REQUIRE(qi->GetOutputLayout() == QVectorLayout::byVDIM);
+   REQUIRE(qi->UsesTensorProducts());
+
+   // meshes without nodes use the vertex coordinates
+   Mesh vert_mesh = (type == Element::HEXAHEDRON) ?
+                    Mesh::MakeCartesian3D(2, 2, 2, type, 1.0, 1.5, 2.0) :
+                    Mesh::MakeCartesian2D(3, 2, type, true, 1.0, 1.5);
+   REQUIRE(vert_mesh.GetNodes() == nullptr);
+   QuadratureSpace qs_vert(&vert_mesh, ir);
+   Vector vert_values;
+   f_coeff.Project(qs_vert, vert_values);
+   f_coeff.Project(qs, values);
+   vert_values -= values;
+   REQUIRE(vert_values.Normlinf() == MFEM_Approx(0.0));
+   REQUIRE(vert_mesh.GetNodes() == nullptr);
+}
+
+TEST_CASE("Vector and matrix Coefficient Project on QuadratureSpace",
+          "[Coefficient]")
+{
+   const int order = 2;
+   const auto type = GENERATE(Element::QUADRILATERAL, Element::HEXAHEDRON);
+   CAPTURE(type);
+
+   Mesh mesh = (type == Element::HEXAHEDRON) ?
+               Mesh::MakeCartesian3D(2, 2, 2, type, 1.0, 1.5, 2.0) :
+               Mesh::MakeCartesian2D(3, 2, type, true, 1.0, 1.5);
+   const int dim = mesh.Dimension();
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace vfes(&mesh, &fec, dim);
+
+   auto vf = [](const Vector &x, Vector &v)
+   {
+      for (int i = 0; i < v.Size(); i++) { v(i) = (i + 1)*x(i)*x(i); }
+   };
+   VectorFunctionCoefficient vf_coeff(dim, vf);
+   GridFunction vgf(&vfes);
+   vgf.ProjectCoefficient(vf_coeff);
+
+   Vector v(dim);
+   for (int i = 0; i < dim; i++) { v(i) = 1.0 + i; }
+   VectorConstantCoefficient vc_coeff(v);
+   VectorGridFunctionCoefficient vgf_coeff(&vgf);
+   ConstantCoefficient two(2.0);
+   VectorFunctionCoefficient vf_scaled_coeff(dim, vf, &two);
+
+   DenseMatrix m(dim);
+   for (int i = 0; i < dim*dim; i++) { m.Data()[i] = 1.0 + i*i; }
+   MatrixConstantCoefficient mc_coeff(m);
+   MatrixFunctionCoefficient mf_coeff(dim, [](const Vector &x, DenseMatrix &K)
+   {
+      for (int j = 0; j < K.Width(); j++)
+         for (int i = 0; i < K.Height(); i++) { K(i,j) = x(i) - 2.0*x(j); }
+   });
+   DenseSymmetricMatrix sm(dim);
+   for (int i = 0; i < dim; i++)
+      for (int j = i; j < dim; j++) { sm(i,j) = 1.0 + i + 2*j; }
+   SymmetricMatrixConstantCoefficient smc_coeff(sm);
+   SymmetricMatrixFunctionCoefficient smf_coeff(dim,
+                                                [](const Vector &x,
+                                                   DenseSymmetricMatrix &K)
+   {
+      for (int i = 0; i < K.Height(); i++)
+         for (int j = i; j < K.Height(); j++) { K(i,j) = x(i)*x(j) + i; }
+   });
+
+   const IntegrationRule &ir =
+      IntRules.Get(mesh.GetElementBaseGeometry(0), 2*order);
+   const int nq = ir.GetNPoints(), ne = mesh.GetNE();
+   QuadratureSpace qs(&mesh, ir);
+
+   VectorCoefficient *vcoeffs[] = { &vc_coeff, &vf_coeff, &vgf_coeff,
+                                    &vf_scaled_coeff
+                                  };
+   for (VectorCoefficient *coeff : vcoeffs)
+   {
+      Vector values, V;
+      coeff->Project(qs, values);
+      REQUIRE(values.Size() == dim*qs.GetSize());
+      const auto C = Reshape(values.HostRead(), dim, nq, ne);
+      double max_err = 0.0;
+      for (int e = 0; e < ne; e++)
+      {
+         ElementTransformation &T = *mesh.GetElementTransformation(e);
+         for (int q = 0; q < nq; q++)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(q);
+            T.SetIntPoint(&ip);
+            coeff->Eval(V, T, ip);
+            for (int i = 0; i < dim; i++)
+            {
+               max_err = std::max(max_err, std::abs(C(i,q,e) - V(i)));
+            }
+         }
+      }
+      REQUIRE(max_err == MFEM_Approx(0.0));
+   }
+
+   MatrixCoefficient *mcoeffs[] = { &mc_coeff, &mf_coeff, &smc_coeff };
+   for (MatrixCoefficient *coeff : mcoeffs)
+   {
+      for (bool transpose : { false, true })
+      {
+         Vector values;
+         DenseMatrix K(dim);
+         coeff->Project(qs, values, transpose);
+         REQUIRE(values.Size() == dim*dim*qs.GetSize());
+         const auto C = Reshape(values.HostRead(), dim, dim, nq, ne);
+         double max_err = 0.0;
+         for (int e = 0; e < ne; e++)
+         {
+            ElementTransformation &T = *mesh.GetElementTransformation(e);
+            for (int q = 0; q < nq; q++)
+            {
+               const IntegrationPoint &ip = ir.IntPoint(q);
+               T.SetIntPoint(&ip);
+               coeff->Eval(K, T, ip);
+               for (int j = 0; j < dim; j++)
+                  for (int i = 0; i < dim; i++)
+                  {
+                     const double c = transpose ? C(j,i,q,e) : C(i,j,q,e);
+                     max_err = std::max(max_err, std::abs(c - K(i,j)));
+                  }
+            }
+         }
+         REQUIRE(max_err == MFEM_Approx(0.0));
+      }
+   }
+
+   const int symm_size = (dim*(dim + 1))/2;
+   SymmetricMatrixCoefficient *smcoeffs[] = { &smc_coeff, &smf_coeff };
+   for (SymmetricMatrixCoefficient *coeff : smcoeffs)
+   {
+      Vector values;
+      DenseSymmetricMatrix K(dim);
+      coeff->ProjectSymmetric(qs, values);
+      REQUIRE(values.Size() == symm_size*qs.GetSize());
+      const auto C = Reshape(values.HostRead(), symm_size, nq, ne);
+      double max_err = 0.0;
+      for (int e = 0; e < ne; e++)
+      {
+         ElementTransformation &T = *mesh.GetElementTransformation(e);
+         for (int q = 0; q < nq; q++)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(q);
+            T.SetIntPoint(&ip);
+            coeff->Eval(K, T, ip);
+            for (int i = 0, k = 0; i < dim; i++)
+               for (int j = i; j < dim; j++, k++)
+               {
+                  max_err = std::max(max_err, std::abs(C(k,q,e) - K(i,j)));
+               }
+         }
+      }
+      REQUIRE(max_err == MFEM_Approx(0.0));
+   }
+}
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <array>
+#include <algorithm>
 
 using namespace mfem;
 
@@ -720,3 +721,105 @@ TEST_CASE("Kelly Error Estimator on 3D NCMesh",
 }
 
 #endif
+
+namespace testhelper
+{
+
+// Diffusion integrator without the batched flux methods, used as a reference
+// for the batched implementations.
+class HostDiffusionIntegrator : public DiffusionIntegrator
+{
+public:
+   HostDiffusionIntegrator(Coefficient &q) : DiffusionIntegrator(q) { }
+
+   bool ComputeElementFluxes(const FiniteElementSpace &, const Vector &,
+                             const FiniteElementSpace &, Vector &,
+                             bool) override { return false; }
+
+   bool ComputeFluxEnergies(const FiniteElementSpace &, const Vector &,
+                            Vector &, Vector *) override { return false; }
+};
+
+void DistortMesh(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.05*std::sin(M_PI*x(1));
+   y(1) += 0.05*std::sin(2.0*M_PI*x(0));
+}
+
+}
+
+TEST_CASE("Batched error estimators", "[ErrorEstimator]")
+{
+   const auto type = GENERATE(Element::QUADRILATERAL, Element::TRIANGLE,
+                              Element::HEXAHEDRON);
+   const auto order = GENERATE(1, 2);
+   Mesh mesh = (type == Element::HEXAHEDRON) ?
+               Mesh::MakeCartesian3D(3, 3, 2, type) :
+               Mesh::MakeCartesian2D(4, 3, type);
+   mesh.Transform(testhelper::DistortMesh);
+   const int dim = mesh.Dimension();
+
+   H1_FECollection fe_coll(order, dim);
+   FiniteElementSpace fespace(&mesh, &fe_coll);
+   FunctionCoefficient u_analytic(testhelper::SinXSinY);
+   GridFunction u_gf(&fespace);
+   u_gf.ProjectCoefficient(u_analytic);
+
+   FunctionCoefficient q([](const Vector &x) { return 1.0 + x(0); });
+   DiffusionIntegrator di(q);
+   testhelper::HostDiffusionIntegrator host_di(q);
+
+   SECTION("ZZ estimator")
+   {
+      FiniteElementSpace flux_fes(&mesh, &fe_coll, dim);
+      GridFunction flux(&flux_fes), host_flux(&flux_fes);
+      Vector errors, host_errors;
+      Array<int> aniso, host_aniso;
+      const double total =
+         ZZErrorEstimator(di, u_gf, flux, errors, &aniso);
+      const double host_total =
+         ZZErrorEstimator(host_di, u_gf, host_flux, host_errors, &host_aniso);
+
+      REQUIRE(total == MFEM_Approx(host_total));
+      REQUIRE(total > 0.0);
+      for (int i = 0; i < flux.Size(); i++)
+      {
+         REQUIRE(flux(i) == MFEM_Approx(host_flux(i)));
+      }
+      for (int e = 0; e < mesh.GetNE(); e++)
+      {
+         REQUIRE(errors(e) == MFEM_Approx(host_errors(e)));
+         REQUIRE(aniso[e] == host_aniso[e]);
+      }
+   }
+
+   SECTION("Kelly estimator")
+   {
+      L2_FECollection flux_fec(order, dim);
+      FiniteElementSpace flux_fes(&mesh, &flux_fec, dim);
+      KellyErrorEstimator estimator(di, u_gf, flux_fes);
+      Vector errors = estimator.GetLocalErrors();
+      const double total = estimator.GetTotalError();
+      REQUIRE(total > 0.0);
+
+      // The faces of nonconforming meshes are processed one by one.
+      Mesh nc_mesh(mesh);
+      nc_mesh.EnsureNCMesh(true);
+      FiniteElementSpace nc_fespace(&nc_mesh, &fe_coll);
+      GridFunction nc_u_gf(&nc_fespace);
+      nc_u_gf.ProjectCoefficient(u_analytic);
+      FiniteElementSpace nc_flux_fes(&nc_mesh, &flux_fec, dim);
+      KellyErrorEstimator host_estimator(host_di, nc_u_gf, nc_flux_fes);
+      Vector host_errors = host_estimator.GetLocalErrors();
+
+      REQUIRE(total == MFEM_Approx(host_estimator.GetTotalError()));
+      // The elements may be reordered by EnsureNCMesh()
+      std::sort(errors.begin(), errors.end());
+      std::sort(host_errors.begin(), host_errors.end());
+      for (int e = 0; e < mesh.GetNE(); e++)
+      {
+         REQUIRE(errors(e) == MFEM_Approx(host_errors(e)));
+      }
+   }
+}
@@ -161,6 +161,83 @@ TEST_CASE("Linear Form Extension", "[LinearformExt], [CUDA]")
       LinearFormExtTest(mesh_file, vdim, ordering, gll, problem, p).Run();
    }
 
+   SECTION("Boundary")
+   {
+      Mesh mesh(mesh_file);
+      mesh.SetCurvature(3); // the face geometric factors need H1 tensor nodes
+      const int dim = mesh.Dimension();
+      CAPTURE(mesh_file, dim, p, gll);
+
+      FunctionCoefficient f([](const Vector &x)
+      { return std::sin(M_PI*x(0)) + std::cos(M_PI*x(1)) + x.Sum(); });
+      VectorFunctionCoefficient fv(dim, [](const Vector &x, Vector &v)
+      { v = x; v(0) = std::sin(M_PI*x(1)); });
+      Array<int> bdr_marker(mesh.bdr_attributes.Max());
+      bdr_marker = 0;
+      bdr_marker[0] = 1;
+
+      const auto compare = [](LinearForm &lf_dev, LinearForm &lf_std)
+      {
+         REQUIRE(lf_dev.SupportsDevice());
+         lf_dev.Assemble(true);
+         lf_std.Assemble(false);
+         lf_std -= lf_dev;
+         REQUIRE(0.0 == MFEM_Approx(lf_std.Normlinf(), 1e-12, 1e-12));
+      };
+
+      // Two domain integrators exercise the accumulation in the E-vector
+      H1_FECollection H1(p, dim);
+      FiniteElementSpace H1fes(&mesh, &H1);
+      LinearForm b_dev(&H1fes), b_std(&H1fes);
+      for (LinearForm *b : {&b_dev, &b_std})
+      {
+         b->AddDomainIntegrator(new DomainLFIntegrator(f));
+         b->AddDomainIntegrator(new DomainLFIntegrator(f));
+         b->AddBoundaryIntegrator(new BoundaryLFIntegrator(f));
+         b->AddBoundaryIntegrator(new BoundaryNormalLFIntegrator(fv),
+                                  bdr_marker);
+      }
+      compare(b_dev, b_std);
+
+      // Batched piecewise constant and GridFunction coefficients, assembled
+      // twice with the cached boundary face data
+      PWConstCoefficient pw(mesh.bdr_attributes.Max());
+      for (int i = 1; i <= pw.GetNConst(); i++) { pw(i) = 1.0 + i; }
+      GridFunction gf(&H1fes);
+      gf.ProjectCoefficient(f);
+      GridFunctionCoefficient gf_coeff(&gf);
+      LinearForm c_dev(&H1fes), c_std(&H1fes);
+      for (LinearForm *c : {&c_dev, &c_std})
+      {
+         c->AddBoundaryIntegrator(new BoundaryLFIntegrator(pw));
+         c->AddBoundaryIntegrator(new BoundaryLFIntegrator(gf_coeff));
+      }
+      compare(c_dev, c_std);
+      gf *= 2.0;
+      compare(c_dev, c_std);
+
+      const int btype = gll ? BasisType::GaussLobatto : BasisType::GaussLegendre;
+      L2_FECollection L2(p, dim, btype);
+      FiniteElementSpace L2fes(&mesh, &L2);
+      LinearForm d_dev(&L2fes), d_std(&L2fes);
+      const double sigma = -1.0, kappa = (p+1)*(p+1);
+      for (LinearForm *d : {&d_dev, &d_std})
+      {
+         d->AddDomainIntegrator(new DomainLFIntegrator(f));
+         d->AddBdrFaceIntegrator(new DGDirichletLFIntegrator(f, sigma, kappa));
+         d->AddBdrFaceIntegrator(new DGDirichletLFIntegrator(f, f, sigma, kappa),
+                                 bdr_marker);
+      }
+      compare(d_dev, d_std);
+
+      // The boundary faces are checked again after the mesh is refined
+      mesh.UniformRefinement();
+      H1fes.Update();
+      b_dev.Update();
+      b_std.Update();
+      compare(b_dev, b_std);
+   }
+
    SECTION("SetIntPoint")
    {
       Mesh mesh(mesh_file);
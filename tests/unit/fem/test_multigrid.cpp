@@ -0,0 +1,208 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace multigrid
+{
+
+// Geometric multigrid for the diffusion problem with Chebyshev smoothers and
+// an accurate coarse solver, as in example 26
+class DiffusionMultigrid : public GeometricMultigrid
+{
+   ConstantCoefficient one;
+
+   void AddLevelForm(FiniteElementSpace &fes, Array<int> &ess_bdr)
+   {
+      BilinearForm *form = new BilinearForm(&fes);
+      form->SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      form->AddDomainIntegrator(new DiffusionIntegrator(one));
+      form->Assemble();
+      bfs.Append(form);
+      essentialTrueDofs.Append(new Array<int>());
+      fes.GetEssentialTrueDofs(ess_bdr, *essentialTrueDofs.Last());
+   }
+
+public:
+   DiffusionMultigrid(FiniteElementSpaceHierarchy &fespaces_,
+                      Array<int> &ess_bdr)
+      : GeometricMultigrid(fespaces_), one(1.0)
+   {
+      for (int level = 0; level < fespaces_.GetNumLevels(); level++)
+      {
+         FiniteElementSpace &fes = fespaces_.GetFESpaceAtLevel(level);
+         AddLevelForm(fes, ess_bdr);
+         OperatorPtr opr;
+         opr.SetType(Operator::ANY_TYPE);
+         bfs.Last()->FormSystemMatrix(*essentialTrueDofs.Last(), opr);
+         opr.SetOperatorOwner(false);
+         Solver *solver;
+         if (level == 0)
+         {
+            CGSolver *cg = new CGSolver();
+            cg->SetRelTol(1e-14);
+            cg->SetMaxIter(500);
+            cg->SetOperator(*opr);
+            solver = cg;
+         }
+         else
+         {
+            Vector diag(fes.GetTrueVSize());
+            bfs.Last()->AssembleDiagonal(diag);
+            solver = new OperatorChebyshevSmoother(*opr, diag,
+                                                   *essentialTrueDofs.Last(), 2);
+         }
+         AddLevel(opr.Ptr(), solver, true, true);
+      }
+   }
+};
+
+TEST_CASE("Multigrid cycles", "[Multigrid]")
+{
+   Mesh *mesh = new Mesh(Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL));
+   H1_FECollection fec(2, mesh->Dimension());
+   FiniteElementSpace *coarse_fes = new FiniteElementSpace(mesh, &fec);
+   FiniteElementSpaceHierarchy fespaces(mesh, coarse_fes, true, true);
+   fespaces.AddUniformlyRefinedLevel();
+   fespaces.AddUniformlyRefinedLevel();
+   fespaces.AddUniformlyRefinedLevel();
+
+   Array<int> ess_bdr(mesh->bdr_attributes.Max());
+   ess_bdr = 1;
+   DiffusionMultigrid mg(fespaces, ess_bdr);
+   REQUIRE(mg.NumLevels() == 4);
+
+   FiniteElementSpace &fes = fespaces.GetFinestFESpace();
+   ConstantCoefficient one(1.0);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   GridFunction x(&fes);
+   x = 0.0;
+   OperatorPtr A;
+   Vector B, X;
+   mg.FormFineLinearSystem(x, b, A, X, B);
+
+   // Number of iterations of a Krylov solver preconditioned by the cycle
+   auto solve = [&](IterativeSolver &solver)
+   {
+      X = 0.0;
+      solver.Mult(B, X);
+      REQUIRE(solver.GetConverged());
+      return solver.GetNumIterations();
+   };
+
+   CGSolver cg;
+   FGMRESSolver fgmres;
+   fgmres.SetKDim(50);
+   IterativeSolver *solvers[2] = {&cg, &fgmres};
+   for (IterativeSolver *solver : solvers)
+   {
+      solver->SetRelTol(1e-10);
+      solver->SetMaxIter(100);
+      solver->SetOperator(*A);
+      solver->SetPreconditioner(mg);
+   }
+   mg.SetCycleType(Multigrid::CycleType::VCYCLE, 1, 1);
+   const int v_its = solve(cg);
+   mg.SetCycleType(Multigrid::CycleType::WCYCLE, 1, 1);
+   const int w_its = solve(cg);
+   mg.SetCycleType(Multigrid::CycleType::FCYCLE, 1, 1);
+   const int f_its = solve(cg);
+   REQUIRE(v_its < 20);
+   REQUIRE(w_its <= v_its);
+   REQUIRE(f_its <= v_its);
+
+   // The K-cycle and the adaptive smoothing are nonlinear preconditioners
+   mg.SetCycleType(Multigrid::CycleType::VCYCLE, 1, 1);
+   const int fv_its = solve(fgmres);
+   mg.SetCycleType(Multigrid::CycleType::KCYCLE, 1, 1);
+   const int k_its = solve(fgmres);
+   mg.SetCycleType(Multigrid::CycleType::VCYCLE, 1, 1);
+   mg.SetAdaptiveSmoothing(5, 0.9);
+   const int a_its = solve(fgmres);
+   REQUIRE(k_its <= fv_its);
+   REQUIRE(a_its <= fv_its);
+   mg.SetAdaptiveSmoothing(0);
+
+   // Full multigrid gives a good initial guess
+   mg.FullMultigrid(B, X);
+   Vector r(B.Size());
+   A->Mult(X, r);
+   r -= B;
+   REQUIRE(r.Norml2() < 0.1*B.Norml2());
+}
+
+} // namespace multigrid
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("P-multigrid solver", "[Multigrid][Parallel]")
+{
+   const int order = GENERATE(4, 6);
+   Mesh serial_mesh = Mesh::MakeCartesian2D(6, 6, Element::QUADRILATERAL);
+   ParMesh mesh(MPI_COMM_WORLD, serial_mesh);
+   serial_mesh.Clear();
+
+   H1_FECollection fec(order, mesh.Dimension());
+   ParFiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   Array<int> ess_tdof_list;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   FunctionCoefficient kappa([](const Vector &x) { return 1.0 + x(0)*x(1); });
+   ParBilinearForm a(&fes);
+   a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a.AddDomainIntegrator(new DiffusionIntegrator(kappa));
+   a.Assemble();
+
+   ConstantCoefficient one(1.0);
+   ParLinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+
+   ParGridFunction x(&fes);
+   x = 0.0;
+   OperatorPtr A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+   PMultigridSolver pmg(a, ess_bdr);
+   const Array<int> &orders = pmg.GetOrders();
+   REQUIRE(orders[0] == 1);
+   REQUIRE(orders.Last() == order);
+   REQUIRE(orders.Size() == 3);
+
+   CGSolver cg(MPI_COMM_WORLD);
+   cg.SetRelTol(1e-10);
+   cg.SetMaxIter(100);
+   cg.SetOperator(*A);
+   cg.SetPreconditioner(pmg);
+   cg.Mult(B, X);
+   REQUIRE(cg.GetConverged());
+   const int iterations = cg.GetNumIterations();
+   REQUIRE(iterations < 30);
+
+   // The levels are reused by the next solves, or set up again after Reset()
+   X = 0.0;
+   cg.Mult(B, X);
+   REQUIRE(cg.GetNumIterations() == iterations);
+   pmg.Reset();
+   X = 0.0;
+   cg.Mult(B, X);
+   REQUIRE(cg.GetNumIterations() == iterations);
+}
+
+#endif // MFEM_USE_MPI
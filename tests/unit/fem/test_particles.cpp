@@ -0,0 +1,144 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace particles
+{
+
+// Check that the particles are sorted by element and that their reference
+// coordinates map to their physical coordinates.
+void CheckParticles(ParticleSet &particles)
+{
+   Mesh &mesh = *particles.GetMesh();
+   const int np = particles.GetNP();
+   const int sdim = mesh.SpaceDimension();
+   const Array<int> &elems = particles.GetElements();
+   const Array<int> &offsets = particles.GetElementOffsets();
+   const Vector &x = particles.GetCoordinates();
+   const Vector &ref = particles.GetReferenceCoordinates();
+
+   REQUIRE(offsets.Size() == mesh.GetNE() + 1);
+   REQUIRE(offsets[mesh.GetNE()] == np);
+   Vector phys;
+   IntegrationPoint ip;
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      for (int i = offsets[e]; i < offsets[e+1]; i++)
+      {
+         REQUIRE(elems[i] == e);
+         ip.x = ref(i);
+         ip.y = ref(np + i);
+         mesh.GetElementTransformation(e)->Transform(ip, phys);
+         for (int d = 0; d < sdim; d++)
+         {
+            REQUIRE(phys(d) == MFEM_Approx(x(d*np + i)));
+         }
+      }
+   }
+}
+
+TEST_CASE("Particle set", "[ParticleSet]")
+{
+   auto type = GENERATE(Element::QUADRILATERAL, Element::TRIANGLE);
+   Mesh mesh = Mesh::MakeCartesian2D(8, 6, type);
+
+   const int n = 200;
+   DenseMatrix pts(2, n + 2), mass(1, n + 2);
+   Vector(pts.Data(), 2*(n + 2)).Randomize(3);
+   for (int k = 0; k < n + 2; k++) { mass(0,k) = k; }
+   // two points outside the mesh
+   pts(0,n) = 1.2;
+   pts(1,n+1) = -0.1;
+
+   ParticleSet particles(mesh, 1);
+   REQUIRE(particles.AddParticles(pts, &mass) == 2);
+   REQUIRE(particles.GetNP() == n);
+   CheckParticles(particles);
+
+   // the ids and the fields follow the particles when they are sorted
+   Vector m;
+   particles.GetField(0, m);
+   for (int i = 0; i < n; i++)
+   {
+      REQUIRE(m(i) == particles.GetIds()[i]);
+   }
+
+   SECTION("Relocate")
+   {
+      // move the particles in a rotating flow, a few leave the mesh
+      Vector &x = particles.GetCoordinates();
+      const int np = particles.GetNP();
+      int outside = 0;
+      for (int i = 0; i < np; i++)
+      {
+         const double x0 = x(i) - 0.5, y0 = x(np + i) - 0.5;
+         x(i) = 0.5 + 0.95*x0 - 0.3*y0;
+         x(np + i) = 0.5 + 0.3*x0 + 0.95*y0;
+         const bool in = x(i) >= 0.0 && x(i) <= 1.0 &&
+                         x(np + i) >= 0.0 && x(np + i) <= 1.0;
+         outside += !in;
+      }
+      REQUIRE(particles.Relocate() == outside);
+      REQUIRE(particles.GetNP() == np - outside);
+      CheckParticles(particles);
+      particles.GetField(0, m);
+      for (int i = 0; i < particles.GetNP(); i++)
+      {
+         REQUIRE(m(i) == particles.GetIds()[i]);
+      }
+
+      // relocation after the mesh is refined
+      mesh.UniformRefinement();
+      REQUIRE(particles.Relocate() == 0);
+      REQUIRE(particles.GetNP() == np - outside);
+      CheckParticles(particles);
+   }
+
+   SECTION("Interpolate and deposit")
+   {
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace fes(&mesh, &fec, 2);
+      VectorFunctionCoefficient coeff(2, [](const Vector &x, Vector &v)
+      {
+         v(0) = x(0)*x(0) - x(1);
+         v(1) = 3.0*x(0)*x(1);
+      });
+      GridFunction gf(&fes);
+      gf.ProjectCoefficient(coeff);
+
+      const int np = particles.GetNP();
+      const Vector &x = particles.GetCoordinates();
+      Vector vals;
+      particles.Interpolate(gf, vals);
+      REQUIRE(vals.Size() == 2*np);
+      for (int i = 0; i < np; i++)
+      {
+         REQUIRE(vals(i) == MFEM_Approx(x(i)*x(i) - x(np + i)));
+         REQUIRE(vals(np + i) == MFEM_Approx(3.0*x(i)*x(np + i)));
+      }
+
+      // the basis functions are a partition of unity: the deposited weights
+      // sum to the total weight, and <b, gf> sums gf at the particles
+      Vector w(2*np);
+      w = 1.0;
+      GridFunction b(&fes);
+      b = 0.0;
+      particles.Deposit(w, b);
+      REQUIRE(b.Sum() == MFEM_Approx(2.0*np));
+      REQUIRE((b * gf) == MFEM_Approx(vals.Sum()));
+   }
+}
+
+} // namespace particles
@@ -251,3 +251,81 @@ TEST_CASE("QuadratureInterpolator",
    const auto nz = 3; // number of element in z
    testQuadratureInterpolator(d, p, q, l, nx, ny, nz);
 } // TEST_CASE "QuadratureInterpolator"
+
+TEST_CASE("QuadratureInterpolator MultTranspose",
+          "[QuadratureInterpolator]"
+          "[CUDA]")
+{
+   const auto type = GENERATE(Element::QUADRILATERAL, Element::TRIANGLE,
+                              Element::HEXAHEDRON, Element::TETRAHEDRON);
+   const auto p = GENERATE(1, 2, 3, 4);
+   const auto l = GENERATE(QVectorLayout::byNODES, QVectorLayout::byVDIM);
+   const bool tensor = GENERATE(true, false);
+   const bool vector = GENERATE(true, false);
+   CAPTURE(type, p, l, tensor, vector);
+
+   const bool is_3d = (type == Element::HEXAHEDRON ||
+                       type == Element::TETRAHEDRON);
+   Mesh mesh = is_3d ? Mesh::MakeCartesian3D(2, 2, 2, type) :
+               Mesh::MakeCartesian2D(3, 3, type);
+   mesh.EnsureNodes();
+   // perturb the vertices, so that the physical derivatives are not trivial
+   GridFunction &nodes = *mesh.GetNodes();
+   for (int i = 0; i < nodes.Size(); i++)
+   {
+      nodes(i) += 0.05*sin(7.0*i);
+   }
+   const int dim = mesh.Dimension();
+
+   H1_FECollection fec(p, dim);
+   FiniteElementSpace fes(&mesh, &fec, vector ? dim : 1);
+   const int vdim = fes.GetVDim();
+   const int ne = mesh.GetNE();
+
+   const Geometry::Type geom = mesh.GetElementBaseGeometry(0);
+   const IntegrationRule &ir = IntRules.Get(geom, 2*p + 1);
+   const int nq = ir.GetNPoints();
+
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   qi->SetOutputLayout(l);
+   qi->DisableTensorProducts(!tensor);
+   const ElementDofOrdering ordering = (tensor && UsesTensorBasis(fes)) ?
+                                       ElementDofOrdering::LEXICOGRAPHIC :
+                                       ElementDofOrdering::NATIVE;
+   const Operator *R = fes.GetElementRestriction(ordering);
+
+   Vector x(R->Height()), ax(R->Height()), bx(R->Height());
+   Vector val(nq*vdim*ne), der(nq*vdim*dim*ne);
+   Vector qv(val.Size()), qd(der.Size()), empty;
+   x.Randomize(1);
+   qv.Randomize(2);
+   qd.Randomize(3);
+
+   using QI = QuadratureInterpolator;
+   // Check <Mult(x), (qv,qd)> == <x, MultTranspose(qv,qd)>
+   for (unsigned flags : { unsigned(QI::VALUES), unsigned(QI::DERIVATIVES),
+                           unsigned(QI::PHYSICAL_DERIVATIVES),
+                           unsigned(QI::VALUES | QI::DERIVATIVES)
+                         })
+   {
+      CAPTURE(flags);
+      qi->Mult(x, flags, val, der, empty);
+      double lhs = 0.0;
+      if (flags & QI::VALUES) { lhs += val*qv; }
+      if (flags & (QI::DERIVATIVES | QI::PHYSICAL_DERIVATIVES))
+      {
+         lhs += der*qd;
+      }
+      qi->MultTranspose(flags, qv, qd, ax);
+      const double rhs = x*ax;
+      REQUIRE(rhs == MFEM_Approx(lhs, 1e-10*std::abs(lhs)));
+   }
+
+   // The combined transpose is the sum of the separate ones
+   qi->MultTranspose(QI::VALUES, qv, empty, ax);
+   qi->MultTranspose(QI::DERIVATIVES, empty, qd, bx);
+   ax += bx;
+   qi->MultTranspose(QI::VALUES | QI::DERIVATIVES, qv, qd, bx);
+   bx -= ax;
+   REQUIRE(bx.Normlinf() == MFEM_Approx(0.0, 1e-12*ax.Normlinf()));
+}
@@ -12,6 +12,8 @@
 #include "unit_tests.hpp"
 #include "mfem.hpp"
 
+#include <memory>
+
 using namespace mfem;
 
 int RandomPRefinement(FiniteElementSpace & fes)
@@ -75,7 +77,7 @@ void vectorcoeff(const Vector& x, Vector& y)
    }
 }
 
-enum class VecSpace { H1, VectorH1, ND, RT };
+enum class VecSpace { H1, VectorH1, ND, RT, L2 };
 
 std::string VecSpaceName(VecSpace vectorspace)
 {
@@ -85,6 +87,7 @@ std::string VecSpaceName(VecSpace vectorspace)
       case VecSpace::VectorH1: return "Vector H1";
       case VecSpace::ND: return "Nedelec";
       case VecSpace::RT: return "Raviart-Thomas";
+      case VecSpace::L2: return "L2";
    }
    return "";
 }
@@ -92,7 +95,7 @@ std::string VecSpaceName(VecSpace vectorspace)
 TEST_CASE("Transfer", "[Transfer]")
 {
    auto vectorspace = GENERATE(VecSpace::H1, VecSpace::VectorH1, VecSpace::ND,
-                               VecSpace::RT);
+                               VecSpace::RT, VecSpace::L2);
    auto geometric = GENERATE(true, false);
    auto simplex = GENERATE(true, false);
    dimension = GENERATE(2, 3);
@@ -136,6 +139,10 @@ TEST_CASE("Transfer", "[Transfer]")
          c_fec = new RT_FECollection(order, dimension);
          f_fec = geometric ? c_fec : new RT_FECollection(fineOrder, dimension);
          break;
+      case VecSpace::L2:
+         c_fec = new L2_FECollection(order, dimension);
+         f_fec = geometric ? c_fec : new L2_FECollection(fineOrder, dimension);
+         break;
    }
 
    Mesh fineMesh(mesh);
@@ -173,7 +180,7 @@ TEST_CASE("Transfer", "[Transfer]")
    GridFunction Y_std(f_fespace);
    GridFunction Y_test(f_fespace);
    coeff_order = 1;
-   if (vectorspace == VecSpace::H1)
+   if (vectorspace == VecSpace::H1 || vectorspace == VecSpace::L2)
    {
       FunctionCoefficient funcCoeff(&coeff);
       X.ProjectCoefficient(funcCoeff);
@@ -215,6 +222,93 @@ TEST_CASE("Transfer", "[Transfer]")
    delete c_fec;
 }
 
+TEST_CASE("Tensor Product Transfer", "[Transfer]")
+{
+   auto vectorspace = GENERATE(VecSpace::H1, VecSpace::ND, VecSpace::RT,
+                               VecSpace::L2);
+   dimension = GENERATE(2, 3);
+   const int order = 2;
+   CAPTURE(VecSpaceName(vectorspace), dimension);
+
+   Mesh mesh = (dimension == 2) ?
+               Mesh::MakeCartesian2D(3, 2, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(2, 2, 1, Element::HEXAHEDRON);
+   std::unique_ptr<FiniteElementCollection> c_fec, f_fec;
+   switch (vectorspace)
+   {
+      case VecSpace::H1:
+      case VecSpace::VectorH1:
+         c_fec.reset(new H1_FECollection(order, dimension));
+         f_fec.reset(new H1_FECollection(order + 2, dimension));
+         break;
+      case VecSpace::ND:
+         c_fec.reset(new ND_FECollection(order, dimension));
+         f_fec.reset(new ND_FECollection(order + 2, dimension));
+         break;
+      case VecSpace::RT:
+         c_fec.reset(new RT_FECollection(order, dimension));
+         f_fec.reset(new RT_FECollection(order + 2, dimension));
+         break;
+      case VecSpace::L2:
+         c_fec.reset(new L2_FECollection(order, dimension,
+                                         BasisType::GaussLobatto,
+                                         FiniteElement::INTEGRAL));
+         f_fec.reset(new L2_FECollection(order + 2, dimension,
+                                         BasisType::GaussLegendre,
+                                         FiniteElement::INTEGRAL));
+         break;
+   }
+
+   // Random coarse function and fine dual vector
+   auto check = [](const Operator &reference, const Operator &test)
+   {
+      Vector x(test.Width()), y(test.Height()), y_ref(test.Height());
+      x.Randomize(1);
+      reference.Mult(x, y_ref);
+      test.Mult(x, y);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() < 1e-12 * y_ref.Normlinf());
+
+      Vector z(test.Height()), w(test.Width()), w_ref(test.Width());
+      z.Randomize(2);
+      reference.MultTranspose(z, w_ref);
+      test.MultTranspose(z, w);
+      w -= w_ref;
+      REQUIRE(w.Normlinf() < 1e-12 * w_ref.Normlinf());
+   };
+
+   SECTION("p-refinement")
+   {
+      FiniteElementSpace c_fes(&mesh, c_fec.get());
+      FiniteElementSpace f_fes(&mesh, f_fec.get());
+      REQUIRE(TensorProductPRefinementTransferOperator::Supports(c_fes, f_fes));
+      TensorProductPRefinementTransferOperator test(c_fes, f_fes);
+      PRefinementTransferOperator reference(c_fes, f_fes);
+      check(reference, test);
+   }
+
+   SECTION("h-refinement")
+   {
+      // Anisotropic and nonconforming refinement
+      mesh.EnsureNCMesh();
+      Mesh fine_mesh(mesh);
+      Array<Refinement> refs;
+      refs.Append(Refinement(0, Refinement::X));
+      refs.Append(Refinement(1, Refinement::Y));
+      refs.Append(Refinement(2, (dimension == 2) ? Refinement::XY :
+                             Refinement::XYZ));
+      fine_mesh.GeneralRefinement(refs);
+
+      FiniteElementSpace c_fes(&mesh, c_fec.get());
+      FiniteElementSpace f_fes(&fine_mesh, c_fec.get());
+      REQUIRE(TensorProductHRefinementTransferOperator::Supports(c_fes, f_fes));
+      TensorProductHRefinementTransferOperator test(c_fes, f_fes);
+      OperatorPtr reference(Operator::ANY_TYPE);
+      f_fes.GetTransferOperator(c_fes, reference);
+      check(*reference, test);
+   }
+}
+
 TEST_CASE("Variable Order Transfer", "[Transfer][VariableOrder]")
 {
    auto vectorspace = GENERATE(VecSpace::H1, VecSpace::VectorH1, VecSpace::ND,
@@ -256,6 +350,10 @@ TEST_CASE("Variable Order Transfer", "[Transfer][VariableOrder]")
          c_fec = new RT_FECollection(order, dimension);
          f_fec = new RT_FECollection(order, dimension);
          break;
+      case VecSpace::L2:
+         c_fec = new L2_FECollection(order, dimension);
+         f_fec = new L2_FECollection(order, dimension);
+         break;
    }
 
    mesh.EnsureNCMesh();
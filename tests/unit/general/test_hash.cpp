@@ -0,0 +1,110 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+TEST_CASE("HashTable insert/find/delete", "[HashTable]")
+{
+   // small initial size to exercise rehashing
+   HashTable<Hashed2> ht(64, 16);
+
+   const int n = 100;
+   for (int i = 0; i < n; i++)
+   {
+      for (int j = i+1; j < n; j++)
+      {
+         ht.GetId(j, i);
+      }
+   }
+   REQUIRE(ht.Size() == n*(n-1)/2);
+
+   // every pair is found, with sorted keys, regardless of the order
+   for (int i = 0; i < n; i++)
+   {
+      for (int j = i+1; j < n; j++)
+      {
+         const int id = ht.FindId(i, j);
+         REQUIRE(id >= 0);
+         REQUIRE(ht.FindId(j, i) == id);
+         REQUIRE(ht[id].p1 == i);
+         REQUIRE(ht[id].p2 == j);
+      }
+   }
+   REQUIRE(ht.FindId(0, n) == -1);
+
+   // delete every other item, the rest must still be found
+   int ndel = 0;
+   for (int i = 0; i < n; i++)
+   {
+      for (int j = i+1; j < n; j++)
+      {
+         if ((i + j) % 2) { ht.Delete(ht.FindId(i, j)); ndel++; }
+      }
+   }
+   REQUIRE(ht.Size() == n*(n-1)/2 - ndel);
+   REQUIRE(ht.NumFreeIds() == ndel);
+   for (int i = 0; i < n; i++)
+   {
+      for (int j = i+1; j < n; j++)
+      {
+         const int id = ht.FindId(i, j);
+         REQUIRE(((i + j) % 2 ? (id == -1) : (id >= 0 && ht.IdExists(id))));
+      }
+   }
+
+   int count = 0;
+   for (auto it = ht.begin(); it != ht.end(); ++it) { count++; }
+   REQUIRE(count == ht.Size());
+
+   // reparent an item and re-insert deleted ones (reusing the free ids)
+   const int id = ht.FindId(0, 2);
+   ht.Reparent(id, n+1, n);
+   REQUIRE(ht.FindId(0, 2) == -1);
+   REQUIRE(ht.FindId(n, n+1) == id);
+
+   const int new_id = ht.GetId(0, 1);
+   REQUIRE(new_id < ht.NumIds());
+   REQUIRE(ht.NumFreeIds() == ndel - 1);
+   REQUIRE(ht.FindId(1, 0) == new_id);
+}
+
+TEST_CASE("HashTable with four indices", "[HashTable]")
+{
+   HashTable<Hashed4> ht(64, 16);
+
+   const int n = 20;
+   for (int i = 0; i < n; i++)
+   {
+      ht.GetId(i, i+1, i+2, i+3); // quad
+      ht.GetId(n+i, i, i+1);      // triangle
+   }
+   REQUIRE(ht.Size() == 2*n);
+
+   for (int i = 0; i < n; i++)
+   {
+      REQUIRE(ht.FindId(i+3, i+2, i+1, i) >= 0);
+      REQUIRE(ht.FindId(i, i+1, n+i) >= 0);
+      REQUIRE(ht.FindId(i, i+1, i+3) == -1);
+   }
+
+   for (int i = 0; i < n; i += 2)
+   {
+      ht.Delete(ht.FindId(i, i+1, i+2, i+3));
+   }
+   for (int i = 0; i < n; i++)
+   {
+      REQUIRE((ht.FindId(i, i+1, i+2, i+3) >= 0) == (i % 2 == 1));
+      REQUIRE(ht.FindId(i+1, n+i, i) >= 0);
+   }
+}
@@ -12,6 +12,9 @@
 #include "mfem.hpp"
 #include "unit_tests.hpp"
 
+#include <cstdint>
+#include <sstream>
+
 using namespace mfem;
 
 TEST_CASE("MemoryManager/Scopes",
@@ -67,3 +70,155 @@ TEST_CASE("MemoryManager/Scopes",
       REQUIRE((x_data == x.HostRead()));
    }
 }
+
+TEST_CASE("MemoryUsage", "[MemoryManager]")
+{
+   const bool enabled = MemoryUsage::IsEnabled();
+   MemoryUsage::Enable();
+   MemoryUsage::ResetPeak();
+   const std::size_t current = MemoryUsage::GetCurrent();
+   const std::size_t host = MemoryUsage::GetCurrent(MemoryType::HOST);
+   const std::size_t host64 = MemoryUsage::GetCurrent(MemoryType::HOST_64);
+
+   {
+      MemoryUsageTag tag("test tag");
+      Vector x(1000);
+      REQUIRE(MemoryUsage::GetCurrent("test tag") == 8000);
+      REQUIRE(MemoryUsage::GetCurrent(MemoryType::HOST) == host + 8000);
+      {
+         // the allocations are charged to the innermost tag
+         MemoryUsageTag inner("inner tag");
+         Vector y(100, MemoryType::HOST_64);
+         REQUIRE(MemoryUsage::GetCurrent("inner tag") == 800);
+         REQUIRE(MemoryUsage::GetCurrent(MemoryType::HOST_64) == host64 + 800);
+         REQUIRE(MemoryUsage::GetCurrent("test tag") == 8000);
+      }
+      REQUIRE(MemoryUsage::GetCurrent() == current + 8000);
+   }
+   REQUIRE(MemoryUsage::GetCurrent("test tag") == 0);
+   REQUIRE(MemoryUsage::GetPeak("test tag") == 8000);
+   REQUIRE(MemoryUsage::GetPeak("inner tag") == 800);
+   REQUIRE(MemoryUsage::GetCurrent() == current);
+   REQUIRE(MemoryUsage::GetPeak() >= current + 8800);
+
+   std::ostringstream report;
+   MemoryUsage::PrintReport(report);
+   REQUIRE(report.str().find("\ntest tag ") != std::string::npos);
+   REQUIRE(report.str().find("\nhost-64 ") != std::string::npos);
+
+   SECTION("Library tags")
+   {
+      Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+      H1_FECollection fec(2, 3);
+      FiniteElementSpace fes(&mesh, &fec);
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.Assemble();
+      REQUIRE(MemoryUsage::GetCurrent("Mesh") > 0);
+      REQUIRE(MemoryUsage::GetCurrent("FiniteElementSpace") > 0);
+      // the partial assembly data: 6 entries per quadrature point
+      REQUIRE(MemoryUsage::GetCurrent("BilinearForm") >=
+              6*sizeof(double)*8*27);
+   }
+
+   SECTION("Disabled")
+   {
+      Vector x(10);
+      MemoryUsage::Enable(false);
+      REQUIRE(MemoryUsage::BeginTag("disabled") == -1);
+      Vector y(10);
+      REQUIRE(MemoryUsage::GetCurrent() == current + 80);
+      // the memory recorded before is still released
+      x.Destroy();
+      REQUIRE(MemoryUsage::GetCurrent() == current);
+      MemoryUsage::Enable();
+   }
+
+   MemoryUsage::ResetPeak();
+   MemoryUsage::Enable(enabled);
+}
+
+TEST_CASE("MemoryPool", "[MemoryManager]")
+{
+   const MemoryType mt = MemoryType::HOST_POOL;
+   REQUIRE(MemoryManager::GetDualMemoryType(mt) == MemoryType::DEVICE_POOL);
+   const MemoryPool::Statistics s0 = MemoryPool::GetStatistics(mt);
+
+   const double *x_data;
+   {
+      Vector x(1000, mt);
+      x = 1.0;
+      x_data = x.GetData();
+      // the host blocks are aligned at 64 bytes
+      REQUIRE(reinterpret_cast<std::uintptr_t>(x_data) % 64 == 0);
+   }
+   {
+      // the freed block is reused from the thread cache
+      Vector y(1000, mt);
+      REQUIRE(y.GetData() == x_data);
+      const MemoryPool::Statistics s = MemoryPool::GetStatistics(mt);
+      REQUIRE(s.allocs == s0.allocs + 2);
+      REQUIRE(s.thread_hits == s0.thread_hits + 1);
+      REQUIRE(s.deallocs == s0.deallocs + 1);
+      // 8000 bytes are rounded up to the size class of 8192 bytes
+      REQUIRE(s.bytes_used == s0.bytes_used + 8192);
+   }
+   {
+      // the blocks larger than 1 MiB are not cached by the threads
+      Vector z(200000, mt);
+      const double *z_data = z.GetData();
+      z.Destroy();
+      z.SetSize(200000, mt);
+      REQUIRE(z.GetData() == z_data);
+      const MemoryPool::Statistics s = MemoryPool::GetStatistics(mt);
+      REQUIRE(s.pool_hits == s0.pool_hits + 1);
+   }
+
+   SECTION("Failed allocation")
+   {
+      // the cached blocks are released before the allocation is tried again
+      void *ptr = MemoryPool::Allocate(mt, 1000);
+      MemoryPool::Deallocate(mt, ptr, 1000);
+      const MemoryPool::Statistics s1 = MemoryPool::GetStatistics(mt);
+      REQUIRE(s1.bytes_reserved > s1.bytes_used);
+      const std::size_t too_large = std::size_t(1) << 58;
+      REQUIRE_THROWS_AS(MemoryPool::Allocate(mt, too_large), std::bad_alloc);
+      const MemoryPool::Statistics s2 = MemoryPool::GetStatistics(mt);
+      REQUIRE(s2.bytes_reserved == s2.bytes_used);
+      REQUIRE(s2.bytes_used == s1.bytes_used);
+   }
+
+   MemoryPool::Release(mt);
+   const MemoryPool::Statistics s = MemoryPool::GetStatistics(mt);
+   REQUIRE(s.bytes_used == s0.bytes_used);
+   REQUIRE(s.bytes_reserved == s.bytes_used);
+   REQUIRE(s.peak_reserved >= s0.bytes_used + 8192 + 1600000);
+
+   std::ostringstream stats;
+   MemoryPool::PrintStatistics(mt, stats);
+   REQUIRE(stats.str().find("host-pool") != std::string::npos);
+}
+
+TEST_CASE("MemoryManager/LargeHostMemoryTypes", "[MemoryManager]")
+{
+   const MemoryType types[3] = { MemoryType::HOST_HUGE, MemoryType::HOST_NUMA,
+                                 MemoryType::HOST_FIRST_TOUCH
+                               };
+   for (const MemoryType mt : types)
+   {
+      // the large arrays are mapped, the small ones are aligned at 64 bytes
+      const int n = 300000;
+      Vector x(n, mt), y(10, mt);
+      x = 1.0;
+      y = 2.0;
+      REQUIRE(x.Sum() == n);
+      REQUIRE(y.Sum() == 20.0);
+      const std::uintptr_t x_addr =
+         reinterpret_cast<std::uintptr_t>(x.GetData());
+      REQUIRE(x_addr % (mt == MemoryType::HOST_HUGE ? 2 << 20 : 4096) == 0);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(y.GetData()) % 64 == 0);
+      REQUIRE(x.GetMemory().GetMemoryType() == mt);
+      REQUIRE(MemoryClassContainsType(MemoryClass::HOST, mt));
+   }
+}
@@ -0,0 +1,204 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+#include <sstream>
+#include <thread>
+
+using namespace mfem;
+
+static void ProfiledFunction()
+{
+   MFEM_PERF_FUNCTION;
+   MFEM_PERF_BEGIN("inner");
+   MFEM_PERF_END("inner");
+}
+
+TEST_CASE("Profiler", "[Profiler]")
+{
+   const bool enabled = Profiler::IsEnabled();
+   Profiler::Enable();
+   Profiler::Reset();
+
+   const int id = Profiler::Begin("outer region");
+   for (int i = 0; i < 3; i++) { ProfiledFunction(); }
+   {
+      MFEM_PERF_SCOPE(std::string("scope"));
+   }
+   Profiler::End(id);
+   // unbalanced calls are ignored
+   Profiler::End("outer region");
+   Profiler::End(id);
+
+   // regions are not recorded when the profiler is disabled
+   Profiler::Enable(false);
+   REQUIRE(Profiler::Begin("disabled") == -1);
+   Profiler::Enable();
+
+   // the regions are identified by the keys of their names
+   REQUIRE(Profiler::RegisterRegion("outer region") ==
+           Profiler::RegisterRegion(std::string("outer region").c_str()));
+   REQUIRE(Profiler::RegisterRegion("inner") !=
+           Profiler::RegisterRegion("outer region"));
+
+   std::ostringstream json;
+   Profiler::PrintJSON(json);
+   const std::string s = json.str();
+   // the function signature is shortened
+   REQUIRE(s.find("\"name\": \"ProfiledFunction\"") != std::string::npos);
+   REQUIRE(s.find("\"name\": \"inner\"") != std::string::npos);
+   REQUIRE(s.find("\"calls\": 3") != std::string::npos);
+   REQUIRE(s.find("\"name\": \"scope\"") != std::string::npos);
+   REQUIRE(s.find("disabled") == std::string::npos);
+   // nesting: inner is a child of ProfiledFunction, a child of outer region
+   const size_t outer = s.find("outer region");
+   const size_t func = s.find("ProfiledFunction");
+   const size_t inner = s.find("\"inner\"");
+   REQUIRE(outer < func);
+   REQUIRE(func < inner);
+   REQUIRE(s.find("\"children\": [\n", outer) < func);
+
+   std::ostringstream text;
+   Profiler::PrintReport(text);
+   REQUIRE(text.str().find("\n  ProfiledFunction ") != std::string::npos);
+   REQUIRE(text.str().find("\n    inner ") != std::string::npos);
+
+   // the regions without calls are not reported after a reset
+   Profiler::Reset();
+   std::ostringstream empty;
+   Profiler::PrintJSON(empty);
+   REQUIRE(empty.str().find("outer region") == std::string::npos);
+
+   SECTION("Threads")
+   {
+      // only the thread that enabled the profiler records regions
+      const int id = Profiler::Begin("main thread");
+      int thread_id = 0;
+      std::thread thread([&thread_id]()
+      {
+         thread_id = Profiler::Begin("other thread");
+         MFEM_PERF_WORK(1.0, 1.0);
+         Profiler::End(thread_id);
+      });
+      thread.join();
+      Profiler::End(id);
+      REQUIRE(id > 0);
+      REQUIRE(thread_id == -1);
+
+      std::ostringstream report;
+      Profiler::PrintJSON(report);
+      REQUIRE(report.str().find("main thread") != std::string::npos);
+      REQUIRE(report.str().find("other thread") == std::string::npos);
+      REQUIRE(report.str().find("\"flops\"") == std::string::npos);
+   }
+
+   SECTION("Fine-grained regions")
+   {
+      // the fine-grained regions and their work are only recorded with
+      // EnableDetails()
+      REQUIRE(!Profiler::DetailsEnabled());
+      const int id = Profiler::Begin("coarse");
+      {
+         MFEM_PERF_DETAIL_SCOPE("fine");
+         MFEM_PERF_WORK(1.0, 1.0);
+      }
+      Profiler::EnableDetails();
+      {
+         MFEM_PERF_DETAIL_SCOPE("recorded fine");
+      }
+      Profiler::EnableDetails(false);
+      Profiler::End(id);
+
+      std::ostringstream report;
+      Profiler::PrintJSON(report);
+      REQUIRE(report.str().find("\"coarse\"") != std::string::npos);
+      REQUIRE(report.str().find("\"fine\"") == std::string::npos);
+      REQUIRE(report.str().find("recorded fine") != std::string::npos);
+      REQUIRE(report.str().find("\"flops\"") == std::string::npos);
+   }
+
+   SECTION("Instrumented library")
+   {
+      Profiler::EnableDetails();
+      Mesh mesh = Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL);
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new MassIntegrator);
+      a.Assemble();
+      a.Finalize();
+      Vector b(fes.GetVSize()), x(fes.GetVSize());
+      b = 1.0;
+      x = 0.0;
+      CGSolver cg;
+      cg.SetOperator(a.SpMat());
+      cg.SetRelTol(1e-12);
+      cg.SetMaxIter(200);
+      cg.Mult(b, x);
+
+      std::ostringstream report;
+      Profiler::PrintJSON(report);
+      const std::string r = report.str();
+      REQUIRE(r.find("\"name\": \"BilinearForm::Assemble\"") !=
+              std::string::npos);
+      const size_t solve = r.find("\"name\": \"CGSolver::Mult\"");
+      REQUIRE(solve != std::string::npos);
+      std::ostringstream calls;
+      calls << "\"name\": \"CGSolver::Iteration\",\n"
+            << std::string(10, ' ') << "\"calls\": "
+            << cg.GetNumIterations();
+      REQUIRE(r.find(calls.str(), solve) != std::string::npos);
+      Profiler::EnableDetails(false);
+   }
+
+   SECTION("Kernel work")
+   {
+      {
+         MFEM_PERF_SCOPE("kernel");
+         MFEM_PERF_WORK(2e3, 1e3);
+         MFEM_PERF_WORK(2e3, 1e3);
+      }
+      std::ostringstream report;
+      Profiler::PrintJSON(report);
+      REQUIRE(report.str().find("\"flops\": 4000") != std::string::npos);
+      REQUIRE(report.str().find("\"bytes\": 2000") != std::string::npos);
+
+      // the partial assembly kernels register their work
+      Profiler::EnableDetails();
+      Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+      H1_FECollection fec(2, 3);
+      FiniteElementSpace fes(&mesh, &fec);
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(new MassIntegrator);
+      a.Assemble();
+      Vector x(fes.GetVSize()), y(fes.GetVSize());
+      x = 1.0;
+      a.Mult(x, y);
+      Profiler::EnableDetails(false);
+
+      std::ostringstream roofline;
+      Profiler::PrintRoofline(roofline, 100.0, 10.0);
+      const std::string r = roofline.str();
+      REQUIRE(r.find("\n  PAMassApply3D ") != std::string::npos);
+      REQUIRE(r.find("\nkernel ") != std::string::npos);
+      REQUIRE(r.find("Flop/B") != std::string::npos);
+      // 2 flops per byte is below the ridge point of 10 flops per byte
+      REQUIRE(r.find("memory") != std::string::npos);
+      // the regions without work are not reported
+      REQUIRE(r.find("Profiled") == std::string::npos);
+   }
+
+   Profiler::Reset();
+   Profiler::Enable(enabled);
+}
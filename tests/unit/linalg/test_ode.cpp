@@ -252,6 +252,23 @@ TEST_CASE("First order ODE methods",
       REQUIRE(conv_rate + tol > 4.0);
    }
 
+   // Embedded pairs with fixed steps
+   SECTION("EmbeddedESDIRK32Solver")
+   {
+      std::cout <<"\nTesting EmbeddedESDIRK32Solver" << std::endl;
+      AdaptiveODESolver *ode_solver = new EmbeddedESDIRK32Solver;
+      ode_solver->EnableStepControl(false);
+      REQUIRE(check.order(ode_solver) + tol > 3.0);
+   }
+
+   SECTION("EmbeddedESDIRK43Solver")
+   {
+      std::cout <<"\nTesting EmbeddedESDIRK43Solver" << std::endl;
+      AdaptiveODESolver *ode_solver = new EmbeddedESDIRK43Solver;
+      ode_solver->EnableStepControl(false);
+      REQUIRE(check.order(ode_solver) + tol > 4.0);
+   }
+
    SECTION("TrapezoidalRuleSolver")
    {
       std::cout <<"\nTesting TrapezoidalRuleSolver" << std::endl;
@@ -270,6 +287,52 @@ TEST_CASE("First order ODE methods",
       REQUIRE(check.order(new ESDIRK33Solver) + tol > 3.0 );
    }
 
+   SECTION("EmbeddedRK32Solver")
+   {
+      std::cout <<"\nTesting EmbeddedRK32Solver" << std::endl;
+      AdaptiveODESolver *ode_solver = new EmbeddedRK32Solver;
+      ode_solver->EnableStepControl(false);
+      REQUIRE(check.order(ode_solver) + tol > 3.0);
+   }
+
+   SECTION("EmbeddedRK54Solver")
+   {
+      std::cout <<"\nTesting EmbeddedRK54Solver" << std::endl;
+      AdaptiveODESolver *ode_solver = new EmbeddedRK54Solver;
+      ode_solver->EnableStepControl(false);
+      REQUIRE(check.order(ode_solver) + tol > 5.0);
+   }
+
+   SECTION("EmbeddedRK65Solver")
+   {
+      std::cout <<"\nTesting EmbeddedRK65Solver" << std::endl;
+      AdaptiveODESolver *ode_solver = new EmbeddedRK65Solver;
+      ode_solver->EnableStepControl(false);
+      REQUIRE(check.order(ode_solver) + tol > 6.0);
+   }
+
+   // Low-storage methods
+   SECTION("LSRK3Solver")
+   {
+      std::cout <<"\nTesting LSRK3Solver" << std::endl;
+      double conv_rate = check.order(new LSRK3Solver);
+      REQUIRE(conv_rate + tol > 3.0);
+   }
+
+   SECTION("LSRK54Solver")
+   {
+      std::cout <<"\nTesting LSRK54Solver" << std::endl;
+      double conv_rate = check.order(new LSRK54Solver);
+      REQUIRE(conv_rate + tol > 4.0);
+   }
+
+   SECTION("SSPRK104Solver")
+   {
+      std::cout <<"\nTesting SSPRK104Solver" << std::endl;
+      double conv_rate = check.order(new SSPRK104Solver);
+      REQUIRE(conv_rate + tol > 4.0);
+   }
+
    // Generalized-alpha
    SECTION("GeneralizedAlphaSolver(1.0)")
    {
@@ -413,3 +476,300 @@ TEST_CASE("First order ODE methods",
       REQUIRE(conv_rate + tol > 5.0);
    }
 }
+
+TEST_CASE("Adaptive ODE methods",
+          "[ODE1]")
+{
+   // du/dt = A u with a decaying mode of rate lambda and an oscillating mode,
+   // u(t) = (exp(-lambda t), cos(t), -sin(t)).
+   class ODE : public TimeDependentOperator
+   {
+   protected:
+      DenseMatrix A, T;
+      Vector r;
+   public:
+      ODE(double lambda) : TimeDependentOperator(3, 0.0), A(3), T(3), r(3)
+      {
+         A = 0.0;
+         A(0,0) = -lambda;
+         A(1,2) = 1.0;
+         A(2,1) = -1.0;
+      }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         A.Mult(u, dudt);
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u,
+                                 Vector &dudt)
+      {
+         // (I - dt A) dudt = A u
+         A.Mult(u, r);
+         T = A;
+         T *= -dt;
+         for (int i = 0; i < 3; i++) { T(i,i) += 1.0; }
+         T.Invert();
+         T.Mult(r, dudt);
+      }
+   };
+
+   auto type = GENERATE(0, 1, 2, 3, 4);
+   const bool implicit = (type >= 3);
+   // the implicit methods are tested with a stiff decaying mode
+   const double lambda = implicit ? 1e4 : 10.0;
+   ODE oper(lambda);
+   const double tf = 2.0;
+
+   int steps[2];
+   double error[2];
+   const double rtol[2] = { 1e-4, 1e-7 };
+   for (int k = 0; k < 2; k++)
+   {
+      AdaptiveODESolver *ode_solver = NULL;
+      switch (type)
+      {
+         case 0: ode_solver = new EmbeddedRK32Solver; break;
+         case 1: ode_solver = new EmbeddedRK54Solver; break;
+         case 2: ode_solver = new EmbeddedRK65Solver; break;
+         case 3: ode_solver = new EmbeddedESDIRK32Solver; break;
+         case 4: ode_solver = new EmbeddedESDIRK43Solver; break;
+      }
+      ode_solver->SetTolerances(rtol[k], rtol[k]);
+      ode_solver->Init(oper);
+
+      Vector u(3);
+      u(0) = 1.0; u(1) = 1.0; u(2) = 0.0;
+      double t = 0.0, dt = 1e-3;
+      ode_solver->Run(u, t, dt, tf);
+      REQUIRE(t == MFEM_Approx(tf));
+
+      u(0) -= exp(-lambda*tf);
+      u(1) -= cos(tf);
+      u(2) += sin(tf);
+      error[k] = u.Normlinf();
+      steps[k] = ode_solver->GetNumSteps();
+      REQUIRE(error[k] < 100.0*rtol[k]);
+      delete ode_solver;
+   }
+   REQUIRE(error[1] < error[0]);
+   REQUIRE(steps[1] > steps[0]);
+   // the step size is not limited by the stiff mode
+   if (implicit) { REQUIRE(steps[0] < 100); }
+}
+
+TEST_CASE("Adaptive ODE methods restarts and limits",
+          "[ODE1]")
+{
+   // du/dt = -u + sin(t)
+   class ODE : public TimeDependentOperator
+   {
+   public:
+      ODE() : TimeDependentOperator(2, 0.0) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         for (int i = 0; i < 2; i++) { dudt(i) = -u(i) + sin(GetTime()); }
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u,
+                                 Vector &dudt)
+      {
+         for (int i = 0; i < 2; i++)
+         {
+            dudt(i) = (-u(i) + sin(GetTime())) / (1.0 + dt);
+         }
+      }
+   };
+   ODE oper;
+
+   auto type = GENERATE(0, 1);
+   AdaptiveODESolver *ode_solver = NULL;
+   if (type == 0) { ode_solver = new EmbeddedRK54Solver; }
+   else { ode_solver = new EmbeddedESDIRK32Solver; }
+   ode_solver->Init(oper);
+
+   SECTION("Restart from a different solution")
+   {
+      // the last stage of a step is not reused when the next step starts
+      // from another solution
+      ode_solver->EnableStepControl(false);
+      Vector u0(2), u(2), v(2);
+      u0 = 1.0;
+      double t = 0.0, dt = 0.1;
+      u = u0;
+      ode_solver->Step(u, t, dt);
+      u = u0;
+      ode_solver->Step(u, t, dt);
+
+      // the same step without a previous step
+      ode_solver->Init(oper);
+      ode_solver->EnableStepControl(false);
+      double tv = dt;
+      v = u0;
+      ode_solver->Step(v, tv, dt);
+      REQUIRE(t == tv);
+      for (int i = 0; i < 2; i++) { REQUIRE(u(i) == v(i)); }
+   }
+
+   SECTION("Last step shorter than the minimal step size")
+   {
+      ode_solver->SetStepSizeLimits(0.3, 1.0);
+      Vector u(2);
+      u = 1.0;
+      const double tf = 1.0;
+      double t = 0.0, dt = 0.3;
+      ode_solver->Run(u, t, dt, tf);
+      REQUIRE(t == tf);
+      REQUIRE(dt < 0.3);
+   }
+
+   delete ode_solver;
+}
+
+TEST_CASE("Explicit RK method with many stages",
+          "[ODE1]")
+{
+   // 20 stages, all evaluated at the initial solution: forward Euler
+   const int s = 20;
+   Array<double> a(s*(s-1)/2), b(s), c(s-1);
+   a = 0.0;
+   b = 1.0/s;
+   c = 0.0;
+   ExplicitRKSolver rk(s, a.GetData(), b.GetData(), c.GetData());
+   ForwardEulerSolver fe;
+
+   class ODE : public TimeDependentOperator
+   {
+   public:
+      ODE() : TimeDependentOperator(2, 0.0) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         dudt(0) = -u(0) + 2.0*u(1);
+         dudt(1) = -2.0*u(0) - u(1);
+      }
+   };
+   ODE oper;
+   rk.Init(oper);
+   fe.Init(oper);
+
+   Vector u(2), v(2);
+   u = 1.0;
+   v = 1.0;
+   double t = 0.0, tv = 0.0, dt = 0.1;
+   rk.Step(u, t, dt);
+   fe.Step(v, tv, dt);
+   REQUIRE(t == MFEM_Approx(tv));
+   for (int i = 0; i < 2; i++) { REQUIRE(u(i) == MFEM_Approx(v(i))); }
+}
+
+TEST_CASE("IMEX ODE methods",
+          "[ODE1]")
+{
+   // du/dt = f1(u) + f2(u) with an explicit rotation f1(u) = R u and an
+   // implicit decay f2(u) = -mu u, u(t) = exp(-mu t) (cos(t), -sin(t)).
+   class ODE : public TimeDependentOperator
+   {
+   protected:
+      double mu;
+   public:
+      ODE(double mu_) : TimeDependentOperator(2, 0.0), mu(mu_) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         dudt = 0.0;
+         if (eval_mode != ADDITIVE_TERM_2)
+         {
+            dudt(0) += u(1);
+            dudt(1) -= u(0);
+         }
+         if (eval_mode != ADDITIVE_TERM_1)
+         {
+            dudt.Add(-mu, u);
+         }
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u,
+                                 Vector &dudt)
+      {
+         REQUIRE(eval_mode == ADDITIVE_TERM_2);
+         // dudt = -mu (u + dt dudt)
+         dudt.Set(-mu/(1.0 + mu*dt), u);
+      }
+   };
+
+   auto type = GENERATE(0, 1, 2);
+   const int order = type + 2;
+   auto make_solver = [type]() -> IMEXRKSolver*
+   {
+      switch (type)
+      {
+         case 0: return new IMEXARS222Solver;
+         case 1: return new IMEXARK32Solver;
+         default: return new IMEXARK43Solver;
+      }
+   };
+   const double tf = 1.0;
+   auto error = [tf](const Vector &u, double mu)
+   {
+      const double e = exp(-mu*tf);
+      return std::hypot(u(0) - e*cos(tf), u(1) + e*sin(tf));
+   };
+
+   SECTION("Order")
+   {
+      ODE oper(1.0);
+      double err[2];
+      for (int l = 0; l < 2; l++)
+      {
+         IMEXRKSolver *ode_solver = make_solver();
+         ode_solver->Init(oper);
+         if (type > 0) { ode_solver->EnableStepControl(false); }
+         Vector u(2);
+         u(0) = 1.0; u(1) = 0.0;
+         double t = 0.0, dt = tf/(16 << l);
+         ode_solver->Run(u, t, dt, tf - 1e-12);
+         REQUIRE(oper.GetEvalMode() == TimeDependentOperator::NORMAL);
+         err[l] = error(u, 1.0);
+         delete ode_solver;
+      }
+      REQUIRE(log(err[0]/err[1])/log(2.0) > order - 0.2);
+   }
+
+   SECTION("Explicit weights")
+   {
+      // without the implicit term, one step of size h applies the stability
+      // polynomial of the explicit tableau to the rotation, which for
+      // ARS(2,2,2), with the weights (delta, 1-delta, 0), is 1 + z + z^2/2
+      if (type == 0)
+      {
+         ODE oper(0.0);
+         IMEXRKSolver *ode_solver = make_solver();
+         ode_solver->Init(oper);
+         Vector u(2);
+         u(0) = 1.0; u(1) = 0.0;
+         double t = 0.0, dt = 0.1;
+         ode_solver->Step(u, t, dt);
+         REQUIRE(u(0) == MFEM_Approx(1.0 - dt*dt/2.0));
+         REQUIRE(u(1) == MFEM_Approx(-dt));
+         delete ode_solver;
+      }
+   }
+
+   SECTION("Stiff implicit term")
+   {
+      // the step size is not limited by the stiff implicit term
+      const double mu = 1e6;
+      ODE oper(mu);
+      IMEXRKSolver *ode_solver = make_solver();
+      ode_solver->Init(oper);
+      Vector u(2);
+      u(0) = 1.0; u(1) = 0.0;
+      double t = 0.0, dt = 0.1;
+      ode_solver->Run(u, t, dt, tf - 1e-12);
+      REQUIRE(u.Normlinf() < 1e-6);
+      if (type > 0) { REQUIRE(ode_solver->GetNumSteps() < 100); }
+      delete ode_solver;
+   }
+}
@@ -225,3 +225,106 @@ TEST_CASE("Vector Tests", "[Vector]")
       REQUIRE(diff.Norml2() < tol);
    }
 }
+
+TEST_CASE("Vector fused operations", "[Vector]")
+{
+   const int n = 37, m = 7;
+   Vector x(n), y(n), z(n), yr(n);
+   x.Randomize(1);
+   y.Randomize(2);
+   z.Randomize(3);
+
+   SECTION("AxpbyDot")
+   {
+      add(0.5, x, -2.0, y, yr);
+      const double dot = AxpbyDot(0.5, x, -2.0, y, z);
+      REQUIRE(dot == MFEM_Approx(yr * z));
+      yr -= y;
+      REQUIRE(yr.Normlinf() == MFEM_Approx(0.0));
+
+      // the updated vector and its squared norm
+      yr = y;
+      yr.Add(3.0, x);
+      REQUIRE(AxpbyDot(3.0, x, 1.0, y, y) == MFEM_Approx(yr * yr));
+   }
+
+   Array<Vector*> v(m);
+   double a[m], dots[m];
+   for (int k = 0; k < m; k++)
+   {
+      v[k] = new Vector(n);
+      v[k]->Randomize(10 + k);
+      a[k] = 1.0 - 0.3*k;
+   }
+
+   SECTION("MultiAxpy")
+   {
+      // all group sizes, including the padded ones
+      for (int mm = 0; mm <= m; mm++)
+      {
+         yr = y;
+         for (int k = 0; k < mm; k++) { yr.Add(a[k], *v[k]); }
+         z = y;
+         MultiAxpy(mm, a, v.GetData(), z);
+         z -= yr;
+         REQUIRE(z.Normlinf() == MFEM_Approx(0.0));
+      }
+   }
+
+   SECTION("MultiDot")
+   {
+      for (int mm = 1; mm <= m; mm++)
+      {
+         MultiDot(mm, v.GetData(), y, dots);
+         for (int k = 0; k < mm; k++)
+         {
+            REQUIRE(dots[k] == MFEM_Approx((*v[k]) * y));
+         }
+      }
+   }
+
+   for (int k = 0; k < m; k++) { delete v[k]; }
+}
+
+TEST_CASE("GMRES orthogonalization", "[Vector]")
+{
+   // nonsymmetric convection-diffusion matrix
+   const int n = 40;
+   SparseMatrix A(n);
+   for (int i = 0; i < n; i++)
+   {
+      A.Add(i, i, 2.0);
+      if (i > 0) { A.Add(i, i-1, -1.5); }
+      if (i < n-1) { A.Add(i, i+1, -0.5); }
+   }
+   A.Finalize();
+   Vector b(n), x(n), r(n);
+   b.Randomize(1);
+
+   auto type = GENERATE(GMRESSolver::MGS, GMRESSolver::CGS2);
+   auto flexible = GENERATE(false, true);
+   GMRESSolver gmres;
+   FGMRESSolver fgmres;
+   IterativeSolver *solver = &gmres;
+   gmres.SetKDim(n);
+   fgmres.SetKDim(n);
+   if (flexible)
+   {
+      fgmres.SetOrthogonalization(type);
+      solver = &fgmres;
+   }
+   else
+   {
+      gmres.SetOrthogonalization(type);
+   }
+   solver->SetOperator(A);
+   solver->SetRelTol(1e-12);
+   solver->SetMaxIter(n);
+   x = 0.0;
+   solver->Mult(b, x);
+   REQUIRE(solver->GetConverged());
+
+   A.Mult(x, r);
+   r -= b;
+   REQUIRE(r.Norml2() <= 1e-10*b.Norml2());
+}
@@ -181,6 +181,203 @@ TEST_CASE("MakeSimplicial", "[Mesh]")
    REQUIRE(simplex_mesh.GetNE() == orig_mesh.GetNE()*factor);
 }
 
+TEST_CASE("Uniform hex refinement", "[Mesh]")
+{
+   auto mesh_fname = GENERATE("../../data/beam-hex.mesh",
+                              "../../data/fichera.mesh",
+                              "../../data/inline-hex.mesh");
+
+   Mesh mesh(mesh_fname, 1, 1);
+   mesh.UniformRefinement();
+   mesh.UniformRefinement();
+
+   // Rebuild the topology of the refined mesh from its elements and compare
+   // it with the one generated directly by the refinement.
+   std::stringstream mesh_str;
+   mesh.Print(mesh_str);
+   Mesh ref_mesh(mesh_str, 1, 1);
+
+   REQUIRE(mesh.GetNV() == ref_mesh.GetNV());
+   REQUIRE(mesh.GetNE() == ref_mesh.GetNE());
+   REQUIRE(mesh.GetNBE() == ref_mesh.GetNBE());
+   REQUIRE(mesh.GetNEdges() == ref_mesh.GetNEdges());
+   REQUIRE(mesh.GetNFaces() == ref_mesh.GetNFaces());
+
+   Array<int> row, ref_row, cor;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      mesh.ElementToEdgeTable().GetRow(i, row);
+      ref_mesh.ElementToEdgeTable().GetRow(i, ref_row);
+      REQUIRE(row == ref_row);
+      mesh.ElementToFaceTable().GetRow(i, row);
+      ref_mesh.ElementToFaceTable().GetRow(i, ref_row);
+      REQUIRE(row == ref_row);
+   }
+   for (int i = 0; i < mesh.GetNBE(); i++)
+   {
+      mesh.GetBdrElementEdges(i, row, cor);
+      ref_mesh.GetBdrElementEdges(i, ref_row, cor);
+      REQUIRE(row == ref_row);
+      REQUIRE(mesh.GetBdrFace(i) == ref_mesh.GetBdrFace(i));
+   }
+   for (int f = 0; f < mesh.GetNFaces(); f++)
+   {
+      int e1, e2, ref_e1, ref_e2, inf1, inf2, ref_inf1, ref_inf2;
+      mesh.GetFaceElements(f, &e1, &e2);
+      ref_mesh.GetFaceElements(f, &ref_e1, &ref_e2);
+      mesh.GetFaceInfos(f, &inf1, &inf2);
+      ref_mesh.GetFaceInfos(f, &ref_inf1, &ref_inf2);
+      REQUIRE(e1 == ref_e1);
+      REQUIRE(e2 == ref_e2);
+      REQUIRE(inf1 == ref_inf1);
+      REQUIRE(inf2 == ref_inf2);
+   }
+}
+
+static void ShearMesh(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.3*x(1);
+}
+
+static void TwistMesh(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.2*x(0)*x(1);
+}
+
+TEST_CASE("Compressed geometric factors", "[Mesh]")
+{
+   const int dim = GENERATE(2, 3);
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(3, 4, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(3, 2, 4, Element::HEXAHEDRON);
+   mesh.Transform(ShearMesh); // still affine
+   mesh.EnsureNodes();
+
+   const int NE = mesh.GetNE();
+   const IntegrationRule &ir = IntRules.Get(mesh.GetElementGeometry(0), 4);
+   const int flags = GeometricFactors::JACOBIANS |
+                     GeometricFactors::DETERMINANTS;
+
+   auto check = [&](const GeometricFactors &cgf, const GeometricFactors &gf)
+   {
+      const int NQ = gf.IntRule->GetNPoints();
+      const int nj = cgf.compressed ? 1 : NQ;
+      for (int e = 0; e < NE; e++)
+      {
+         for (int q = 0; q < NQ; q++)
+         {
+            const int qc = cgf.compressed ? 0 : q;
+            for (int k = 0; k < dim*dim; k++)
+            {
+               REQUIRE(cgf.J(qc + nj*(k + dim*dim*e)) ==
+                       MFEM_Approx(gf.J(q + NQ*(k + dim*dim*e))));
+            }
+            REQUIRE(cgf.detJ(qc + nj*e) == MFEM_Approx(gf.detJ(q + NQ*e)));
+         }
+      }
+   };
+
+   const GeometricFactors *cgf = mesh.GetGeometricFactors(
+                                    ir, flags | GeometricFactors::COMPRESSED);
+   const GeometricFactors *gf = mesh.GetGeometricFactors(ir, flags);
+   REQUIRE(cgf != gf);
+   REQUIRE(cgf->compressed);
+   REQUIRE(!gf->compressed);
+   REQUIRE(cgf->J.Size() == dim*dim*NE);
+   REQUIRE(cgf->detJ.Size() == NE);
+   REQUIRE(cgf->MemoryUsage() < gf->MemoryUsage());
+   REQUIRE(mesh.GeometricFactorsMemoryUsage() >=
+           cgf->MemoryUsage() + gf->MemoryUsage());
+   check(*cgf, *gf);
+
+   // the compressed factors of all rules share their storage, and the
+   // coordinates are shared by the factors of the same rule
+   const IntegrationRule &ir2 = IntRules.Get(mesh.GetElementGeometry(0), 2);
+   const GeometricFactors *cgf2 = mesh.GetGeometricFactors(
+                                     ir2, flags | GeometricFactors::COMPRESSED);
+   REQUIRE(cgf2->compressed);
+   REQUIRE(cgf2->J.GetData() == cgf->J.GetData());
+   REQUIRE(cgf2->detJ.GetData() == cgf->detJ.GetData());
+   const int xflags = GeometricFactors::COORDINATES;
+   const GeometricFactors *cxgf = mesh.GetGeometricFactors(
+                                     ir, flags | xflags |
+                                     GeometricFactors::COMPRESSED);
+   const GeometricFactors *xgf = mesh.GetGeometricFactors(ir, flags | xflags);
+   REQUIRE(cxgf->compressed);
+   REQUIRE(!xgf->compressed);
+   REQUIRE(xgf->X.GetData() == cxgf->X.GetData());
+
+   // moving the nodes makes the mesh non-affine: the factors are recomputed
+   // in place by the next request, and the uncompressed requests can then
+   // use the factors requested with COMPRESSED
+   mesh.Transform(TwistMesh);
+   REQUIRE(mesh.GetGeometricFactors(
+              ir, flags | GeometricFactors::COMPRESSED) == cgf);
+   REQUIRE(mesh.GetGeometricFactors(ir, flags) == cgf);
+   REQUIRE(!cgf->compressed);
+   REQUIRE(cgf->J.Size() == dim*dim*ir.GetNPoints()*NE);
+
+   GeometricFactors ref(*mesh.GetNodes(), ir, flags);
+   check(*cgf, ref);
+   check(*mesh.GetGeometricFactors(ir2, flags | GeometricFactors::COMPRESSED),
+         GeometricFactors(*mesh.GetNodes(), ir2, flags));
+
+   // copies and swapped meshes do not use the factors of the other mesh
+   Mesh copy(mesh);
+   check(*copy.GetGeometricFactors(ir, flags), ref);
+   Mesh other = (dim == 2) ?
+                Mesh::MakeCartesian2D(3, 4, Element::QUADRILATERAL) :
+                Mesh::MakeCartesian3D(3, 2, 4, Element::HEXAHEDRON);
+   other.EnsureNodes();
+   GeometricFactors other_ref(*other.GetNodes(), ir, flags);
+   other.GetGeometricFactors(ir, flags);
+   other.Swap(mesh, true);
+   check(*other.GetGeometricFactors(ir, flags), ref);
+   check(*mesh.GetGeometricFactors(ir, flags), other_ref);
+}
+
+TEST_CASE("PA mass and diffusion on affine meshes", "[Mesh], [PartialAssembly]")
+{
+   const int dim = GENERATE(2, 3);
+   const int order = 2;
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(3, 4, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(3, 2, 2, Element::HEXAHEDRON);
+   mesh.Transform(ShearMesh);
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   GridFunction x(&fes), y_pa(&fes), y_fa(&fes);
+   x.Randomize(1);
+
+   for (int integ = 0; integ < 2; integ++)
+   {
+      BilinearForm a_pa(&fes), a_fa(&fes);
+      if (integ == 0)
+      {
+         a_pa.AddDomainIntegrator(new MassIntegrator);
+         a_fa.AddDomainIntegrator(new MassIntegrator);
+      }
+      else
+      {
+         a_pa.AddDomainIntegrator(new DiffusionIntegrator);
+         a_fa.AddDomainIntegrator(new DiffusionIntegrator);
+      }
+      a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_pa.Assemble();
+      a_fa.Assemble();
+      a_fa.Finalize();
+
+      a_pa.Mult(x, y_pa);
+      a_fa.Mult(x, y_fa);
+      y_pa -= y_fa;
+      REQUIRE(y_pa.Normlinf() == MFEM_Approx(0.0));
+   }
+}
+
 TEST_CASE("MakeNurbs", "[Mesh]") {
   Array<double> intervals;
   intervals.Append(1);
@@ -245,3 +442,119 @@ TEST_CASE("MakeNurbs", "[Mesh]") {
   fe->SetProlongation(&p);
   fe->SetRestriction(&r);
 }
+
+TEST_CASE("Point locator", "[Mesh]")
+{
+   auto check_mesh = [](Mesh &mesh)
+   {
+      const int sdim = mesh.SpaceDimension();
+      const int npts = 50;
+      DenseMatrix pts(sdim, npts + 1);
+      Vector(pts.Data(), pts.Height()*pts.Width()).Randomize(1);
+      // keep the points away from the boundary of the unit box
+      for (int k = 0; k < npts; k++)
+      {
+         for (int d = 0; d < sdim; d++) { pts(d,k) = 0.05 + 0.9*pts(d,k); }
+      }
+      for (int d = 0; d < sdim; d++) { pts(d,npts) = 1.5; }
+
+      Array<int> elem_ids;
+      Array<IntegrationPoint> ips;
+      const int found = mesh.FindPoints(pts, elem_ids, ips, false);
+      REQUIRE(found == npts);
+      REQUIRE(elem_ids[npts] == -1);
+
+      Vector x;
+      for (int k = 0; k < npts; k++)
+      {
+         REQUIRE(elem_ids[k] >= 0);
+         ElementTransformation *T = mesh.GetElementTransformation(elem_ids[k]);
+         T->Transform(ips[k], x);
+         for (int d = 0; d < sdim; d++)
+         {
+            REQUIRE(x(d) == MFEM_Approx(pts(d,k)));
+         }
+      }
+
+      // the index is rebuilt after the nodes are moved
+      const long seq = mesh.GetNodesSequence();
+      Vector disp(mesh.GetNV()*sdim);
+      disp = 1.0;
+      mesh.MoveVertices(disp);
+      REQUIRE(mesh.GetNodesSequence() != seq);
+      REQUIRE(mesh.GetPointLocator().IsUpToDate());
+      for (int k = 0; k < pts.Width(); k++)
+      {
+         for (int d = 0; d < sdim; d++) { pts(d,k) += 1.0; }
+      }
+      REQUIRE(mesh.FindPoints(pts, elem_ids, ips, false) == npts);
+
+      // nodes modified in place, without NodesUpdated(), are also detected
+      mesh.EnsureNodes();
+      const PointLocator &locator = mesh.GetPointLocator();
+      REQUIRE(locator.IsUpToDate());
+      *mesh.GetNodes() += 1.0;
+      REQUIRE(!locator.IsUpToDate());
+      for (int k = 0; k < pts.Width(); k++)
+      {
+         for (int d = 0; d < sdim; d++) { pts(d,k) += 1.0; }
+      }
+      REQUIRE(mesh.FindPoints(pts, elem_ids, ips, false) == npts);
+   };
+
+   SECTION("Quadrilaterals")
+   {
+      Mesh mesh = Mesh::MakeCartesian2D(7, 5, Element::QUADRILATERAL);
+      check_mesh(mesh);
+   }
+   SECTION("Triangles")
+   {
+      Mesh mesh = Mesh::MakeCartesian2D(6, 6, Element::TRIANGLE);
+      check_mesh(mesh);
+   }
+   SECTION("Hexahedra")
+   {
+      Mesh mesh = Mesh::MakeCartesian3D(4, 3, 5, Element::HEXAHEDRON);
+      check_mesh(mesh);
+   }
+
+   SECTION("Surface")
+   {
+      // a flat surface in 3D: the grid has about one cell per element
+      Mesh mesh = Mesh::MakeCartesian2D(40, 40, Element::QUADRILATERAL);
+      mesh.SetCurvature(1, false, 3, Ordering::byVDIM);
+      const PointLocator &locator = mesh.GetPointLocator();
+      REQUIRE(locator.GetNCells() <= mesh.GetNE());
+      REQUIRE(locator.GetNCells() >= mesh.GetNE()/4);
+
+      DenseMatrix pts(3, 2);
+      pts(0,0) = 0.33; pts(1,0) = 0.71; pts(2,0) = 0.0;
+      pts(0,1) = 0.33; pts(1,1) = 0.71; pts(2,1) = 0.5;
+      Array<int> elem_ids;
+      Array<IntegrationPoint> ips;
+      REQUIRE(mesh.FindPoints(pts, elem_ids, ips, false) == 1);
+      REQUIRE(elem_ids[0] >= 0);
+      REQUIRE(elem_ids[1] == -1);
+   }
+
+   SECTION("InterpolateFromMesh")
+   {
+      Mesh src_mesh = Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL);
+      Mesh dst_mesh = Mesh::MakeCartesian2D(3, 5, Element::TRIANGLE,
+                                            false, 0.8, 0.9);
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace src_fes(&src_mesh, &fec, 2);
+      FiniteElementSpace dst_fes(&dst_mesh, &fec, 2);
+
+      auto f = [](const Vector &x, Vector &v)
+      {
+         v(0) = x(0)*x(1) + 2.0*x(0) - 1.0;
+         v(1) = x(1)*x(1) - x(0);
+      };
+      VectorFunctionCoefficient coeff(2, f);
+      GridFunction src(&src_fes), dst(&dst_fes);
+      src.ProjectCoefficient(coeff);
+      dst.InterpolateFromMesh(src);
+      REQUIRE(dst.ComputeL2Error(coeff) == MFEM_Approx(0.0));
+   }
+}
@@ -12,6 +12,10 @@
 #include "mfem.hpp"
 #include "unit_tests.hpp"
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -115,6 +119,126 @@ TEST_CASE("NCMesh PA diagonal", "[NCMesh]")
 
 } // test case
 
+// Test case: Refine one corner of a hex mesh and check that the face and edge
+//            lists are consistent and do not depend on the number of threads,
+//            and that the update stages are timed.
+TEST_CASE("NCMesh face list and timings", "[NCMesh]")
+{
+   Mesh mesh = Mesh::MakeCartesian3D(3, 3, 3, Element::HEXAHEDRON);
+   mesh.EnsureNCMesh();
+
+   Array<int> refs;
+   refs.Append(0);
+   mesh.GeneralRefinement(refs);
+   refs[0] = mesh.GetNE() - 1;
+   mesh.GeneralRefinement(refs);
+
+   NCMesh &ncmesh = *mesh.ncmesh;
+   for (int entity = 1; entity <= 2; entity++)
+   {
+      const NCMesh::NCList &list = ncmesh.GetNCList(entity);
+      REQUIRE(list.masters.Size() > 0);
+      for (int i = 0; i < list.slaves.Size(); i++)
+      {
+         REQUIRE(list.slaves[i].master >= 0);
+      }
+
+      const int num = (entity == 1) ? mesh.GetNEdges() : mesh.GetNFaces();
+      Array<bool> seen(num);
+      seen = false;
+      for (int i = 0; i < list.conforming.Size(); i++)
+      {
+         seen[list.conforming[i].index] = true;
+      }
+      for (int i = 0; i < list.masters.Size(); i++)
+      {
+         seen[list.masters[i].index] = true;
+      }
+      for (int i = 0; i < list.slaves.Size(); i++)
+      {
+         seen[list.slaves[i].index] = true;
+      }
+      if (entity == 2)
+      {
+         // conforming boundary faces are not included in the face list
+         for (int i = 0; i < mesh.GetNBE(); i++)
+         {
+            seen[mesh.GetBdrElementEdgeIndex(i)] = true;
+         }
+      }
+      for (int i = 0; i < num; i++) { REQUIRE(seen[i]); }
+   }
+
+   // The face and edge lists built with a single thread are identical to the
+   // ones built above with the default number of threads (the hash lookups
+   // in BuildFaceList and BuildEdgeList are threaded with OpenMP).
+#ifdef MFEM_USE_OPENMP
+   const int nthreads = omp_get_max_threads();
+   omp_set_num_threads(1);
+#endif
+   Mesh serial = Mesh::MakeCartesian3D(3, 3, 3, Element::HEXAHEDRON);
+   serial.EnsureNCMesh();
+   refs[0] = 0;
+   serial.GeneralRefinement(refs);
+   refs[0] = serial.GetNE() - 1;
+   serial.GeneralRefinement(refs);
+   NCMesh &serial_ncmesh = *serial.ncmesh;
+   for (int entity = 1; entity <= 2; entity++)
+   {
+      const NCMesh::NCList &list = ncmesh.GetNCList(entity);
+      const NCMesh::NCList &slist = serial_ncmesh.GetNCList(entity);
+      auto same_id = [](const NCMesh::MeshId &a, const NCMesh::MeshId &b)
+      {
+         return a.index == b.index && a.element == b.element &&
+                a.local == b.local && a.geom == b.geom;
+      };
+      REQUIRE(list.conforming.Size() == slist.conforming.Size());
+      for (int i = 0; i < list.conforming.Size(); i++)
+      {
+         REQUIRE(same_id(list.conforming[i], slist.conforming[i]));
+      }
+      REQUIRE(list.masters.Size() == slist.masters.Size());
+      for (int i = 0; i < list.masters.Size(); i++)
+      {
+         REQUIRE(same_id(list.masters[i], slist.masters[i]));
+         REQUIRE(list.masters[i].slaves_begin == slist.masters[i].slaves_begin);
+         REQUIRE(list.masters[i].slaves_end == slist.masters[i].slaves_end);
+      }
+      REQUIRE(list.slaves.Size() == slist.slaves.Size());
+      for (int i = 0; i < list.slaves.Size(); i++)
+      {
+         REQUIRE(same_id(list.slaves[i], slist.slaves[i]));
+         REQUIRE(list.slaves[i].master == slist.slaves[i].master);
+         REQUIRE(list.slaves[i].matrix == slist.slaves[i].matrix);
+         REQUIRE(list.slaves[i].edge_flags == slist.slaves[i].edge_flags);
+      }
+      for (int g = 0; g < Geometry::NumGeom; g++)
+      {
+         REQUIRE(list.point_matrices[g].Size() ==
+                 slist.point_matrices[g].Size());
+         for (int i = 0; i < list.point_matrices[g].Size(); i++)
+         {
+            DenseMatrix diff(*list.point_matrices[g][i]);
+            diff -= *slist.point_matrices[g][i];
+            REQUIRE(diff.MaxMaxNorm() == 0.0);
+         }
+      }
+   }
+#ifdef MFEM_USE_OPENMP
+   omp_set_num_threads(nthreads);
+#endif
+
+   const NCMesh::Timings &t = ncmesh.GetTimings();
+   REQUIRE(t.refine >= 0.0);
+   REQUIRE(t.update >= 0.0);
+   REQUIRE(t.face_list >= 0.0);
+
+   ncmesh.ResetTimings();
+   REQUIRE(t.refine == 0.0);
+   REQUIRE(t.face_list == 0.0);
+
+} // test case
+
 #ifdef MFEM_USE_MPI
 
 // Test case: Verify that a conforming mesh yields the same norm for the